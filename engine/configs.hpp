@@ -8,6 +8,93 @@
 
 #include <cinttypes>
 
-#define TSHAPE_TYPE uint32_t
+// Type of the extents of tensor axes, 64 bits so a single axis, e.g. the rows of an embedding
+// table, can go past 4G items. Can be defined to uint32_t before including the engine to halve
+// the size of the shapes, element counts and offsets are size_t either way
+#ifndef TSHAPE_TYPE
+  #define TSHAPE_TYPE uint64_t
+#endif
+
+// Type of the column indices of sparse matrices, see "math/sparse.hpp", 32 bits halve the memory
+// of the indices, can be defined to uint64_t before including the engine for more than 4G columns
+#ifndef TSPARSE_INDEX_TYPE
+  #define TSPARSE_INDEX_TYPE uint32_t
+#endif
+
+// Shapes and strides of up to MNT_TENSOR_INLINE_RANK axes are stored inside the tensor,
+// see "math/shape.hpp", higher ranks work but allocate
+#define MNT_TENSOR_INLINE_RANK 8
+
+// The environment variables to configure the global thread pool, the number of threads
+// (including the calling thread) and pinning the workers to the CPU cores ("1" to enable)
+#define MNT_POOL_THREADS_ENV_VARIABLE "MNT_NUM_THREADS"
+#define MNT_POOL_PIN_ENV_VARIABLE "MNT_PIN_THREADS"
+
+// How long an idle worker spins before parking itself on a futex, short ops issued back to
+// back find the workers awake and don`t pay the wake-up cost of tens of microseconds
+#define MNT_POOL_SPIN_MICROSECONDS 100
+
+// Parallel loops estimate their cost as (number of items * cost per item) in CPU cycles,
+// a loop cheaper than MNT_POOL_MIN_PARALLEL_COST runs on the calling thread, otherwise it is
+// split into chunks of at least MNT_POOL_MIN_CHUNK_COST cycles, and around
+// MNT_POOL_CHUNKS_PER_THREAD chunks per thread for load balancing
+#define MNT_POOL_MIN_PARALLEL_COST 32768
+#define MNT_POOL_MIN_CHUNK_COST 8192
+#define MNT_POOL_CHUNKS_PER_THREAD 4
+
+// Cache blocking of the packed GEMM, a MC x KC block of A (96KB) stays in L2 next to the
+// KC x NC block of B (512KB), which is also the size of the patch tiles extracted by convolutions.
+// MNT_GEMM_PARALLEL_COLS is the width of the column slices the threads work on
+#define MNT_GEMM_MC 96
+#define MNT_GEMM_KC 256
+#define MNT_GEMM_NC 512
+#define MNT_GEMM_PARALLEL_COLS 128
+
+// Products of up to MNT_GEMM_SKINNY_M rows stream B through the skinny kernels instead of
+// packing it, above that the packed GEMM reuses every block of B for enough rows. B is
+// streamed MNT_GEMM_SKINNY_KC rows at a time, which has to divide MNT_GEMM_KC
+#define MNT_GEMM_SKINNY_M 8
+#define MNT_GEMM_SKINNY_KC 32
+
+// Typical relative error of Winograd F(4x4, 3x3) in float, compared to "Conv2DParams::tolerance",
+// and the number of transformed filters kept for layers with a constant filter
+#define MNT_WINOGRAD_RELATIVE_ERROR 1e-4f
+#define MNT_WINOGRAD_CACHE_ENTRIES 64
+
+// Typical relative error of the FFT convolution in float, and the number of blocks of the
+// signal (times channels) transformed together by a task of the overlap-add, enough
+// for the batched FFT kernels to run on full vectors
+#define MNT_FFT_RELATIVE_ERROR 1e-5f
+#define MNT_FFT_CONV_LANES 64
+
+// Reductions, see "math/reduce.hpp": contiguous runs are reduced in segments of MNT_REDUCE_SEGMENT
+// items, rows in vectors of MNT_REDUCE_COLUMNS outputs and blocks of MNT_REDUCE_BLOCK rows.
+// The threads split the reduced items if there are less than MNT_REDUCE_SPLIT_OUTPUTS outputs,
+// in deterministic mode in chunks of about MNT_REDUCE_DETERMINISTIC_GRAIN items
+#define MNT_REDUCE_SEGMENT 16384
+#define MNT_REDUCE_COLUMNS 256
+#define MNT_REDUCE_BLOCK 64
+#define MNT_REDUCE_SPLIT_OUTPUTS 64
+#define MNT_REDUCE_DETERMINISTIC_GRAIN 65536
+
+// Einsum, see "math/einsum.hpp": the contraction order of up to MNT_EINSUM_OPTIMAL_OPERANDS
+// inputs is searched exhaustively, 3^n subsets of pairs. Pairwise products of less than
+// MNT_EINSUM_GEMM_MIN_FLOPS multiply-adds per batch run as plain loops instead of the packed GEMM
+#define MNT_EINSUM_OPTIMAL_OPERANDS 8
+#define MNT_EINSUM_GEMM_MIN_FLOPS 512
+
+// Index ops, see "IndexSelect" of "math/backend.hpp": rows copied from random positions prefetch
+// the first MNT_PREFETCH_BYTES of the row MNT_PREFETCH_DISTANCE rows ahead, the hardware prefetcher
+// follows longer rows. ScatterAdd into a result with less independent lines than threads splits
+// the indices in chunks of MNT_SCATTER_GRAIN items, each adding into its own zeroed copy of a
+// result of at most MNT_SCATTER_GRAIN items
+#define MNT_PREFETCH_DISTANCE 8
+#define MNT_PREFETCH_BYTES 256
+#define MNT_SCATTER_GRAIN 65536
+
+// Allocation policies, see "memory/allocator/policies.hpp": pools and arenas align their allocations
+// to MNT_ALLOC_ALIGNMENT bytes, arenas take memory from the system in blocks of MNT_ARENA_BLOCK_SIZE bytes
+#define MNT_ALLOC_ALIGNMENT 64
+#define MNT_ARENA_BLOCK_SIZE (1 << 20)
 
 #endif
@@ -0,0 +1,42 @@
+// File Name:     activation.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Activations fused into the epilogue of other operations, and their gradients
+
+// ---------------------
+// Note:
+// Fused activations are applied by the kernels right before the results are stored,
+// "Activate" is the scalar version for the item types without SIMD kernels. The float
+// kernels use the vector functions of "kernels/vecmath.inl"
+// ---------------------
+
+#ifndef ENGINE_MATH_ACTIVATION_HPP
+#define ENGINE_MATH_ACTIVATION_HPP
+
+#include <cstdint>
+
+namespace mnt {
+
+  enum class Activation : uint8_t
+  {
+    None = 0,
+    Relu,     // max(x, 0)
+    Relu6,    // min(max(x, 0), 6)
+    Sigmoid,  // 1 / (1 + e^-x)
+    Tanh,
+    Gelu,     // x * Phi(x), Phi is the CDF of the standard normal distribution
+    Silu      // x * sigmoid(x)
+  };
+
+  template <typename T>
+  T Activate(T _x, Activation _activation) noexcept;
+
+  // Gradient of the input from the gradient of the output _dy, _x is the input of the
+  // activation, except for Sigmoid and Tanh where it is the output
+  template <typename T>
+  T ActivateBackward(T _x, T _dy, Activation _activation) noexcept;
+}
+
+#include "math/activation.inl"
+
+#endif
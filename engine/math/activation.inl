@@ -0,0 +1,55 @@
+// File Name:     activation.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Activations fused into the epilogue of other operations, and their gradients
+
+#ifndef ENGINE_MATH_ACTIVATION_INL
+#define ENGINE_MATH_ACTIVATION_INL
+
+#include "math/activation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mnt;
+
+template <typename T>
+T mnt::Activate(T _x, Activation _activation) noexcept
+{
+  switch (_activation)
+  {
+  case Activation::Relu:    return std::max(_x, T(0));
+  case Activation::Relu6:   return std::min(std::max(_x, T(0)), T(6));
+  case Activation::Sigmoid: return T(1) / (T(1) + std::exp(-_x));
+  case Activation::Tanh:    return std::tanh(_x);
+  case Activation::Gelu:    return _x * std::erfc(-_x * T(0.70710678118654752)) / T(2);
+  case Activation::Silu:    return _x / (T(1) + std::exp(-_x));
+  default:                  return _x;
+  }
+};
+
+template <typename T>
+T mnt::ActivateBackward(T _x, T _dy, Activation _activation) noexcept
+{
+  switch (_activation)
+  {
+  case Activation::Relu:    return _x > T(0) ? _dy : T(0);
+  case Activation::Relu6:   return _x > T(0) && _x < T(6) ? _dy : T(0);
+  case Activation::Sigmoid: return _dy * _x * (T(1) - _x);
+  case Activation::Tanh:    return _dy * (T(1) - _x * _x);
+  case Activation::Gelu:
+  {
+    const T cdf = std::erfc(-_x * T(0.70710678118654752)) / T(2);
+    const T density = std::exp(-_x * _x / T(2)) * T(0.39894228040143268);
+    return _dy * (cdf + _x * density);
+  }
+  case Activation::Silu:
+  {
+    const T sigmoid = T(1) / (T(1) + std::exp(-_x));
+    return _dy * sigmoid * (T(1) + _x * (T(1) - sigmoid));
+  }
+  default:                  return _dy;
+  }
+};
+
+#endif
@@ -2,7 +2,17 @@
 #define ENGINE_MATH_BACKEND_HPP
 
 #include "math/tensor.hpp"
+#include "math/half.hpp"
+#include "math/packed_matrix.hpp"
+#include "math/quantized_matrix.hpp"
+#include "math/sparse.hpp"
+#include "math/bitmask.hpp"
+#include "math/conv.hpp"
+#include "math/pool.hpp"
+#include "math/reduce.hpp"
+#include "math/einsum.hpp"
 
+#include <string>
 #include <vector>
 
 namespace mnt {
@@ -11,14 +21,149 @@ namespace mnt {
   class OPBackend
   {
   public:
+    virtual ~OPBackend() = default;
+
     // Linear Algebra
     virtual Tensor<T> Transpose(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
+    // Products of the matrices in the last two axes, the leading axes are a batch. A batch axis
+    // of size 1, or missing in the tensor of lower rank, is shared by the whole axis of the
+    // other tensor. Views of Shapeshift are read in place, e.g. the transposed keys of attention
+    virtual Tensor<T> BatchedMatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
+    // Sums of products given by subscripts, e.g. "bhqd,bhkd->bhqk", see "math/einsum.hpp", on
+    // plain tensors and their views. The inputs are contracted two at a time in the order of
+    // "EinsumPath", every pair is a batched GEMM on the strides of its operands, an operand is
+    // only copied if its rows or depth can`t be read with one stride. A full contraction has
+    // shape {1}
+    virtual Tensor<T> Einsum(const std::string& _spec, const std::vector<Tensor<T>*>& _tensors) = 0;
+    template <typename... TENSORS>
+    Tensor<T> Einsum(const std::string& _spec, Tensor<T>& _tensor, TENSORS&... _tensors)
+    {
+      return Einsum(_spec, std::vector<Tensor<T>*>{&_tensor, &_tensors...});
+    };
+    // Rows of _tensor, along its last axis, times weights packed beforehand, the result has
+    // the shape of _tensor with the last axis replaced by the columns of _matrix
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, const PackedMatrix<T>& _matrix) = 0;
+    // The same with a plain {rows, cols} matrix of weights in reduced precision, they are
+    // converted as they are read and the products accumulate in T
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, Tensor<Half>& _weights) = 0;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, Tensor<BFloat16>& _weights) = 0;
+    // The same with int8 weights, the input is quantized to uint8 with the input params of
+    // _weights, or with params chosen from its range if it has none, see "math/quantize.hpp"
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, const QuantizedMatrix& _weights) = 0;
 
     // Low-Level
     virtual Tensor<T> Add(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
+    virtual Tensor<T> Sub(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
+    virtual Tensor<T> Mul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
+    virtual Tensor<T> Div(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) = 0;
 
-    // High-Level
+    // Sparse, see "math/sparse.hpp", the work scales with the non-zeros. Dense operands are
+    // contiguous plain matrices. SpMM returns the dense product of {M, K} by {K, N}, SDDMM the
+    // non-zeros of _pattern .* (_a * _b^T) for _a {M, K} and _b {N, K}, sharing the structure
+    // of _pattern. Add and Sub keep the union of the non-zeros, Mul their intersection, or the
+    // non-zeros of _sparse when the other operand is dense
+    virtual Tensor<T> SpMM(SparseCSR<T>& _sparse, Tensor<T>& _dense) = 0;
+    virtual Tensor<T> SpMM(SparseBSR<T>& _sparse, Tensor<T>& _dense) = 0;
+    virtual SparseCSR<T> SDDMM(SparseCSR<T>& _pattern, Tensor<T>& _a, Tensor<T>& _b) = 0;
+    virtual SparseCSR<T> Add(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) = 0;
+    virtual SparseCSR<T> Sub(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) = 0;
+    virtual SparseCSR<T> Mul(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) = 0;
+    virtual SparseCSR<T> Mul(SparseCSR<T>& _sparse, Tensor<T>& _dense) = 0;
+
+    // Masks, see "math/bitmask.hpp", on contiguous plain tensors. ToMask sets the bits of the
+    // non-zero items, FromMask writes 1 and 0. MaskedFill replaces the items of the set bits
+    // with _value, _mask has the shape of _tensor or of its last axes and repeats over the
+    // leading ones, e.g. one {T, S} attention mask for all the batches and heads. MaskedSelect
+    // returns the items of the set bits in order, in a tensor of rank 1. Dropout keeps the
+    // items of the set bits times _scale and zeroes the others, on the gradient it is also
+    // the backward op, "Bernoulli" of "math/random.hpp" draws the kept bits
+    virtual BitMask ToMask(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> FromMask(BitMask& _mask) = 0;
+    virtual Tensor<T> MaskedFill(Tensor<T>& _tensor, BitMask& _mask, T _value) = 0;
+    virtual Tensor<T> MaskedSelect(Tensor<T>& _tensor, BitMask& _mask) = 0;
+    virtual Tensor<T> Dropout(Tensor<T>& _tensor, BitMask& _keep, T _scale) = 0;
+
+    // Indexing, on contiguous plain tensors, the indices are of the type of ArgMax and throw if
+    // they are out of range. IndexSelect takes the slices _indices of _axis, _indices of any shape
+    // replaces _axis in the result, e.g. the rows of an embedding table for {batch, tokens} ids.
+    // Gather takes y[i][j][k] = x[i][index[i][j][k]][k] for _axis 1, _indices has the rank of
+    // _tensor and is not larger along the other axes, e.g. the values of the indices of top-k.
+    // Scatter and ScatterAdd are its reverse, a copy of _tensor where the items of _source, of the
+    // shape of _indices, are written or added at the positions of _indices, the last one in order
+    // wins for Scatter. Concat joins tensors that only differ along _axis, Split cuts _tensor
+    // along _axis into parts of _sizes
+    virtual Tensor<T> IndexSelect(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices) = 0;
+    virtual Tensor<T> Gather(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices) = 0;
+    virtual Tensor<T> Scatter(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                              Tensor<T>& _source) = 0;
+    virtual Tensor<T> ScatterAdd(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                 Tensor<T>& _source) = 0;
+    virtual Tensor<T> Concat(const std::vector<Tensor<T>*>& _tensors, size_t _axis) = 0;
+    virtual std::vector<Tensor<T>> Split(Tensor<T>& _tensor, size_t _axis, const std::vector<size_t>& _sizes) = 0;
+
+    // Layout, also makes a contiguous copy of a view
+    virtual Tensor<T> Reorder(Tensor<T>& _tensor, Layout _layout) = 0;
 
+    // Reduced precision copies, see "math/half.hpp", they keep the shape and the layout
+    virtual Tensor<Half> ToHalf(Tensor<T>& _tensor) = 0;
+    virtual Tensor<BFloat16> ToBFloat16(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> Convert(Tensor<Half>& _tensor) = 0;
+    virtual Tensor<T> Convert(Tensor<BFloat16>& _tensor) = 0;
+
+    // Reductions, over any axes of plain tensors and their views
+    virtual Tensor<T> Sum(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    virtual Tensor<T> Mean(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    virtual Tensor<T> Max(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    virtual Tensor<T> Min(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    // L2 norm
+    virtual Tensor<T> Norm(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    virtual Tensor<T> Variance(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) = 0;
+    // Index of the first maximum along _axis
+    virtual Tensor<TSHAPE_TYPE> ArgMax(Tensor<T>& _tensor, size_t _axis, bool _keep_dims = false) = 0;
+
+    // Normalization, along the last axis of plain tensors, _gamma and _beta have the shape of
+    // the last axis. The backward ops take the output of softmax and the input of the norms,
+    // and replace _grad_gamma and _grad_beta with the gradients of the parameters
+    virtual Tensor<T> Softmax(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> LogSoftmax(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> SoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> LogSoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> LayerNorm(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _beta,
+                                T _epsilon = T(1e-5)) = 0;
+    virtual Tensor<T> RMSNorm(Tensor<T>& _input, Tensor<T>& _gamma, T _epsilon = T(1e-6)) = 0;
+    virtual Tensor<T> LayerNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                        Tensor<T>& _grad_gamma, Tensor<T>& _grad_beta,
+                                        T _epsilon = T(1e-5)) = 0;
+    virtual Tensor<T> RMSNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                      Tensor<T>& _grad_gamma, T _epsilon = T(1e-6)) = 0;
+
+    // Activations, elementwise on any layout, the backward ops take the input of the
+    // activation, except Sigmoid and Tanh that take its output
+    virtual Tensor<T> Relu(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> LeakyRelu(Tensor<T>& _tensor, T _alpha = T(0.01)) = 0;
+    virtual Tensor<T> Sigmoid(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> Tanh(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> Gelu(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> Silu(Tensor<T>& _tensor) = 0;
+    virtual Tensor<T> ReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> LeakyReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output, T _alpha = T(0.01)) = 0;
+    virtual Tensor<T> SigmoidBackward(Tensor<T>& _output, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> TanhBackward(Tensor<T>& _output, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> GeluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) = 0;
+    virtual Tensor<T> SiluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) = 0;
+
+    // High-Level
+    virtual Tensor<T> Conv2D(Tensor<T>& _input, Tensor<T>& _filter,
+                             const Conv2DParams& _params = Conv2DParams()) = 0;
+    // _bias has shape {OC}, it is added before the activation of the params
+    virtual Tensor<T> Conv2D(Tensor<T>& _input, Tensor<T>& _filter, Tensor<T>& _bias,
+                             const Conv2DParams& _params = Conv2DParams()) = 0;
+    // _input has shape {N, C, L} and _filter {OC, C, K}
+    virtual Tensor<T> Conv1D(Tensor<T>& _input, Tensor<T>& _filter,
+                             const Conv1DParams& _params = Conv1DParams()) = 0;
+    virtual Tensor<T> MaxPool2D(Tensor<T>& _input, const Pool2DParams& _params = Pool2DParams()) = 0;
+    virtual Tensor<T> AvgPool2D(Tensor<T>& _input, const Pool2DParams& _params = Pool2DParams()) = 0;
   };
 
 }
@@ -1,23 +1,290 @@
+// File Name:     default.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The CPU backend of the engine
+
+// ---------------------
+// Detail Description:
+// Float operations run the kernels bound by KernelRegistry for the running CPU
+// (SSE4, AVX2, AVX-512 or NEON), the other types use the reference kernels.
+// Operations are split over the global ThreadPool, small ones run on the calling thread.
+// MatMul, BatchedMatMul and the GEMM based convolutions only have a packed float implementation, the
+// other types fall back to plain loops. Half and BFloat16 are storage only, the products with
+// weights in reduced precision compute in float, or in T after a conversion for the other types.
+// The int8 MatMul only runs the integer GEMM for float, the other types use the dequantized weights.
+// Sparse products split the rows in chunks of about the same number of non-zeros, see
+// "ForEachSparseRows", so a few dense rows don`t stall one thread. Masks are applied in
+// chunks of whole 64-bit words, see "math/bitmask.hpp". Einsum runs every pair of its path
+// through the batched GEMM on the strides of the operands, products of less than
+// MNT_EINSUM_GEMM_MIN_FLOPS per batch and the other types use plain loops.
+// The index ops copy whole rows with memcpy where the indices pick rows, and prefetch the rows
+// ahead since their positions are random. Scatter splits the lines along the axis over the
+// threads, every position is written by one thread, ScatterAdd into a small result with few
+// lines adds into zeroed copies of the result per chunk of indices and sums them at the end.
+// ---------------------
+
+// ---------------------
+// Note:
+// Convolutions and pooling keep the layout of their input, blocked inputs (NCHW8c, NCHW16c)
+// run the direct blocked kernels with the filter reordered on every call, grouped
+// convolutions that are not depthwise go through the plain layout. The other
+// operations need plain tensors, except the elementwise ones that only need equal layouts.
+// ---------------------
+
 #ifndef ENGINE_MATH_BACKENDS_DEFAULT_HPP
 #define ENGINE_MATH_BACKENDS_DEFAULT_HPP
 
 #include "math/tensor.hpp"
 #include "math/backend.hpp"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace mnt {
 
   template<typename T>
-  class DefaultBackend : OPBackend<T>
+  class DefaultBackend : public OPBackend<T>
   {
   public:
     // Linear Algebra
-    virtual Tensor<T> Transpose(Tensor<T>& _tensor);
+    virtual Tensor<T> Transpose(Tensor<T>& _tensor) override;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+    virtual Tensor<T> BatchedMatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+    using OPBackend<T>::Einsum;
+    virtual Tensor<T> Einsum(const std::string& _spec, const std::vector<Tensor<T>*>& _tensors) override;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, const PackedMatrix<T>& _matrix) override;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, Tensor<Half>& _weights) override;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, Tensor<BFloat16>& _weights) override;
+    virtual Tensor<T> MatMul(Tensor<T>& _tensor, const QuantizedMatrix& _weights) override;
 
     // Low-Level
-    virtual Tensor<T> Add(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2);
+    virtual Tensor<T> Add(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+    virtual Tensor<T> Sub(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+    virtual Tensor<T> Mul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+    virtual Tensor<T> Div(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2) override;
+
+    // Sparse
+    virtual Tensor<T> SpMM(SparseCSR<T>& _sparse, Tensor<T>& _dense) override;
+    virtual Tensor<T> SpMM(SparseBSR<T>& _sparse, Tensor<T>& _dense) override;
+    virtual SparseCSR<T> SDDMM(SparseCSR<T>& _pattern, Tensor<T>& _a, Tensor<T>& _b) override;
+    virtual SparseCSR<T> Add(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) override;
+    virtual SparseCSR<T> Sub(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) override;
+    virtual SparseCSR<T> Mul(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2) override;
+    virtual SparseCSR<T> Mul(SparseCSR<T>& _sparse, Tensor<T>& _dense) override;
+
+    // Masks
+    virtual BitMask ToMask(Tensor<T>& _tensor) override;
+    virtual Tensor<T> FromMask(BitMask& _mask) override;
+    virtual Tensor<T> MaskedFill(Tensor<T>& _tensor, BitMask& _mask, T _value) override;
+    virtual Tensor<T> MaskedSelect(Tensor<T>& _tensor, BitMask& _mask) override;
+    virtual Tensor<T> Dropout(Tensor<T>& _tensor, BitMask& _keep, T _scale) override;
+
+    // Indexing
+    virtual Tensor<T> IndexSelect(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices) override;
+    virtual Tensor<T> Gather(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices) override;
+    virtual Tensor<T> Scatter(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                              Tensor<T>& _source) override;
+    virtual Tensor<T> ScatterAdd(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                 Tensor<T>& _source) override;
+    virtual Tensor<T> Concat(const std::vector<Tensor<T>*>& _tensors, size_t _axis) override;
+    virtual std::vector<Tensor<T>> Split(Tensor<T>& _tensor, size_t _axis, const std::vector<size_t>& _sizes) override;
+
+    // Layout
+    virtual Tensor<T> Reorder(Tensor<T>& _tensor, Layout _layout) override;
+
+    // Reduced precision
+    virtual Tensor<Half> ToHalf(Tensor<T>& _tensor) override;
+    virtual Tensor<BFloat16> ToBFloat16(Tensor<T>& _tensor) override;
+    virtual Tensor<T> Convert(Tensor<Half>& _tensor) override;
+    virtual Tensor<T> Convert(Tensor<BFloat16>& _tensor) override;
+
+    // Reductions
+    virtual Tensor<T> Sum(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<T> Mean(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<T> Max(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<T> Min(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<T> Norm(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<T> Variance(Tensor<T>& _tensor, const ReduceParams& _params = ReduceParams()) override;
+    virtual Tensor<TSHAPE_TYPE> ArgMax(Tensor<T>& _tensor, size_t _axis, bool _keep_dims = false) override;
+
+    // Normalization
+    virtual Tensor<T> Softmax(Tensor<T>& _tensor) override;
+    virtual Tensor<T> LogSoftmax(Tensor<T>& _tensor) override;
+    virtual Tensor<T> SoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> LogSoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> LayerNorm(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _beta,
+                                T _epsilon = T(1e-5)) override;
+    virtual Tensor<T> RMSNorm(Tensor<T>& _input, Tensor<T>& _gamma, T _epsilon = T(1e-6)) override;
+    virtual Tensor<T> LayerNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                        Tensor<T>& _grad_gamma, Tensor<T>& _grad_beta,
+                                        T _epsilon = T(1e-5)) override;
+    virtual Tensor<T> RMSNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                      Tensor<T>& _grad_gamma, T _epsilon = T(1e-6)) override;
+
+    // Activations
+    virtual Tensor<T> Relu(Tensor<T>& _tensor) override;
+    virtual Tensor<T> LeakyRelu(Tensor<T>& _tensor, T _alpha = T(0.01)) override;
+    virtual Tensor<T> Sigmoid(Tensor<T>& _tensor) override;
+    virtual Tensor<T> Tanh(Tensor<T>& _tensor) override;
+    virtual Tensor<T> Gelu(Tensor<T>& _tensor) override;
+    virtual Tensor<T> Silu(Tensor<T>& _tensor) override;
+    virtual Tensor<T> ReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> LeakyReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output, T _alpha = T(0.01)) override;
+    virtual Tensor<T> SigmoidBackward(Tensor<T>& _output, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> TanhBackward(Tensor<T>& _output, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> GeluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) override;
+    virtual Tensor<T> SiluBackward(Tensor<T>& _input, Tensor<T>& _grad_output) override;
 
     // High-Level
+    virtual Tensor<T> Conv2D(Tensor<T>& _input, Tensor<T>& _filter,
+                             const Conv2DParams& _params = Conv2DParams()) override;
+    virtual Tensor<T> Conv2D(Tensor<T>& _input, Tensor<T>& _filter, Tensor<T>& _bias,
+                             const Conv2DParams& _params = Conv2DParams()) override;
+    virtual Tensor<T> Conv1D(Tensor<T>& _input, Tensor<T>& _filter,
+                             const Conv1DParams& _params = Conv1DParams()) override;
+    virtual Tensor<T> MaxPool2D(Tensor<T>& _input, const Pool2DParams& _params = Pool2DParams()) override;
+    virtual Tensor<T> AvgPool2D(Tensor<T>& _input, const Pool2DParams& _params = Pool2DParams()) override;
+
+  private:
+    using BinaryKernel = void (*)(const T*, const T*, T*, size_t) noexcept;
+
+    Tensor<T> Binary(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2, BinaryKernel _kernel);
+
+    // _kernel(x, y, length) and _kernel(x, dy, dx, length) on chunks of the items, the layout is kept
+    template <typename F>
+    Tensor<T> Unary(Tensor<T>& _tensor, const F& _kernel, size_t _cost);
+    template <typename F>
+    Tensor<T> UnaryBackward(Tensor<T>& _tensor, Tensor<T>& _grad_output, const F& _kernel, size_t _cost);
+
+    Tensor<T> Apply(Tensor<T>& _tensor, Activation _activation);
+    Tensor<T> ApplyBackward(Tensor<T>& _tensor, Tensor<T>& _grad_output, Activation _activation);
+
+    // Copies the items of a view or of block storage in row-major order
+    Tensor<T> Contiguous(Tensor<T>& _tensor);
+    // Copies the items of _src at the _strides of the axes of _shape to _dst in row-major order
+    static void CopyStrided(const T* _src, const TensorShape& _shape, const TensorStrides& _strides, T* _dst);
+
+    // Throws if _tensor is a view or not in linear storage, the other ops only work on contiguous tensors
+    template <typename U>
+    static void CheckContiguous(const Tensor<U>& _tensor);
+
+    // Copies _tensor item by item into a tensor of DST, float uses the kernels of KernelRegistry
+    template <typename SRC, typename DST>
+    static Tensor<DST> Cast(Tensor<SRC>& _tensor);
+
+    // Rows of _tensor times the weights, W is Half or BFloat16
+    template <typename W>
+    Tensor<T> ReducedMatMul(Tensor<T>& _tensor, Tensor<W>& _weights);
+
+    // Columns of a dense operand of a sparse op, throws if it is not a contiguous plain
+    // matrix of _rows rows
+    static size_t SparseOperand(const Tensor<T>& _dense, size_t _rows, const char* _op);
+    // Merges the sorted rows of two CSR matrices, _op(x, y) of every column in the union of
+    // their non-zeros, or in the intersection, a missing item is zero
+    template <typename F>
+    SparseCSR<T> Merge(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2, bool _union, const F& _op,
+                       const char* _op_name);
+
+    // Number of times _mask repeats over the leading axes of _tensor, throws if its shape isn`t
+    // the shape of the last axes or if _tensor isn`t a contiguous plain tensor
+    static size_t MaskRepeats(const Tensor<T>& _tensor, const BitMask& _mask, const char* _op);
+    // _kernel(x, bits, y, length) on chunks of whole words of every repeat of _mask
+    template <typename F>
+    Tensor<T> Masked(Tensor<T>& _tensor, BitMask& _mask, const F& _kernel, const char* _op);
+
+    // The items of a tensor of Einsum read with any strides, one letter per axis. _storage
+    // keeps the copies and the intermediates alive, "packed" if it holds the items in
+    // row-major order of the letters
+    struct EinsumOperand
+    {
+      const T* data = nullptr;
+      TensorShape shape;
+      TensorStrides strides;
+      std::string labels;
+      std::unique_ptr<Tensor<T>> storage;
+      bool packed = false;
+    };
+
+    // A packed operand on a new tensor of _labels, a tensor of shape {1} without letters
+    static EinsumOperand EinsumPacked(const std::string& _labels, const EinsumSpec& _spec);
+    // Input _input with the diagonals of its repeated letters, without the broadcast axes,
+    // and summed over the letters that the others don`t need
+    EinsumOperand EinsumInput(Tensor<T>& _tensor, const EinsumSpec& _spec, size_t _input);
+    // The product of a pair with the letters _labels: the letters of both operands that stay are
+    // the batch, the others are the depth, the letters of one operand are its rows or columns
+    EinsumOperand EinsumContract(EinsumOperand& _x, EinsumOperand& _y, const std::string& _labels,
+                                 const EinsumSpec& _spec);
+    // A packed copy of _operand with its axes in the order of _labels
+    static EinsumOperand EinsumArrange(const EinsumOperand& _operand, const std::string& _labels,
+                                       const EinsumSpec& _spec);
+    // Stride of the axes of _labels, in that order, read as one axis, false if they can`t be
+    static bool EinsumMerge(const EinsumOperand& _operand, const std::string& _labels, const EinsumSpec& _spec,
+                            size_t& _stride);
+
+    // Throws if _tensor isn`t a contiguous plain tensor or has no _axis
+    static void CheckIndexed(const Tensor<T>& _tensor, size_t _axis, const char* _op);
+    // Throws if _indices isn`t a contiguous tensor or has an index of _extent or more
+    static void CheckIndices(Tensor<TSHAPE_TYPE>& _indices, size_t _extent, const char* _op);
+    // Throws if _indices of Gather and Scatter doesn`t fit _tensor
+    static void CheckGather(const Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices, const char* _op);
+    // Items before and after _axis, the number of rows and the length of a row of a slice
+    static void AxisSplit(const TensorShape& _shape, size_t _axis, size_t& _outer, size_t& _inner) noexcept;
+    // Copies _rows rows of _length items, _src and _dst rows are _src_row and _dst_row items apart
+    static void CopyRows(const T* _src, size_t _src_row, T* _dst, size_t _dst_row, size_t _rows, size_t _length);
+    // Scatter with _op(y, x) on the items of the result, _partials allows the zeroed copies of
+    // the result, see the description
+    template <typename F>
+    Tensor<T> Scattered(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices, Tensor<T>& _source,
+                        const F& _op, bool _partials, const char* _op_name);
+
+    // Throws if _tensor isn`t a plain tensor in linear storage, the reductions copy block storage first
+    static ReduceGeometry Reduction(const Tensor<T>& _tensor, const std::vector<size_t>& _axes, bool _keep_dims);
+    Tensor<T> Extremum(Tensor<T>& _tensor, const ReduceParams& _params, bool _maximum);
+
+    // Row kernels of the normalizations, see "kernels/normalize.inl", RMSNorm ignores the beta
+    using RowKernel = void (*)(const T*, T*, size_t) noexcept;
+    using RowGradKernel = void (*)(const T*, const T*, T*, size_t) noexcept;
+    using NormKernel = void (*)(const T*, const T*, const T*, T*, size_t, T) noexcept;
+    using NormGradKernel = void (*)(const T*, const T*, const T*, T*, T*, T*, size_t, T) noexcept;
+
+    // Length of the last axis, throws if _tensor is not a contiguous plain tensor or if
+    // _other (if given) has another shape
+    static size_t RowLength(const Tensor<T>& _tensor, const Tensor<T>* _other, const char* _op);
+    static void CheckParameter(const Tensor<T>& _parameter, size_t _length, const char* _op);
+
+    Tensor<T> Rows(Tensor<T>& _tensor, RowKernel _kernel, const char* _op);
+    Tensor<T> RowsBackward(Tensor<T>& _output, Tensor<T>& _grad_output, RowGradKernel _kernel, const char* _op);
+    Tensor<T> Normalize(Tensor<T>& _input, Tensor<T>& _gamma, const T* _beta, T _epsilon,
+                        NormKernel _kernel, const char* _op);
+    // _grad_beta is nullptr for RMSNorm
+    Tensor<T> NormalizeBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                Tensor<T>& _grad_gamma, Tensor<T>* _grad_beta, T _epsilon,
+                                NormGradKernel _kernel, const char* _op);
+
+    // _bias is nullptr or has out_channels items
+    Tensor<T> Convolve(Tensor<T>& _input, Tensor<T>& _filter, const T* _bias, const Conv2DParams& _params);
+    void ConvolvePlain(const T* _input, const T* _filter, const T* _bias, T* _output,
+                       const Conv2DGeometry& _geometry);
+    Tensor<T> Conv2DBlocked(Tensor<T>& _input, Tensor<T>& _filter, const T* _bias, const Conv2DParams& _params);
+    Tensor<T> Pool2D(Tensor<T>& _input, const Pool2DParams& _params, bool _maximum);
+
+    // Zeroes the channels that only pad the last group of a blocked tensor
+    void ClearPadding(Tensor<T>& _tensor) noexcept;
+
+    // Arguments of the window kernels shared by all the rows of a convolution
+    static BlockedRowArgs WindowArgs(const Conv2DGeometry& _geometry) noexcept;
+
+    // Adds the bias of the output channel and applies the activation, per plane
+    void Epilogue(T* _output, const T* _bias, const Conv2DGeometry& _geometry);
+    static void EpiloguePlane(T* _plane, size_t _length, T _bias, Activation _activation) noexcept;
+
+    // Estimates the cost of every algorithm that can run the convolution, picks the cheapest
+    ConvAlgorithm SelectConv2D(const Conv2DGeometry& _geometry) const noexcept;
+    ConvAlgorithm SelectConv1D(const Conv1DGeometry& _geometry) const noexcept;
 
+    // Packing the patches and the GEMMs of all the images and groups
+    static size_t GemmCost(const Conv2DGeometry& _geometry) noexcept;
   };
 
 }
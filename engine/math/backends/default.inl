@@ -1,15 +1,2780 @@
+// File Name:     default.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The CPU backend of the engine
+
 #ifndef ENGINE_MATH_BACKENDS_DEFAULT_INL
 #define ENGINE_MATH_BACKENDS_DEFAULT_INL
 
 #include "math/backends/default.hpp"
+#include "math/kernels/registry.hpp"
+#include "math/kernels/reference.hpp"
+#include "math/gemm.hpp"
+#include "math/conv.hpp"
+#include "math/winograd.hpp"
+#include "math/fft_conv.hpp"
+#include "math/reduce.hpp"
+#include "math/simd/simd.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 using namespace mnt;
 
+template <typename T>
+Tensor<T> DefaultBackend<T>::Transpose(Tensor<T>& _tensor)
+{
+  // Tensors of higher ranks are treated as a batch of matrices
+  if (_tensor.Rank() < 2)
+    MNT_THROW("Transpose needs a tensor of rank 2 or higher");
+
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("Transpose needs a tensor in the plain layout");
+
+  CheckContiguous(_tensor);
+
+  TensorShape shape = _tensor.Shape();
+  size_t rank = shape.size();
+  size_t rows = shape[rank - 2];
+  size_t cols = shape[rank - 1];
+  std::swap(shape[rank - 2], shape[rank - 1]);
+
+  Tensor<T> result(shape);
+
+  size_t matrix_length = rows * cols;
+  size_t no_of_matrices = matrix_length ? _tensor.Length() / matrix_length : 0;
+
+  const T* src = _tensor.Data();
+  T* dst = result.Data();
+
+  // Every matrix is split into bands of source rows, a band is a band of destination columns
+  ParallelFor2D(no_of_matrices, rows, [&](size_t _matrix_begin, size_t _matrix_end,
+                                          size_t _row_begin, size_t _row_end)
+  {
+    for (size_t i=_matrix_begin; i<_matrix_end; i++)
+    {
+      const T* src_band = src + i * matrix_length + _row_begin * cols;
+      T* dst_band = dst + i * matrix_length + _row_begin;
+
+      if constexpr (std::is_same<T, float>::value)
+        KernelRegistry::Get().transpose(src_band, dst_band, _row_end - _row_begin, cols, cols, rows);
+      else
+        kernels::reference::Transpose(src_band, dst_band, _row_end - _row_begin, cols, cols, rows);
+    }
+  }, 2 * cols);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
+{
+  if (_tensor_1.Rank() != 2 || _tensor_2.Rank() != 2 || _tensor_1.Shape()[1] != _tensor_2.Shape()[0])
+    MNT_THROW(("Shapes " + _tensor_1.ShapeStr() + " and " + _tensor_2.ShapeStr() +
+               " can`t be multiplied").c_str());
+
+  if (_tensor_1.MemoryLayout() != Layout::Plain || _tensor_2.MemoryLayout() != Layout::Plain)
+    MNT_THROW("MatMul needs tensors in the plain layout");
+
+  CheckContiguous(_tensor_1);
+  CheckContiguous(_tensor_2);
+
+  const size_t m = _tensor_1.Shape()[0];
+  const size_t k = _tensor_1.Shape()[1];
+  const size_t n = _tensor_2.Shape()[1];
+
+  Tensor<T> result({(TSHAPE_TYPE)m, (TSHAPE_TYPE)n});
+
+  const T* a = _tensor_1.Data();
+  const T* b = _tensor_2.Data();
+  T* c = result.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    Gemm::Run(m, n, k, a, k, 1, b, n, 1, c, n);
+  }
+  else
+  {
+    ParallelFor(0, m, [&](size_t _begin, size_t _end)
+    {
+      kernels::reference::Gemm(_end - _begin, n, k, a + _begin * k, k, 1, b, n, 1, c + _begin * n, n, false);
+    }, n * k);
+  }
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::BatchedMatMul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
+{
+  const TensorShape& shape_1 = _tensor_1.Shape();
+  const TensorShape& shape_2 = _tensor_2.Shape();
+  const size_t rank_1 = shape_1.size();
+  const size_t rank_2 = shape_2.size();
+
+  const std::string error = "Shapes " + _tensor_1.ShapeStr() + " and " + _tensor_2.ShapeStr() +
+                            " can`t be multiplied";
+
+  if (rank_1 < 2 || rank_2 < 2 || shape_1[rank_1 - 1] != shape_2[rank_2 - 2])
+    MNT_THROW(error.c_str());
+
+  if (_tensor_1.MemoryLayout() != Layout::Plain || _tensor_2.MemoryLayout() != Layout::Plain)
+    MNT_THROW("BatchedMatMul needs tensors in the plain layout");
+
+  // Block storage is copied once, views are read with their strides
+  if (_tensor_1.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor_1);
+    return BatchedMatMul(contiguous, _tensor_2);
+  }
+
+  if (_tensor_2.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor_2);
+    return BatchedMatMul(_tensor_1, contiguous);
+  }
+
+  const size_t m = shape_1[rank_1 - 2];
+  const size_t k = shape_1[rank_1 - 1];
+  const size_t n = shape_2[rank_2 - 1];
+
+  const TensorStrides strides_1 = _tensor_1.Strides();
+  const TensorStrides strides_2 = _tensor_2.Strides();
+
+  // Batch axes aligned from the right, a shared axis has stride 0
+  const size_t batch_rank = std::max(rank_1, rank_2) - 2;
+  TensorShape shape(batch_rank);
+  TensorStrides batch_strides_1(batch_rank, 0);
+  TensorStrides batch_strides_2(batch_rank, 0);
+  size_t batch = 1;
+
+  for (size_t d = 0; d < batch_rank; d++)
+  {
+    const size_t extent_1 = d + rank_1 >= batch_rank + 2 ? shape_1[d + rank_1 - 2 - batch_rank] : 1;
+    const size_t extent_2 = d + rank_2 >= batch_rank + 2 ? shape_2[d + rank_2 - 2 - batch_rank] : 1;
+
+    if (extent_1 != extent_2 && extent_1 != 1 && extent_2 != 1)
+      MNT_THROW(error.c_str());
+
+    if (extent_1 != 1)
+      batch_strides_1[d] = strides_1[d + rank_1 - 2 - batch_rank];
+    if (extent_2 != 1)
+      batch_strides_2[d] = strides_2[d + rank_2 - 2 - batch_rank];
+
+    shape[d] = (TSHAPE_TYPE)std::max(extent_1, extent_2);
+    batch *= shape[d];
+  }
+
+  shape.push_back((TSHAPE_TYPE)m);
+  shape.push_back((TSHAPE_TYPE)n);
+  Tensor<T> result(shape);
+
+  // Offsets of the matrices of every batch, the batch index counts in row-major order
+  std::vector<size_t> offsets_1(batch), offsets_2(batch);
+  TensorStrides index(batch_rank, 0);
+  size_t offset_1 = 0, offset_2 = 0;
+
+  for (size_t b = 0; b < batch; b++)
+  {
+    offsets_1[b] = offset_1;
+    offsets_2[b] = offset_2;
+
+    for (size_t d = batch_rank; d-- > 0;)
+    {
+      offset_1 += batch_strides_1[d];
+      offset_2 += batch_strides_2[d];
+      if (++index[d] < shape[d])
+        break;
+
+      offset_1 -= index[d] * batch_strides_1[d];
+      offset_2 -= index[d] * batch_strides_2[d];
+      index[d] = 0;
+    }
+  }
+
+  const T* a = _tensor_1.Data();
+  const T* b = _tensor_2.Data();
+  T* c = result.Data();
+
+  const size_t a_row = strides_1[rank_1 - 2], a_col = strides_1[rank_1 - 1];
+  const size_t b_row = strides_2[rank_2 - 2], b_col = strides_2[rank_2 - 1];
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    Gemm::Batched(batch, m, n, k, a, offsets_1.data(), a_row, a_col,
+                  b, offsets_2.data(), b_row, b_col, c, n);
+  }
+  else
+  {
+    ParallelFor(0, batch * m, [&](size_t _begin, size_t _end)
+    {
+      for (size_t row = _begin; row < _end; row++)
+        kernels::reference::Gemm(1, n, k, a + offsets_1[row / m] + (row % m) * a_row, a_row, a_col,
+                                 b + offsets_2[row / m], b_row, b_col, c + row * n, n, false);
+    }, n * k);
+  }
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Einsum(const std::string& _spec, const std::vector<Tensor<T>*>& _tensors)
+{
+  std::vector<TensorShape> shapes;
+  for (Tensor<T>* tensor : _tensors)
+  {
+    if (tensor->MemoryLayout() != Layout::Plain)
+      MNT_THROW("Einsum needs tensors in the plain layout");
+    shapes.push_back(tensor->Shape());
+  }
+
+  const EinsumSpec spec(_spec, shapes);
+
+  std::vector<EinsumOperand> operands;
+  for (size_t i=0; i<_tensors.size(); i++)
+    operands.push_back(EinsumInput(*_tensors[i], spec, i));
+
+  for (const EinsumContraction& step : EinsumPath(spec))
+  {
+    EinsumOperand result = EinsumContract(operands[step.first], operands[step.second], step.labels, spec);
+    operands.erase(operands.begin() + step.second);
+    operands.erase(operands.begin() + step.first);
+    operands.push_back(std::move(result));
+  }
+
+  // The last operand has the letters of the output, maybe in another order
+  EinsumOperand& result = operands.front();
+  if (result.packed && result.labels == spec.output)
+    return std::move(*result.storage);
+
+  return std::move(*EinsumArrange(result, spec.output, spec).storage);
+}
+
+template <typename T>
+typename DefaultBackend<T>::EinsumOperand DefaultBackend<T>::EinsumPacked(const std::string& _labels,
+                                                                          const EinsumSpec& _spec)
+{
+  EinsumOperand operand;
+  operand.labels = _labels;
+
+  for (char label : _labels)
+    operand.shape.push_back((TSHAPE_TYPE)_spec.Extent(label));
+
+  operand.strides = TensorStrides(_labels.size(), 1);
+  for (size_t i=_labels.size(); i-- > 1;)
+    operand.strides[i - 1] = operand.strides[i] * operand.shape[i];
+
+  operand.storage = std::make_unique<Tensor<T>>(_labels.empty() ? TensorShape{1} : operand.shape);
+  operand.data = operand.storage->Data();
+  operand.packed = true;
+
+  return operand;
+}
+
+template <typename T>
+typename DefaultBackend<T>::EinsumOperand DefaultBackend<T>::EinsumInput(Tensor<T>& _tensor, const EinsumSpec& _spec,
+                                                                         size_t _input)
+{
+  EinsumOperand operand;
+
+  // Block storage is copied once, views are read with their strides
+  if (!_tensor.Data())
+    operand.storage = std::make_unique<Tensor<T>>(Contiguous(_tensor));
+
+  const Tensor<T>& tensor = operand.storage ? *operand.storage : _tensor;
+  const TensorStrides strides = tensor.Strides();
+  const std::string& labels = _spec.inputs[_input];
+  operand.data = tensor.Data();
+
+  // A repeated letter steps over all its axes at once, the broadcast axes have size 1
+  for (size_t a=0; a<labels.size(); a++)
+  {
+    if (labels[a] == '\0')
+      continue;
+
+    const size_t position = operand.labels.find(labels[a]);
+    if (position != std::string::npos)
+    {
+      operand.strides[position] += strides[a];
+      continue;
+    }
+
+    operand.labels.push_back(labels[a]);
+    operand.shape.push_back(tensor.Shape()[a]);
+    operand.strides.push_back(strides[a]);
+  }
+
+  const std::string kept = _spec.Kept(_input);
+  if (kept.size() == operand.labels.size())
+    return operand;
+
+  std::vector<size_t> axes;
+  for (size_t a=0; a<operand.labels.size(); a++)
+    if (kept.find(operand.labels[a]) == std::string::npos)
+      axes.push_back(a);
+
+  // The kept letters stay in their order
+  const ReduceGeometry geometry(operand.shape, operand.strides, axes, false);
+  EinsumOperand sum = EinsumPacked(kept, _spec);
+  Reducer<T>::Sum(operand.data, geometry, sum.storage->Data(), false);
+
+  return sum;
+}
+
+template <typename T>
+typename DefaultBackend<T>::EinsumOperand DefaultBackend<T>::EinsumContract(EinsumOperand& _x, EinsumOperand& _y,
+                                                                            const std::string& _labels,
+                                                                            const EinsumSpec& _spec)
+{
+  std::string batch, rows, depth, cols;
+
+  for (char label : _x.labels)
+  {
+    if (_y.labels.find(label) == std::string::npos)
+      rows.push_back(label);
+    else if (_labels.find(label) != std::string::npos)
+      batch.push_back(label);
+    else
+      depth.push_back(label);
+  }
+
+  for (char label : _y.labels)
+    if (_x.labels.find(label) == std::string::npos)
+      cols.push_back(label);
+
+  // Largest stride first, so the groups of axes that are contiguous in memory can be merged
+  const auto by_stride = [](const EinsumOperand& _operand)
+  {
+    return [&_operand](char _a, char _b)
+    {
+      return _operand.strides[_operand.labels.find(_a)] > _operand.strides[_operand.labels.find(_b)];
+    };
+  };
+  std::stable_sort(batch.begin(), batch.end(), by_stride(_x));
+  std::stable_sort(rows.begin(), rows.end(), by_stride(_x));
+  std::stable_sort(depth.begin(), depth.end(), by_stride(_x));
+  std::stable_sort(cols.begin(), cols.end(), by_stride(_y));
+
+  size_t row_stride, x_depth_stride, y_depth_stride, col_stride;
+
+  if (!EinsumMerge(_x, rows, _spec, row_stride) || !EinsumMerge(_x, depth, _spec, x_depth_stride))
+  {
+    _x = EinsumArrange(_x, batch + rows + depth, _spec);
+    EinsumMerge(_x, rows, _spec, row_stride);
+    EinsumMerge(_x, depth, _spec, x_depth_stride);
+  }
+
+  if (!EinsumMerge(_y, depth, _spec, y_depth_stride) || !EinsumMerge(_y, cols, _spec, col_stride))
+  {
+    _y = EinsumArrange(_y, batch + depth + cols, _spec);
+    EinsumMerge(_y, depth, _spec, y_depth_stride);
+    EinsumMerge(_y, cols, _spec, col_stride);
+  }
+
+  size_t count = 1, m = 1, k = 1, n = 1;
+  for (char label : batch)
+    count *= _spec.Extent(label);
+  for (char label : rows)
+    m *= _spec.Extent(label);
+  for (char label : depth)
+    k *= _spec.Extent(label);
+  for (char label : cols)
+    n *= _spec.Extent(label);
+
+  EinsumOperand result = EinsumPacked(batch + rows + cols, _spec);
+  if (count * m * n == 0)
+    return result;
+
+  // Offsets of the matrices of every batch, the batch index counts in row-major order
+  std::vector<size_t> offsets_x(count), offsets_y(count);
+  TensorStrides index(batch.size(), 0);
+  size_t offset_x = 0, offset_y = 0;
+
+  for (size_t b = 0; b < count; b++)
+  {
+    offsets_x[b] = offset_x;
+    offsets_y[b] = offset_y;
+
+    for (size_t d = batch.size(); d-- > 0;)
+    {
+      const size_t stride_x = _x.strides[_x.labels.find(batch[d])];
+      const size_t stride_y = _y.strides[_y.labels.find(batch[d])];
+
+      offset_x += stride_x;
+      offset_y += stride_y;
+      if (++index[d] < _spec.Extent(batch[d]))
+        break;
+
+      offset_x -= index[d] * stride_x;
+      offset_y -= index[d] * stride_y;
+      index[d] = 0;
+    }
+  }
+
+  const T* x = _x.data;
+  const T* y = _y.data;
+  T* c = result.storage->Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    if (m * n * k >= MNT_EINSUM_GEMM_MIN_FLOPS)
+    {
+      Gemm::Batched(count, m, n, k, x, offsets_x.data(), row_stride, x_depth_stride,
+                    y, offsets_y.data(), y_depth_stride, col_stride, c, n);
+      return result;
+    }
+  }
+
+  // Small products, e.g. the elementwise ones of a batch of 1 x 1 matrices
+  ParallelFor(0, count, [&](size_t _begin, size_t _end)
+  {
+    for (size_t b = _begin; b < _end; b++)
+      kernels::reference::Gemm(m, n, k, x + offsets_x[b], row_stride, x_depth_stride,
+                               y + offsets_y[b], y_depth_stride, col_stride, c + b * m * n, n, false);
+  }, m * n * k + 1);
+
+  return result;
+}
+
+template <typename T>
+typename DefaultBackend<T>::EinsumOperand DefaultBackend<T>::EinsumArrange(const EinsumOperand& _operand,
+                                                                           const std::string& _labels,
+                                                                           const EinsumSpec& _spec)
+{
+  EinsumOperand result = EinsumPacked(_labels, _spec);
+
+  TensorStrides strides;
+  for (char label : _labels)
+    strides.push_back(_operand.strides[_operand.labels.find(label)]);
+
+  CopyStrided(_operand.data, result.shape, strides, result.storage->Data());
+
+  return result;
+}
+
+template <typename T>
+bool DefaultBackend<T>::EinsumMerge(const EinsumOperand& _operand, const std::string& _labels,
+                                    const EinsumSpec& _spec, size_t& _stride)
+{
+  // Every axis has to step over all of the next one, axes of size 1 don`t matter
+  _stride = 0;
+  size_t span = 0;
+
+  for (size_t i=_labels.size(); i-- > 0;)
+  {
+    const size_t extent = _spec.Extent(_labels[i]);
+    const size_t stride = _operand.strides[_operand.labels.find(_labels[i])];
+
+    if (extent == 1)
+      continue;
+
+    if (span == 0)
+      _stride = stride;
+    else if (stride != span)
+      return false;
+
+    span = stride * extent;
+  }
+
+  return true;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MatMul(Tensor<T>& _tensor, const PackedMatrix<T>& _matrix)
+{
+  TensorShape shape = _tensor.Shape();
+
+  if (shape.empty() || shape.back() != _matrix.Rows())
+    MNT_THROW(("Shape " + _tensor.ShapeStr() + " can`t be multiplied with a matrix of " +
+               std::to_string(_matrix.Rows()) + " rows").c_str());
+
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("MatMul needs tensors in the plain layout");
+
+  CheckContiguous(_tensor);
+
+  const size_t k = _matrix.Rows();
+  const size_t n = _matrix.Cols();
+  size_t m = 1;
+  for (size_t d=0; d+1<shape.size(); d++)
+    m *= shape[d];
+
+  shape.back() = (TSHAPE_TYPE)n;
+  Tensor<T> result(shape);
+
+  const T* a = _tensor.Data();
+  const T* b = _matrix.Data();
+  T* c = result.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const size_t nr = _matrix.PanelWidth();
+
+    if (m <= MNT_GEMM_SKINNY_M)
+    {
+      Gemm::Skinny(m, n, k, a, k, 1, b, 0, true, c, n);
+    }
+    else
+    {
+      static_assert(MNT_GEMM_KC % MNT_GEMM_SKINNY_KC == 0, "The blocks of PackedMatrix have to tile the GEMM blocks");
+
+      const size_t kc = MNT_GEMM_SKINNY_KC;
+      const size_t cols = (n + nr - 1) / nr * nr;
+
+      // A panel of a GEMM block is the same panel of a few blocks of rows of the matrix
+      Gemm::Run(1, m, n, k, a, 0, k, 1,
+                [&](size_t, size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+                {
+                  for (size_t row = _k_begin; row < _k_begin + _depth; row += kc)
+                  {
+                    const size_t rows = std::min(kc, k - row);
+                    for (size_t col = 0; col < _cols; col += nr)
+                      std::copy_n(b + row * cols + (_n_begin + col) * rows, rows * nr,
+                                  _packed + col * _depth + (row - _k_begin) * nr);
+                  }
+                },
+                c, 0, n);
+    }
+  }
+  else
+  {
+    ParallelFor(0, m, [&](size_t _begin, size_t _end)
+    {
+      kernels::reference::Gemm(_end - _begin, n, k, a + _begin * k, k, 1, b, n, 1, c + _begin * n, n, false);
+    }, n * k);
+  }
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MatMul(Tensor<T>& _tensor, Tensor<Half>& _weights)
+{
+  return ReducedMatMul(_tensor, _weights);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MatMul(Tensor<T>& _tensor, Tensor<BFloat16>& _weights)
+{
+  return ReducedMatMul(_tensor, _weights);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MatMul(Tensor<T>& _tensor, const QuantizedMatrix& _weights)
+{
+  TensorShape shape = _tensor.Shape();
+
+  if (shape.empty() || shape.back() != _weights.Rows())
+    MNT_THROW(("Shape " + _tensor.ShapeStr() + " can`t be multiplied by a matrix of " +
+               std::to_string(_weights.Rows()) + " rows").c_str());
+
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("MatMul needs tensors in the plain layout");
+
+  CheckContiguous(_tensor);
+
+  const size_t k = _weights.Rows();
+  const size_t n = _weights.Cols();
+  size_t m = 1;
+  for (size_t d=0; d+1<shape.size(); d++)
+    m *= shape[d];
+
+  shape.back() = (TSHAPE_TYPE)n;
+  Tensor<T> result(shape);
+
+  const T* a = _tensor.Data();
+  T* c = result.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    QuantParams params = _weights.InputParams();
+    if (!_weights.HasInputParams())
+    {
+      float min, max;
+      FindRange(a, m * k, min, max);
+      params = ChooseQuantParams<uint8_t>(min, max);
+    }
+
+    // Rows are padded to a multiple of 4 bytes for the kernels
+    const size_t lda = (k + 3) / 4 * 4;
+    std::vector<uint8_t> quantized(m * lda, 0);
+
+    ParallelFor(0, m, [&](size_t _begin, size_t _end)
+    {
+      for (size_t i=_begin; i<_end; i++)
+        QuantizedTensor<uint8_t>::Quantize(a + i * k, quantized.data() + i * lda, k, params);
+    }, k);
+
+    Gemm::Quantized(m, quantized.data(), lda, params, _weights, c, n);
+  }
+  else
+  {
+    Tensor<float> dequantized = _weights.Dequantize();
+    Tensor<T> weights = Cast<float, T>(dequantized);
+    const T* b = weights.Data();
+
+    ParallelFor(0, m, [&](size_t _begin, size_t _end)
+    {
+      kernels::reference::Gemm(_end - _begin, n, k, a + _begin * k, k, 1, b, n, 1, c + _begin * n, n, false);
+    }, n * k);
+  }
+
+  return result;
+}
+
+// Weights are rarely reused by enough rows to pay for converting them beforehand, the float
+// GEMM converts them while packing or streaming them, the other types convert them once
+template <typename T>
+template <typename W>
+Tensor<T> DefaultBackend<T>::ReducedMatMul(Tensor<T>& _tensor, Tensor<W>& _weights)
+{
+  TensorShape shape = _tensor.Shape();
+
+  if (_weights.Rank() != 2 || shape.empty() || shape.back() != _weights.Shape()[0])
+    MNT_THROW(("Shapes " + _tensor.ShapeStr() + " and " + _weights.ShapeStr() +
+               " can`t be multiplied").c_str());
+
+  if (_tensor.MemoryLayout() != Layout::Plain || _weights.MemoryLayout() != Layout::Plain)
+    MNT_THROW("MatMul needs tensors in the plain layout");
+
+  CheckContiguous(_tensor);
+  CheckContiguous(_weights);
+
+  const size_t k = _weights.Shape()[0];
+  const size_t n = _weights.Shape()[1];
+  size_t m = 1;
+  for (size_t d=0; d+1<shape.size(); d++)
+    m *= shape[d];
+
+  shape.back() = (TSHAPE_TYPE)n;
+  Tensor<T> result(shape);
+
+  const T* a = _tensor.Data();
+  T* c = result.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    Gemm::Run(m, n, k, a, k, 1, _weights.Data(), n, 1, c, n);
+  }
+  else
+  {
+    Tensor<T> weights = Cast<W, T>(_weights);
+    const T* b = weights.Data();
+
+    ParallelFor(0, m, [&](size_t _begin, size_t _end)
+    {
+      kernels::reference::Gemm(_end - _begin, n, k, a + _begin * k, k, 1, b, n, 1, c + _begin * n, n, false);
+    }, n * k);
+  }
+
+  return result;
+}
+
 template <typename T>
 Tensor<T> DefaultBackend<T>::Add(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
 {
-  return nullptr;
+  if constexpr (std::is_same<T, float>::value)
+    return Binary(_tensor_1, _tensor_2, KernelRegistry::Get().add);
+  else
+    return Binary(_tensor_1, _tensor_2, &kernels::reference::Add<T>);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Sub(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Binary(_tensor_1, _tensor_2, KernelRegistry::Get().sub);
+  else
+    return Binary(_tensor_1, _tensor_2, &kernels::reference::Sub<T>);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Mul(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Binary(_tensor_1, _tensor_2, KernelRegistry::Get().mul);
+  else
+    return Binary(_tensor_1, _tensor_2, &kernels::reference::Mul<T>);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Div(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Binary(_tensor_1, _tensor_2, KernelRegistry::Get().div);
+  else
+    return Binary(_tensor_1, _tensor_2, &kernels::reference::Div<T>);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::SpMM(SparseCSR<T>& _sparse, Tensor<T>& _dense)
+{
+  const size_t n = SparseOperand(_dense, _sparse.Cols(), "SpMM");
+  const size_t rows = _sparse.Rows();
+
+  Tensor<T> result({(TSHAPE_TYPE)rows, (TSHAPE_TYPE)n});
+
+  const size_t* offsets = _sparse.Offsets();
+  const SparseIndex* indices = _sparse.Indices();
+  const T* values = _sparse.Values();
+  const T* b = _dense.Data();
+  T* c = result.Data();
+
+  auto kernel = &kernels::reference::Spmm<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().spmm;
+
+  ForEachSparseRows(offsets, rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      kernel(1, 1, values + offsets[i], indices + offsets[i], offsets[i + 1] - offsets[i], b, n, c + i * n, n, n);
+  }, n);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::SpMM(SparseBSR<T>& _sparse, Tensor<T>& _dense)
+{
+  const size_t n = SparseOperand(_dense, _sparse.Cols(), "SpMM");
+  const size_t br = _sparse.BlockRows();
+  const size_t bc = _sparse.BlockCols();
+
+  Tensor<T> result({(TSHAPE_TYPE)_sparse.Rows(), (TSHAPE_TYPE)n});
+
+  const size_t* offsets = _sparse.Offsets();
+  const SparseIndex* indices = _sparse.Indices();
+  const T* values = _sparse.Values();
+  const T* b = _dense.Data();
+  T* c = result.Data();
+
+  auto kernel = &kernels::reference::Spmm<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().spmm;
+
+  ForEachSparseRows(offsets, _sparse.Rows() / br, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      kernel(br, bc, values + offsets[i] * br * bc, indices + offsets[i], offsets[i + 1] - offsets[i],
+             b, n, c + i * br * n, n, n);
+  }, br * bc * n);
+
+  return result;
+}
+
+template <typename T>
+SparseCSR<T> DefaultBackend<T>::SDDMM(SparseCSR<T>& _pattern, Tensor<T>& _a, Tensor<T>& _b)
+{
+  const size_t k = SparseOperand(_a, _pattern.Rows(), "SDDMM");
+  if (SparseOperand(_b, _pattern.Cols(), "SDDMM") != k)
+    MNT_THROW(("SDDMM can`t multiply shapes " + _a.ShapeStr() + " and " + _b.ShapeStr() +
+               " transposed").c_str());
+
+  const size_t* offsets = _pattern.Offsets();
+  const SparseIndex* indices = _pattern.Indices();
+  const T* pattern = _pattern.Values();
+  const T* a = _a.Data();
+  const T* b = _b.Data();
+
+  SparseArray<T> values(_pattern.NonZeros());
+
+  auto kernel = &kernels::reference::Sddmm<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().sddmm;
+
+  ForEachSparseRows(offsets, _pattern.Rows(), [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      kernel(a + i * k, b, k, k, indices + offsets[i], pattern + offsets[i], values.Data() + offsets[i],
+             offsets[i + 1] - offsets[i]);
+  }, k);
+
+  return SparseCSR<T>(_pattern, std::move(values));
+}
+
+template <typename T>
+SparseCSR<T> DefaultBackend<T>::Add(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2)
+{
+  return Merge(_sparse_1, _sparse_2, true, [](const T& _x, const T& _y) {return _x + _y;}, "Add");
+}
+
+template <typename T>
+SparseCSR<T> DefaultBackend<T>::Sub(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2)
+{
+  return Merge(_sparse_1, _sparse_2, true, [](const T& _x, const T& _y) {return _x - _y;}, "Sub");
+}
+
+template <typename T>
+SparseCSR<T> DefaultBackend<T>::Mul(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2)
+{
+  return Merge(_sparse_1, _sparse_2, false, [](const T& _x, const T& _y) {return _x * _y;}, "Mul");
+}
+
+template <typename T>
+SparseCSR<T> DefaultBackend<T>::Mul(SparseCSR<T>& _sparse, Tensor<T>& _dense)
+{
+  const size_t cols = SparseOperand(_dense, _sparse.Rows(), "Mul");
+  if (cols != _sparse.Cols())
+    MNT_THROW(("Mul of a sparse matrix of " + std::to_string(_sparse.Cols()) + " columns and shape " +
+               _dense.ShapeStr()).c_str());
+
+  const size_t* offsets = _sparse.Offsets();
+  const SparseIndex* indices = _sparse.Indices();
+  const T* x = _sparse.Values();
+  const T* dense = _dense.Data();
+
+  SparseArray<T> values(_sparse.NonZeros());
+
+  ForEachSparseRows(offsets, _sparse.Rows(), [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      for (size_t p=offsets[i]; p<offsets[i + 1]; p++)
+        values[p] = x[p] * dense[i * cols + indices[p]];
+  });
+
+  return SparseCSR<T>(_sparse, std::move(values));
+}
+
+template <typename T>
+size_t DefaultBackend<T>::SparseOperand(const Tensor<T>& _dense, size_t _rows, const char* _op)
+{
+  if (_dense.Rank() != 2 || _dense.Shape()[0] != _rows || _dense.MemoryLayout() != Layout::Plain)
+    MNT_THROW((std::string(_op) + " needs a plain matrix of " + std::to_string(_rows) + " rows, not shape " +
+               _dense.ShapeStr()).c_str());
+
+  CheckContiguous(_dense);
+
+  return _dense.Shape()[1];
+}
+
+// Both passes walk the rows of the two matrices at the same time, the chunks are balanced
+// on their summed non-zeros
+template <typename T>
+template <typename F>
+SparseCSR<T> DefaultBackend<T>::Merge(SparseCSR<T>& _sparse_1, SparseCSR<T>& _sparse_2, bool _union,
+                                      const F& _op, const char* _op_name)
+{
+  if (_sparse_1.Rows() != _sparse_2.Rows() || _sparse_1.Cols() != _sparse_2.Cols())
+    MNT_THROW((std::string(_op_name) + " of sparse matrices of " + std::to_string(_sparse_1.Rows()) + " x " +
+               std::to_string(_sparse_1.Cols()) + " and " + std::to_string(_sparse_2.Rows()) + " x " +
+               std::to_string(_sparse_2.Cols())).c_str());
+
+  const size_t rows = _sparse_1.Rows();
+  const size_t* offsets_1 = _sparse_1.Offsets();
+  const size_t* offsets_2 = _sparse_2.Offsets();
+  const SparseIndex* indices_1 = _sparse_1.Indices();
+  const SparseIndex* indices_2 = _sparse_2.Indices();
+  const T* values_1 = _sparse_1.Values();
+  const T* values_2 = _sparse_2.Values();
+
+  std::vector<size_t> work(rows + 1);
+  for (size_t i=0; i<=rows; i++)
+    work[i] = offsets_1[i] + offsets_2[i];
+
+  // _emit(column, x, y) for the columns of the merged row in order
+  auto merge_row = [&](size_t _row, const auto& _emit)
+  {
+    size_t p = offsets_1[_row], q = offsets_2[_row];
+    const size_t p_end = offsets_1[_row + 1], q_end = offsets_2[_row + 1];
+
+    while (p < p_end || q < q_end)
+    {
+      if (q == q_end || (p < p_end && indices_1[p] < indices_2[q]))
+      {
+        if (_union)
+          _emit(indices_1[p], values_1[p], T(0));
+        p++;
+      }
+      else if (p == p_end || indices_2[q] < indices_1[p])
+      {
+        if (_union)
+          _emit(indices_2[q], T(0), values_2[q]);
+        q++;
+      }
+      else
+      {
+        _emit(indices_1[p], values_1[p], values_2[q]);
+        p++;
+        q++;
+      }
+    }
+  };
+
+  SparseArray<size_t> offsets(rows + 1);
+
+  ForEachSparseRows(work.data(), rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t count = 0;
+      merge_row(i, [&](SparseIndex, const T&, const T&) {count++;});
+      offsets[i + 1] = count;
+    }
+  });
+
+  offsets[0] = 0;
+  for (size_t i=0; i<rows; i++)
+    offsets[i + 1] += offsets[i];
+
+  SparseArray<SparseIndex> indices(offsets[rows]);
+  SparseArray<T> values(offsets[rows]);
+
+  ForEachSparseRows(work.data(), rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t p = offsets[i];
+      merge_row(i, [&](SparseIndex _column, const T& _x, const T& _y)
+      {
+        indices[p] = _column;
+        values[p++] = _op(_x, _y);
+      });
+    }
+  });
+
+  return SparseCSR<T>(rows, _sparse_1.Cols(), std::move(offsets), std::move(indices), std::move(values));
 }
 
+template <typename T>
+BitMask DefaultBackend<T>::ToMask(Tensor<T>& _tensor)
+{
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("ToMask needs a tensor in the plain layout");
+
+  CheckContiguous(_tensor);
+
+  BitMask mask(_tensor.Shape());
+  const size_t length = mask.Length();
+  const T* x = _tensor.Data();
+  uint64_t* bits = mask.Data();
+
+  auto kernel = &kernels::reference::MaskPack<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().mask_pack;
+
+  ParallelFor(0, mask.Words(), [&](size_t _begin, size_t _end)
+  {
+    kernel(x + _begin * 64, bits + _begin, std::min(_end * 64, length) - _begin * 64);
+  }, 64);
+
+  return mask;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::FromMask(BitMask& _mask)
+{
+  Tensor<T> result(_mask.Shape());
+  const size_t length = _mask.Length();
+  const uint64_t* bits = _mask.Data();
+  T* y = result.Data();
+
+  auto kernel = &kernels::reference::MaskUnpack<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().mask_unpack;
+
+  ParallelFor(0, _mask.Words(), [&](size_t _begin, size_t _end)
+  {
+    kernel(bits + _begin, y + _begin * 64, std::min(_end * 64, length) - _begin * 64);
+  }, 64);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MaskedFill(Tensor<T>& _tensor, BitMask& _mask, T _value)
+{
+  auto kernel = &kernels::reference::MaskedFill<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().masked_fill;
+
+  return Masked(_tensor, _mask, [&](const T* _x, const uint64_t* _bits, T* _y, size_t _length)
+  {
+    kernel(_x, _bits, _y, _length, _value);
+  }, "MaskedFill");
+}
+
+// Chunks of whole words are counted first, so every chunk knows where its items go
+template <typename T>
+Tensor<T> DefaultBackend<T>::MaskedSelect(Tensor<T>& _tensor, BitMask& _mask)
+{
+  if (_tensor.Shape() != _mask.Shape())
+    MNT_THROW(("MaskedSelect needs a mask of shape " + _tensor.ShapeStr() + ", not " + _mask.ShapeStr()).c_str());
+
+  MaskRepeats(_tensor, _mask, "MaskedSelect");
+
+  const size_t length = _mask.Length();
+  const size_t chunk = 1024;
+  const size_t chunks = (_mask.Words() + chunk - 1) / chunk;
+  const uint64_t* bits = _mask.Data();
+  const T* x = _tensor.Data();
+  const auto count = KernelRegistry::Get().mask_count;
+
+  std::vector<size_t> offsets(chunks + 1, 0);
+  ParallelFor(0, chunks, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      offsets[i + 1] = count(bits + i * chunk, std::min((i + 1) * chunk * 64, length) - i * chunk * 64);
+  }, chunk);
+
+  for (size_t i=0; i<chunks; i++)
+    offsets[i + 1] += offsets[i];
+
+  Tensor<T> result({(TSHAPE_TYPE)offsets[chunks]});
+  T* y = result.Data();
+
+  auto kernel = &kernels::reference::MaskedSelect<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().masked_select;
+
+  ParallelFor(0, chunks, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      kernel(x + i * chunk * 64, bits + i * chunk, y + offsets[i], std::min((i + 1) * chunk * 64, length) - i * chunk * 64);
+  }, chunk * 64);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Dropout(Tensor<T>& _tensor, BitMask& _keep, T _scale)
+{
+  if (_tensor.Shape() != _keep.Shape())
+    MNT_THROW(("Dropout needs a mask of shape " + _tensor.ShapeStr() + ", not " + _keep.ShapeStr()).c_str());
+
+  auto kernel = &kernels::reference::MaskedScale<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().masked_scale;
+
+  return Masked(_tensor, _keep, [&](const T* _x, const uint64_t* _bits, T* _y, size_t _length)
+  {
+    kernel(_x, _bits, _y, _length, _scale);
+  }, "Dropout");
+}
+
+template <typename T>
+size_t DefaultBackend<T>::MaskRepeats(const Tensor<T>& _tensor, const BitMask& _mask, const char* _op)
+{
+  const TensorShape& shape = _tensor.Shape();
+  const TensorShape& mask = _mask.Shape();
+
+  bool trailing = mask.size() <= shape.size();
+  for (size_t i=0; trailing && i<mask.size(); i++)
+    trailing = mask[i] == shape[shape.size() - mask.size() + i];
+
+  if (!trailing)
+    MNT_THROW((std::string(_op) + " can`t apply a mask of shape " + _mask.ShapeStr() + " to shape " +
+               _tensor.ShapeStr()).c_str());
+
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW((std::string(_op) + " needs a tensor in the plain layout").c_str());
+
+  CheckContiguous(_tensor);
+
+  return _mask.Length() ? _tensor.Length() / _mask.Length() : 0;
+}
+
+template <typename T>
+template <typename F>
+Tensor<T> DefaultBackend<T>::Masked(Tensor<T>& _tensor, BitMask& _mask, const F& _kernel, const char* _op)
+{
+  const size_t repeats = MaskRepeats(_tensor, _mask, _op);
+  const size_t length = _mask.Length();
+  const uint64_t* bits = _mask.Data();
+  const T* x = _tensor.Data();
+
+  Tensor<T> result(_tensor.Shape());
+  T* y = result.Data();
+
+  ParallelFor2D(repeats, _mask.Words(), [&](size_t _row_begin, size_t _row_end, size_t _word_begin, size_t _word_end)
+  {
+    const size_t begin = _word_begin * 64;
+    const size_t end = std::min(_word_end * 64, length);
+
+    for (size_t r=_row_begin; r<_row_end; r++)
+      _kernel(x + r * length + begin, bits + _word_begin, y + r * length + begin, end - begin);
+  }, 64);
+
+  return result;
+}
+
+// Row r of the result is row _indices[r % count] of slice r / count, the rows a few ahead are
+// prefetched since nothing predicts their positions
+template <typename T>
+Tensor<T> DefaultBackend<T>::IndexSelect(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices)
+{
+  CheckIndexed(_tensor, _axis, "IndexSelect");
+
+  const TensorShape& shape = _tensor.Shape();
+  const size_t extent = shape[_axis];
+  CheckIndices(_indices, extent, "IndexSelect");
+
+  TensorShape result_shape(shape.begin(), shape.begin() + _axis);
+  for (const TSHAPE_TYPE size : _indices.Shape())
+    result_shape.push_back(size);
+  for (size_t d=_axis + 1; d<shape.size(); d++)
+    result_shape.push_back(shape[d]);
+
+  Tensor<T> result(result_shape);
+
+  size_t outer, inner;
+  AxisSplit(shape, _axis, outer, inner);
+
+  const size_t count = _indices.Length();
+  const size_t prefetch = std::min(inner * sizeof(T), (size_t)MNT_PREFETCH_BYTES);
+  const TSHAPE_TYPE* index = _indices.Data();
+  const T* x = _tensor.Data();
+  T* y = result.Data();
+
+  ParallelFor(0, outer * count, [&](size_t _begin, size_t _end)
+  {
+    for (size_t r=_begin; r<_end; r++)
+    {
+      const size_t ahead = r + MNT_PREFETCH_DISTANCE;
+      if (ahead < _end)
+      {
+        const char* row = (const char*)(x + (ahead / count * extent + index[ahead % count]) * inner);
+        for (size_t b=0; b<prefetch; b+=64)
+          MNT_PREFETCH(row + b);
+      }
+
+      std::memcpy(y + r * inner, x + (r / count * extent + index[r % count]) * inner, inner * sizeof(T));
+    }
+  }, inner + 16);
+
+  return result;
+}
+
+// The items of a run of the last axis have their own index, along the last axis they are read
+// from one row of _tensor, along another axis from a row per item and the items ahead are prefetched
+template <typename T>
+Tensor<T> DefaultBackend<T>::Gather(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices)
+{
+  CheckGather(_tensor, _axis, _indices, "Gather");
+
+  Tensor<T> result(_indices.Shape());
+
+  const size_t rank = _tensor.Rank();
+  const bool last = _axis + 1 == rank;
+  const TensorStrides extents(_indices.Shape().begin(), _indices.Shape().end());
+  const TensorStrides strides = _tensor.Strides();
+  const TensorStrides index_strides = _indices.Strides();
+  const size_t stride = strides[_axis];
+  const TSHAPE_TYPE* index = _indices.Data();
+  const T* x = _tensor.Data();
+  T* y = result.Data();
+
+  ParallelForND(extents, [&](const size_t* _index, size_t _length)
+  {
+    size_t offset = 0;
+    size_t x_offset = 0;
+    for (size_t d=0; d<rank; d++)
+    {
+      offset += _index[d] * index_strides[d];
+      if (d != _axis)
+        x_offset += _index[d] * strides[d];
+    }
+
+    const TSHAPE_TYPE* position = index + offset;
+    const T* src = x + x_offset;
+    T* dst = y + offset;
+
+    if (last)
+    {
+      for (size_t i=0; i<_length; i++)
+        dst[i] = src[position[i]];
+      return;
+    }
+
+    for (size_t i=0; i<_length; i++)
+    {
+      if (i + MNT_PREFETCH_DISTANCE < _length)
+        MNT_PREFETCH(src + i + MNT_PREFETCH_DISTANCE + position[i + MNT_PREFETCH_DISTANCE] * stride);
+
+      dst[i] = src[i + position[i] * stride];
+    }
+  }, 4);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Scatter(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                     Tensor<T>& _source)
+{
+  return Scattered(_tensor, _axis, _indices, _source, [](T& _y, T _x) {_y = _x;}, false, "Scatter");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::ScatterAdd(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                        Tensor<T>& _source)
+{
+  return Scattered(_tensor, _axis, _indices, _source, [](T& _y, T _x) {_y += _x;}, true, "ScatterAdd");
+}
+
+// A line is a run of the last axis of _indices at one position of the other axes but _axis, its
+// items only meet the items of the same line at other positions of _axis, so the threads take
+// whole lines and walk _axis in order. Without enough lines for the threads, ScatterAdd splits
+// _axis instead, every chunk adds into its own zeroed copy of the result
+template <typename T>
+template <typename F>
+Tensor<T> DefaultBackend<T>::Scattered(Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                       Tensor<T>& _source, const F& _op, bool _partials, const char* _op_name)
+{
+  CheckGather(_tensor, _axis, _indices, _op_name);
+  CheckIndexed(_source, _axis, _op_name);
+
+  if (_source.Shape() != _indices.Shape())
+    MNT_THROW((std::string(_op_name) + " needs a source of shape " + _indices.ShapeStr() + ", not " +
+               _source.ShapeStr()).c_str());
+
+  const size_t length = _tensor.Length();
+  Tensor<T> result(_tensor.Shape());
+  CopyRows(_tensor.Data(), length, result.Data(), length, 1, length);
+
+  const TensorShape& shape = _indices.Shape();
+  const size_t rank = shape.size();
+  const bool last = _axis + 1 == rank;
+  const size_t extent = shape[_axis];
+  const size_t run = last ? 1 : shape[rank - 1];
+  const size_t lines = extent && run ? _indices.Length() / extent / run : 0;
+
+  const TensorStrides strides = _tensor.Strides();
+  const TensorStrides index_strides = _indices.Strides();
+  const size_t stride = strides[_axis];
+  const TSHAPE_TYPE* index = _indices.Data();
+  const T* source = _source.Data();
+
+  // Positions _begin to _end of _axis of line _line into _y
+  auto scatter = [&](size_t _line, size_t _begin, size_t _end, T* _y)
+  {
+    size_t offset = 0;
+    size_t x_offset = 0;
+    for (size_t d=rank - 1, rest=_line; d-- > 0;)
+    {
+      if (d == _axis)
+        continue;
+
+      offset += rest % shape[d] * index_strides[d];
+      x_offset += rest % shape[d] * strides[d];
+      rest /= shape[d];
+    }
+
+    if (last)
+    {
+      for (size_t j=_begin; j<_end; j++)
+        _op(_y[x_offset + index[offset + j]], source[offset + j]);
+      return;
+    }
+
+    for (size_t j=_begin; j<_end; j++)
+    {
+      const TSHAPE_TYPE* position = index + offset + j * index_strides[_axis];
+      const T* src = source + offset + j * index_strides[_axis];
+
+      for (size_t i=0; i<run; i++)
+        _op(_y[x_offset + i + position[i] * stride], src[i]);
+    }
+  };
+
+  const size_t threads = ThreadPool::Global().NoOfThreads();
+  const size_t items = lines * extent * run;
+
+  if (!_partials || threads == 1 || lines >= threads || length > MNT_SCATTER_GRAIN || items <= MNT_SCATTER_GRAIN)
+  {
+    T* y = result.Data();
+
+    ParallelFor(0, lines, [&](size_t _begin, size_t _end)
+    {
+      for (size_t l=_begin; l<_end; l++)
+        scatter(l, 0, extent, y);
+    }, 2 * extent * run);
+
+    return result;
+  }
+
+  // Chunks of _axis of about MNT_SCATTER_GRAIN items, they don`t depend on the number of threads
+  const size_t grain = std::max((size_t)MNT_SCATTER_GRAIN / (lines * run), (size_t)1);
+  const size_t chunks = (extent + grain - 1) / grain;
+  std::vector<T> partials(chunks * length, T(0));
+
+  ParallelFor(0, chunks, [&](size_t _begin, size_t _end)
+  {
+    for (size_t c=_begin; c<_end; c++)
+      for (size_t l=0; l<lines; l++)
+        scatter(l, c * grain, std::min((c + 1) * grain, extent), partials.data() + c * length);
+  }, 2 * grain * lines * run);
+
+  auto add = &kernels::reference::Add<T>;
+  if constexpr (std::is_same<T, float>::value)
+    add = KernelRegistry::Get().add;
+
+  T* y = result.Data();
+  ParallelFor(0, length, [&](size_t _begin, size_t _end)
+  {
+    for (size_t c=0; c<chunks; c++)
+      add(y + _begin, partials.data() + c * length + _begin, y + _begin, _end - _begin);
+  }, chunks);
+
+  return result;
+}
+
+// Every tensor is copied as rows of its slice of _axis into the rows of the result
+template <typename T>
+Tensor<T> DefaultBackend<T>::Concat(const std::vector<Tensor<T>*>& _tensors, size_t _axis)
+{
+  if (_tensors.empty())
+    MNT_THROW("Concat needs at least one tensor");
+
+  CheckIndexed(*_tensors[0], _axis, "Concat");
+
+  TensorShape shape = _tensors[0]->Shape();
+  shape[_axis] = 0;
+
+  for (Tensor<T>* tensor : _tensors)
+  {
+    CheckIndexed(*tensor, _axis, "Concat");
+
+    const TensorShape& other = tensor->Shape();
+    bool fits = other.size() == shape.size();
+    for (size_t d=0; fits && d<shape.size(); d++)
+      fits = d == _axis || other[d] == shape[d];
+
+    if (!fits)
+      MNT_THROW(("Concat can`t join shapes " + _tensors[0]->ShapeStr() + " and " + tensor->ShapeStr() +
+                 " along axis " + std::to_string(_axis)).c_str());
+
+    shape[_axis] += other[_axis];
+  }
+
+  Tensor<T> result(shape);
+
+  size_t outer, inner;
+  AxisSplit(shape, _axis, outer, inner);
+
+  const size_t row = shape[_axis] * inner;
+  size_t offset = 0;
+
+  for (Tensor<T>* tensor : _tensors)
+  {
+    const size_t length = tensor->Shape()[_axis] * inner;
+    CopyRows(tensor->Data(), length, result.Data() + offset, row, outer, length);
+    offset += length;
+  }
+
+  return result;
+}
+
+template <typename T>
+std::vector<Tensor<T>> DefaultBackend<T>::Split(Tensor<T>& _tensor, size_t _axis, const std::vector<size_t>& _sizes)
+{
+  CheckIndexed(_tensor, _axis, "Split");
+
+  const TensorShape& shape = _tensor.Shape();
+
+  size_t total = 0;
+  for (const size_t size : _sizes)
+    total += size;
+
+  if (total != shape[_axis])
+    MNT_THROW(("Split can`t cut axis " + std::to_string(_axis) + " of shape " + _tensor.ShapeStr() +
+               " into parts of " + std::to_string(total) + " items").c_str());
+
+  size_t outer, inner;
+  AxisSplit(shape, _axis, outer, inner);
+
+  const size_t row = shape[_axis] * inner;
+  size_t offset = 0;
+
+  std::vector<Tensor<T>> parts;
+  parts.reserve(_sizes.size());
+
+  for (const size_t size : _sizes)
+  {
+    TensorShape part_shape = shape;
+    part_shape[_axis] = (TSHAPE_TYPE)size;
+
+    Tensor<T> part(part_shape);
+    const size_t length = size * inner;
+    CopyRows(_tensor.Data() + offset, row, part.Data(), length, outer, length);
+    offset += length;
+
+    parts.push_back(std::move(part));
+  }
+
+  return parts;
+}
+
+template <typename T>
+void DefaultBackend<T>::CheckIndexed(const Tensor<T>& _tensor, size_t _axis, const char* _op)
+{
+  if (_axis >= _tensor.Rank())
+    MNT_THROW((std::string(_op) + " axis is out of the range of shape " + _tensor.ShapeStr()).c_str());
+
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW((std::string(_op) + " needs a tensor in the plain layout").c_str());
+
+  // A tensor without items has no memory
+  if (_tensor.Length() > 0)
+    CheckContiguous(_tensor);
+}
+
+template <typename T>
+void DefaultBackend<T>::CheckIndices(Tensor<TSHAPE_TYPE>& _indices, size_t _extent, const char* _op)
+{
+  if (_indices.Length() > 0)
+    CheckContiguous(_indices);
+
+  const TSHAPE_TYPE* index = _indices.Data();
+  const TSHAPE_TYPE largest = ParallelReduce(0, _indices.Length(), (TSHAPE_TYPE)0, [&](size_t _begin, size_t _end)
+  {
+    TSHAPE_TYPE maximum = 0;
+    for (size_t i=_begin; i<_end; i++)
+      maximum = std::max(maximum, index[i]);
+    return maximum;
+  }, [](TSHAPE_TYPE _a, TSHAPE_TYPE _b) {return std::max(_a, _b);});
+
+  if (_indices.Length() > 0 && largest >= _extent)
+    MNT_THROW((std::string(_op) + " index " + std::to_string(largest) + " is out of the range of an axis of " +
+               std::to_string(_extent) + " items").c_str());
+}
+
+template <typename T>
+void DefaultBackend<T>::CheckGather(const Tensor<T>& _tensor, size_t _axis, Tensor<TSHAPE_TYPE>& _indices,
+                                    const char* _op)
+{
+  CheckIndexed(_tensor, _axis, _op);
+
+  const TensorShape& shape = _tensor.Shape();
+  const TensorShape& indices = _indices.Shape();
+
+  bool fits = indices.size() == shape.size();
+  for (size_t d=0; fits && d<shape.size(); d++)
+    fits = d == _axis || indices[d] <= shape[d];
+
+  if (!fits)
+    MNT_THROW((std::string(_op) + " can`t take indices of shape " + _indices.ShapeStr() + " along axis " +
+               std::to_string(_axis) + " of shape " + _tensor.ShapeStr()).c_str());
+
+  CheckIndices(_indices, shape[_axis], _op);
+}
+
+template <typename T>
+void DefaultBackend<T>::AxisSplit(const TensorShape& _shape, size_t _axis, size_t& _outer, size_t& _inner) noexcept
+{
+  _outer = 1;
+  _inner = 1;
+
+  for (size_t d=0; d<_axis; d++)
+    _outer *= _shape[d];
+  for (size_t d=_axis + 1; d<_shape.size(); d++)
+    _inner *= _shape[d];
+}
+
+template <typename T>
+void DefaultBackend<T>::CopyRows(const T* _src, size_t _src_row, T* _dst, size_t _dst_row, size_t _rows, size_t _length)
+{
+  ParallelFor2D(_rows, _length, [&](size_t _row_begin, size_t _row_end, size_t _col_begin, size_t _col_end)
+  {
+    for (size_t r=_row_begin; r<_row_end; r++)
+      std::memcpy(_dst + r * _dst_row + _col_begin, _src + r * _src_row + _col_begin, (_col_end - _col_begin) * sizeof(T));
+  });
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Binary(Tensor<T>& _tensor_1, Tensor<T>& _tensor_2, BinaryKernel _kernel)
+{
+  if (_tensor_1.Shape() != _tensor_2.Shape())
+    MNT_THROW(("Shapes " + _tensor_1.ShapeStr() + " and " + _tensor_2.ShapeStr() +
+               " don`t match").c_str());
+
+  if (_tensor_1.MemoryLayout() != _tensor_2.MemoryLayout())
+    MNT_THROW("Elementwise operations need tensors of the same layout");
+
+  CheckContiguous(_tensor_1);
+  CheckContiguous(_tensor_2);
+
+  Tensor<T> result(_tensor_1.Shape(), _tensor_1.MemoryLayout());
+
+  const T* a = _tensor_1.Data();
+  const T* b = _tensor_2.Data();
+  T* out = result.Data();
+
+  ParallelFor(0, result.Length(), [&](size_t _begin, size_t _end)
+  {
+    _kernel(a + _begin, b + _begin, out + _begin, _end - _begin);
+  });
+
+  // The padding is zero in both inputs, Div turns it into NaN
+  ClearPadding(result);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Relu(Tensor<T>& _tensor)
+{
+  return Apply(_tensor, Activation::Relu);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LeakyRelu(Tensor<T>& _tensor, T _alpha)
+{
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const auto kernel = KernelRegistry::Get().leaky_relu;
+    return Unary(_tensor, [&](const T* _x, T* _y, size_t _length) {kernel(_x, _y, _length, _alpha);}, 1);
+  }
+  else
+  {
+    return Unary(_tensor, [&](const T* _x, T* _y, size_t _length)
+    {
+      kernels::reference::LeakyRelu(_x, _y, _length, _alpha);
+    }, 1);
+  }
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Sigmoid(Tensor<T>& _tensor)
+{
+  return Apply(_tensor, Activation::Sigmoid);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Tanh(Tensor<T>& _tensor)
+{
+  return Apply(_tensor, Activation::Tanh);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Gelu(Tensor<T>& _tensor)
+{
+  return Apply(_tensor, Activation::Gelu);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Silu(Tensor<T>& _tensor)
+{
+  return Apply(_tensor, Activation::Silu);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::ReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output)
+{
+  return ApplyBackward(_input, _grad_output, Activation::Relu);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LeakyReluBackward(Tensor<T>& _input, Tensor<T>& _grad_output, T _alpha)
+{
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const auto kernel = KernelRegistry::Get().leaky_relu_backward;
+    return UnaryBackward(_input, _grad_output, [&](const T* _x, const T* _dy, T* _dx, size_t _length)
+    {
+      kernel(_x, _dy, _dx, _length, _alpha);
+    }, 1);
+  }
+  else
+  {
+    return UnaryBackward(_input, _grad_output, [&](const T* _x, const T* _dy, T* _dx, size_t _length)
+    {
+      kernels::reference::LeakyReluBackward(_x, _dy, _dx, _length, _alpha);
+    }, 1);
+  }
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::SigmoidBackward(Tensor<T>& _output, Tensor<T>& _grad_output)
+{
+  return ApplyBackward(_output, _grad_output, Activation::Sigmoid);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::TanhBackward(Tensor<T>& _output, Tensor<T>& _grad_output)
+{
+  return ApplyBackward(_output, _grad_output, Activation::Tanh);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::GeluBackward(Tensor<T>& _input, Tensor<T>& _grad_output)
+{
+  return ApplyBackward(_input, _grad_output, Activation::Gelu);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::SiluBackward(Tensor<T>& _input, Tensor<T>& _grad_output)
+{
+  return ApplyBackward(_input, _grad_output, Activation::Silu);
+}
+
+// Relu and Relu6 are a compare per item, the others a few dozen vector instructions
+template <typename T>
+Tensor<T> DefaultBackend<T>::Apply(Tensor<T>& _tensor, Activation _activation)
+{
+  const size_t cost = _activation == Activation::Relu || _activation == Activation::Relu6 ? 1 : 4;
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const auto kernel = KernelRegistry::Get().activation;
+    return Unary(_tensor, [&](const T* _x, T* _y, size_t _length) {kernel(_x, _y, _length, _activation);}, cost);
+  }
+  else
+  {
+    return Unary(_tensor, [&](const T* _x, T* _y, size_t _length)
+    {
+      kernels::reference::ActivationRow(_x, _y, _length, _activation);
+    }, cost);
+  }
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::ApplyBackward(Tensor<T>& _tensor, Tensor<T>& _grad_output, Activation _activation)
+{
+  const size_t cost = _activation == Activation::Relu || _activation == Activation::Relu6 ? 1 : 4;
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const auto kernel = KernelRegistry::Get().activation_backward;
+    return UnaryBackward(_tensor, _grad_output, [&](const T* _x, const T* _dy, T* _dx, size_t _length)
+    {
+      kernel(_x, _dy, _dx, _length, _activation);
+    }, cost);
+  }
+  else
+  {
+    return UnaryBackward(_tensor, _grad_output, [&](const T* _x, const T* _dy, T* _dx, size_t _length)
+    {
+      kernels::reference::ActivationBackwardRow(_x, _dy, _dx, _length, _activation);
+    }, cost);
+  }
+}
+
+template <typename T>
+template <typename F>
+Tensor<T> DefaultBackend<T>::Unary(Tensor<T>& _tensor, const F& _kernel, size_t _cost)
+{
+  CheckContiguous(_tensor);
+
+  Tensor<T> result(_tensor.Shape(), _tensor.MemoryLayout());
+
+  const T* x = _tensor.Data();
+  T* y = result.Data();
+
+  ParallelFor(0, result.Length(), [&](size_t _begin, size_t _end)
+  {
+    _kernel(x + _begin, y + _begin, _end - _begin);
+  }, _cost);
+
+  // Sigmoid and the others don`t keep zero at zero
+  ClearPadding(result);
+
+  return result;
+}
+
+template <typename T>
+template <typename F>
+Tensor<T> DefaultBackend<T>::UnaryBackward(Tensor<T>& _tensor, Tensor<T>& _grad_output, const F& _kernel,
+                                           size_t _cost)
+{
+  if (_tensor.Shape() != _grad_output.Shape())
+    MNT_THROW(("Shapes " + _tensor.ShapeStr() + " and " + _grad_output.ShapeStr() +
+               " don`t match").c_str());
+
+  if (_tensor.MemoryLayout() != _grad_output.MemoryLayout())
+    MNT_THROW("Elementwise operations need tensors of the same layout");
+
+  CheckContiguous(_tensor);
+  CheckContiguous(_grad_output);
+
+  Tensor<T> result(_tensor.Shape(), _tensor.MemoryLayout());
+
+  const T* x = _tensor.Data();
+  const T* dy = _grad_output.Data();
+  T* dx = result.Data();
+
+  ParallelFor(0, result.Length(), [&](size_t _begin, size_t _end)
+  {
+    _kernel(x + _begin, dy + _begin, dx + _begin, _end - _begin);
+  }, _cost);
+
+  ClearPadding(result);
+
+  return result;
+}
+
+// Converts one group of channels of one image at a time, the group is a channels x pixels
+// matrix in the plain layout and a pixels x block one in the blocked layouts
+template <typename T>
+Tensor<T> DefaultBackend<T>::Reorder(Tensor<T>& _tensor, Layout _layout)
+{
+  if (!_tensor.IsContiguous())
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Reorder(contiguous, _layout);
+  }
+
+  const Layout layout = _tensor.MemoryLayout();
+
+  if (layout != Layout::Plain && _layout != Layout::Plain)
+  {
+    Tensor<T> plain = Reorder(_tensor, Layout::Plain);
+    return Reorder(plain, _layout);
+  }
+
+  Tensor<T> result(_tensor.Shape(), _layout);
+
+  const T* src = _tensor.Data();
+  T* dst = result.Data();
+
+  if (layout == _layout)
+  {
+    std::copy(src, src + _tensor.Length(), dst);
+    return result;
+  }
+
+  const TensorShape& shape = _tensor.Shape();
+  const size_t channels = shape[1];
+  const size_t pixels = shape[2] * shape[3];
+  const size_t block = LayoutBlock(layout == Layout::Plain ? _layout : layout);
+  const size_t groups = (channels + block - 1) / block;
+  const bool to_blocked = layout == Layout::Plain;
+
+  ParallelFor(0, shape[0] * groups, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i = _begin; i < _end; i++)
+    {
+      const size_t image = i / groups;
+      const size_t group = i % groups;
+      const size_t count = std::min(block, channels - group * block);
+
+      const size_t plain_offset = (image * channels + group * block) * pixels;
+      const size_t blocked_offset = i * pixels * block;
+
+      if constexpr (std::is_same<T, float>::value)
+      {
+        if (to_blocked)
+          KernelRegistry::Get().transpose(src + plain_offset, dst + blocked_offset, count, pixels, pixels, block);
+        else
+          KernelRegistry::Get().transpose(src + blocked_offset, dst + plain_offset, pixels, count, block, pixels);
+      }
+      else
+      {
+        if (to_blocked)
+          kernels::reference::Transpose(src + plain_offset, dst + blocked_offset, count, pixels, pixels, block);
+        else
+          kernels::reference::Transpose(src + blocked_offset, dst + plain_offset, pixels, count, block, pixels);
+      }
+    }
+  }, 2 * pixels * block);
+
+  ClearPadding(result);
+
+  return result;
+}
+
+template <typename T>
+Tensor<Half> DefaultBackend<T>::ToHalf(Tensor<T>& _tensor)
+{
+  return Cast<T, Half>(_tensor);
+}
+
+template <typename T>
+Tensor<BFloat16> DefaultBackend<T>::ToBFloat16(Tensor<T>& _tensor)
+{
+  return Cast<T, BFloat16>(_tensor);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Convert(Tensor<Half>& _tensor)
+{
+  return Cast<Half, T>(_tensor);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Convert(Tensor<BFloat16>& _tensor)
+{
+  return Cast<BFloat16, T>(_tensor);
+}
+
+// Conversions are bound by memory, a chunk is worth splitting at about one item per cycle
+template <typename T>
+template <typename SRC, typename DST>
+Tensor<DST> DefaultBackend<T>::Cast(Tensor<SRC>& _tensor)
+{
+  CheckContiguous(_tensor);
+
+  Tensor<DST> result(_tensor.Shape(), _tensor.MemoryLayout());
+
+  const SRC* x = _tensor.Data();
+  DST* y = result.Data();
+
+  void (*kernel)(const SRC*, DST*, size_t) noexcept = nullptr;
+
+  const KernelTable& table = KernelRegistry::Get();
+  if constexpr (std::is_same<SRC, Half>::value && std::is_same<DST, float>::value)
+    kernel = table.half_to_float;
+  else if constexpr (std::is_same<SRC, float>::value && std::is_same<DST, Half>::value)
+    kernel = table.float_to_half;
+  else if constexpr (std::is_same<SRC, BFloat16>::value && std::is_same<DST, float>::value)
+    kernel = table.bfloat16_to_float;
+  else if constexpr (std::is_same<SRC, float>::value && std::is_same<DST, BFloat16>::value)
+    kernel = table.float_to_bfloat16;
+
+  ParallelFor(0, result.Length(), [&](size_t _begin, size_t _end)
+  {
+    if (kernel)
+      kernel(x + _begin, y + _begin, _end - _begin);
+    else
+      for (size_t i=_begin; i<_end; i++)
+        y[i] = DST((float)x[i]);
+  }, result.Length());
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Sum(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Sum(contiguous, _params);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, _params.axes, _params.keep_dims);
+  Tensor<T> result(geometry.out_shape);
+
+  Reducer<T>::Sum(_tensor.Data(), geometry, result.Data(), _params.deterministic);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Mean(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Mean(contiguous, _params);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, _params.axes, _params.keep_dims);
+  Tensor<T> result(geometry.out_shape);
+
+  Reducer<T>::Sum(_tensor.Data(), geometry, result.Data(), _params.deterministic);
+
+  T* output = result.Data();
+  for (size_t i=0; i<geometry.outputs; i++)
+    output[i] /= (T)geometry.count;
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Max(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  return Extremum(_tensor, _params, true);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Min(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  return Extremum(_tensor, _params, false);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Extremum(Tensor<T>& _tensor, const ReduceParams& _params, bool _maximum)
+{
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Extremum(contiguous, _params, _maximum);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, _params.axes, _params.keep_dims);
+
+  if (geometry.count == 0 && geometry.outputs != 0)
+    MNT_THROW("Max and Min can`t reduce an empty axis");
+
+  Tensor<T> result(geometry.out_shape);
+
+  Reducer<T>::Extremum(_tensor.Data(), geometry, result.Data(), _maximum, _params.deterministic);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Norm(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Norm(contiguous, _params);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, _params.axes, _params.keep_dims);
+  Tensor<T> result(geometry.out_shape);
+
+  Reducer<T>::Sum(_tensor.Data(), geometry, result.Data(), _params.deterministic, true);
+
+  T* output = result.Data();
+  for (size_t i=0; i<geometry.outputs; i++)
+    output[i] = std::sqrt(output[i]);
+
+  return result;
+}
+
+// Two passes, the mean and then the squares of the distances to it
+template <typename T>
+Tensor<T> DefaultBackend<T>::Variance(Tensor<T>& _tensor, const ReduceParams& _params)
+{
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return Variance(contiguous, _params);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, _params.axes, _params.keep_dims);
+  Tensor<T> mean = Mean(_tensor, _params);
+  Tensor<T> result(geometry.out_shape);
+
+  Reducer<T>::Sum(_tensor.Data(), geometry, result.Data(), _params.deterministic, true, mean.Data());
+
+  // No items left after the correction gives infinity or NaN
+  const T divisor = (T)geometry.count - (T)_params.correction;
+
+  T* output = result.Data();
+  for (size_t i=0; i<geometry.outputs; i++)
+    output[i] /= std::max(divisor, T(0));
+
+  return result;
+}
+
+template <typename T>
+Tensor<TSHAPE_TYPE> DefaultBackend<T>::ArgMax(Tensor<T>& _tensor, size_t _axis, bool _keep_dims)
+{
+  if (_axis >= _tensor.Rank())
+    MNT_THROW(("ArgMax axis is out of the range of shape " + _tensor.ShapeStr()).c_str());
+
+  if (_tensor.Storage() != MemoryKind::Linear)
+  {
+    Tensor<T> contiguous = Contiguous(_tensor);
+    return ArgMax(contiguous, _axis, _keep_dims);
+  }
+
+  const ReduceGeometry geometry = Reduction(_tensor, {_axis}, _keep_dims);
+  Tensor<TSHAPE_TYPE> result(geometry.out_shape);
+
+  Reducer<T>::ArgMax(_tensor.Data(), geometry, result.Data());
+
+  return result;
+}
+
+template <typename T>
+ReduceGeometry DefaultBackend<T>::Reduction(const Tensor<T>& _tensor, const std::vector<size_t>& _axes,
+                                            bool _keep_dims)
+{
+  if (_tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("Reductions need a tensor in the plain layout");
+
+  // The kernels read the items through Data() and the strides, views are fine, block storage isn`t
+  if (_tensor.Storage() != MemoryKind::Linear)
+    MNT_THROW("Reductions need linear storage, \"Reorder\" makes a contiguous copy of block storage");
+
+  return ReduceGeometry(_tensor.Shape(), _tensor.Strides(), _axes, _keep_dims);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Softmax(Tensor<T>& _tensor)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Rows(_tensor, KernelRegistry::Get().softmax, "Softmax");
+  else
+    return Rows(_tensor, &kernels::reference::Softmax<T, false>, "Softmax");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LogSoftmax(Tensor<T>& _tensor)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Rows(_tensor, KernelRegistry::Get().log_softmax, "LogSoftmax");
+  else
+    return Rows(_tensor, &kernels::reference::Softmax<T, true>, "LogSoftmax");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::SoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return RowsBackward(_output, _grad_output, KernelRegistry::Get().softmax_backward, "SoftmaxBackward");
+  else
+    return RowsBackward(_output, _grad_output, &kernels::reference::SoftmaxBackward<T, false>, "SoftmaxBackward");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LogSoftmaxBackward(Tensor<T>& _output, Tensor<T>& _grad_output)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return RowsBackward(_output, _grad_output, KernelRegistry::Get().log_softmax_backward, "LogSoftmaxBackward");
+  else
+    return RowsBackward(_output, _grad_output, &kernels::reference::SoftmaxBackward<T, true>, "LogSoftmaxBackward");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LayerNorm(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _beta, T _epsilon)
+{
+  CheckParameter(_beta, RowLength(_input, nullptr, "LayerNorm"), "LayerNorm");
+
+  if constexpr (std::is_same<T, float>::value)
+    return Normalize(_input, _gamma, _beta.Data(), _epsilon, KernelRegistry::Get().layer_norm, "LayerNorm");
+  else
+    return Normalize(_input, _gamma, _beta.Data(), _epsilon, &kernels::reference::Norm<T, false>, "LayerNorm");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::RMSNorm(Tensor<T>& _input, Tensor<T>& _gamma, T _epsilon)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return Normalize(_input, _gamma, nullptr, _epsilon, KernelRegistry::Get().rms_norm, "RMSNorm");
+  else
+    return Normalize(_input, _gamma, nullptr, _epsilon, &kernels::reference::Norm<T, true>, "RMSNorm");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::LayerNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                               Tensor<T>& _grad_gamma, Tensor<T>& _grad_beta, T _epsilon)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return NormalizeBackward(_input, _gamma, _grad_output, _grad_gamma, &_grad_beta, _epsilon,
+                             KernelRegistry::Get().layer_norm_backward, "LayerNormBackward");
+  else
+    return NormalizeBackward(_input, _gamma, _grad_output, _grad_gamma, &_grad_beta, _epsilon,
+                             &kernels::reference::NormBackward<T, false>, "LayerNormBackward");
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::RMSNormBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                             Tensor<T>& _grad_gamma, T _epsilon)
+{
+  if constexpr (std::is_same<T, float>::value)
+    return NormalizeBackward(_input, _gamma, _grad_output, _grad_gamma, nullptr, _epsilon,
+                             KernelRegistry::Get().rms_norm_backward, "RMSNormBackward");
+  else
+    return NormalizeBackward(_input, _gamma, _grad_output, _grad_gamma, nullptr, _epsilon,
+                             &kernels::reference::NormBackward<T, true>, "RMSNormBackward");
+}
+
+template <typename T>
+size_t DefaultBackend<T>::RowLength(const Tensor<T>& _tensor, const Tensor<T>* _other, const char* _op)
+{
+  if (_tensor.MemoryLayout() != Layout::Plain || _tensor.Rank() == 0)
+    MNT_THROW((std::string(_op) + " needs a tensor in the plain layout").c_str());
+
+  CheckContiguous(_tensor);
+
+  if (_other)
+  {
+    if (_other->Shape() != _tensor.Shape() || _other->MemoryLayout() != Layout::Plain)
+      MNT_THROW((std::string(_op) + " shapes " + _tensor.ShapeStr() + " and " + _other->ShapeStr() +
+                 " don`t match").c_str());
+    CheckContiguous(*_other);
+  }
+
+  return _tensor.Shape().back();
+}
+
+template <typename T>
+void DefaultBackend<T>::CheckParameter(const Tensor<T>& _parameter, size_t _length, const char* _op)
+{
+  if (_parameter.Rank() != 1 || _parameter.Shape()[0] != _length || _parameter.MemoryLayout() != Layout::Plain)
+    MNT_THROW((std::string(_op) + " parameters of shape " + _parameter.ShapeStr() +
+               " don`t match the last axis of length " + std::to_string(_length)).c_str());
+
+  CheckContiguous(_parameter);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Rows(Tensor<T>& _tensor, RowKernel _kernel, const char* _op)
+{
+  const size_t length = RowLength(_tensor, nullptr, _op);
+  Tensor<T> result(_tensor.Shape());
+
+  if (length == 0)
+    return result;
+
+  const T* input = _tensor.Data();
+  T* output = result.Data();
+
+  ParallelFor(0, _tensor.Length() / length, [&](size_t _begin, size_t _end)
+  {
+    for (size_t row=_begin; row<_end; row++)
+      _kernel(input + row * length, output + row * length, length);
+  }, 4 * length);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::RowsBackward(Tensor<T>& _output, Tensor<T>& _grad_output, RowGradKernel _kernel,
+                                          const char* _op)
+{
+  const size_t length = RowLength(_output, &_grad_output, _op);
+  Tensor<T> result(_output.Shape());
+
+  if (length == 0)
+    return result;
+
+  const T* output = _output.Data();
+  const T* grad_output = _grad_output.Data();
+  T* grad_input = result.Data();
+
+  ParallelFor(0, _output.Length() / length, [&](size_t _begin, size_t _end)
+  {
+    for (size_t row=_begin; row<_end; row++)
+      _kernel(output + row * length, grad_output + row * length, grad_input + row * length, length);
+  }, 4 * length);
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Normalize(Tensor<T>& _input, Tensor<T>& _gamma, const T* _beta, T _epsilon,
+                                       NormKernel _kernel, const char* _op)
+{
+  const size_t length = RowLength(_input, nullptr, _op);
+  CheckParameter(_gamma, length, _op);
+
+  Tensor<T> result(_input.Shape());
+
+  if (length == 0)
+    return result;
+
+  const T* input = _input.Data();
+  const T* gamma = _gamma.Data();
+  T* output = result.Data();
+
+  ParallelFor(0, _input.Length() / length, [&](size_t _begin, size_t _end)
+  {
+    for (size_t row=_begin; row<_end; row++)
+      _kernel(input + row * length, gamma, _beta, output + row * length, length, _epsilon);
+  }, 2 * length);
+
+  return result;
+}
+
+// Every chunk of rows accumulates its own gradients of the parameters, the chunks are
+// added in order, one chunk per thread at most
+template <typename T>
+Tensor<T> DefaultBackend<T>::NormalizeBackward(Tensor<T>& _input, Tensor<T>& _gamma, Tensor<T>& _grad_output,
+                                               Tensor<T>& _grad_gamma, Tensor<T>* _grad_beta, T _epsilon,
+                                               NormGradKernel _kernel, const char* _op)
+{
+  const size_t length = RowLength(_input, &_grad_output, _op);
+  CheckParameter(_gamma, length, _op);
+
+  Tensor<T> result(_input.Shape());
+  _grad_gamma = Tensor<T>({(TSHAPE_TYPE)length});
+  if (_grad_beta)
+    *_grad_beta = Tensor<T>({(TSHAPE_TYPE)length});
+
+  const size_t rows = length ? _input.Length() / length : 0;
+  const size_t threads = ThreadPool::Global().NoOfThreads();
+  const size_t grain = std::max(ThreadPool::Global().Grain(rows, 3 * length), (rows + threads - 1) / threads);
+
+  const T* input = _input.Data();
+  const T* gamma = _gamma.Data();
+  const T* grad_output = _grad_output.Data();
+  T* grad_input = result.Data();
+
+  // [gamma][beta] gradients of a chunk
+  const std::vector<T> partial = ParallelReduce(0, rows, std::vector<T>(2 * length, T(0)),
+  [&](size_t _begin, size_t _end)
+  {
+    std::vector<T> grads(2 * length, T(0));
+    for (size_t row=_begin; row<_end; row++)
+      _kernel(input + row * length, gamma, grad_output + row * length, grad_input + row * length,
+              grads.data(), grads.data() + length, length, _epsilon);
+    return grads;
+  },
+  [](std::vector<T> _a, const std::vector<T>& _b)
+  {
+    for (size_t i=0; i<_a.size(); i++)
+      _a[i] += _b[i];
+    return _a;
+  }, 3 * length, std::max(grain, (size_t)1));
+
+  std::copy(partial.begin(), partial.begin() + length, _grad_gamma.Data());
+  if (_grad_beta)
+    std::copy(partial.begin() + length, partial.end(), _grad_beta->Data());
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Conv2D(Tensor<T>& _input, Tensor<T>& _filter, const Conv2DParams& _params)
+{
+  return Convolve(_input, _filter, nullptr, _params);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Conv2D(Tensor<T>& _input, Tensor<T>& _filter, Tensor<T>& _bias,
+                                    const Conv2DParams& _params)
+{
+  if (_bias.Rank() != 1 || _filter.Rank() < 1 || _bias.Shape()[0] != _filter.Shape()[0])
+    MNT_THROW(("Conv2D bias of shape " + _bias.ShapeStr() + " doesn`t match the filter " +
+               _filter.ShapeStr()).c_str());
+
+  return Convolve(_input, _filter, _bias.Data(), _params);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Convolve(Tensor<T>& _input, Tensor<T>& _filter, const T* _bias,
+                                      const Conv2DParams& _params)
+{
+  if (_filter.MemoryLayout() != Layout::Plain)
+    MNT_THROW("Conv2D needs a filter in the plain layout");
+
+  CheckContiguous(_input);
+  CheckContiguous(_filter);
+
+  if (_input.MemoryLayout() != Layout::Plain)
+    return Conv2DBlocked(_input, _filter, _bias, _params);
+
+  const Conv2DGeometry geometry(_input.Shape(), _filter.Shape(), _params);
+
+  Tensor<T> result({(TSHAPE_TYPE)geometry.batch, (TSHAPE_TYPE)geometry.out_channels,
+                    (TSHAPE_TYPE)geometry.out_height, (TSHAPE_TYPE)geometry.out_width});
+
+  ConvolvePlain(_input.Data(), _filter.Data(), _bias, result.Data(), geometry);
+
+  return result;
+}
+
+template <typename T>
+void DefaultBackend<T>::ConvolvePlain(const T* _input, const T* _filter, const T* _bias, T* _output,
+                                      const Conv2DGeometry& _geometry)
+{
+  const Conv2DGeometry& geometry = _geometry;
+  const Conv2DParams& params = _geometry.params;
+
+  const T* input = _input;
+  const T* filter = _filter;
+  T* output = _output;
+
+  const size_t pixels = geometry.Pixels();
+  const size_t depth = geometry.Depth();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const ConvAlgorithm algorithm = SelectConv2D(geometry);
+
+    if (algorithm == ConvAlgorithm::Depthwise)
+    {
+      const size_t plane_length = geometry.in_height * geometry.in_width;
+      const size_t window = geometry.kernel_h * geometry.kernel_w;
+      auto kernel = KernelRegistry::Get().depthwise;
+
+      // Rows of every output plane, bias and activation are fused
+      ParallelFor(0, geometry.batch * geometry.out_channels * geometry.out_height, [&](size_t _begin, size_t _end)
+      {
+        BlockedRowArgs args = WindowArgs(geometry);
+
+        for (size_t row = _begin; row < _end; row++)
+        {
+          const size_t oh = row % geometry.out_height;
+          const size_t plane = row / geometry.out_height;
+          const size_t channel = plane % geometry.out_channels;
+
+          args.input = input + plane * plane_length;
+          args.filter = filter + channel * window;
+          args.bias = _bias ? _bias + channel : nullptr;
+          args.output = output + row * geometry.out_width;
+          args.row = (ptrdiff_t)(oh * params.stride_h) - (ptrdiff_t)params.padding_h;
+
+          kernel(args);
+        }
+      }, geometry.out_width * window);
+
+      return;
+    }
+
+    if (algorithm == ConvAlgorithm::Winograd)
+    {
+      std::shared_ptr<const std::vector<float>> transformed = Winograd::Filter(filter, geometry);
+      Winograd::Run(input, transformed->data(), output, geometry);
+      Epilogue(output, _bias, geometry);
+      return;
+    }
+
+    if (algorithm == ConvAlgorithm::Gemm)
+    {
+      // Per image and group: output[OC x pixels] = filter[OC x depth] * patches[depth x pixels],
+      // the filter is shared by all the images
+      const size_t image_length = geometry.in_channels * geometry.in_height * geometry.in_width;
+      const size_t group_rows = geometry.GroupOutChannels();
+
+      for (size_t group = 0; group < params.groups; group++)
+      {
+        const float* group_filter = filter + group * group_rows * depth;
+        float* group_output = output + group * group_rows * pixels;
+
+        if (geometry.IsPointwise())
+        {
+          const KernelTable& table = KernelRegistry::Get();
+          const float* group_input = input + group * geometry.GroupChannels() * pixels;
+
+          Gemm::Run(geometry.batch, group_rows, pixels, depth, group_filter, 0, depth, 1,
+                    [&](size_t _image, size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+                    {
+                      table.gemm_pack_b(group_input + _image * image_length + _k_begin * pixels + _n_begin,
+                                        pixels, 1, _depth, _cols, _packed);
+                    },
+                    group_output, geometry.out_channels * pixels, pixels);
+        }
+        else
+        {
+          Gemm::Run(geometry.batch, group_rows, pixels, depth, group_filter, 0, depth, 1,
+                    Im2ColPacker(input, geometry, group), group_output, geometry.out_channels * pixels, pixels);
+        }
+      }
+
+      Epilogue(output, _bias, geometry);
+      return;
+    }
+  }
+
+  // The epilogue of a plane runs right after it is computed, while it is still in the cache
+  ParallelFor(0, geometry.batch * geometry.out_channels, [&](size_t _begin, size_t _end)
+  {
+    for (size_t plane = _begin; plane < _end; plane++)
+    {
+      Conv2DDirect(input, filter, output, geometry, plane);
+      EpiloguePlane(output + plane * pixels, pixels,
+                    _bias ? _bias[plane % geometry.out_channels] : T(0), params.activation);
+    }
+  }, pixels * depth);
+}
+
+// A Conv1D is a Conv2D of height 1, unless the FFT is cheaper
+template <typename T>
+Tensor<T> DefaultBackend<T>::Conv1D(Tensor<T>& _input, Tensor<T>& _filter, const Conv1DParams& _params)
+{
+  if (_input.MemoryLayout() != Layout::Plain || _filter.MemoryLayout() != Layout::Plain)
+    MNT_THROW("Conv1D needs tensors in the plain layout");
+
+  CheckContiguous(_input);
+  CheckContiguous(_filter);
+
+  const Conv1DGeometry geometry(_input.Shape(), _filter.Shape(), _params);
+
+  Tensor<T> result({(TSHAPE_TYPE)geometry.batch, (TSHAPE_TYPE)geometry.out_channels,
+                    (TSHAPE_TYPE)geometry.out_length});
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    if (SelectConv1D(geometry) == ConvAlgorithm::FFT)
+    {
+      FFTConv1D::Run(_input.Data(), _filter.Data(), result.Data(), geometry);
+      return result;
+    }
+  }
+
+  ConvolvePlain(_input.Data(), _filter.Data(), nullptr, result.Data(), geometry.AsConv2D());
+
+  return result;
+}
+
+// Rows of output (image, group of output channels, output row) are independent, a row
+// reads KH input rows of every input group (only its own for depthwise) and the filters
+// of its output group
+template <typename T>
+Tensor<T> DefaultBackend<T>::Conv2DBlocked(Tensor<T>& _input, Tensor<T>& _filter, const T* _bias,
+                                           const Conv2DParams& _params)
+{
+  const Conv2DGeometry geometry(_input.Shape(), _filter.Shape(), _params);
+  const Layout layout = _input.MemoryLayout();
+  const bool depthwise = geometry.IsDepthwise() && _params.algorithm != ConvAlgorithm::Direct;
+
+  // There are only float kernels for the blocked layouts, and only for dense and depthwise filters
+  if (!std::is_same<T, float>::value || (_params.groups > 1 && !depthwise))
+  {
+    Tensor<T> plain = Reorder(_input, Layout::Plain);
+    Tensor<T> output = Convolve(plain, _filter, _bias, _params);
+    return Reorder(output, layout);
+  }
+
+  Tensor<T> result({(TSHAPE_TYPE)geometry.batch, (TSHAPE_TYPE)geometry.out_channels,
+                    (TSHAPE_TYPE)geometry.out_height, (TSHAPE_TYPE)geometry.out_width}, layout);
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const size_t block = LayoutBlock(layout);
+    const size_t in_groups = (geometry.in_channels + block - 1) / block;
+    const size_t out_groups = (geometry.out_channels + block - 1) / block;
+    const size_t window = geometry.kernel_h * geometry.kernel_w;
+    const size_t filter_length = depthwise ? window * block : in_groups * window * block * block;
+
+    std::vector<float> filter(out_groups * filter_length);
+    PackBlockedFilter(_filter.Data(), geometry, block, filter.data());
+
+    // The bias is zero padded like the channels
+    std::vector<float> bias;
+    if (_bias)
+    {
+      bias.assign(out_groups * block, 0.0f);
+      std::copy(_bias, _bias + geometry.out_channels, bias.begin());
+    }
+
+    const KernelTable& table = KernelRegistry::Get();
+    auto kernel = depthwise ? table.depthwise_blocked[block == 16] : table.conv_blocked[block == 16];
+
+    const float* input = _input.Data();
+    float* output = result.Data();
+    const size_t group_length = geometry.in_height * geometry.in_width * block;
+    const size_t rows = geometry.batch * out_groups * geometry.out_height;
+
+    ParallelFor(0, rows, [&](size_t _begin, size_t _end)
+    {
+      BlockedRowArgs args = WindowArgs(geometry);
+      args.in_groups = in_groups;
+
+      for (size_t row = _begin; row < _end; row++)
+      {
+        const size_t oh = row % geometry.out_height;
+        const size_t group = (row / geometry.out_height) % out_groups;
+        const size_t image = row / (geometry.out_height * out_groups);
+
+        // A depthwise row only reads its own group of channels
+        args.input = input + (depthwise ? image * in_groups + group : image * in_groups) * group_length;
+        args.filter = filter.data() + group * filter_length;
+        args.bias = _bias ? bias.data() + group * block : nullptr;
+        args.output = output + row * geometry.out_width * block;
+        args.row = (ptrdiff_t)(oh * _params.stride_h) - (ptrdiff_t)_params.padding_h;
+
+        kernel(args);
+      }
+    }, geometry.out_width * (depthwise ? 1 : in_groups * block) * window);
+
+    // Activations that don`t keep zero at zero would fill the padding
+    ClearPadding(result);
+  }
+
+  return result;
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::MaxPool2D(Tensor<T>& _input, const Pool2DParams& _params)
+{
+  return Pool2D(_input, _params, true);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::AvgPool2D(Tensor<T>& _input, const Pool2DParams& _params)
+{
+  return Pool2D(_input, _params, false);
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Pool2D(Tensor<T>& _input, const Pool2DParams& _params, bool _maximum)
+{
+  CheckContiguous(_input);
+
+  const Pool2DGeometry geometry(_input.Shape(), _params);
+  const Layout layout = _input.MemoryLayout();
+
+  Tensor<T> result({(TSHAPE_TYPE)geometry.batch, (TSHAPE_TYPE)geometry.channels,
+                    (TSHAPE_TYPE)geometry.out_height, (TSHAPE_TYPE)geometry.out_width}, layout);
+
+  const T* input = _input.Data();
+  T* output = result.Data();
+  const size_t window = _params.kernel_h * _params.kernel_w;
+
+  if (layout == Layout::Plain)
+  {
+    ParallelFor(0, geometry.batch * geometry.channels, [&](size_t _begin, size_t _end)
+    {
+      for (size_t plane = _begin; plane < _end; plane++)
+      {
+        if (_maximum)
+          MaxPool2DPlane(input, output, geometry, plane);
+        else
+          AvgPool2DPlane(input, output, geometry, plane);
+      }
+    }, geometry.out_height * geometry.out_width * window);
+
+    return result;
+  }
+
+  if constexpr (!std::is_same<T, float>::value)
+  {
+    Tensor<T> plain = Reorder(_input, Layout::Plain);
+    Tensor<T> pooled = Pool2D(plain, _params, _maximum);
+    return Reorder(pooled, layout);
+  }
+  else
+  {
+    const size_t block = LayoutBlock(layout);
+    const size_t groups = (geometry.channels + block - 1) / block;
+    const KernelTable& table = KernelRegistry::Get();
+    auto kernel = _maximum ? table.max_pool_blocked[block == 16] : table.avg_pool_blocked[block == 16];
+
+    ParallelFor(0, geometry.batch * groups * geometry.out_height, [&](size_t _begin, size_t _end)
+    {
+      BlockedRowArgs args = {};
+      args.in_height = geometry.in_height;
+      args.in_width = geometry.in_width;
+      args.out_width = geometry.out_width;
+      args.kernel_h = _params.kernel_h;
+      args.kernel_w = _params.kernel_w;
+      args.stride_w = _params.stride_w;
+      args.col = -(ptrdiff_t)_params.padding_w;
+
+      for (size_t row = _begin; row < _end; row++)
+      {
+        const size_t oh = row % geometry.out_height;
+        const size_t plane = row / geometry.out_height;
+
+        args.input = input + plane * geometry.in_height * geometry.in_width * block;
+        args.output = output + row * geometry.out_width * block;
+        args.row = (ptrdiff_t)(oh * _params.stride_h) - (ptrdiff_t)_params.padding_h;
+
+        kernel(args);
+      }
+    }, geometry.out_width * window * block);
+
+    return result;
+  }
+}
+
+template <typename T>
+Tensor<T> DefaultBackend<T>::Contiguous(Tensor<T>& _tensor)
+{
+  const TensorShape& shape = _tensor.Shape();
+  const TensorStrides strides = _tensor.Strides();
+  const size_t rank = shape.size();
+
+  Tensor<T> result(shape);
+
+  TensorStrides dst_strides(rank, 1);
+  for (size_t i=rank; i-- > 1;)
+    dst_strides[i - 1] = dst_strides[i] * shape[i];
+
+  const T* src = _tensor.Data();
+  T* dst = result.Data();
+
+  // Other storages are read span by span, straight into the result if the items are in order,
+  // otherwise into one array that "Gather" reads with the strides
+  std::vector<T> gathered;
+  if (!src)
+  {
+    const bool in_order = strides == dst_strides;
+
+    T* items = dst;
+    if (!in_order)
+    {
+      gathered.resize(_tensor.Length());
+      items = gathered.data();
+    }
+
+    for (const MemorySpan<T>& span : _tensor.Spans())
+      items = std::copy(span.data, span.data + span.length, items);
+
+    if (in_order)
+      return result;
+    src = gathered.data();
+  }
+
+  CopyStrided(src, shape, strides, dst);
+
+  return result;
+}
+
+template <typename T>
+void DefaultBackend<T>::CopyStrided(const T* _src, const TensorShape& _shape, const TensorStrides& _strides, T* _dst)
+{
+  const size_t rank = _shape.size();
+
+  if (rank == 0)
+  {
+    _dst[0] = _src[0];
+    return;
+  }
+
+  const TensorStrides extents(_shape.begin(), _shape.end());
+  TensorStrides dst_strides(rank, 1);
+  for (size_t i=rank; i-- > 1;)
+    dst_strides[i - 1] = dst_strides[i] * _shape[i];
+
+  ParallelForND(extents, [&](const size_t* _index, size_t _length)
+  {
+    size_t src_offset = 0;
+    size_t dst_offset = 0;
+    for (size_t d=0; d<rank; d++)
+    {
+      src_offset += _index[d] * _strides[d];
+      dst_offset += _index[d] * dst_strides[d];
+    }
+
+    for (size_t i=0; i<_length; i++)
+      _dst[dst_offset + i] = _src[src_offset + i * _strides[rank - 1]];
+  }, 2);
+}
+
+template <typename T>
+template <typename U>
+void DefaultBackend<T>::CheckContiguous(const Tensor<U>& _tensor)
+{
+  if (!_tensor.IsContiguous())
+    MNT_THROW("The operation needs a contiguous tensor, \"Reorder\" makes a contiguous copy of a view or of block storage");
+}
+
+template <typename T>
+void DefaultBackend<T>::ClearPadding(Tensor<T>& _tensor) noexcept
+{
+  const size_t block = LayoutBlock(_tensor.MemoryLayout());
+  const TensorShape& shape = _tensor.Shape();
+
+  if (block == 1 || shape[1] % block == 0)
+    return;
+
+  // Only the last group of every image has padding
+  const size_t groups = (shape[1] + block - 1) / block;
+  const size_t pixels = shape[2] * shape[3];
+  const size_t used = shape[1] % block;
+  T* data = _tensor.Data();
+
+  for (size_t image = 0; image < shape[0]; image++)
+  {
+    T* group = data + ((image + 1) * groups - 1) * pixels * block;
+    for (size_t pixel = 0; pixel < pixels; pixel++)
+      std::fill(group + pixel * block + used, group + (pixel + 1) * block, T(0));
+  }
+}
+
+template <typename T>
+BlockedRowArgs DefaultBackend<T>::WindowArgs(const Conv2DGeometry& _geometry) noexcept
+{
+  BlockedRowArgs args = {};
+  args.in_groups = 1;
+  args.in_height = _geometry.in_height;
+  args.in_width = _geometry.in_width;
+  args.out_width = _geometry.out_width;
+  args.kernel_h = _geometry.kernel_h;
+  args.kernel_w = _geometry.kernel_w;
+  args.stride_w = _geometry.params.stride_w;
+  args.dilation_h = _geometry.params.dilation_h;
+  args.dilation_w = _geometry.params.dilation_w;
+  args.col = -(ptrdiff_t)_geometry.params.padding_w;
+  args.activation = _geometry.params.activation;
+  return args;
+}
+
+template <typename T>
+void DefaultBackend<T>::Epilogue(T* _output, const T* _bias, const Conv2DGeometry& _geometry)
+{
+  const Activation activation = _geometry.params.activation;
+  if (!_bias && activation == Activation::None)
+    return;
+
+  const size_t pixels = _geometry.Pixels();
+
+  ParallelFor(0, _geometry.batch * _geometry.out_channels, [&](size_t _begin, size_t _end)
+  {
+    for (size_t plane = _begin; plane < _end; plane++)
+      EpiloguePlane(_output + plane * pixels, pixels, _bias ? _bias[plane % _geometry.out_channels] : T(0), activation);
+  }, pixels);
+}
+
+template <typename T>
+void DefaultBackend<T>::EpiloguePlane(T* _plane, size_t _length, T _bias, Activation _activation) noexcept
+{
+  if (_bias == T(0) && _activation == Activation::None)
+    return;
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    KernelRegistry::Get().bias_activation(_plane, _length, _bias, _activation);
+  }
+  else
+  {
+    for (size_t i = 0; i < _length; i++)
+      _plane[i] = Activate(T(_plane[i] + _bias), _activation);
+  }
+}
+
+// The direct loops do about one multiply-add per cycle, the GEMM several per cycle but
+// it pays for the packing, gathering patches costs about twice as much as copying.
+// Winograd is only a candidate if its shape fits and its error is within the tolerance.
+// Depthwise convolutions always use their own kernels unless another one is forced.
+template <typename T>
+ConvAlgorithm DefaultBackend<T>::SelectConv2D(const Conv2DGeometry& _geometry) const noexcept
+{
+  if (!std::is_same<T, float>::value)
+    return ConvAlgorithm::Direct;
+
+  if (_geometry.IsDepthwise() && _geometry.params.algorithm != ConvAlgorithm::Direct &&
+      _geometry.params.algorithm != ConvAlgorithm::Gemm)
+    return ConvAlgorithm::Depthwise;
+
+  const bool winograd_fits = Winograd::Supports(_geometry) &&
+                             _geometry.params.tolerance >= MNT_WINOGRAD_RELATIVE_ERROR;
+
+  const ConvAlgorithm forced = _geometry.params.algorithm;
+  if (forced == ConvAlgorithm::Direct || forced == ConvAlgorithm::Gemm ||
+      (forced == ConvAlgorithm::Winograd && winograd_fits))
+    return forced;
+
+  size_t gemm = GemmCost(_geometry);
+  size_t direct = _geometry.MACs();
+
+  ConvAlgorithm best = gemm < direct ? ConvAlgorithm::Gemm : ConvAlgorithm::Direct;
+  size_t best_cost = std::min(gemm, direct);
+
+  if (winograd_fits && Winograd::Cost(_geometry) < best_cost)
+    best = ConvAlgorithm::Winograd;
+
+  return best;
+}
+
+template <typename T>
+ConvAlgorithm DefaultBackend<T>::SelectConv1D(const Conv1DGeometry& _geometry) const noexcept
+{
+  if (!std::is_same<T, float>::value || !FFTConv1D::Supports(_geometry) ||
+      _geometry.params.tolerance < MNT_FFT_RELATIVE_ERROR)
+    return ConvAlgorithm::Auto;
+
+  const ConvAlgorithm forced = _geometry.params.algorithm;
+  if (forced == ConvAlgorithm::FFT)
+    return forced;
+  if (forced != ConvAlgorithm::Auto)
+    return ConvAlgorithm::Auto;
+
+  const Conv2DGeometry plane = _geometry.AsConv2D();
+  const size_t others = std::min(GemmCost(plane), plane.MACs());
+
+  return FFTConv1D::Cost(_geometry) < others ? ConvAlgorithm::FFT : ConvAlgorithm::Auto;
+}
+
+template <typename T>
+size_t DefaultBackend<T>::GemmCost(const Conv2DGeometry& _geometry) noexcept
+{
+  const size_t pixels = _geometry.Pixels();
+  const size_t depth = _geometry.Depth();
+
+  size_t gemm = Gemm::Cost(_geometry.GroupOutChannels(), pixels, depth);
+  if (!_geometry.IsPointwise())
+    gemm += depth * pixels * ((_geometry.GroupOutChannels() + MNT_GEMM_MC - 1) / MNT_GEMM_MC);
+
+  return gemm * _geometry.batch * _geometry.params.groups;
+}
 
 #endif
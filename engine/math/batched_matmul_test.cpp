@@ -0,0 +1,219 @@
+// File Name:     batched_matmul_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of BatchedMatMul on every instruction set
+
+// ---------------------
+// Detail Description:
+// The naive product reads both tensors through their logical index and strides, so it sees
+// views of Shapeshift the way the caller does, and broadcasts the batch axes by itself. The
+// float products run on the packed GEMM and its single tall GEMM path when every batch
+// shares the second matrix, the double products on the reference kernel. Operands in block
+// storage are checked against the same items in linear storage.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/test_utils.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  // Item of _tensor at the logical _index, aligned from the right with the axes of _tensor
+  // and broadcast on the axes of size 1
+  template <typename T>
+  double At(const Tensor<T>& _tensor, const std::vector<size_t>& _index)
+  {
+    const TensorShape& shape = _tensor.Shape();
+    const TensorStrides strides = _tensor.Strides();
+    const size_t skip = _index.size() - shape.size();
+
+    size_t offset = 0;
+    for (size_t d=0; d<shape.size(); d++)
+      offset += (shape[d] == 1 ? 0 : _index[skip + d]) * strides[d];
+
+    return (double)_tensor.Data()[offset];
+  }
+
+  template <typename T>
+  std::vector<double> NaiveBatchedMatMul(const Tensor<T>& _tensor_1, const Tensor<T>& _tensor_2,
+                                         TensorShape& _shape)
+  {
+    const TensorShape& shape_1 = _tensor_1.Shape();
+    const TensorShape& shape_2 = _tensor_2.Shape();
+    const size_t rank = std::max(shape_1.size(), shape_2.size());
+    const size_t m = shape_1[shape_1.size() - 2];
+    const size_t k = shape_1[shape_1.size() - 1];
+    const size_t n = shape_2[shape_2.size() - 1];
+
+    _shape = TensorShape(rank);
+    size_t batch = 1;
+    for (size_t d=0; d<rank - 2; d++)
+    {
+      const size_t extent_1 = d + shape_1.size() >= rank ? shape_1[d + shape_1.size() - rank] : 1;
+      const size_t extent_2 = d + shape_2.size() >= rank ? shape_2[d + shape_2.size() - rank] : 1;
+      _shape[d] = (TSHAPE_TYPE)std::max(extent_1, extent_2);
+      batch *= _shape[d];
+    }
+    _shape[rank - 2] = (TSHAPE_TYPE)m;
+    _shape[rank - 1] = (TSHAPE_TYPE)n;
+
+    std::vector<double> output(batch * m * n);
+    std::vector<size_t> index(rank, 0);
+
+    for (size_t b=0; b<batch; b++)
+    {
+      size_t rest = b;
+      for (size_t d=rank - 2; d-- > 0;)
+      {
+        index[d] = rest % _shape[d];
+        rest /= _shape[d];
+      }
+
+      for (size_t i=0; i<m; i++)
+        for (size_t j=0; j<n; j++)
+        {
+          double sum = 0.0;
+          for (size_t p=0; p<k; p++)
+          {
+            index[rank - 2] = i;
+            index[rank - 1] = p;
+            const double a = At(_tensor_1, index);
+            index[rank - 2] = p;
+            index[rank - 1] = j;
+            sum += a * At(_tensor_2, index);
+          }
+          output[(b * m + i) * n + j] = sum;
+        }
+    }
+
+    return output;
+  }
+
+  // _reference_1 and _reference_2 hold the items of the operands in linear storage, for the naive product
+  template <typename T>
+  void Check(Checks& _checks, Tensor<T>& _tensor_1, Tensor<T>& _tensor_2, const Tensor<T>& _reference_1,
+             const Tensor<T>& _reference_2, const std::string& _what)
+  {
+    DefaultBackend<T> backend;
+
+    TensorShape shape;
+    const std::vector<double> expected = NaiveBatchedMatMul(_reference_1, _reference_2, shape);
+    Tensor<T> result = backend.BatchedMatMul(_tensor_1, _tensor_2);
+
+    _checks.Expect(result.Shape() == shape, _what + " has the shape " + result.ShapeStr());
+    _checks.Items(result, expected, 1e-4, _what);
+  }
+
+  template <typename T>
+  void Check(Checks& _checks, Tensor<T>& _tensor_1, Tensor<T>& _tensor_2, const std::string& _what)
+  {
+    Check(_checks, _tensor_1, _tensor_2, _tensor_1, _tensor_2, _what);
+  }
+
+  template <typename T>
+  void CheckShapes(Checks& _checks, const char* _type, const TensorShape& _shape_1, const TensorShape& _shape_2,
+                   const std::string& _name)
+  {
+    Tensor<T> tensor_1(_shape_1);
+    Tensor<T> tensor_2(_shape_2);
+    Fill(tensor_1, 1);
+    Fill(tensor_2, 2);
+
+    Check(_checks, tensor_1, tensor_2, std::string(_type) + " " + _name);
+  }
+
+  template <typename T>
+  void CheckBatchedMatMul(Checks& _checks, const char* _type)
+  {
+    CheckShapes<T>(_checks, _type, {4, 7, 5}, {4, 5, 9}, "same batch");
+    CheckShapes<T>(_checks, _type, {3, 1, 7, 5}, {1, 4, 5, 9}, "batch axes of size 1");
+    CheckShapes<T>(_checks, _type, {7, 5}, {2, 3, 5, 9}, "missing batch axes of the first");
+    CheckShapes<T>(_checks, _type, {2, 3, 6, 5}, {5, 8}, "missing batch axes of the second");
+    CheckShapes<T>(_checks, _type, {2, 3, 6, 5}, {1, 1, 5, 8}, "shared second matrix");
+    CheckShapes<T>(_checks, _type, {3, 70, 130}, {3, 130, 90}, "large");
+    CheckShapes<T>(_checks, _type, {5, 1, 33}, {5, 33, 1}, "vectors");
+    CheckShapes<T>(_checks, _type, {2, 2, 17, 3}, {2, 1, 3, 300}, "wide");
+
+    // The transposed keys of attention, a view of the last two axes
+    {
+      Tensor<T> queries({2, 4, 8, 16});
+      Tensor<T> keys({2, 4, 8, 16});
+      Fill(queries, 3);
+      Fill(keys, 4);
+      Tensor<T> transposed = keys.Shapeshift({0, 1, 3, 2});
+      Check(_checks, queries, transposed, std::string(_type) + " transposed second");
+    }
+
+    // A view that moves the batch axes, {batch, rows, heads, k} read as {heads, batch, rows, k}
+    {
+      Tensor<T> tensor({3, 10, 2, 12});
+      Tensor<T> values({2, 3, 12, 7});
+      Fill(tensor, 5);
+      Fill(values, 6);
+      Tensor<T> view = tensor.Shapeshift({2, 0, 1, 3});
+      Check(_checks, view, values, std::string(_type) + " permuted batch axes");
+    }
+
+    // Both operands transposed
+    {
+      Tensor<T> tensor_1({3, 9, 11});
+      Tensor<T> tensor_2({3, 13, 9});
+      Fill(tensor_1, 7);
+      Fill(tensor_2, 8);
+      Tensor<T> view_1 = tensor_1.Shapeshift({0, 2, 1});
+      Tensor<T> view_2 = tensor_2.Shapeshift({0, 2, 1});
+      Check(_checks, view_1, view_2, std::string(_type) + " both transposed");
+    }
+
+    // Block storage is copied to linear storage, views of it as well
+    {
+      Tensor<T> tensor_1({3, 9, 11});
+      Tensor<T> tensor_2({3, 11, 6});
+      Fill(tensor_1, 9);
+      Fill(tensor_2, 10);
+      Tensor<T> blocks_1 = OnBlocks(tensor_1);
+      Tensor<T> blocks_2 = OnBlocks(tensor_2);
+      Check(_checks, blocks_1, tensor_2, tensor_1, tensor_2, std::string(_type) + " first in block storage");
+      Check(_checks, tensor_1, blocks_2, tensor_1, tensor_2, std::string(_type) + " second in block storage");
+      Check(_checks, blocks_1, blocks_2, tensor_1, tensor_2, std::string(_type) + " both in block storage");
+
+      Tensor<T> keys({3, 6, 11});
+      Fill(keys, 11);
+      Tensor<T> blocks_keys = OnBlocks(keys);
+      Tensor<T> view = keys.Shapeshift({0, 2, 1});
+      Tensor<T> blocks_view = blocks_keys.Shapeshift({0, 2, 1});
+      Check(_checks, blocks_1, blocks_view, tensor_1, view, std::string(_type) + " transposed block storage");
+    }
+
+    DefaultBackend<T> backend;
+
+    Tensor<T> matrix({4, 6, 5});
+    Tensor<T> wrong_k({4, 6, 5});
+    Tensor<T> wrong_batch({3, 5, 2});
+    Tensor<T> vector({5});
+    Tensor<T> blocked({1, 8, 4, 4}, Layout::NCHW8c);
+
+    _checks.Throws([&]() {backend.BatchedMatMul(matrix, wrong_k);}, "BatchedMatMul of another inner size");
+    _checks.Throws([&]() {backend.BatchedMatMul(matrix, wrong_batch);}, "BatchedMatMul of another batch");
+    _checks.Throws([&]() {backend.BatchedMatMul(vector, matrix);}, "BatchedMatMul of a vector");
+    _checks.Throws([&]() {backend.BatchedMatMul(blocked, blocked);}, "BatchedMatMul of a blocked tensor");
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckBatchedMatMul<float>(checks, "float");
+    CheckBatchedMatMul<double>(checks, "double");
+
+    return checks.Failures();
+  });
+}
@@ -0,0 +1,85 @@
+// File Name:     bitmask.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Bit-packed boolean tensors for masking
+
+// ---------------------
+// Detail Description:
+// A mask of a tensor, e.g. the kept items of dropout or the hidden scores of attention, as float
+// or byte items costs 32 or 8 times the bandwidth of the information in it. BitMask stores one
+// bit per item, item i is bit i % 64 of word i / 64, in LinearHeapMemory like the items of
+// Tensor. The ops that apply it (MaskedFill, MaskedSelect, Dropout, etc. in "math/backend.hpp")
+// and its conversions from and to tensors run kernels that read and write the bits directly,
+// see "math/kernels/mask.inl".
+// ---------------------
+
+// ---------------------
+// Note:
+// The bits of the last word beyond Length() are always zero, every function that writes
+// whole words keeps them so, "Count" and the kernels rely on it
+// ---------------------
+
+// =====
+// [BitMask(_shape, _value)]: A mask of the items of _shape, all set to _value
+// =====
+
+// =====
+// [Count()]: Number of set bits, with the popcount of the words
+// =====
+
+#ifndef ENGINE_MATH_BITMASK_HPP
+#define ENGINE_MATH_BITMASK_HPP
+
+#include "configs.hpp"
+
+#include "memory/memory_ref.hpp"
+
+#include "math/shape.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mnt {
+
+  class BitMask
+  {
+  public:
+    explicit BitMask(const TensorShape& _shape, bool _value = false);
+
+    BitMask(const BitMask&) = delete;
+    BitMask& operator = (const BitMask&) = delete;
+    BitMask(BitMask&&) noexcept = default;
+    BitMask& operator = (BitMask&&) noexcept = default;
+
+    inline const TensorShape& Shape() const noexcept {return m_shape;};
+    inline size_t Rank() const noexcept {return m_shape.size();};
+    inline size_t Length() const noexcept {return m_length;};
+    std::string ShapeStr() const;
+
+    // Words of 64 items, the last one may be partial
+    inline size_t Words() const noexcept {return (m_length + 63) / 64;};
+    inline uint64_t* Data() noexcept {return m_words;};
+    inline const uint64_t* Data() const noexcept {return m_words;};
+
+    inline bool Get(size_t _index) const noexcept {return (m_words[_index / 64] >> (_index % 64)) & 1;};
+    inline void Set(size_t _index, bool _value) noexcept
+    {
+      const uint64_t bit = 1ull << (_index % 64);
+      m_words[_index / 64] = _value ? m_words[_index / 64] | bit : m_words[_index / 64] & ~bit;
+    };
+
+    void Fill(bool _value) noexcept;
+    size_t Count() const;
+
+  private:
+    TensorShape m_shape;
+    size_t m_length = 0;
+    MemoryRef<uint64_t> m_memory;
+    uint64_t* m_words = nullptr;
+  };
+}
+
+#include "math/bitmask.inl"
+
+#endif
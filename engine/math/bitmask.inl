@@ -0,0 +1,73 @@
+// File Name:     bitmask.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Bit-packed boolean tensors for masking
+
+#ifndef ENGINE_MATH_BITMASK_INL
+#define ENGINE_MATH_BITMASK_INL
+
+#include "math/bitmask.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "memory/linear/linear_heap.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace mnt;
+
+inline BitMask::BitMask(const TensorShape& _shape, bool _value)
+{
+  m_shape = _shape;
+  m_length = ShapeLength(_shape);
+
+  if (m_length == 0)
+    return;
+
+  LinearHeapMemory<uint64_t>* memory = new LinearHeapMemory<uint64_t>(Words());
+  m_memory = MemoryRef<uint64_t>(memory);
+  m_words = memory->Data();
+
+  Fill(_value);
+};
+
+inline std::string BitMask::ShapeStr() const
+{
+  std::stringstream string_stream;
+
+  string_stream << "{";
+  for (size_t i=0; i<m_shape.size(); i++)
+    string_stream << (i ? ", " : "") << m_shape[i];
+  string_stream << "}";
+
+  return string_stream.str();
+};
+
+inline void BitMask::Fill(bool _value) noexcept
+{
+  if (m_length == 0)
+    return;
+
+  std::fill_n(m_words, Words(), _value ? ~0ull : 0ull);
+
+  // Clears the bits beyond the last item
+  if (_value && m_length % 64)
+    m_words[Words() - 1] = (1ull << (m_length % 64)) - 1;
+};
+
+inline size_t BitMask::Count() const
+{
+  const auto count = KernelRegistry::Get().mask_count;
+
+  // Chunks of whole words, the last one stops at the last item
+  return ParallelReduce(0, Words(), (size_t)0,
+                        [&](size_t _begin, size_t _end)
+                        {
+                          return count(m_words + _begin, std::min(_end * 64, m_length) - _begin * 64);
+                        },
+                        [](size_t _a, size_t _b) {return _a + _b;}, 64);
+};
+
+#endif
@@ -0,0 +1,178 @@
+// File Name:     conv.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Parameters, geometry and building blocks of convolutions
+
+// ---------------------
+// Detail Description:
+// Conv2D takes an input of shape {N, C, H, W} and a filter of shape {OC, C, KH, KW} and
+// returns {N, OC, OH, OW}. Seen per image, it is a GEMM of the filter (OC x C*KH*KW) and the
+// patch matrix (C*KH*KW x OH*OW), whose column p holds the input values under the filter
+// for the output pixel p (im2col). Im2ColPacker writes tiles of the patch matrix straight
+// into the packed layout of the GEMM, so the patch matrix is never materialized.
+// With groups, the channels are split into independent groups: the filter has shape
+// {OC, C / groups, KH, KW} and output channel oc only sees the input channels of its group.
+// Depthwise convolutions (groups == C == OC) run dedicated kernels instead of the GEMM.
+// Conv1D takes {N, C, L} and {OC, C, K}, it runs as a Conv2D of height one, or with FFTs for
+// long filters (see "math/fft_conv.hpp").
+// ---------------------
+
+// ---------------------
+// Note:
+// The backend picks the algorithm per call with "ConvAlgorithm::Auto", forcing one
+// is meant for testing and benchmarking
+// ---------------------
+
+#ifndef ENGINE_MATH_CONV_HPP
+#define ENGINE_MATH_CONV_HPP
+
+#include "configs.hpp"
+
+#include "math/shape.hpp"
+
+#include "math/activation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mnt {
+
+  enum class ConvAlgorithm : uint8_t
+  {
+    Auto = 0,
+    Direct,   // Plain loops, no packing, best for tiny layers
+    Gemm,     // im2col tiles + packed GEMM, 1x1 convolutions use the input as it is
+    Winograd,  // F(4x4, 3x3), only 3x3 filters with stride 1 and no dilation
+    Depthwise, // Only depthwise convolutions, vectorized over pixels or blocked channels
+    FFT        // Conv1D only, stride 1, overlap-add of blocks multiplied in the frequency domain
+  };
+
+  struct Conv2DParams
+  {
+    size_t stride_h = 1;
+    size_t stride_w = 1;
+    size_t padding_h = 0;
+    size_t padding_w = 0;
+    size_t dilation_h = 1;
+    size_t dilation_w = 1;
+    size_t groups = 1;
+
+    // Forcing an algorithm that can`t run the convolution (shape or tolerance) falls back to Auto
+    ConvAlgorithm algorithm = ConvAlgorithm::Auto;
+
+    // Largest relative error accepted from the fast algorithms, 0 only allows the exact ones
+    float tolerance = 1e-3f;
+
+    // The filter doesn`t change between calls (inference), transformed filters can be cached
+    bool constant_filter = false;
+
+    // Applied after the bias, fused in the direct kernels and a separate pass after the GEMM
+    Activation activation = Activation::None;
+  };
+
+  struct Conv2DGeometry
+  {
+    size_t batch;
+    size_t in_channels;
+    size_t in_height;
+    size_t in_width;
+    size_t out_channels;
+    size_t kernel_h;
+    size_t kernel_w;
+    size_t out_height;
+    size_t out_width;
+
+    Conv2DParams params;
+
+    // Throws if the shapes or the parameters are not valid
+    Conv2DGeometry(const TensorShape& _input_shape,
+                   const TensorShape& _filter_shape,
+                   const Conv2DParams& _params);
+
+    // Channels of a group
+    inline size_t GroupChannels() const noexcept {return in_channels / params.groups;};
+    inline size_t GroupOutChannels() const noexcept {return out_channels / params.groups;};
+
+    // Dimensions of the per image and per group GEMM
+    inline size_t Depth() const noexcept {return GroupChannels() * kernel_h * kernel_w;};
+    inline size_t Pixels() const noexcept {return out_height * out_width;};
+
+    // Number of multiply-adds of the whole convolution
+    inline size_t MACs() const noexcept {return batch * out_channels * Pixels() * Depth();};
+
+    // 1x1 filter, stride 1 and no padding, the input image is already the patch matrix
+    bool IsPointwise() const noexcept;
+
+    // One filter per channel, groups == in_channels == out_channels
+    bool IsDepthwise() const noexcept;
+  };
+
+  struct Conv1DParams
+  {
+    size_t stride = 1;
+    size_t padding = 0;
+    size_t dilation = 1;
+
+    // Same as in Conv2DParams
+    ConvAlgorithm algorithm = ConvAlgorithm::Auto;
+    float tolerance = 1e-3f;
+  };
+
+  struct Conv1DGeometry
+  {
+    size_t batch;
+    size_t in_channels;
+    size_t in_length;
+    size_t out_channels;
+    size_t kernel;
+    size_t out_length;
+
+    Conv1DParams params;
+
+    // Throws if the shapes or the parameters are not valid
+    Conv1DGeometry(const TensorShape& _input_shape,
+                   const TensorShape& _filter_shape,
+                   const Conv1DParams& _params);
+
+    // Span of the dilated filter
+    inline size_t Extent() const noexcept {return (kernel - 1) * params.dilation + 1;};
+
+    inline size_t MACs() const noexcept {return batch * out_channels * out_length * in_channels * kernel;};
+
+    // The same convolution on images of height one
+    Conv2DGeometry AsConv2D() const;
+  };
+
+  // Writes blocks of the patch matrix of an image (of the channels of _group) in the
+  // layout of "KernelTable::gemm_pack_b"
+  class Im2ColPacker
+  {
+  public:
+    Im2ColPacker(const float* _input, const Conv2DGeometry& _geometry, size_t _group = 0) noexcept;
+
+    void operator () (size_t _image, size_t _k_begin, size_t _depth,
+                      size_t _n_begin, size_t _cols, float* _packed) const noexcept;
+
+  private:
+    const float* m_input;
+    const Conv2DGeometry& m_geometry;
+    size_t m_nr;
+  };
+
+  // Reorders a {OC, C, KH, KW} filter for the kernels of the blocked layouts, _packed has
+  // [OC / _block][C / _block][KH][KW][_block input channels][_block output channels] items,
+  // or [C / _block][KH][KW][_block] for depthwise filters,
+  // the channels of the last groups are zero padded
+  void PackBlockedFilter(const float* _filter, const Conv2DGeometry& _geometry, size_t _block,
+                         float* _packed) noexcept;
+
+  // Computes the output plane _plane (= image * out_channels + output channel)
+  template <typename T>
+  void Conv2DDirect(const T* _input, const T* _filter, T* _output,
+                    const Conv2DGeometry& _geometry, size_t _plane) noexcept;
+}
+
+#include "math/conv.inl"
+
+#endif
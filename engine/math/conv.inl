@@ -0,0 +1,278 @@
+// File Name:     conv.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Parameters, geometry and building blocks of convolutions
+
+#ifndef ENGINE_MATH_CONV_INL
+#define ENGINE_MATH_CONV_INL
+
+#include "math/conv.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mnt;
+
+inline Conv2DGeometry::Conv2DGeometry(const TensorShape& _input_shape,
+                                      const TensorShape& _filter_shape,
+                                      const Conv2DParams& _params)
+  : params(_params)
+{
+  if (_input_shape.size() != 4 || _filter_shape.size() != 4)
+    MNT_THROW("Conv2D needs an input of shape {N, C, H, W} and a filter of shape {OC, C, KH, KW}");
+
+  batch = _input_shape[0];
+  in_channels = _input_shape[1];
+  in_height = _input_shape[2];
+  in_width = _input_shape[3];
+  out_channels = _filter_shape[0];
+  kernel_h = _filter_shape[2];
+  kernel_w = _filter_shape[3];
+
+  if (params.groups == 0 || in_channels % params.groups != 0 || out_channels % params.groups != 0)
+    MNT_THROW("Conv2D channels must be divisible by the number of groups");
+
+  if (_filter_shape[1] != in_channels / params.groups)
+    MNT_THROW("Conv2D filter and input have different number of channels");
+
+  if (kernel_h == 0 || kernel_w == 0)
+    MNT_THROW("Conv2D filter is empty");
+
+  if (params.stride_h == 0 || params.stride_w == 0 || params.dilation_h == 0 || params.dilation_w == 0)
+    MNT_THROW("Conv2D strides and dilations must be at least 1");
+
+  const size_t extent_h = (kernel_h - 1) * params.dilation_h + 1;
+  const size_t extent_w = (kernel_w - 1) * params.dilation_w + 1;
+
+  if (extent_h > in_height + 2 * params.padding_h || extent_w > in_width + 2 * params.padding_w)
+    MNT_THROW("Conv2D filter is bigger than the padded input");
+
+  out_height = (in_height + 2 * params.padding_h - extent_h) / params.stride_h + 1;
+  out_width = (in_width + 2 * params.padding_w - extent_w) / params.stride_w + 1;
+};
+
+inline bool Conv2DGeometry::IsPointwise() const noexcept
+{
+  return kernel_h == 1 && kernel_w == 1 &&
+         params.stride_h == 1 && params.stride_w == 1 &&
+         params.padding_h == 0 && params.padding_w == 0;
+};
+
+inline bool Conv2DGeometry::IsDepthwise() const noexcept
+{
+  return params.groups == in_channels && out_channels == in_channels;
+};
+
+inline Conv1DGeometry::Conv1DGeometry(const TensorShape& _input_shape,
+                                      const TensorShape& _filter_shape,
+                                      const Conv1DParams& _params)
+  : params(_params)
+{
+  if (_input_shape.size() != 3 || _filter_shape.size() != 3)
+    MNT_THROW("Conv1D needs an input of shape {N, C, L} and a filter of shape {OC, C, K}");
+
+  batch = _input_shape[0];
+  in_channels = _input_shape[1];
+  in_length = _input_shape[2];
+  out_channels = _filter_shape[0];
+  kernel = _filter_shape[2];
+
+  if (_filter_shape[1] != in_channels)
+    MNT_THROW("Conv1D filter and input have different number of channels");
+
+  if (kernel == 0)
+    MNT_THROW("Conv1D filter is empty");
+
+  if (params.stride == 0 || params.dilation == 0)
+    MNT_THROW("Conv1D stride and dilation must be at least 1");
+
+  if (Extent() > in_length + 2 * params.padding)
+    MNT_THROW("Conv1D filter is longer than the padded input");
+
+  out_length = (in_length + 2 * params.padding - Extent()) / params.stride + 1;
+};
+
+inline Conv2DGeometry Conv1DGeometry::AsConv2D() const
+{
+  Conv2DParams params_2d;
+  params_2d.stride_w = params.stride;
+  params_2d.padding_w = params.padding;
+  params_2d.dilation_w = params.dilation;
+  params_2d.algorithm = params.algorithm;
+  params_2d.tolerance = params.tolerance;
+
+  return Conv2DGeometry({(TSHAPE_TYPE)batch, (TSHAPE_TYPE)in_channels, 1, (TSHAPE_TYPE)in_length},
+                        {(TSHAPE_TYPE)out_channels, (TSHAPE_TYPE)in_channels, 1, (TSHAPE_TYPE)kernel},
+                        params_2d);
+};
+
+inline Im2ColPacker::Im2ColPacker(const float* _input, const Conv2DGeometry& _geometry, size_t _group) noexcept
+  : m_input(_input + _group * _geometry.GroupChannels() * _geometry.in_height * _geometry.in_width),
+    m_geometry(_geometry), m_nr(KernelRegistry::Get().gemm_nr)
+{
+};
+
+// Row k of the patch matrix is (channel, kh, kw), column p is the output pixel (oh, ow),
+// the item is input[channel][oh * stride_h - padding_h + kh * dilation_h][ow * ...], or
+// zero in the padding. Panels of gemm_nr pixels from the same output row read contiguous
+// input with stride 1, they are copied with a single memcpy per row of the panel.
+inline void Im2ColPacker::operator () (size_t _image, size_t _k_begin, size_t _depth,
+                                       size_t _n_begin, size_t _cols, float* _packed) const noexcept
+{
+  const Conv2DGeometry& g = m_geometry;
+  const Conv2DParams& p = g.params;
+  const ptrdiff_t height = (ptrdiff_t)g.in_height;
+  const ptrdiff_t width = (ptrdiff_t)g.in_width;
+  const size_t plane_length = g.in_height * g.in_width;
+  const float* image = m_input + _image * g.in_channels * plane_length;
+
+  // gemm_nr is at most 32 for all instruction sets
+  ptrdiff_t origin_h[64];
+  ptrdiff_t origin_w[64];
+
+  for (size_t panel = 0; panel < _cols; panel += m_nr)
+  {
+    const size_t cols = std::min(m_nr, _cols - panel);
+    float* packed = _packed + panel * _depth;
+
+    for (size_t j = 0; j < cols; j++)
+    {
+      const size_t pixel = _n_begin + panel + j;
+      origin_h[j] = (ptrdiff_t)((pixel / g.out_width) * p.stride_h) - (ptrdiff_t)p.padding_h;
+      origin_w[j] = (ptrdiff_t)((pixel % g.out_width) * p.stride_w) - (ptrdiff_t)p.padding_w;
+    }
+
+    const bool same_row = cols == m_nr && p.stride_w == 1 && origin_h[0] == origin_h[cols - 1];
+
+    // (channel, kh, kw) of the current row, advanced incrementally
+    size_t channel = _k_begin / (g.kernel_h * g.kernel_w);
+    size_t kh = (_k_begin / g.kernel_w) % g.kernel_h;
+    size_t kw = _k_begin % g.kernel_w;
+
+    for (size_t k = 0; k < _depth; k++)
+    {
+      const float* plane = image + channel * plane_length;
+      const ptrdiff_t offset_h = (ptrdiff_t)(kh * p.dilation_h);
+      const ptrdiff_t offset_w = (ptrdiff_t)(kw * p.dilation_w);
+
+      const ptrdiff_t first_h = origin_h[0] + offset_h;
+      const ptrdiff_t first_w = origin_w[0] + offset_w;
+
+      if (same_row && first_h >= 0 && first_h < height && first_w >= 0 && first_w + (ptrdiff_t)m_nr <= width)
+      {
+        memcpy(packed, plane + first_h * width + first_w, m_nr * sizeof(float));
+      }
+      else
+      {
+        for (size_t j = 0; j < m_nr; j++)
+        {
+          const ptrdiff_t h = origin_h[j] + offset_h;
+          const ptrdiff_t w = origin_w[j] + offset_w;
+          packed[j] = (j < cols && h >= 0 && h < height && w >= 0 && w < width) ? plane[h * width + w] : 0.0f;
+        }
+      }
+
+      packed += m_nr;
+
+      if (++kw == g.kernel_w)
+      {
+        kw = 0;
+        if (++kh == g.kernel_h)
+        {
+          kh = 0;
+          channel++;
+        }
+      }
+    }
+  }
+};
+
+inline void mnt::PackBlockedFilter(const float* _filter, const Conv2DGeometry& _geometry, size_t _block,
+                                   float* _packed) noexcept
+{
+  const size_t in_groups = (_geometry.in_channels + _block - 1) / _block;
+  const size_t out_groups = (_geometry.out_channels + _block - 1) / _block;
+  const size_t window = _geometry.kernel_h * _geometry.kernel_w;
+
+  if (_geometry.IsDepthwise())
+  {
+    for (size_t group = 0; group < in_groups; group++)
+      for (size_t k = 0; k < window; k++)
+        for (size_t i = 0; i < _block; i++)
+        {
+          const size_t channel = group * _block + i;
+          *_packed++ = channel < _geometry.in_channels ? _filter[channel * window + k] : 0.0f;
+        }
+    return;
+  }
+
+  for (size_t og = 0; og < out_groups; og++)
+    for (size_t ig = 0; ig < in_groups; ig++)
+      for (size_t k = 0; k < window; k++)
+        for (size_t i = 0; i < _block; i++)
+          for (size_t o = 0; o < _block; o++)
+          {
+            const size_t oc = og * _block + o;
+            const size_t ic = ig * _block + i;
+
+            *_packed++ = (oc < _geometry.out_channels && ic < _geometry.in_channels) ?
+                         _filter[(oc * _geometry.in_channels + ic) * window + k] : 0.0f;
+          }
+};
+
+template <typename T>
+void mnt::Conv2DDirect(const T* _input, const T* _filter, T* _output,
+                       const Conv2DGeometry& _geometry, size_t _plane) noexcept
+{
+  const Conv2DGeometry& g = _geometry;
+  const Conv2DParams& p = g.params;
+  const size_t image = _plane / g.out_channels;
+  const size_t out_channel = _plane % g.out_channels;
+  const size_t group = out_channel / g.GroupOutChannels();
+
+  const T* input = _input + (image * g.in_channels + group * g.GroupChannels()) * g.in_height * g.in_width;
+  const T* filter = _filter + out_channel * g.Depth();
+  T* output = _output + _plane * g.Pixels();
+
+  for (size_t i = 0; i < g.Pixels(); i++)
+    output[i] = T(0);
+
+  for (size_t channel = 0; channel < g.GroupChannels(); channel++)
+  {
+    const T* plane = input + channel * g.in_height * g.in_width;
+
+    for (size_t kh = 0; kh < g.kernel_h; kh++)
+      for (size_t kw = 0; kw < g.kernel_w; kw++)
+      {
+        const T weight = filter[(channel * g.kernel_h + kh) * g.kernel_w + kw];
+        const ptrdiff_t offset_w = (ptrdiff_t)(kw * p.dilation_w) - (ptrdiff_t)p.padding_w;
+
+        // Output columns whose input column falls inside the image
+        size_t ow_begin = 0;
+        if (offset_w < 0)
+          ow_begin = ((size_t)(-offset_w) + p.stride_w - 1) / p.stride_w;
+
+        size_t ow_end = 0;
+        if ((ptrdiff_t)g.in_width > offset_w)
+          ow_end = std::min(g.out_width, ((size_t)((ptrdiff_t)g.in_width - offset_w) + p.stride_w - 1) / p.stride_w);
+
+        for (size_t oh = 0; oh < g.out_height; oh++)
+        {
+          const ptrdiff_t h = (ptrdiff_t)(oh * p.stride_h + kh * p.dilation_h) - (ptrdiff_t)p.padding_h;
+          if (h < 0 || h >= (ptrdiff_t)g.in_height)
+            continue;
+
+          const T* row = plane + h * (ptrdiff_t)g.in_width;
+          T* out = output + oh * g.out_width;
+
+          for (size_t ow = ow_begin; ow < ow_end; ow++)
+            out[ow] += weight * row[(ptrdiff_t)(ow * p.stride_w) + offset_w];
+        }
+      }
+  }
+};
+
+#endif
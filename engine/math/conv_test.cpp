@@ -0,0 +1,252 @@
+// File Name:     conv_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of Conv2D and Conv1D on every algorithm and instruction set
+
+// ---------------------
+// Detail Description:
+// Every geometry runs with each algorithm forced and with Auto, and is compared with a naive
+// loop over the output pixels. Forcing an algorithm that can`t run a geometry falls back to
+// Auto, so every case is valid with every algorithm. Winograd and the FFT are compared with
+// the tolerance of their parameters, the others have to match to rounding.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/test_utils.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  struct Case
+  {
+    const char* name;
+    TensorShape input;
+    TensorShape filter;
+    Conv2DParams params;
+    bool bias;
+  };
+
+  Conv2DParams Params(size_t _stride_h, size_t _stride_w, size_t _padding_h, size_t _padding_w,
+                      size_t _dilation, size_t _groups, Activation _activation = Activation::None)
+  {
+    Conv2DParams params;
+    params.stride_h = _stride_h;
+    params.stride_w = _stride_w;
+    params.padding_h = _padding_h;
+    params.padding_w = _padding_w;
+    params.dilation_h = _dilation;
+    params.dilation_w = _dilation;
+    params.groups = _groups;
+    params.activation = _activation;
+    return params;
+  }
+
+  double Activate(double _x, Activation _activation)
+  {
+    switch (_activation)
+    {
+    case Activation::Relu:    return std::fmax(_x, 0.0);
+    case Activation::Sigmoid: return 1.0 / (1.0 + std::exp(-_x));
+    default:                  return _x;
+    }
+  }
+
+  template <typename T>
+  std::vector<double> NaiveConv2D(const Tensor<T>& _input, const Tensor<T>& _filter, const T* _bias,
+                                  const Conv2DParams& _params)
+  {
+    const TensorShape& in = _input.Shape();
+    const TensorShape& fs = _filter.Shape();
+    const size_t n = in[0], c = in[1], h = in[2], w = in[3];
+    const size_t oc = fs[0], gc = fs[1], kh = fs[2], kw = fs[3];
+    const size_t goc = oc / _params.groups;
+    const size_t oh = (h + 2 * _params.padding_h - (kh - 1) * _params.dilation_h - 1) / _params.stride_h + 1;
+    const size_t ow = (w + 2 * _params.padding_w - (kw - 1) * _params.dilation_w - 1) / _params.stride_w + 1;
+
+    std::vector<double> output(n * oc * oh * ow);
+
+    for (size_t b=0; b<n; b++)
+      for (size_t o=0; o<oc; o++)
+        for (size_t y=0; y<oh; y++)
+          for (size_t x=0; x<ow; x++)
+          {
+            double sum = _bias ? (double)_bias[o] : 0.0;
+
+            for (size_t i=0; i<gc; i++)
+              for (size_t r=0; r<kh; r++)
+                for (size_t s=0; s<kw; s++)
+                {
+                  const long row = (long)(y * _params.stride_h + r * _params.dilation_h) - (long)_params.padding_h;
+                  const long col = (long)(x * _params.stride_w + s * _params.dilation_w) - (long)_params.padding_w;
+                  if (row < 0 || col < 0 || row >= (long)h || col >= (long)w)
+                    continue;
+
+                  const size_t channel = o / goc * gc + i;
+                  sum += (double)_input.Data()[((b * c + channel) * h + row) * w + col] *
+                         (double)_filter.Data()[((o * gc + i) * kh + r) * kw + s];
+                }
+
+            output[((b * oc + o) * oh + y) * ow + x] = Activate(sum, _params.activation);
+          }
+
+    return output;
+  }
+
+  template <typename T>
+  std::vector<double> NaiveConv1D(const Tensor<T>& _input, const Tensor<T>& _filter, const Conv1DParams& _params)
+  {
+    const size_t n = _input.Shape()[0], c = _input.Shape()[1], l = _input.Shape()[2];
+    const size_t oc = _filter.Shape()[0], k = _filter.Shape()[2];
+    const size_t ol = (l + 2 * _params.padding - (k - 1) * _params.dilation - 1) / _params.stride + 1;
+
+    std::vector<double> output(n * oc * ol, 0.0);
+
+    for (size_t b=0; b<n; b++)
+      for (size_t o=0; o<oc; o++)
+        for (size_t x=0; x<ol; x++)
+        {
+          double sum = 0.0;
+          for (size_t i=0; i<c; i++)
+            for (size_t s=0; s<k; s++)
+            {
+              const long position = (long)(x * _params.stride + s * _params.dilation) - (long)_params.padding;
+              if (position >= 0 && position < (long)l)
+                sum += (double)_input.Data()[(b * c + i) * l + position] * (double)_filter.Data()[(o * c + i) * k + s];
+            }
+          output[(b * oc + o) * ol + x] = sum;
+        }
+
+    return output;
+  }
+
+  const ConvAlgorithm algorithms[] = {ConvAlgorithm::Auto, ConvAlgorithm::Direct, ConvAlgorithm::Gemm,
+                                      ConvAlgorithm::Winograd, ConvAlgorithm::Depthwise};
+  const char* algorithm_names[] = {"auto", "direct", "gemm", "winograd", "depthwise"};
+
+  template <typename T>
+  void CheckConv2D(Checks& _checks, const char* _type)
+  {
+    const std::vector<Case> cases = {
+      {"3x3 padded", {2, 3, 11, 13}, {5, 3, 3, 3}, Params(1, 1, 1, 1, 1, 1), false},
+      {"3x3 bias relu", {1, 8, 16, 16}, {16, 8, 3, 3}, Params(1, 1, 1, 1, 1, 1, Activation::Relu), true},
+      {"strided dilated", {2, 4, 15, 17}, {6, 4, 3, 3}, Params(2, 2, 0, 0, 2, 1), false},
+      {"pointwise", {2, 16, 7, 9}, {8, 16, 1, 1}, Params(1, 1, 0, 0, 1, 1), true},
+      {"grouped", {1, 8, 12, 10}, {12, 2, 3, 3}, Params(2, 2, 1, 1, 1, 4), true},
+      {"depthwise", {2, 16, 9, 11}, {16, 1, 3, 3}, Params(1, 1, 1, 1, 1, 16, Activation::Sigmoid), true},
+      {"depthwise strided", {1, 8, 14, 14}, {8, 1, 5, 5}, Params(2, 2, 2, 2, 1, 8), false},
+      {"5x3 asymmetric", {1, 3, 9, 20}, {4, 3, 5, 3}, Params(1, 3, 2, 0, 1, 1), false},
+      {"large", {1, 32, 28, 28}, {64, 32, 3, 3}, Params(1, 1, 1, 1, 1, 1, Activation::Relu), true},
+      {"filter as large as the input", {1, 2, 5, 5}, {3, 2, 5, 5}, Params(1, 1, 0, 0, 1, 1), false},
+    };
+
+    DefaultBackend<T> backend;
+
+    for (const Case& test : cases)
+    {
+      Tensor<T> input(test.input);
+      Tensor<T> filter(test.filter);
+      Tensor<T> bias({test.filter[0]});
+      Fill(input, 1);
+      Fill(filter, 2);
+      Fill(bias, 3);
+
+      const std::vector<double> expected = NaiveConv2D(input, filter, test.bias ? bias.Data() : nullptr, test.params);
+
+      for (size_t a=0; a<sizeof(algorithms) / sizeof(algorithms[0]); a++)
+      {
+        Conv2DParams params = test.params;
+        params.algorithm = algorithms[a];
+
+        Tensor<T> result = test.bias ? backend.Conv2D(input, filter, bias, params) : backend.Conv2D(input, filter, params);
+
+        const double tolerance = algorithms[a] == ConvAlgorithm::Winograd || algorithms[a] == ConvAlgorithm::Auto ?
+                                 2.0 * params.tolerance : 1e-4;
+        _checks.Items(result, expected, tolerance,
+                std::string(_type) + " Conv2D " + test.name + " " + algorithm_names[a]);
+      }
+    }
+
+    Tensor<T> input({1, 4, 8, 8});
+    Tensor<T> wrong_channels({2, 3, 3, 3});
+    Tensor<T> too_large({2, 4, 11, 3});
+    Fill(input, 1);
+
+    _checks.Throws([&]() {backend.Conv2D(input, wrong_channels);}, "Conv2D with other channels");
+    _checks.Throws([&]() {backend.Conv2D(input, too_large);}, "Conv2D with a filter larger than the input");
+    _checks.Throws([&]() {backend.Conv2D(input, wrong_channels, Params(1, 1, 0, 0, 1, 3));},
+                   "Conv2D with groups that don`t divide the channels");
+    _checks.Throws([&]() {backend.Conv2D(input, wrong_channels, Params(0, 1, 0, 0, 1, 1));}, "Conv2D with stride 0");
+  }
+
+  template <typename T>
+  void CheckConv1D(Checks& _checks, const char* _type)
+  {
+    struct Case1D
+    {
+      const char* name;
+      TensorShape input;
+      TensorShape filter;
+      size_t stride;
+      size_t padding;
+      size_t dilation;
+    };
+
+    const std::vector<Case1D> cases = {
+      {"short", {2, 3, 50}, {4, 3, 3}, 1, 1, 1},
+      {"strided dilated", {1, 4, 64}, {5, 4, 4}, 2, 3, 2},
+      {"long filter", {2, 4, 1500}, {3, 4, 129}, 1, 64, 1},
+    };
+
+    const ConvAlgorithm algorithms_1d[] = {ConvAlgorithm::Auto, ConvAlgorithm::Direct, ConvAlgorithm::Gemm,
+                                           ConvAlgorithm::FFT};
+    const char* names_1d[] = {"auto", "direct", "gemm", "fft"};
+
+    DefaultBackend<T> backend;
+
+    for (const Case1D& test : cases)
+    {
+      Tensor<T> input(test.input);
+      Tensor<T> filter(test.filter);
+      Fill(input, 4);
+      Fill(filter, 5);
+
+      Conv1DParams params;
+      params.stride = test.stride;
+      params.padding = test.padding;
+      params.dilation = test.dilation;
+
+      const std::vector<double> expected = NaiveConv1D(input, filter, params);
+
+      for (size_t a=0; a<4; a++)
+      {
+        params.algorithm = algorithms_1d[a];
+        Tensor<T> result = backend.Conv1D(input, filter, params);
+
+        const double tolerance = algorithms_1d[a] == ConvAlgorithm::FFT || algorithms_1d[a] == ConvAlgorithm::Auto ?
+                                 2.0 * params.tolerance : 1e-4;
+        _checks.Items(result, expected, tolerance, std::string(_type) + " Conv1D " + test.name + " " + names_1d[a]);
+      }
+    }
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckConv2D<float>(checks, "float");
+    CheckConv2D<double>(checks, "double");
+    CheckConv1D<float>(checks, "float");
+    CheckConv1D<double>(checks, "double");
+
+    return checks.Failures();
+  });
+}
@@ -0,0 +1,97 @@
+// File Name:     einsum.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Subscripts and contraction order of Einsum
+
+// ---------------------
+// Detail Description:
+// "Einsum" of "math/backend.hpp" computes a sum of products given by subscripts, e.g.
+// "bhqd,bhkd->bhqk" for the scores of attention, one letter per axis and "->" before the
+// axes of the output. Without "->" the output has the letters that appear once, in
+// alphabetical order. "..." stands for the leading axes of every input, aligned from the
+// right, an axis of size 1 there is broadcast against the others. A letter repeated in one
+// input takes the diagonal, a letter missing from the output is summed over.
+//
+// The inputs are contracted two at a time. EinsumPath picks the order: the number of
+// multiply-adds of a pair is the product of the extents of all its letters, and a pair keeps
+// the letters that the output or the other inputs still need. Up to MNT_EINSUM_OPTIMAL_OPERANDS
+// inputs every order is searched by dynamic programming over the subsets of inputs for the
+// fewest multiply-adds, ties go to the smaller largest intermediate. Beyond that the greedy
+// search contracts the pair that shrinks the intermediates the most, then the cheapest one.
+// Letters of a single input that nothing else needs are summed before any contraction.
+// ---------------------
+
+// ---------------------
+// Note:
+// A letter is a char, the axes of "..." get the chars from 0x80 on and the broadcast axes of
+// size 1 get '\0', they are dropped from their input
+// ---------------------
+
+// =====
+// [EinsumSpec(_spec, _shapes)]: Parses _spec for inputs of _shapes, throws on a syntax error,
+// on a number of axes that doesn`t match and on letters of different extents
+// =====
+
+// =====
+// [Kept(_input)]: The letters of _input, once each and in order, that the output or another
+// input has, the others are summed before the contractions
+// =====
+
+// =====
+// [EinsumPath(_spec, _strategy)]: Pairs of positions in the list of operands, the inputs first,
+// the result of a pair is removed from the list and appended to its end. Empty for one input
+// =====
+
+#ifndef ENGINE_MATH_EINSUM_HPP
+#define ENGINE_MATH_EINSUM_HPP
+
+#include "configs.hpp"
+
+#include "math/shape.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mnt {
+
+  enum class EinsumStrategy : uint8_t
+  {
+    Auto = 0,  // Optimal up to MNT_EINSUM_OPTIMAL_OPERANDS inputs, greedy beyond
+    Greedy,
+    Optimal
+  };
+
+  struct EinsumSpec
+  {
+    // Letters of every axis of every input, and of the output
+    std::vector<std::string> inputs;
+    std::string output;
+
+    // Extent of every letter
+    std::vector<size_t> extents = std::vector<size_t>(256, 0);
+
+    EinsumSpec(const std::string& _spec, const std::vector<TensorShape>& _shapes);
+
+    inline size_t Extent(char _label) const noexcept {return extents[(unsigned char)_label];};
+
+    std::string Kept(size_t _input) const;
+  };
+
+  struct EinsumContraction
+  {
+    size_t first;
+    size_t second;
+
+    // Letters of the result, sorted, and multiply-adds of the product
+    std::string labels;
+    double flops;
+  };
+
+  std::vector<EinsumContraction> EinsumPath(const EinsumSpec& _spec, EinsumStrategy _strategy = EinsumStrategy::Auto);
+}
+
+#include "math/einsum.inl"
+
+#endif
@@ -0,0 +1,388 @@
+// File Name:     einsum.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Subscripts and contraction order of Einsum
+
+#ifndef ENGINE_MATH_EINSUM_INL
+#define ENGINE_MATH_EINSUM_INL
+
+#include "math/einsum.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <functional>
+#include <string>
+
+using namespace mnt;
+
+namespace mnt { namespace einsum_detail {
+
+  using Labels = std::bitset<256>;
+
+  // The chars of the axes of "..."
+  constexpr size_t ellipsis_first = 0x80;
+  constexpr size_t ellipsis_max = 0x80;
+
+  // Searching every order of more inputs takes too long
+  constexpr size_t optimal_max = 16;
+
+  inline Labels ToLabels(const std::string& _labels) noexcept
+  {
+    Labels labels;
+    for (char label : _labels)
+      labels.set((unsigned char)label);
+    return labels;
+  };
+
+  inline std::string ToString(const Labels& _labels)
+  {
+    std::string labels;
+    for (size_t l=1; l<256; l++)
+      if (_labels[l])
+        labels.push_back((char)l);
+    return labels;
+  };
+
+  // Product of the extents, in double so it doesn`t overflow
+  inline double Size(const Labels& _labels, const EinsumSpec& _spec) noexcept
+  {
+    double size = 1.0;
+    for (size_t l=1; l<256; l++)
+      if (_labels[l])
+        size *= (double)_spec.extents[l];
+    return size;
+  };
+
+  // Letters of a term and the position of "..." among them, npos without one
+  inline void ParseTerm(const std::string& _term, const std::string& _spec, std::string& _letters, size_t& _ellipsis)
+  {
+    _letters.clear();
+    _ellipsis = std::string::npos;
+
+    for (size_t i=0; i<_term.size();)
+    {
+      if (_term.compare(i, 3, "...") == 0)
+      {
+        if (_ellipsis != std::string::npos)
+          MNT_THROW(("Einsum subscripts \"" + _spec + "\" have two \"...\" in one term").c_str());
+
+        _ellipsis = _letters.size();
+        i += 3;
+        continue;
+      }
+
+      if (!std::isalpha((unsigned char)_term[i]))
+        MNT_THROW(("Einsum subscripts \"" + _spec + "\" have an invalid character '" + _term[i] + "'").c_str());
+
+      _letters.push_back(_term[i++]);
+    }
+  };
+
+  // The letters that the output or the operands other than _first and _second need
+  inline Labels Needed(const std::vector<Labels>& _operands, const Labels& _output, size_t _first, size_t _second)
+  {
+    Labels needed = _output;
+    for (size_t k=0; k<_operands.size(); k++)
+      if (k != _first && k != _second)
+        needed |= _operands[k];
+    return needed;
+  };
+
+  // Contracts the pair that shrinks the intermediates the most, then the cheapest one
+  inline std::vector<EinsumContraction> Greedy(const EinsumSpec& _spec, std::vector<Labels> _operands,
+                                               const Labels& _output)
+  {
+    std::vector<EinsumContraction> path;
+
+    while (_operands.size() > 1)
+    {
+      EinsumContraction best = {0, 1, "", 0.0};
+      Labels best_result;
+      double best_score = 0.0;
+      bool found = false;
+
+      for (size_t i=0; i<_operands.size(); i++)
+      {
+        for (size_t j=i + 1; j<_operands.size(); j++)
+        {
+          const Labels both = _operands[i] | _operands[j];
+          const Labels result = both & Needed(_operands, _output, i, j);
+          const double flops = Size(both, _spec);
+          const double score = Size(result, _spec) - Size(_operands[i], _spec) - Size(_operands[j], _spec);
+
+          if (!found || score < best_score || (score == best_score && flops < best.flops))
+          {
+            best = {i, j, "", flops};
+            best_score = score;
+            best_result = result;
+            found = true;
+          }
+        }
+      }
+
+      best.labels = ToString(best_result);
+      path.push_back(best);
+
+      _operands.erase(_operands.begin() + best.second);
+      _operands.erase(_operands.begin() + best.first);
+      _operands.push_back(best_result);
+    }
+
+    return path;
+  };
+
+  // Dynamic programming over the subsets of the inputs, the cheapest split of every subset
+  inline std::vector<EinsumContraction> Optimal(const EinsumSpec& _spec, const std::vector<Labels>& _inputs,
+                                                const Labels& _output)
+  {
+    const size_t count = _inputs.size();
+    const size_t full = ((size_t)1 << count) - 1;
+
+    std::vector<Labels> labels(full + 1);
+    for (size_t s=1; s<=full; s++)
+    {
+      size_t lowest = 0;
+      while (!((s >> lowest) & 1))
+        lowest++;
+      labels[s] = labels[s & (s - 1)] | _inputs[lowest];
+    }
+
+    // Letters of the result of a subset, the ones that the output or the other inputs need
+    std::vector<Labels> results(full + 1);
+    for (size_t s=1; s<=full; s++)
+      results[s] = labels[s] & (_output | labels[full ^ s]);
+
+    std::vector<double> flops(full + 1, 0.0);
+    std::vector<double> peaks(full + 1, 0.0);
+    std::vector<size_t> splits(full + 1, 0);
+
+    for (size_t s=1; s<=full; s++)
+    {
+      const size_t low = s & (~s + 1);
+      if (s == low)
+        continue;
+
+      const double size = Size(results[s], _spec);
+      bool found = false;
+
+      // Every split once, the first part has the lowest input
+      for (size_t first = (s - 1) & s; first > 0; first = (first - 1) & s)
+      {
+        if (!(first & low))
+          continue;
+
+        const size_t second = s ^ first;
+        const double cost = flops[first] + flops[second] + Size(results[first] | results[second], _spec);
+        const double peak = std::max({peaks[first], peaks[second], size});
+
+        if (!found || cost < flops[s] || (cost == flops[s] && peak < peaks[s]))
+        {
+          flops[s] = cost;
+          peaks[s] = peak;
+          splits[s] = first;
+          found = true;
+        }
+      }
+    }
+
+    // The splits in post-order, the operands of the list are subsets
+    std::vector<size_t> operands;
+    for (size_t i=0; i<count; i++)
+      operands.push_back((size_t)1 << i);
+
+    std::vector<EinsumContraction> path;
+    std::function<void(size_t)> emit = [&](size_t _subset)
+    {
+      if ((_subset & (_subset - 1)) == 0)
+        return;
+
+      const size_t first = splits[_subset];
+      const size_t second = _subset ^ first;
+      emit(first);
+      emit(second);
+
+      const size_t position_1 = std::find(operands.begin(), operands.end(), first) - operands.begin();
+      const size_t position_2 = std::find(operands.begin(), operands.end(), second) - operands.begin();
+
+      path.push_back({std::min(position_1, position_2), std::max(position_1, position_2),
+                      ToString(results[_subset]), Size(results[first] | results[second], _spec)});
+
+      operands.erase(operands.begin() + std::max(position_1, position_2));
+      operands.erase(operands.begin() + std::min(position_1, position_2));
+      operands.push_back(_subset);
+    };
+    emit(full);
+
+    return path;
+  };
+}}
+
+inline EinsumSpec::EinsumSpec(const std::string& _spec, const std::vector<TensorShape>& _shapes)
+{
+  std::string spec;
+  for (char c : _spec)
+    if (!std::isspace((unsigned char)c))
+      spec.push_back(c);
+
+  const size_t arrow = spec.find("->");
+  const std::string left = spec.substr(0, arrow);
+
+  std::vector<std::string> terms(1);
+  for (char c : left)
+    if (c == ',')
+      terms.emplace_back();
+    else
+      terms.back().push_back(c);
+
+  if (terms.size() != _shapes.size())
+    MNT_THROW(("Einsum subscripts \"" + _spec + "\" have " + std::to_string(terms.size()) + " inputs, " +
+               std::to_string(_shapes.size()) + " tensors are given").c_str());
+
+  std::vector<std::string> letters(terms.size());
+  std::vector<size_t> ellipses(terms.size());
+  size_t ellipsis_rank = 0;
+
+  for (size_t i=0; i<terms.size(); i++)
+  {
+    einsum_detail::ParseTerm(terms[i], _spec, letters[i], ellipses[i]);
+
+    const size_t rank = _shapes[i].size();
+    if (rank < letters[i].size() || (ellipses[i] == std::string::npos && rank != letters[i].size()))
+      MNT_THROW(("Einsum subscripts \"" + terms[i] + "\" don`t match a tensor of rank " + std::to_string(rank)).c_str());
+
+    if (ellipses[i] != std::string::npos)
+      ellipsis_rank = std::max(ellipsis_rank, rank - letters[i].size());
+  }
+
+  if (ellipsis_rank > einsum_detail::ellipsis_max)
+    MNT_THROW("Einsum supports up to 128 axes for \"...\"");
+
+  // Axes of "..." aligned from the right, their extent is the largest one
+  std::vector<bool> seen(256, false);
+
+  for (size_t i=0; i<terms.size(); i++)
+  {
+    const size_t axes = _shapes[i].size() - letters[i].size();
+    std::string& labels = inputs.emplace_back();
+
+    for (size_t a=0; a<letters[i].size() + (ellipses[i] == std::string::npos ? 0 : 1); a++)
+    {
+      if (a == ellipses[i])
+        for (size_t d=0; d<axes; d++)
+          labels.push_back((char)(einsum_detail::ellipsis_first + ellipsis_rank - axes + d));
+
+      if (a < letters[i].size())
+        labels.push_back(letters[i][a]);
+    }
+
+    for (size_t a=0; a<labels.size(); a++)
+    {
+      const unsigned char label = (unsigned char)labels[a];
+      const size_t extent = _shapes[i][a];
+      const bool broadcast = label >= einsum_detail::ellipsis_first;
+
+      if (!seen[label] || (broadcast && extents[label] == 1))
+        extents[label] = extent;
+      else if (extent != extents[label] && !(broadcast && extent == 1))
+        MNT_THROW(("Einsum subscript '" + (broadcast ? std::string("...") : std::string(1, labels[a])) +
+                   "' has extents " + std::to_string(extents[label]) + " and " + std::to_string(extent)).c_str());
+
+      seen[label] = true;
+    }
+  }
+
+  // Broadcast axes of size 1 are dropped
+  for (size_t i=0; i<terms.size(); i++)
+    for (size_t a=0; a<inputs[i].size(); a++)
+    {
+      const unsigned char label = (unsigned char)inputs[i][a];
+      if (label >= einsum_detail::ellipsis_first && _shapes[i][a] == 1 && extents[label] != 1)
+        inputs[i][a] = '\0';
+    }
+
+  if (arrow != std::string::npos)
+  {
+    std::string term_letters;
+    size_t ellipsis;
+    einsum_detail::ParseTerm(spec.substr(arrow + 2), _spec, term_letters, ellipsis);
+
+    for (size_t a=0; a<=term_letters.size(); a++)
+    {
+      if (a == ellipsis)
+        for (size_t d=0; d<ellipsis_rank; d++)
+          output.push_back((char)(einsum_detail::ellipsis_first + d));
+
+      if (a < term_letters.size())
+      {
+        const char label = term_letters[a];
+
+        if (!seen[(unsigned char)label])
+          MNT_THROW(("Einsum output subscript '" + std::string(1, label) + "' is not in the inputs").c_str());
+        if (output.find(label) != std::string::npos)
+          MNT_THROW(("Einsum output subscript '" + std::string(1, label) + "' is repeated").c_str());
+
+        output.push_back(label);
+      }
+    }
+  }
+  else
+  {
+    // The axes of "...", then the letters that appear once in alphabetical order
+    for (size_t d=0; d<ellipsis_rank; d++)
+      output.push_back((char)(einsum_detail::ellipsis_first + d));
+
+    std::vector<size_t> counts(256, 0);
+    for (const std::string& term : letters)
+      for (char label : term)
+        counts[(unsigned char)label]++;
+
+    for (size_t l='A'; l<='z'; l++)
+      if (counts[l] == 1)
+        output.push_back((char)l);
+  }
+};
+
+inline std::string EinsumSpec::Kept(size_t _input) const
+{
+  std::string kept;
+
+  for (char label : inputs[_input])
+  {
+    if (label == '\0' || kept.find(label) != std::string::npos)
+      continue;
+
+    bool needed = output.find(label) != std::string::npos;
+    for (size_t i=0; i<inputs.size() && !needed; i++)
+      needed = i != _input && inputs[i].find(label) != std::string::npos;
+
+    if (needed)
+      kept.push_back(label);
+  }
+
+  return kept;
+};
+
+inline std::vector<EinsumContraction> mnt::EinsumPath(const EinsumSpec& _spec, EinsumStrategy _strategy)
+{
+  if (_spec.inputs.size() < 2)
+    return {};
+
+  std::vector<einsum_detail::Labels> inputs;
+  for (size_t i=0; i<_spec.inputs.size(); i++)
+    inputs.push_back(einsum_detail::ToLabels(_spec.Kept(i)));
+
+  const einsum_detail::Labels output = einsum_detail::ToLabels(_spec.output);
+
+  const bool optimal = _strategy == EinsumStrategy::Optimal ||
+                       (_strategy == EinsumStrategy::Auto && inputs.size() <= MNT_EINSUM_OPTIMAL_OPERANDS);
+
+  if (optimal && inputs.size() > einsum_detail::optimal_max)
+    MNT_THROW(("The optimal Einsum path of " + std::to_string(inputs.size()) + " inputs takes too long, the greedy one doesn`t").c_str());
+
+  return optimal ? einsum_detail::Optimal(_spec, inputs, output) : einsum_detail::Greedy(_spec, inputs, output);
+};
+
+#endif
@@ -0,0 +1,346 @@
+// File Name:     einsum_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of Einsum and its contraction paths on every instruction set
+
+// ---------------------
+// Detail Description:
+// Every spec is compared with a naive loop over all the combinations of its letters, given
+// the spec with "..." and the implicit output written out, so the reference doesn`t share
+// the parser. Axes of size 1 of the reference are broadcast against the others.
+// The paths are replayed: every pair has to exist, keep the letters that are still needed
+// and cost the product of the extents of its letters. The optimal path has to cost as little
+// as an exhaustive search of all the orders, and no more than the greedy one.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/einsum.hpp"
+#include "math/test_utils.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  // _spec is explicit, letters only and "->", every letter is an axis, the tensors are read
+  // through their strides
+  template <typename T>
+  std::vector<double> NaiveEinsum(const std::string& _spec, const std::vector<Tensor<T>*>& _tensors, TensorShape& _shape)
+  {
+    const size_t arrow = _spec.find("->");
+    const std::string output = _spec.substr(arrow + 2);
+
+    std::vector<std::string> inputs(1);
+    for (char c : _spec.substr(0, arrow))
+      if (c == ',')
+        inputs.emplace_back();
+      else
+        inputs.back().push_back(c);
+
+    std::string letters;
+    std::vector<size_t> extents(256, 1);
+    for (size_t t=0; t<inputs.size(); t++)
+      for (size_t a=0; a<inputs[t].size(); a++)
+      {
+        const char label = inputs[t][a];
+        if (letters.find(label) == std::string::npos)
+          letters.push_back(label);
+        extents[(unsigned char)label] = std::max(extents[(unsigned char)label], (size_t)_tensors[t]->Shape()[a]);
+      }
+
+    // A full contraction has shape {1}
+    _shape = TensorShape(std::max(output.size(), (size_t)1), 1);
+    size_t length = 1;
+    for (size_t a=0; a<output.size(); a++)
+    {
+      _shape[a] = (TSHAPE_TYPE)extents[(unsigned char)output[a]];
+      length *= _shape[a];
+    }
+
+    std::vector<double> result(length, 0.0);
+    std::vector<size_t> index(256, 0);
+
+    while (true)
+    {
+      double product = 1.0;
+      for (size_t t=0; t<inputs.size(); t++)
+      {
+        const TensorShape& shape = _tensors[t]->Shape();
+        const TensorStrides strides = _tensors[t]->Strides();
+        size_t offset = 0;
+        for (size_t a=0; a<inputs[t].size(); a++)
+          offset += (shape[a] == 1 ? 0 : index[(unsigned char)inputs[t][a]]) * strides[a];
+        product *= (double)_tensors[t]->Data()[offset];
+      }
+
+      size_t offset = 0;
+      for (size_t a=0; a<output.size(); a++)
+        offset = offset * _shape[a] + index[(unsigned char)output[a]];
+      result[offset] += product;
+
+      // The next combination of the letters, the last one changes fastest
+      size_t l = letters.size();
+      while (l > 0 && ++index[(unsigned char)letters[l - 1]] == extents[(unsigned char)letters[l - 1]])
+        index[(unsigned char)letters[--l]] = 0;
+
+      if (l == 0)
+        break;
+    }
+
+    return result;
+  }
+
+  struct Case
+  {
+    const char* spec;
+    // The spec with "..." and the output written out, the same as spec if empty
+    const char* explicit_spec;
+    std::vector<TensorShape> shapes;
+  };
+
+  template <typename T>
+  void CheckEinsum(Checks& _checks, const std::string& _type)
+  {
+    const std::vector<Case> cases = {
+      {"ij,jk->ik", "", {{13, 17}, {17, 11}}},
+      {"bhqd,bhkd->bhqk", "", {{2, 3, 7, 8}, {2, 3, 9, 8}}},
+      {"bhqk,bhkd->bqhd", "", {{2, 3, 7, 9}, {2, 3, 9, 8}}},
+      {"bij,bjk->bik", "", {{4, 5, 6}, {4, 6, 3}}},
+      {"ij,jk,kl->il", "", {{5, 30}, {30, 2}, {2, 40}}},
+      {"ab,bc,cd,de,ef->af", "", {{3, 8}, {8, 2}, {2, 9}, {9, 4}, {4, 6}}},
+      {"ii->i", "", {{6, 6}}},
+      {"ii->", "", {{6, 6}}},
+      {"iji->j", "", {{4, 5, 4}}},
+      {"ij->ji", "", {{7, 9}}},
+      {"ijk->kj", "", {{3, 4, 5}}},
+      {"ij->", "", {{7, 9}}},
+      {"ij,ij->", "", {{8, 12}, {8, 12}}},
+      {"i,i->", "", {{300}, {300}}},
+      {"i,j->ij", "", {{5}, {7}}},
+      {"i,i,i->i", "", {{33}, {33}, {33}}},
+      {"ij,k->i", "", {{4, 6}, {5}}},
+      {"ij,jk", "ij,jk->ik", {{6, 4}, {4, 3}}},
+      {"ba", "ba->ab", {{3, 4}}},
+      {"ij,ij", "ij,ij->", {{4, 4}, {4, 4}}},
+      {"...ij,...jk->...ik", "abij,bjk->abik", {{2, 1, 4, 5}, {3, 5, 6}}},
+      {"...ij,jk", "abij,jk->abik", {{2, 3, 4, 5}, {5, 6}}},
+      {"i...,i...->...", "iab,iab->ab", {{5, 2, 3}, {5, 1, 3}}},
+      {"b i j , b j k -> b i k", "bij,bjk->bik", {{2, 3, 4}, {2, 4, 5}}},
+    };
+
+    DefaultBackend<T> backend;
+    uint32_t seed = 1;
+
+    for (const Case& test : cases)
+    {
+      std::vector<Tensor<T>> tensors;
+      std::vector<Tensor<T>*> pointers;
+      for (const TensorShape& shape : test.shapes)
+      {
+        tensors.emplace_back(shape);
+        Fill(tensors.back(), seed++);
+      }
+      for (Tensor<T>& tensor : tensors)
+        pointers.push_back(&tensor);
+
+      const std::string spec = test.explicit_spec[0] ? test.explicit_spec : test.spec;
+
+      TensorShape shape;
+      const std::vector<double> expected = NaiveEinsum(spec, pointers, shape);
+      Tensor<T> result = backend.Einsum(test.spec, pointers);
+
+      const std::string what = _type + " Einsum \"" + test.spec + "\"";
+      _checks.Expect(result.Shape() == shape, what + " has the shape " + result.ShapeStr());
+      _checks.Items(result, expected, 1e-5, what);
+    }
+
+    // The variadic overload and an operand that is a view
+    Tensor<T> queries({2, 5, 4});
+    Tensor<T> keys({2, 4, 6});
+    Fill(queries, 100);
+    Fill(keys, 101);
+    Tensor<T> transposed = keys.Shapeshift({0, 2, 1});
+
+    TensorShape shape;
+    std::vector<Tensor<T>*> operands = {&queries, &transposed};
+    const std::vector<double> expected = NaiveEinsum("bqd,bkd->bqk", operands, shape);
+    _checks.Items(backend.Einsum("bqd,bkd->bqk", queries, transposed), expected, 1e-5, _type + " Einsum of a view");
+
+    Tensor<T> matrix({4, 5});
+    Tensor<T> other({6, 3});
+    Tensor<T> cube({4, 5, 6});
+    Tensor<T> wide({3, 5});
+
+    const std::vector<std::pair<const char*, std::vector<Tensor<T>*>>> invalid = {
+      {"ij,jk->ik", {&matrix}},
+      {"ij->ij", {&matrix, &matrix}},
+      {"ij,jk->ik", {&matrix, &other}},
+      {"ijk->ik", {&matrix}},
+      {"i->i", {&matrix}},
+      {"ij->iz", {&matrix}},
+      {"ij->ii", {&matrix}},
+      {"i1->i", {&matrix}},
+      {"i.j->ij", {&matrix}},
+      {"......->", {&matrix}},
+      {"ij-ji", {&matrix}},
+      {"...j,...j->...", {&matrix, &wide}},
+      {"ijk,jk->i", {&cube, &matrix}},
+    };
+
+    for (const auto& spec : invalid)
+      _checks.Throws([&]() {backend.Einsum(spec.first, spec.second);}, _type + " Einsum \"" + spec.first + "\"");
+  }
+
+  // Replays _path and returns its multiply-adds, or -1 if it isn`t a valid path of _spec
+  double Replay(const EinsumSpec& _spec, const std::vector<EinsumContraction>& _path)
+  {
+    std::vector<std::string> operands;
+    for (size_t i=0; i<_spec.inputs.size(); i++)
+      operands.push_back(_spec.Kept(i));
+
+    if (_path.size() + 1 != operands.size())
+      return -1.0;
+
+    double flops = 0.0;
+
+    for (const EinsumContraction& pair : _path)
+    {
+      if (pair.first == pair.second || pair.first >= operands.size() || pair.second >= operands.size())
+        return -1.0;
+
+      std::string letters = operands[pair.first] + operands[pair.second];
+      std::sort(letters.begin(), letters.end());
+      letters.erase(std::unique(letters.begin(), letters.end()), letters.end());
+
+      std::string needed = _spec.output;
+      for (size_t i=0; i<operands.size(); i++)
+        if (i != pair.first && i != pair.second)
+          needed += operands[i];
+
+      std::string kept;
+      double cost = 1.0;
+      for (char label : letters)
+      {
+        cost *= (double)_spec.Extent(label);
+        if (needed.find(label) != std::string::npos)
+          kept.push_back(label);
+      }
+
+      if (kept != pair.labels || cost != pair.flops)
+        return -1.0;
+
+      flops += cost;
+      operands.erase(operands.begin() + std::max(pair.first, pair.second));
+      operands.erase(operands.begin() + std::min(pair.first, pair.second));
+      operands.push_back(kept);
+    }
+
+    return flops;
+  }
+
+  // The fewest multiply-adds of any order, by trying all of them
+  double Cheapest(const EinsumSpec& _spec, const std::vector<std::string>& _operands)
+  {
+    if (_operands.size() < 2)
+      return 0.0;
+
+    double best = std::numeric_limits<double>::infinity();
+
+    for (size_t i=0; i<_operands.size(); i++)
+      for (size_t j=i + 1; j<_operands.size(); j++)
+      {
+        std::string needed = _spec.output;
+        std::vector<std::string> rest;
+        for (size_t k=0; k<_operands.size(); k++)
+          if (k != i && k != j)
+          {
+            needed += _operands[k];
+            rest.push_back(_operands[k]);
+          }
+
+        std::string letters = _operands[i] + _operands[j];
+        std::sort(letters.begin(), letters.end());
+        letters.erase(std::unique(letters.begin(), letters.end()), letters.end());
+
+        std::string kept;
+        double cost = 1.0;
+        for (char label : letters)
+        {
+          cost *= (double)_spec.Extent(label);
+          if (needed.find(label) != std::string::npos)
+            kept.push_back(label);
+        }
+
+        rest.push_back(kept);
+        best = std::min(best, cost + Cheapest(_spec, rest));
+      }
+
+    return best;
+  }
+
+  void CheckPaths(Checks& _checks)
+  {
+    const std::vector<std::pair<std::string, std::vector<TensorShape>>> cases = {
+      {"ij,jk,kl->il", {{5, 30}, {30, 2}, {2, 40}}},
+      {"ij,jk,kl->il", {{40, 2}, {2, 30}, {30, 5}}},
+      {"ab,bc,cd,de,ef->af", {{3, 8}, {8, 2}, {2, 9}, {9, 4}, {4, 60}}},
+      {"ab,bc,cd,de,ef,fg->ag", {{10, 2}, {2, 50}, {50, 3}, {3, 40}, {40, 1}, {1, 20}}},
+      {"abc,cd,be,ef,df->a", {{4, 5, 6}, {6, 7}, {5, 8}, {8, 3}, {7, 3}}},
+      {"ij,jk,ki,il->l", {{6, 7}, {7, 8}, {8, 6}, {6, 9}}},
+      {"ab,ac,ad,ae->", {{20, 2}, {20, 3}, {20, 4}, {20, 5}}},
+      {"bhqd,bhkd,bhkv->bhqv", {{2, 4, 64, 16}, {2, 4, 64, 16}, {2, 4, 64, 16}}},
+    };
+
+    for (const auto& test : cases)
+    {
+      const EinsumSpec spec(test.first, test.second);
+
+      std::vector<std::string> operands;
+      for (size_t i=0; i<spec.inputs.size(); i++)
+        operands.push_back(spec.Kept(i));
+
+      const double optimal = Replay(spec, EinsumPath(spec, EinsumStrategy::Optimal));
+      const double greedy = Replay(spec, EinsumPath(spec, EinsumStrategy::Greedy));
+      const double cheapest = Cheapest(spec, operands);
+
+      _checks.Expect(optimal >= 0.0, "the optimal path of \"" + test.first + "\" isn`t valid");
+      _checks.Expect(greedy >= 0.0, "the greedy path of \"" + test.first + "\" isn`t valid");
+      _checks.Expect(optimal == cheapest, "the optimal path of \"" + test.first + "\" costs " + std::to_string(optimal) +
+                                          " instead of " + std::to_string(cheapest));
+      _checks.Expect(optimal <= greedy, "the optimal path of \"" + test.first + "\" costs more than the greedy one");
+    }
+
+    // A long chain beyond MNT_EINSUM_OPTIMAL_OPERANDS takes the greedy path
+    std::string chain;
+    std::vector<TensorShape> shapes;
+    for (size_t i=0; i<MNT_EINSUM_OPTIMAL_OPERANDS + 2; i++)
+    {
+      chain += std::string(chain.empty() ? "" : ",") + (char)('a' + i) + (char)('a' + i + 1);
+      shapes.push_back({(TSHAPE_TYPE)(2 + i % 3), (TSHAPE_TYPE)(2 + (i + 1) % 3)});
+    }
+    chain += std::string("->a") + (char)('a' + MNT_EINSUM_OPTIMAL_OPERANDS + 2);
+
+    const EinsumSpec long_spec(chain, shapes);
+    _checks.Expect(Replay(long_spec, EinsumPath(long_spec)) >= 0.0, "the path of \"" + chain + "\" isn`t valid");
+    _checks.Expect(EinsumPath(EinsumSpec("ij->ji", {{3, 4}})).empty(), "the path of one input isn`t empty");
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckEinsum<float>(checks, "float");
+    CheckEinsum<double>(checks, "double");
+    CheckPaths(checks);
+
+    return checks.Failures();
+  });
+}
@@ -0,0 +1,83 @@
+// File Name:     fft.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Batched real FFT, mixed radix Stockham
+
+// ---------------------
+// Detail Description:
+// A real signal of N items is transformed as N/2 complex values z[k] = x[2k] + i x[2k+1],
+// the N/2 + 1 bins of x are recovered from the complex FFT of z in a final pass.
+// N/2 is factored into radices 4, 2, 3 and 5, each radix is one Stockham pass: after the pass
+// with radix r the array holds, for every sub-sequence k (of n / L) the DFT of length L = L' * r
+// of the items k, k + n / L, ..., as
+//
+//   Y'[(j + L' t) * m' + k'] = sum_s w_r^(t s) * w_L^(j s) * Y[(j r + s) * m' + k']
+//
+// The passes ping-pong between two buffers and need no bit reversal. Transforms are
+// batched: item i of signal b is at [i * batch + b], so the innermost index of every pass
+// is a run of m' * batch consecutive floats and all the passes vectorize, even when m' is 1.
+// ---------------------
+
+// ---------------------
+// Note:
+// Inverse is normalized, Inverse(Forward(x)) == x
+// ---------------------
+
+#ifndef ENGINE_MATH_FFT_HPP
+#define ENGINE_MATH_FFT_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace mnt {
+
+  class FFT
+  {
+  public:
+    // Throws if _length is not supported
+    explicit FFT(size_t _length);
+
+    // Even lengths whose half only has the factors 2, 3 and 5
+    static bool Supports(size_t _length) noexcept;
+
+    // Smallest supported length not less than _length
+    static size_t GoodLength(size_t _length) noexcept;
+
+    size_t Length() const noexcept;
+    size_t Bins() const noexcept;
+
+    // _batch signals side by side: item i of signal b is _signal[i * _batch + b] and bin k is
+    // (_re, _im)[k * _batch + b]
+    void Forward(const float* _signal, float* _re, float* _im, size_t _batch) const;
+    void Inverse(const float* _re, const float* _im, float* _signal, size_t _batch) const;
+
+  private:
+    struct Pass
+    {
+      size_t radix;
+      size_t l;        // Length of the transforms before the pass
+      size_t offset;   // Of the l * (radix - 1) twiddles of the pass
+    };
+
+    size_t m_length;
+    size_t m_half;
+    std::vector<Pass> m_passes;
+    std::vector<float> m_twiddle_re;
+    std::vector<float> m_twiddle_im;
+
+    // w^k of the real transform, k <= m_half
+    std::vector<float> m_real_re;
+    std::vector<float> m_real_im;
+
+    // Complex FFT of _batch transforms of m_half items in place, _scratch is as big as the data
+    void Complex(float* _re, float* _im, float* _scratch_re, float* _scratch_im,
+                 size_t _batch, bool _inverse) const noexcept;
+
+    // Thread local buffer
+    static float* Buffer(size_t _length);
+  };
+}
+
+#include "math/fft.inl"
+
+#endif
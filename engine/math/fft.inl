@@ -0,0 +1,175 @@
+// File Name:     fft.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Batched real FFT, mixed radix Stockham
+
+#ifndef ENGINE_MATH_FFT_INL
+#define ENGINE_MATH_FFT_INL
+
+#include "math/fft.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace mnt;
+
+inline FFT::FFT(size_t _length)
+{
+  if (!Supports(_length))
+    MNT_THROW("FFT length must be even and its half can only have the factors 2, 3 and 5");
+
+  m_length = _length;
+  m_half = _length / 2;
+
+  // Radix 4 first, it does the most work per pass
+  size_t rest = m_half;
+  std::vector<size_t> radices;
+  for (size_t radix : {4, 2, 3, 5})
+    while (rest % radix == 0)
+    {
+      radices.push_back(radix);
+      rest /= radix;
+    }
+
+  // Twiddles are computed in double, w_L^(j s) = exp(-2 pi i j s / L)
+  const double pi = 3.14159265358979323846;
+  size_t l = 1;
+  for (size_t radix : radices)
+  {
+    m_passes.push_back({radix, l, m_twiddle_re.size()});
+
+    for (size_t j = 0; j < l; j++)
+      for (size_t s = 1; s < radix; s++)
+      {
+        const double angle = -2.0 * pi * (double)(j * s) / (double)(l * radix);
+        m_twiddle_re.push_back((float)std::cos(angle));
+        m_twiddle_im.push_back((float)std::sin(angle));
+      }
+
+    l *= radix;
+  }
+
+  for (size_t k = 0; k <= m_half; k++)
+  {
+    const double angle = -2.0 * pi * (double)k / (double)m_length;
+    m_real_re.push_back((float)std::cos(angle));
+    m_real_im.push_back((float)std::sin(angle));
+  }
+};
+
+inline bool FFT::Supports(size_t _length) noexcept
+{
+  if (_length < 2 || _length % 2 != 0)
+    return false;
+
+  size_t rest = _length / 2;
+  for (size_t radix : {2, 3, 5})
+    while (rest % radix == 0)
+      rest /= radix;
+
+  return rest == 1;
+};
+
+inline size_t FFT::GoodLength(size_t _length) noexcept
+{
+  size_t length = std::max(_length, (size_t)2);
+  while (!Supports(length))
+    length++;
+
+  return length;
+};
+
+inline size_t FFT::Length() const noexcept
+{
+  return m_length;
+};
+
+inline size_t FFT::Bins() const noexcept
+{
+  return m_half + 1;
+};
+
+inline void FFT::Forward(const float* _signal, float* _re, float* _im, size_t _batch) const
+{
+  const size_t length = m_half * _batch;
+  float* buffer = Buffer(4 * length);
+  float* z_re = buffer;
+  float* z_im = buffer + length;
+
+  // Even items are the real parts, odd items the imaginary parts
+  for (size_t k = 0; k < m_half; k++)
+  {
+    memcpy(z_re + k * _batch, _signal + 2 * k * _batch, _batch * sizeof(float));
+    memcpy(z_im + k * _batch, _signal + (2 * k + 1) * _batch, _batch * sizeof(float));
+  }
+
+  Complex(z_re, z_im, buffer + 2 * length, buffer + 3 * length, _batch, false);
+
+  KernelRegistry::Get().fft_real(z_re, z_im, _re, _im, m_half, _batch,
+                                 m_real_re.data(), m_real_im.data(), false);
+};
+
+inline void FFT::Inverse(const float* _re, const float* _im, float* _signal, size_t _batch) const
+{
+  const size_t length = m_half * _batch;
+  float* buffer = Buffer(4 * length);
+  float* z_re = buffer;
+  float* z_im = buffer + length;
+
+  KernelRegistry::Get().fft_real(_re, _im, z_re, z_im, m_half, _batch,
+                                 m_real_re.data(), m_real_im.data(), true);
+
+  Complex(z_re, z_im, buffer + 2 * length, buffer + 3 * length, _batch, true);
+
+  const float scale = 1.0f / (float)m_half;
+  for (size_t k = 0; k < m_half; k++)
+    for (size_t b = 0; b < _batch; b++)
+    {
+      _signal[2 * k * _batch + b] = z_re[k * _batch + b] * scale;
+      _signal[(2 * k + 1) * _batch + b] = z_im[k * _batch + b] * scale;
+    }
+};
+
+inline void FFT::Complex(float* _re, float* _im, float* _scratch_re, float* _scratch_im,
+                         size_t _batch, bool _inverse) const noexcept
+{
+  const KernelTable& table = KernelRegistry::Get();
+
+  float* in_re = _re;
+  float* in_im = _im;
+  float* out_re = _scratch_re;
+  float* out_im = _scratch_im;
+
+  for (const Pass& pass : m_passes)
+  {
+    const size_t run = m_half / (pass.l * pass.radix) * _batch;
+
+    table.fft_pass(in_re, in_im, out_re, out_im, pass.radix, pass.l, run,
+                   m_twiddle_re.data() + pass.offset, m_twiddle_im.data() + pass.offset, _inverse);
+
+    std::swap(in_re, out_re);
+    std::swap(in_im, out_im);
+  }
+
+  if (in_re != _re)
+  {
+    memcpy(_re, in_re, m_half * _batch * sizeof(float));
+    memcpy(_im, in_im, m_half * _batch * sizeof(float));
+  }
+};
+
+inline float* FFT::Buffer(size_t _length)
+{
+  static thread_local std::vector<float> buffer;
+
+  if (buffer.size() < _length)
+    buffer.resize(_length);
+
+  return buffer.data();
+};
+
+#endif
@@ -0,0 +1,61 @@
+// File Name:     fft_conv.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Conv1D with FFTs, overlap-add
+
+// ---------------------
+// Detail Description:
+// A correlation with a filter of span E is a convolution with the reversed filter. The padded
+// signal is cut into segments of B items, a segment zero padded to F = B + E - 1 items has a
+// linear convolution of F items with the filter, computed as a product of spectra, and the
+// results of consecutive segments overlap by E - 1 items and are added (overlap-add).
+// In the frequency domain the channels mix like a matrix product per bin:
+//
+//   Y[bin] (OC x segments) = H[bin] (OC x C) * X[bin] (C x segments)
+//
+// A task transforms MNT_FFT_CONV_LANES (segment, channel) pairs of an image together, the
+// segments go to a buffer of F items each, the overlaps are added in a second pass over
+// the output, so no two tasks write to the same place.
+// ---------------------
+
+// ---------------------
+// Note:
+// It costs about log(F) per output instead of K, the backend picks it for long filters
+// with stride 1 if "Conv1DParams::tolerance" allows MNT_FFT_RELATIVE_ERROR
+// ---------------------
+
+#ifndef ENGINE_MATH_FFT_CONV_HPP
+#define ENGINE_MATH_FFT_CONV_HPP
+
+#include "configs.hpp"
+
+#include "math/conv.hpp"
+
+#include <cstddef>
+
+namespace mnt {
+
+  class FFTConv1D
+  {
+  public:
+    // Stride 1
+    static bool Supports(const Conv1DGeometry& _geometry) noexcept;
+
+    // FFT length with the lowest cost per output
+    static size_t Length(const Conv1DGeometry& _geometry) noexcept;
+
+    static void Run(const float* _input, const float* _filter, float* _output,
+                    const Conv1DGeometry& _geometry);
+
+    // Rough number of CPU cycles, comparable to "Gemm::Cost"
+    static size_t Cost(const Conv1DGeometry& _geometry) noexcept;
+
+  private:
+    // For an FFT of _length items
+    static size_t Cost(const Conv1DGeometry& _geometry, size_t _length) noexcept;
+  };
+}
+
+#include "math/fft_conv.inl"
+
+#endif
@@ -0,0 +1,210 @@
+// File Name:     fft_conv.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Conv1D with FFTs, overlap-add
+
+#ifndef ENGINE_MATH_FFT_CONV_INL
+#define ENGINE_MATH_FFT_CONV_INL
+
+#include "math/fft_conv.hpp"
+#include "math/fft.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace mnt;
+
+inline bool FFTConv1D::Supports(const Conv1DGeometry& _geometry) noexcept
+{
+  return _geometry.params.stride == 1;
+};
+
+// Longer transforms waste less of every block on the overlap but cost more per item,
+// a few lengths from twice the span of the filter up to the whole signal are compared
+inline size_t FFTConv1D::Length(const Conv1DGeometry& _geometry) noexcept
+{
+  const size_t extent = _geometry.Extent();
+  const size_t longest = FFT::GoodLength(_geometry.in_length + 2 * _geometry.params.padding + extent - 1);
+
+  size_t best = std::min(FFT::GoodLength(2 * extent), longest);
+  size_t best_cost = Cost(_geometry, best);
+
+  for (size_t factor = 4; factor <= 64; factor *= 2)
+  {
+    const size_t length = std::min(FFT::GoodLength(factor * extent), longest);
+    const size_t cost = Cost(_geometry, length);
+
+    if (cost < best_cost)
+    {
+      best = length;
+      best_cost = cost;
+    }
+  }
+
+  return best;
+};
+
+inline void FFTConv1D::Run(const float* _input, const float* _filter, float* _output,
+                           const Conv1DGeometry& _geometry)
+{
+  const size_t channels = _geometry.in_channels;
+  const size_t out_channels = _geometry.out_channels;
+  const size_t extent = _geometry.Extent();
+  const size_t padded = _geometry.in_length + 2 * _geometry.params.padding;
+
+  const FFT fft(Length(_geometry));
+  const size_t length = fft.Length();
+  const size_t bins = fft.Bins();
+  const size_t block = length - extent + 1;
+  const size_t segments = (padded + block - 1) / block;
+
+  const KernelTable& table = KernelRegistry::Get();
+
+  // Spectra of the reversed and dilated filters, [out channel][bin][channel]
+  std::vector<float> filter_re(out_channels * bins * channels);
+  std::vector<float> filter_im(out_channels * bins * channels);
+
+  ParallelFor(0, out_channels, [&](size_t _begin, size_t _end)
+  {
+    std::vector<float> signal(length * channels);
+
+    for (size_t oc = _begin; oc < _end; oc++)
+    {
+      std::fill(signal.begin(), signal.end(), 0.0f);
+      for (size_t c = 0; c < channels; c++)
+        for (size_t k = 0; k < _geometry.kernel; k++)
+          signal[(extent - 1 - k * _geometry.params.dilation) * channels + c] =
+            _filter[(oc * channels + c) * _geometry.kernel + k];
+
+      fft.Forward(signal.data(), filter_re.data() + oc * bins * channels,
+                  filter_im.data() + oc * bins * channels, channels);
+    }
+  }, length * channels * (size_t)std::log2((double)length));
+
+  // Linear convolution of every segment, [image][out channel][segment][length]
+  std::vector<float> results(_geometry.batch * out_channels * segments * length);
+
+  const size_t per_task = std::min(segments, std::max((size_t)1, MNT_FFT_CONV_LANES / channels));
+  const size_t tasks_per_image = (segments + per_task - 1) / per_task;
+
+  ParallelFor(0, _geometry.batch * tasks_per_image, [&](size_t _begin, size_t _end)
+  {
+    std::vector<float> buffer;
+
+    for (size_t task = _begin; task < _end; task++)
+    {
+      const size_t image = task / tasks_per_image;
+      const size_t first = (task % tasks_per_image) * per_task;
+      const size_t count = std::min(per_task, segments - first);
+      const size_t in_lanes = channels * count;
+      const size_t out_lanes = out_channels * count;
+
+      buffer.assign(length * in_lanes + 2 * bins * (in_lanes + out_lanes) + length * out_lanes, 0.0f);
+      float* signal = buffer.data();
+      float* x_re = signal + length * in_lanes;
+      float* x_im = x_re + bins * in_lanes;
+      float* y_re = x_im + bins * in_lanes;
+      float* y_im = y_re + bins * out_lanes;
+      float* y = y_im + bins * out_lanes;
+
+      // Lane (channel, segment), the padding and the tail of every segment stay zero
+      for (size_t c = 0; c < channels; c++)
+      {
+        const float* in = _input + (image * channels + c) * _geometry.in_length;
+
+        for (size_t s = 0; s < count; s++)
+        {
+          const ptrdiff_t start = (ptrdiff_t)((first + s) * block) - (ptrdiff_t)_geometry.params.padding;
+          const size_t lane = c * count + s;
+
+          for (size_t i = 0; i < block; i++)
+          {
+            const ptrdiff_t index = start + (ptrdiff_t)i;
+            if (index >= 0 && index < (ptrdiff_t)_geometry.in_length)
+              signal[i * in_lanes + lane] = in[index];
+          }
+        }
+      }
+
+      fft.Forward(signal, x_re, x_im, in_lanes);
+
+      for (size_t bin = 0; bin < bins; bin++)
+        table.complex_gemm(filter_re.data() + bin * channels, filter_im.data() + bin * channels, bins * channels,
+                           x_re + bin * in_lanes, x_im + bin * in_lanes,
+                           y_re + bin * out_lanes, y_im + bin * out_lanes, out_channels, channels, count);
+
+      fft.Inverse(y_re, y_im, y, out_lanes);
+
+      for (size_t oc = 0; oc < out_channels; oc++)
+        for (size_t s = 0; s < count; s++)
+        {
+          float* result = results.data() + ((image * out_channels + oc) * segments + first + s) * length;
+          for (size_t i = 0; i < length; i++)
+            result[i] = y[i * out_lanes + oc * count + s];
+        }
+    }
+  }, Cost(_geometry, length) / std::max(_geometry.batch * tasks_per_image, (size_t)1));
+
+  // Output o is item o + extent - 1 of the full convolution, segment s covers the items
+  // [s * block, s * block + length) of it
+  ParallelFor(0, _geometry.batch * out_channels, [&](size_t _begin, size_t _end)
+  {
+    for (size_t row = _begin; row < _end; row++)
+    {
+      float* output = _output + row * _geometry.out_length;
+      std::fill(output, output + _geometry.out_length, 0.0f);
+
+      for (size_t s = 0; s < segments; s++)
+      {
+        const ptrdiff_t shift = (ptrdiff_t)(s * block) - (ptrdiff_t)(extent - 1);
+        const size_t begin = (size_t)std::max(shift, (ptrdiff_t)0);
+        const size_t end = (size_t)std::min(shift + (ptrdiff_t)length, (ptrdiff_t)_geometry.out_length);
+
+        if (begin < end)
+        {
+          const float* result = results.data() + (row * segments + s) * length + (begin - shift);
+          table.add(output + begin, result, output + begin, end - begin);
+        }
+      }
+    }
+  }, segments * length);
+};
+
+inline size_t FFTConv1D::Cost(const Conv1DGeometry& _geometry) noexcept
+{
+  return Cost(_geometry, Length(_geometry));
+};
+
+// The passes of a transform are bound by memory rather than arithmetic, a batched transform
+// takes about two cycles per item and pass of radix 2 with the real pass and the copies that
+// split the signal, whatever the instruction set. A product
+// of spectra is 4 fused multiply-adds per bin, and the gathers and copies around them are scalar
+inline size_t FFTConv1D::Cost(const Conv1DGeometry& _geometry, size_t _length) noexcept
+{
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t extent = _geometry.Extent();
+
+  if (_length < extent)
+    return SIZE_MAX;
+
+  const size_t channels = _geometry.in_channels;
+  const size_t out_channels = _geometry.out_channels;
+  const size_t block = _length - extent + 1;
+  const size_t segments = (_geometry.in_length + 2 * _geometry.params.padding + block - 1) / block;
+  const size_t bins = _length / 2 + 1;
+  const size_t transform = 2 * _length * (size_t)std::ceil(std::log2((double)_length));
+
+  const size_t lanes = _geometry.batch * segments;
+  size_t transforms = ((lanes + out_channels) * channels + lanes * out_channels) * transform;
+  size_t products = lanes * bins * out_channels * channels * 8 / table.gemm_nr;
+  size_t copies = lanes * _length * (channels + 2 * out_channels);
+
+  return transforms + products + copies;
+};
+
+#endif
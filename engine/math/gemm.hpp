@@ -0,0 +1,167 @@
+// File Name:     gemm.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Cache-blocked, packed and multi-threaded float matrix multiplication
+
+// ---------------------
+// Detail Description:
+// The classic GotoBLAS/BLIS loop nest around the micro-kernel of KernelRegistry:
+//
+//   for each NC columns of B/C:
+//     for each KC slice of the depth:        pack B[KC x NC] (stays in L2)
+//       for each MC rows of A/C:             pack A[MC x KC]
+//         for each gemm_nr columns, gemm_mr rows: micro-kernel
+//
+// The threads get 2-D slices of C (MC rows x MNT_GEMM_PARALLEL_COLS columns), each one
+// packs what it needs into its own thread local buffers, so there is no synchronization
+// between them. Packing the same block of B for several row blocks costs ~1/MC of the math.
+// ---------------------
+
+// ---------------------
+// Note:
+// B doesn`t have to exist as a matrix, "Run" takes a functor that packs any block of it
+// directly, convolutions use it to extract image patches tile by tile (im2col) without
+// ever materializing the whole patch matrix:
+//
+//   _pack_b(size_t _batch, size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+//
+// has to write the _depth x _cols block starting at (_k_begin, _n_begin) of the _batch-th B
+// in the layout of "KernelTable::gemm_pack_b", it is called from several threads at once
+// ---------------------
+
+// ---------------------
+// Note:
+// Products of at most MNT_GEMM_SKINNY_M rows with a B of contiguous rows skip the loop nest,
+// packing B would cost as much as the product, "Skinny" streams B once with the skinny
+// kernel of KernelRegistry and the threads split the columns. B can also be packed once
+// beforehand for the products that reuse it, see "math/packed_matrix.hpp"
+// ---------------------
+
+// ---------------------
+// Note:
+// B of "Run" and "Skinny" can also be a matrix of Half or BFloat16 items, e.g. weights stored
+// in reduced precision, the kernels convert them to float while packing or streaming B, so
+// the math and the accumulators are float and B is read with half the bandwidth
+// ---------------------
+
+// =====
+// [Run(_batch, ...)]: C[b] = A[b] * B[b] (+ C[b]) for b in [0, _batch), A[b] starts at
+// _a + b * _a_batch_stride (0 to share A), C[b] at _c + b * _c_batch_stride
+// =====
+
+// =====
+// [Skinny(_m, ...)]: C = A * B (+ C), B is row-major with rows _b_row_stride apart, or in
+// the layout of PackedMatrix if _packed
+// =====
+
+// =====
+// [Batched(_batch, ...)]: C[b] = A[b] * B[b] for b in [0, _batch), A[b] and B[b] start at
+// _a + _a_offsets[b] and _b + _b_offsets[b], C[b] at _c + b * _m * _ldc. The batches that
+// share a B are computed next to each other, so a thread packs every block of that B once for
+// all of them, and if every batch shares B and A[b + 1] continues the rows of A[b], the
+// batch is computed as one product of _batch * _m rows
+// =====
+
+// =====
+// [Quantized(_m, _a, _lda, _a_params, _b, _c, _ldc)]: C = A * B of a uint8_t A quantized with
+// _a_params and an int8 B, C is float. Rows of A are _lda bytes apart and must be readable up
+// to the depth rounded up to a multiple of 4, see "math/quantized_matrix.hpp"
+// =====
+
+// =====
+// [Cost(_m, _n, _k)]: Rough number of CPU cycles of a product, including packing, used to
+// choose between algorithms, not to predict time
+// =====
+
+#ifndef ENGINE_MATH_GEMM_HPP
+#define ENGINE_MATH_GEMM_HPP
+
+#include "configs.hpp"
+
+#include "math/kernels/registry.hpp"
+#include "math/quantized_matrix.hpp"
+
+#include <cstddef>
+
+namespace mnt {
+
+  class Gemm
+  {
+  public:
+    template <typename PACK_B>
+    static void Run(size_t _batch, size_t _m, size_t _n, size_t _k,
+                    const float* _a, size_t _a_batch_stride, size_t _a_row_stride, size_t _a_col_stride,
+                    const PACK_B& _pack_b,
+                    float* _c, size_t _c_batch_stride, size_t _ldc, bool _accumulate = false);
+
+    // C = A * B (+ C), item (i, j) of A is at _a[i * _a_row_stride + j * _a_col_stride], same for B,
+    // W is float, Half or BFloat16
+    template <typename W>
+    static void Run(size_t _m, size_t _n, size_t _k,
+                    const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                    const W* _b, size_t _b_row_stride, size_t _b_col_stride,
+                    float* _c, size_t _ldc, bool _accumulate = false);
+
+    template <typename W>
+    static void Skinny(size_t _m, size_t _n, size_t _k,
+                       const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                       const W* _b, size_t _b_row_stride, bool _packed,
+                       float* _c, size_t _ldc, bool _accumulate = false);
+
+    static void Batched(size_t _batch, size_t _m, size_t _n, size_t _k,
+                        const float* _a, const size_t* _a_offsets, size_t _a_row_stride, size_t _a_col_stride,
+                        const float* _b, const size_t* _b_offsets, size_t _b_row_stride, size_t _b_col_stride,
+                        float* _c, size_t _ldc);
+
+    // Computes the block [_m_begin, _m_end) x [_n_begin, _n_end) of C on the calling thread,
+    // _pack_b is called without the batch index
+    template <typename PACK_B>
+    static void Block(size_t _m_begin, size_t _m_end, size_t _n_begin, size_t _n_end, size_t _k,
+                      const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                      const PACK_B& _pack_b, float* _c, size_t _ldc, bool _accumulate);
+
+    static void Quantized(size_t _m, const uint8_t* _a, size_t _lda, const QuantParams& _a_params,
+                          const QuantizedMatrix& _b, float* _c, size_t _ldc);
+
+    static size_t Cost(size_t _m, size_t _n, size_t _k) noexcept;
+
+  private:
+    // At most MC rows of A and the rows of C they compute
+    struct Rows
+    {
+      const float* a;
+      float* c;
+      size_t count;
+    };
+
+    // Columns [_n_begin, _n_end) of _no_of_rows blocks of rows that share B, _rows(i)
+    // returns the i-th one, every block of B is packed once for all of them
+    template <typename PACK_B, typename ROWS>
+    static void Panels(size_t _n_begin, size_t _n_end, size_t _k,
+                       size_t _a_row_stride, size_t _a_col_stride, const PACK_B& _pack_b,
+                       size_t _no_of_rows, const ROWS& _rows, size_t _ldc, bool _accumulate);
+
+    // Panels [_panel_begin, _panel_end) of gemm_nr columns of a skinny product, on the calling thread
+    template <typename W>
+    static void SkinnyPanels(size_t _panel_begin, size_t _panel_end, size_t _m, size_t _n, size_t _k,
+                             const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                             const W* _b, size_t _b_row_stride, bool _packed,
+                             float* _c, size_t _ldc, bool _accumulate);
+
+    // The packing and skinny kernels of the table for B items of type W
+    template <typename W>
+    static auto PackB(const KernelTable& _table) noexcept;
+    template <typename W>
+    static auto SkinnyKernel(const KernelTable& _table) noexcept;
+
+    // Rows of the MC block, a multiple of gemm_mr
+    static size_t RowBlock(const KernelTable& _table) noexcept;
+
+    // Thread local buffer for the packed blocks, grows but never shrinks
+    static float* Buffer(size_t _length);
+  };
+}
+
+#include "math/gemm.inl"
+
+#endif
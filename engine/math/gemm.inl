@@ -0,0 +1,377 @@
+// File Name:     gemm.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Cache-blocked, packed and multi-threaded float matrix multiplication
+
+#ifndef ENGINE_MATH_GEMM_INL
+#define ENGINE_MATH_GEMM_INL
+
+#include "math/gemm.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace mnt;
+
+template <typename PACK_B, typename ROWS>
+void Gemm::Panels(size_t _n_begin, size_t _n_end, size_t _k,
+                  size_t _a_row_stride, size_t _a_col_stride, const PACK_B& _pack_b,
+                  size_t _no_of_rows, const ROWS& _rows, size_t _ldc, bool _accumulate)
+{
+  if (_n_begin >= _n_end || _no_of_rows == 0)
+    return;
+
+  if (_k == 0)
+  {
+    if (!_accumulate)
+      for (size_t r = 0; r < _no_of_rows; r++)
+      {
+        const Rows rows = _rows(r);
+        for (size_t i = 0; i < rows.count; i++)
+          memset(rows.c + i * _ldc + _n_begin, 0, (_n_end - _n_begin) * sizeof(float));
+      }
+    return;
+  }
+
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t mr = table.gemm_mr;
+  const size_t nr = table.gemm_nr;
+  const size_t mc = RowBlock(table);
+  const size_t kc = MNT_GEMM_KC;
+  const size_t nc = (MNT_GEMM_NC + nr - 1) / nr * nr;
+
+  float* packed_a = Buffer(mc * kc + kc * nc);
+  float* packed_b = packed_a + mc * kc;
+
+  for (size_t jc = _n_begin; jc < _n_end; jc += nc)
+  {
+    const size_t cols = std::min(nc, _n_end - jc);
+
+    for (size_t pc = 0; pc < _k; pc += kc)
+    {
+      const size_t depth = std::min(kc, _k - pc);
+
+      // Later slices of the depth add to what the first one wrote
+      const bool accumulate = _accumulate || pc > 0;
+
+      _pack_b(pc, depth, jc, cols, packed_b);
+
+      for (size_t r = 0; r < _no_of_rows; r++)
+      {
+        const Rows rows = _rows(r);
+
+        table.gemm_pack_a(rows.a + pc * _a_col_stride, _a_row_stride, _a_col_stride,
+                          rows.count, depth, packed_a);
+
+        for (size_t jr = 0; jr < cols; jr += nr)
+          for (size_t ir = 0; ir < rows.count; ir += mr)
+            table.gemm_micro(depth, packed_a + ir * depth, packed_b + jr * depth,
+                             rows.c + ir * _ldc + jc + jr, _ldc,
+                             std::min(mr, rows.count - ir), std::min(nr, cols - jr), accumulate);
+      }
+    }
+  }
+};
+
+template <typename PACK_B>
+void Gemm::Block(size_t _m_begin, size_t _m_end, size_t _n_begin, size_t _n_end, size_t _k,
+                 const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                 const PACK_B& _pack_b, float* _c, size_t _ldc, bool _accumulate)
+{
+  if (_m_begin >= _m_end)
+    return;
+
+  const size_t mc = RowBlock(KernelRegistry::Get());
+
+  Panels(_n_begin, _n_end, _k, _a_row_stride, _a_col_stride, _pack_b,
+         (_m_end - _m_begin + mc - 1) / mc, [&](size_t _index)
+         {
+           const size_t row = _m_begin + _index * mc;
+           return Rows{_a + row * _a_row_stride, _c + row * _ldc, std::min(mc, _m_end - row)};
+         }, _ldc, _accumulate);
+};
+
+template <typename PACK_B>
+void Gemm::Run(size_t _batch, size_t _m, size_t _n, size_t _k,
+               const float* _a, size_t _a_batch_stride, size_t _a_row_stride, size_t _a_col_stride,
+               const PACK_B& _pack_b,
+               float* _c, size_t _c_batch_stride, size_t _ldc, bool _accumulate)
+{
+  if (_batch == 0 || _m == 0 || _n == 0)
+    return;
+
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t mc = RowBlock(table);
+  const size_t slice = MNT_GEMM_PARALLEL_COLS;
+
+  const size_t row_blocks = (_m + mc - 1) / mc;
+  const size_t col_slices = (_n + slice - 1) / slice;
+
+  // Rows of the 2-D split are (batch, row block) pairs, columns are slices of C
+  ParallelFor2D(_batch * row_blocks, col_slices, [&](size_t _row_begin, size_t _row_end,
+                                                     size_t _col_begin, size_t _col_end)
+  {
+    for (size_t row = _row_begin; row < _row_end; row++)
+    {
+      const size_t batch = row / row_blocks;
+      const size_t m_begin = (row % row_blocks) * mc;
+
+      auto pack_b = [&](size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+      {
+        _pack_b(batch, _k_begin, _depth, _n_begin, _cols, _packed);
+      };
+
+      Block(m_begin, std::min(m_begin + mc, _m), _col_begin * slice, std::min(_col_end * slice, _n), _k,
+            _a + batch * _a_batch_stride, _a_row_stride, _a_col_stride,
+            pack_b, _c + batch * _c_batch_stride, _ldc, _accumulate);
+    }
+  }, Cost(mc, slice, _k));
+};
+
+template <typename W>
+void Gemm::Run(size_t _m, size_t _n, size_t _k,
+               const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+               const W* _b, size_t _b_row_stride, size_t _b_col_stride,
+               float* _c, size_t _ldc, bool _accumulate)
+{
+  const auto pack_b = PackB<W>(KernelRegistry::Get());
+
+  if (_m <= MNT_GEMM_SKINNY_M && _b_col_stride == 1)
+  {
+    Skinny(_m, _n, _k, _a, _a_row_stride, _a_col_stride, _b, _b_row_stride, false, _c, _ldc, _accumulate);
+    return;
+  }
+
+  Run(1, _m, _n, _k, _a, 0, _a_row_stride, _a_col_stride,
+      [&](size_t, size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+      {
+        pack_b(_b + _k_begin * _b_row_stride + _n_begin * _b_col_stride,
+               _b_row_stride, _b_col_stride, _depth, _cols, _packed);
+      },
+      _c, 0, _ldc, _accumulate);
+};
+
+template <typename W>
+void Gemm::Skinny(size_t _m, size_t _n, size_t _k,
+                  const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                  const W* _b, size_t _b_row_stride, bool _packed,
+                  float* _c, size_t _ldc, bool _accumulate)
+{
+  if (_m == 0 || _n == 0)
+    return;
+
+  const size_t nr = KernelRegistry::Get().gemm_nr;
+
+  // A panel streams _k * nr items of B, about 4 per cycle, and computes _m * _k * nr FMAs
+  ParallelFor(0, (_n + nr - 1) / nr, [&](size_t _begin, size_t _end)
+  {
+    SkinnyPanels(_begin, _end, _m, _n, _k, _a, _a_row_stride, _a_col_stride, _b, _b_row_stride, _packed,
+                 _c, _ldc, _accumulate);
+  }, _k * (_m + nr / 4));
+};
+
+template <typename W>
+void Gemm::SkinnyPanels(size_t _panel_begin, size_t _panel_end, size_t _m, size_t _n, size_t _k,
+                        const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                        const W* _b, size_t _b_row_stride, bool _packed,
+                        float* _c, size_t _ldc, bool _accumulate)
+{
+  const KernelTable& table = KernelRegistry::Get();
+  const auto skinny = SkinnyKernel<W>(table);
+  const size_t nr = table.gemm_nr;
+  const size_t kc = MNT_GEMM_SKINNY_KC;
+  const size_t cols = std::min(_panel_end * nr, _n) - _panel_begin * nr;
+
+  // Once with a depth of 0, to clear C
+  for (size_t k = 0; k < std::max(_k, (size_t)1); k += kc)
+  {
+    const size_t depth = std::min(kc, _k - k);
+
+    // The blocks of rows of a packed B hold the panels one after the other
+    const W* b = _packed ? _b + k * ((_n + nr - 1) / nr * nr) + _panel_begin * depth * nr :
+                           _b + k * _b_row_stride + _panel_begin * nr;
+
+    skinny(_m, cols, depth, _a + k * _a_col_stride, _a_row_stride, _a_col_stride,
+           b, _packed ? nr : _b_row_stride, _packed ? depth * nr : nr, _packed,
+           _c + _panel_begin * nr, _ldc, _accumulate || k > 0);
+  }
+};
+
+inline void Gemm::Batched(size_t _batch, size_t _m, size_t _n, size_t _k,
+                          const float* _a, const size_t* _a_offsets, size_t _a_row_stride, size_t _a_col_stride,
+                          const float* _b, const size_t* _b_offsets, size_t _b_row_stride, size_t _b_col_stride,
+                          float* _c, size_t _ldc)
+{
+  if (_batch == 0 || _m == 0 || _n == 0)
+    return;
+
+  const KernelTable& table = KernelRegistry::Get();
+
+  bool tall = true;
+  for (size_t b = 0; b < _batch && tall; b++)
+    tall = _b_offsets[b] == _b_offsets[0] && _a_offsets[b] == _a_offsets[0] + b * _m * _a_row_stride;
+
+  if (tall)
+  {
+    Run(_batch * _m, _n, _k, _a + _a_offsets[0], _a_row_stride, _a_col_stride,
+        _b + _b_offsets[0], _b_row_stride, _b_col_stride, _c, _ldc);
+    return;
+  }
+
+  if (_m <= MNT_GEMM_SKINNY_M && _b_col_stride == 1)
+  {
+    const size_t nr = table.gemm_nr;
+
+    ParallelFor2D(_batch, (_n + nr - 1) / nr, [&](size_t _batch_begin, size_t _batch_end,
+                                                  size_t _panel_begin, size_t _panel_end)
+    {
+      for (size_t b = _batch_begin; b < _batch_end; b++)
+        SkinnyPanels(_panel_begin, _panel_end, _m, _n, _k, _a + _a_offsets[b], _a_row_stride, _a_col_stride,
+                     _b + _b_offsets[b], _b_row_stride, false, _c + b * _m * _ldc, _ldc, false);
+    }, _k * (_m + nr / 4));
+    return;
+  }
+
+  const size_t mc = RowBlock(table);
+  const size_t slice = MNT_GEMM_PARALLEL_COLS;
+
+  const size_t row_blocks = (_m + mc - 1) / mc;
+  const size_t col_slices = (_n + slice - 1) / slice;
+
+  // The batches that share B are next to each other
+  std::vector<size_t> order(_batch);
+  for (size_t b = 0; b < _batch; b++)
+    order[b] = b;
+  std::stable_sort(order.begin(), order.end(), [&](size_t _x, size_t _y)
+  {
+    return _b_offsets[_x] < _b_offsets[_y];
+  });
+
+  // Rows of the 2-D split are (batch, row block) pairs in that order, columns are slices of C
+  ParallelFor2D(_batch * row_blocks, col_slices, [&](size_t _row_begin, size_t _row_end,
+                                                     size_t _col_begin, size_t _col_end)
+  {
+    for (size_t row = _row_begin; row < _row_end;)
+    {
+      const float* b = _b + _b_offsets[order[row / row_blocks]];
+
+      size_t end = row + 1;
+      while (end < _row_end && _b + _b_offsets[order[end / row_blocks]] == b)
+        end++;
+
+      auto pack_b = [&](size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+      {
+        table.gemm_pack_b(b + _k_begin * _b_row_stride + _n_begin * _b_col_stride,
+                          _b_row_stride, _b_col_stride, _depth, _cols, _packed);
+      };
+
+      auto rows = [&](size_t _index)
+      {
+        const size_t batch = order[(row + _index) / row_blocks];
+        const size_t m_begin = ((row + _index) % row_blocks) * mc;
+
+        return Rows{_a + _a_offsets[batch] + m_begin * _a_row_stride,
+                    _c + (batch * _m + m_begin) * _ldc, std::min(mc, _m - m_begin)};
+      };
+
+      Panels(_col_begin * slice, std::min(_col_end * slice, _n), _k, _a_row_stride, _a_col_stride,
+             pack_b, end - row, rows, _ldc, false);
+
+      row = end;
+    }
+  }, Cost(mc, slice, _k));
+};
+
+// One FMA of gemm_nr lanes per cycle, the packing touches every item of A once per
+// column block and every item of B once per row block
+inline size_t Gemm::Cost(size_t _m, size_t _n, size_t _k) noexcept
+{
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t mc = RowBlock(table);
+
+  // The micro-kernel always computes full gemm_mr x gemm_nr blocks
+  const size_t m = (_m + table.gemm_mr - 1) / table.gemm_mr * table.gemm_mr;
+  const size_t n = (_n + table.gemm_nr - 1) / table.gemm_nr * table.gemm_nr;
+
+  size_t math = m * n * _k / table.gemm_nr;
+  size_t packing = _m * _k * ((_n + MNT_GEMM_NC - 1) / MNT_GEMM_NC) +
+                   _k * _n * ((_m + mc - 1) / mc);
+
+  return math + packing;
+};
+
+template <typename W>
+auto Gemm::PackB(const KernelTable& _table) noexcept
+{
+  if constexpr (std::is_same<W, Half>::value)
+    return _table.gemm_pack_b_f16;
+  else if constexpr (std::is_same<W, BFloat16>::value)
+    return _table.gemm_pack_b_bf16;
+  else
+    return _table.gemm_pack_b;
+};
+
+template <typename W>
+auto Gemm::SkinnyKernel(const KernelTable& _table) noexcept
+{
+  if constexpr (std::is_same<W, Half>::value)
+    return _table.gemm_skinny_f16;
+  else if constexpr (std::is_same<W, BFloat16>::value)
+    return _table.gemm_skinny_bf16;
+  else
+    return _table.gemm_skinny;
+};
+
+inline size_t Gemm::RowBlock(const KernelTable& _table) noexcept
+{
+  return std::max(MNT_GEMM_MC / _table.gemm_mr, (size_t)1) * _table.gemm_mr;
+};
+
+// The zero point of A and both scales fold into a scale and an offset per column. The threads
+// get tiles of rows and panels, a panel of B is read by all the rows of a tile
+inline void Gemm::Quantized(size_t _m, const uint8_t* _a, size_t _lda, const QuantParams& _a_params,
+                            const QuantizedMatrix& _b, float* _c, size_t _ldc)
+{
+  const size_t n = _b.Cols();
+  const size_t k = _b.Rows();
+
+  if (_m == 0 || n == 0)
+    return;
+
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t nr = _b.PanelWidth();
+  const size_t depth4 = (k + 3) / 4 * 4;
+
+  std::vector<float> scales(n);
+  std::vector<float> offsets(n);
+  for (size_t j = 0; j < n; j++)
+  {
+    scales[j] = _a_params.scale * _b.Scales()[j];
+    offsets[j] = -scales[j] * (float)_a_params.zero_point * (float)_b.Sums()[j];
+  }
+
+  // A row and a panel cost about one cycle per 4 depths
+  ParallelFor2D(_m, (n + nr - 1) / nr, [&](size_t _row_begin, size_t _row_end, size_t _panel_begin, size_t _panel_end)
+  {
+    const size_t column = _panel_begin * nr;
+    table.qgemm(_row_end - _row_begin, std::min(_panel_end * nr, n) - column, k, _a + _row_begin * _lda, _lda,
+                _b.Data() + _panel_begin * depth4 * nr, scales.data() + column, offsets.data() + column,
+                _c + _row_begin * _ldc + column, _ldc);
+  }, depth4 / 4 + 1);
+};
+
+inline float* Gemm::Buffer(size_t _length)
+{
+  static thread_local std::vector<float> buffer;
+
+  if (buffer.size() < _length)
+    buffer.resize(_length);
+
+  return buffer.data();
+};
+
+#endif
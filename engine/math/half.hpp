@@ -0,0 +1,68 @@
+// File Name:     half.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   16-bit floating point types for storing tensors in reduced precision
+
+// ---------------------
+// Detail Description:
+// "Half" is IEEE 754 binary16 (1 sign, 5 exponent and 10 mantissa bits) and "BFloat16" is
+// the upper half of a float (1, 8 and 7 bits), it has the range of float with less precision.
+// Both of them are storage formats, tensors of them take half the memory and bandwidth of
+// float, and the kernels convert the items to float as they load them and compute in float,
+// e.g. "MatMul" of float activations and BFloat16 weights, see "math/backend.hpp".
+// ---------------------
+
+// ---------------------
+// Note:
+// Conversions from float round to nearest even, NaN stays NaN and values beyond the range of
+// Half become infinity. The conversions of a single item here are the reference for the
+// vectorized ones of KernelRegistry, which are the ones to use for whole tensors
+// ---------------------
+
+// =====
+// [HalfToFloat/FloatToHalf(_value)]: Converts between the bits of a Half and a float
+// =====
+
+// =====
+// [BFloat16ToFloat/FloatToBFloat16(_value)]: Converts between the bits of a BFloat16 and a float
+// =====
+
+#ifndef ENGINE_MATH_HALF_HPP
+#define ENGINE_MATH_HALF_HPP
+
+#include <cstdint>
+
+namespace mnt {
+
+  float HalfToFloat(const uint16_t _value) noexcept;
+  uint16_t FloatToHalf(const float _value) noexcept;
+
+  float BFloat16ToFloat(const uint16_t _value) noexcept;
+  uint16_t FloatToBFloat16(const float _value) noexcept;
+
+  struct Half
+  {
+    uint16_t bits;
+
+    Half() noexcept = default;
+    explicit Half(const float _value) noexcept : bits(FloatToHalf(_value)) {};
+
+    operator float () const noexcept {return HalfToFloat(bits);};
+  };
+
+  struct BFloat16
+  {
+    uint16_t bits;
+
+    BFloat16() noexcept = default;
+    explicit BFloat16(const float _value) noexcept : bits(FloatToBFloat16(_value)) {};
+
+    operator float () const noexcept {return BFloat16ToFloat(bits);};
+  };
+
+  static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2, "Reduced precision types must be 16 bits");
+}
+
+#include "math/half.inl"
+
+#endif
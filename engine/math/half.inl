@@ -0,0 +1,98 @@
+// File Name:     half.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   16-bit floating point types for storing tensors in reduced precision
+
+#ifndef ENGINE_MATH_HALF_INL
+#define ENGINE_MATH_HALF_INL
+
+#include "math/half.hpp"
+
+#include <cstring>
+
+using namespace mnt;
+
+// The exponent and mantissa move to their place in a float, multiplying by 2^112 rebiases
+// the exponent and normalizes the subnormals of Half, infinity and NaN keep an exponent of 255
+inline float mnt::HalfToFloat(const uint16_t _value) noexcept
+{
+  const uint32_t exponent_mantissa = _value & 0x7FFFu;
+  const uint32_t shifted = exponent_mantissa << 13;
+  const uint32_t magic_bits = (254u - 15u) << 23;
+
+  float shifted_value, magic;
+  std::memcpy(&shifted_value, &shifted, sizeof(float));
+  std::memcpy(&magic, &magic_bits, sizeof(float));
+
+  const float scaled = shifted_value * magic;
+
+  uint32_t bits;
+  std::memcpy(&bits, &scaled, sizeof(float));
+
+  if (exponent_mantissa >= 0x7C00u)
+    bits |= 255u << 23;
+  bits |= (uint32_t)(_value & 0x8000u) << 16;
+
+  float result;
+  std::memcpy(&result, &bits, sizeof(float));
+  return result;
+};
+
+// Subnormal results are rounded by a float addition that aligns the mantissa, normal ones
+// by adding half of the dropped bits, plus one if the kept part is odd
+inline uint16_t mnt::FloatToHalf(const float _value) noexcept
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(float));
+
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32_t result;
+  if (bits >= (127u + 16u) << 23)
+  {
+    result = bits > 255u << 23 ? 0x7E00u : 0x7C00u;
+  }
+  else if (bits < (127u - 14u) << 23)
+  {
+    const uint32_t magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    float value, magic;
+    std::memcpy(&value, &bits, sizeof(float));
+    std::memcpy(&magic, &magic_bits, sizeof(float));
+    value += magic;
+
+    std::memcpy(&result, &value, sizeof(float));
+    result -= magic_bits;
+  }
+  else
+  {
+    const uint32_t odd = (bits >> 13) & 1u;
+    result = (bits + ((uint32_t)(15 - 127) << 23) + 0xFFFu + odd) >> 13;
+  }
+
+  return (uint16_t)(result | (sign >> 16));
+};
+
+inline float mnt::BFloat16ToFloat(const uint16_t _value) noexcept
+{
+  const uint32_t bits = (uint32_t)_value << 16;
+
+  float result;
+  std::memcpy(&result, &bits, sizeof(float));
+  return result;
+};
+
+// NaN is truncated and kept quiet, rounding could carry it into infinity
+inline uint16_t mnt::FloatToBFloat16(const float _value) noexcept
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(float));
+
+  if ((bits & 0x7FFFFFFFu) > 0x7F800000u)
+    return (uint16_t)((bits >> 16) | 0x40u);
+
+  return (uint16_t)((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+};
+
+#endif
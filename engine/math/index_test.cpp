@@ -0,0 +1,295 @@
+// File Name:     index_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the indexing ops on every instruction set
+
+// ---------------------
+// Detail Description:
+// IndexSelect, Gather, Scatter, ScatterAdd, Concat and Split are compared with naive loops
+// over the multi-index of every item, along every axis. ScatterAdd of many indices into a
+// short result runs once on one thread and once on four, the second adds into a zeroed copy
+// of the result per chunk of indices and merges them, see "MNT_SCATTER_GRAIN".
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/test_utils.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  Tensor<TSHAPE_TYPE> Indices(const TensorShape& _shape, size_t _extent, uint32_t _seed)
+  {
+    Tensor<TSHAPE_TYPE> indices(_shape);
+    std::mt19937 generator(_seed);
+
+    for (size_t i=0; i<indices.Length(); i++)
+      indices[i] = (TSHAPE_TYPE)(generator() % _extent);
+
+    return indices;
+  }
+
+  std::vector<size_t> Unravel(size_t _offset, const TensorShape& _shape)
+  {
+    std::vector<size_t> index(_shape.size());
+    for (size_t d=_shape.size(); d-- > 0;)
+    {
+      index[d] = _offset % _shape[d];
+      _offset /= _shape[d];
+    }
+    return index;
+  }
+
+  size_t Ravel(const std::vector<size_t>& _index, const TensorShape& _shape)
+  {
+    size_t offset = 0;
+    for (size_t d=0; d<_shape.size(); d++)
+      offset = offset * _shape[d] + _index[d];
+    return offset;
+  }
+
+  template <typename T>
+  std::vector<double> Items(const Tensor<T>& _tensor)
+  {
+    return std::vector<double>(_tensor.Data(), _tensor.Data() + _tensor.Length());
+  }
+
+  template <typename T>
+  void CheckSelect(Checks& _checks, const std::string& _type)
+  {
+    DefaultBackend<T> backend;
+
+    for (size_t axis=0; axis<3; axis++)
+    {
+      Tensor<T> tensor({5, 7, 9});
+      Fill(tensor, 1, -50.0, 50.0);
+      Tensor<TSHAPE_TYPE> indices = Indices({3, 4}, tensor.Shape()[axis], 2);
+
+      // The axes before _axis, the axes of the indices, the axes after _axis
+      TensorShape shape;
+      for (size_t d=0; d<axis; d++)
+        shape.push_back(tensor.Shape()[d]);
+      shape.push_back(3);
+      shape.push_back(4);
+      for (size_t d=axis + 1; d<3; d++)
+        shape.push_back(tensor.Shape()[d]);
+
+      std::vector<double> expected(3 * 4 * tensor.Length() / tensor.Shape()[axis]);
+      for (size_t i=0; i<expected.size(); i++)
+      {
+        const std::vector<size_t> index = Unravel(i, shape);
+        std::vector<size_t> source(index.begin(), index.begin() + axis);
+        source.push_back(indices[index[axis] * 4 + index[axis + 1]]);
+        source.insert(source.end(), index.begin() + axis + 2, index.end());
+        expected[i] = (double)tensor[Ravel(source, tensor.Shape())];
+      }
+
+      Tensor<T> result = backend.IndexSelect(tensor, axis, indices);
+      const std::string what = _type + " IndexSelect along axis " + std::to_string(axis);
+      _checks.Expect(result.Shape() == shape, what + " has the shape " + result.ShapeStr());
+      _checks.Items(result, expected, 0.0, what);
+    }
+
+    Tensor<T> table({6, 4});
+    Tensor<TSHAPE_TYPE> empty({0});
+    _checks.Expect(backend.IndexSelect(table, 0, empty).Length() == 0, _type + " IndexSelect of no indices");
+
+    Tensor<TSHAPE_TYPE> outside = Indices({3}, 6, 3);
+    outside[1] = 6;
+    _checks.Throws([&]() {backend.IndexSelect(table, 0, outside);}, _type + " IndexSelect of an index out of range");
+    _checks.Throws([&]() {backend.IndexSelect(table, 2, outside);}, _type + " IndexSelect along axis 2 of a matrix");
+  }
+
+  template <typename T>
+  void CheckGatherScatter(Checks& _checks, const std::string& _type)
+  {
+    DefaultBackend<T> backend;
+
+    for (size_t axis=0; axis<3; axis++)
+    {
+      Tensor<T> tensor({6, 5, 8});
+      Fill(tensor, 4, -50.0, 50.0);
+
+      TensorShape shape = {4, 5, 7};
+      shape[axis] = 11;
+      Tensor<TSHAPE_TYPE> indices = Indices(shape, tensor.Shape()[axis], 5);
+      Tensor<T> source(shape);
+      Fill(source, 6, -50.0, 50.0);
+
+      std::vector<double> gathered(indices.Length());
+      std::vector<double> scattered = Items(tensor);
+      std::vector<double> added = Items(tensor);
+
+      // Items of _source in order, the last one written to a position wins
+      for (size_t i=0; i<indices.Length(); i++)
+      {
+        std::vector<size_t> index = Unravel(i, shape);
+        index[axis] = indices[i];
+        const size_t position = Ravel(index, tensor.Shape());
+
+        gathered[i] = (double)tensor[position];
+        added[position] += (double)source[i];
+      }
+
+      for (size_t i=0; i<indices.Length(); i++)
+      {
+        const std::vector<size_t> index = Unravel(i, shape);
+        size_t last = i;
+        for (size_t j=index[axis] + 1; j<shape[axis]; j++)
+        {
+          std::vector<size_t> later = index;
+          later[axis] = j;
+          if (indices[Ravel(later, shape)] == indices[i])
+            last = Ravel(later, shape);
+        }
+
+        std::vector<size_t> target = index;
+        target[axis] = indices[i];
+        scattered[Ravel(target, tensor.Shape())] = (double)source[last];
+      }
+
+      const std::string along = " along axis " + std::to_string(axis);
+      _checks.Items(backend.Gather(tensor, axis, indices), gathered, 0.0, _type + " Gather" + along);
+      _checks.Items(backend.Scatter(tensor, axis, indices, source), scattered, 0.0, _type + " Scatter" + along);
+      _checks.Items(backend.ScatterAdd(tensor, axis, indices, source), added, 1e-4, _type + " ScatterAdd" + along);
+    }
+
+    Tensor<T> tensor({4, 4});
+    Tensor<TSHAPE_TYPE> larger = Indices({5, 4}, 4, 7);
+    Tensor<TSHAPE_TYPE> outside = Indices({4, 4}, 4, 8);
+    Tensor<TSHAPE_TYPE> vector = Indices({4}, 4, 9);
+    Tensor<T> source({4, 4});
+    Tensor<T> other_source({4, 3});
+    outside[5] = 4;
+
+    _checks.Throws([&]() {backend.Gather(tensor, 1, larger);}, _type + " Gather of indices larger than the tensor");
+    _checks.Throws([&]() {backend.Gather(tensor, 1, outside);}, _type + " Gather of an index out of range");
+    _checks.Throws([&]() {backend.Gather(tensor, 1, vector);}, _type + " Gather of indices of another rank");
+    _checks.Throws([&]() {backend.Scatter(tensor, 0, outside, source);}, _type + " Scatter of an index out of range");
+    _checks.Throws([&]() {backend.ScatterAdd(tensor, 1, outside, source);}, _type + " ScatterAdd of an index out of range");
+    _checks.Throws([&]() {backend.ScatterAdd(tensor, 2, vector, source);}, _type + " ScatterAdd along axis 2 of a matrix");
+
+    Tensor<TSHAPE_TYPE> inside = Indices({4, 4}, 4, 10);
+    _checks.Throws([&]() {backend.Scatter(tensor, 0, inside, other_source);}, _type + " Scatter of a source of another shape");
+  }
+
+  // A histogram, many indices into a result short enough to be copied per chunk of indices
+  template <typename T>
+  void CheckHistogram(Checks& _checks, const std::string& _type)
+  {
+    const size_t bins = 100, samples = 300000;
+
+    Tensor<T> counts({(TSHAPE_TYPE)bins});
+    Tensor<T> ones({(TSHAPE_TYPE)samples});
+    Tensor<TSHAPE_TYPE> indices = Indices({(TSHAPE_TYPE)samples}, bins, 11);
+
+    std::vector<double> expected(bins, 1.0);
+    for (size_t i=0; i<bins; i++)
+      counts[i] = T(1);
+    for (size_t i=0; i<samples; i++)
+    {
+      ones[i] = T(1);
+      expected[indices[i]] += 1.0;
+    }
+
+    for (const size_t threads : {1, 4})
+    {
+      ThreadPool::Init(threads, false);
+
+      DefaultBackend<T> backend;
+      _checks.Items(backend.ScatterAdd(counts, 0, indices, ones), expected, 0.0,
+                    _type + " ScatterAdd histogram on " + std::to_string(threads) + " threads");
+    }
+  }
+
+  template <typename T>
+  void CheckConcatSplit(Checks& _checks, const std::string& _type)
+  {
+    DefaultBackend<T> backend;
+
+    for (size_t axis=0; axis<3; axis++)
+    {
+      TensorShape shape_1 = {3, 4, 5}, shape_2 = shape_1, shape_3 = shape_1;
+      shape_2[axis] = 2;
+      shape_3[axis] = 6;
+
+      Tensor<T> tensor_1(shape_1), tensor_2(shape_2), tensor_3(shape_3);
+      Fill(tensor_1, 12, -50.0, 50.0);
+      Fill(tensor_2, 13, -50.0, 50.0);
+      Fill(tensor_3, 14, -50.0, 50.0);
+
+      TensorShape shape = shape_1;
+      shape[axis] = shape_1[axis] + 8;
+
+      std::vector<double> expected(tensor_1.Length() + tensor_2.Length() + tensor_3.Length());
+      for (size_t i=0; i<expected.size(); i++)
+      {
+        std::vector<size_t> index = Unravel(i, shape);
+        if (index[axis] < shape_1[axis])
+          expected[i] = (double)tensor_1[Ravel(index, shape_1)];
+        else if ((index[axis] -= shape_1[axis]) < 2)
+          expected[i] = (double)tensor_2[Ravel(index, shape_2)];
+        else
+        {
+          index[axis] -= 2;
+          expected[i] = (double)tensor_3[Ravel(index, shape_3)];
+        }
+      }
+
+      const std::string along = " along axis " + std::to_string(axis);
+      Tensor<T> joined = backend.Concat({&tensor_1, &tensor_2, &tensor_3}, axis);
+      _checks.Expect(joined.Shape() == shape, _type + " Concat" + along + " has the shape " + joined.ShapeStr());
+      _checks.Items(joined, expected, 0.0, _type + " Concat" + along);
+
+      std::vector<Tensor<T>> parts = backend.Split(joined, axis, {shape_1[axis], 2, 6});
+      _checks.Expect(parts.size() == 3, _type + " Split" + along + " has " + std::to_string(parts.size()) + " parts");
+      if (parts.size() == 3)
+      {
+        _checks.Items(parts[0], Items(tensor_1), 0.0, _type + " Split" + along + " part 0");
+        _checks.Items(parts[1], Items(tensor_2), 0.0, _type + " Split" + along + " part 1");
+        _checks.Items(parts[2], Items(tensor_3), 0.0, _type + " Split" + along + " part 2");
+      }
+
+      std::vector<Tensor<T>> whole = backend.Split(joined, axis, {0, shape[axis]});
+      _checks.Expect(whole.size() == 2 && whole[0].Length() == 0 && whole[1].Shape() == shape,
+                     _type + " Split" + along + " into an empty part and the whole");
+    }
+
+    Tensor<T> square({4, 4});
+    Tensor<T> other({3, 5});
+    _checks.Throws([&]() {backend.Concat({&square, &other}, 0);}, _type + " Concat of tensors that differ along another axis");
+    _checks.Throws([&]() {backend.Concat({&square, &square}, 2);}, _type + " Concat along axis 2 of matrices");
+    _checks.Throws([&]() {backend.Split(square, 1, {1, 2});}, _type + " Split into parts shorter than the axis");
+    _checks.Throws([&]() {backend.Split(square, 1, {3, 2});}, _type + " Split into parts longer than the axis");
+  }
+
+  template <typename T>
+  void CheckIndexing(Checks& _checks, const std::string& _type)
+  {
+    CheckSelect<T>(_checks, _type);
+    CheckGatherScatter<T>(_checks, _type);
+    CheckHistogram<T>(_checks, _type);
+    CheckConcatSplit<T>(_checks, _type);
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckIndexing<float>(checks, "float");
+    CheckIndexing<double>(checks, "double");
+    CheckIndexing<int32_t>(checks, "int32");
+
+    return checks.Failures();
+  });
+}
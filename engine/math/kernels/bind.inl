@@ -0,0 +1,110 @@
+// File Name:     bind.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Fills a KernelTable with the kernels of one instruction set
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+inline void Bind(KernelTable& _table) noexcept
+{
+  _table.isa = simd_isa;
+
+  _table.add = &AddF32;
+  _table.sub = &SubF32;
+  _table.mul = &MulF32;
+  _table.div = &DivF32;
+  _table.maximum = &MaximumF32;
+  _table.minimum = &MinimumF32;
+
+  _table.bias_activation = &BiasActivationF32;
+
+  _table.exp = &ExpF32;
+  _table.log = &LogF32;
+  _table.tanh = &TanhF32;
+  _table.sigmoid = &SigmoidF32;
+  _table.erf = &ErfF32;
+
+  _table.activation = &ActivationF32;
+  _table.activation_backward = &ActivationBackwardF32;
+  _table.leaky_relu = &LeakyReluF32;
+  _table.leaky_relu_backward = &LeakyReluBackwardF32;
+
+  _table.mask_pack = &MaskPackF32;
+  _table.mask_unpack = &MaskUnpackF32;
+  _table.mask_count = &MaskCount;
+  _table.masked_fill = &MaskedFillF32;
+  _table.masked_scale = &MaskedScaleF32;
+  _table.masked_select = &MaskedSelectF32;
+
+  _table.random_bits = &RandomBits;
+  _table.random_uniform = &RandomUniformF32;
+  _table.random_normal = &RandomNormalF32;
+  _table.random_bernoulli = &RandomBernoulli;
+
+  _table.transpose = &TransposeF32;
+
+  _table.half_to_float = &ConvertF32<Half, float>;
+  _table.float_to_half = &ConvertF32<float, Half>;
+  _table.bfloat16_to_float = &ConvertF32<BFloat16, float>;
+  _table.float_to_bfloat16 = &ConvertF32<float, BFloat16>;
+
+  _table.gemm_mr = gemm_mr;
+  _table.gemm_nr = gemm_nr;
+  _table.gemm_pack_a = &GemmPackAF32;
+  _table.gemm_pack_b = &GemmPackBF32<float>;
+  _table.gemm_micro = &GemmMicroF32;
+  _table.gemm_skinny = &GemmSkinnyF32<float>;
+  _table.gemm_pack_b_f16 = &GemmPackBF32<Half>;
+  _table.gemm_pack_b_bf16 = &GemmPackBF32<BFloat16>;
+  _table.gemm_skinny_f16 = &GemmSkinnyF32<Half>;
+  _table.gemm_skinny_bf16 = &GemmSkinnyF32<BFloat16>;
+
+  _table.quantize_s8 = &QuantizeF32<int8_t>;
+  _table.quantize_u8 = &QuantizeF32<uint8_t>;
+  _table.dequantize_s8 = &DequantizeF32<int8_t>;
+  _table.dequantize_u8 = &DequantizeF32<uint8_t>;
+
+  _table.qgemm_nr = qgemm_nr;
+  _table.qgemm_weight_max = dot_weight_max;
+  _table.qgemm_pack_b = &QGemmPackBS8;
+  _table.qgemm = &QGemmU8S8;
+
+  _table.spmm = &SpmmF32;
+  _table.sddmm = &SddmmF32;
+
+  _table.winograd_input = &WinogradInputF32;
+  _table.winograd_output = &WinogradOutputF32;
+
+  _table.fft_pass = &FftPassF32;
+  _table.fft_real = &FftRealF32;
+  _table.complex_gemm = &ComplexGemmF32;
+
+  _table.reduce_sum = &ReduceSumF32;
+  _table.reduce_squares = &ReduceSquaresF32;
+  _table.reduce_max = &ReduceMaxF32;
+  _table.reduce_min = &ReduceMinF32;
+  _table.reduce_argmax = &ReduceArgMaxF32;
+  _table.squares_add = &SquaresAddF32;
+
+  _table.softmax = &SoftmaxF32;
+  _table.log_softmax = &LogSoftmaxF32;
+  _table.softmax_backward = &SoftmaxBackwardF32;
+  _table.log_softmax_backward = &LogSoftmaxBackwardF32;
+  _table.layer_norm = &LayerNormF32;
+  _table.rms_norm = &RMSNormF32;
+  _table.layer_norm_backward = &LayerNormBackwardF32;
+  _table.rms_norm_backward = &RMSNormBackwardF32;
+
+  _table.conv_blocked[0] = &ConvBlockedRowF32<8>;
+  _table.conv_blocked[1] = &ConvBlockedRowF32<16>;
+  _table.depthwise_blocked[0] = &DepthwiseBlockedRowF32<8>;
+  _table.depthwise_blocked[1] = &DepthwiseBlockedRowF32<16>;
+  _table.depthwise = &DepthwiseRowF32;
+  _table.max_pool_blocked[0] = &PoolBlockedRowF32<8, true>;
+  _table.max_pool_blocked[1] = &PoolBlockedRowF32<16, true>;
+  _table.avg_pool_blocked[0] = &PoolBlockedRowF32<8, false>;
+  _table.avg_pool_blocked[1] = &PoolBlockedRowF32<16, false>;
+}
@@ -0,0 +1,220 @@
+// File Name:     blocked.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Window kernels (convolution, pooling) on the blocked NCHW8c/NCHW16c layouts
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// A group of BLOCK channels of a pixel is one (or a few) vectors, so the convolution
+// broadcasts one input channel of a pixel and multiplies it with the weights of all the
+// output channels of the group at once. Several neighbouring output pixels are computed
+// together, every weight vector loaded is used for all of them, and the accumulators of
+// the whole strip stay in registers for the whole reduction over (input channel, kh, kw).
+// ---------------------
+
+// A group of BLOCK channels is blocked_vectors vectors of blocked_lanes lanes,
+// AVX-512 runs NCHW8c on half vectors
+template <size_t BLOCK>
+constexpr size_t blocked_lanes = BLOCK < VecF32::width ? BLOCK : VecF32::width;
+
+template <size_t BLOCK>
+constexpr size_t blocked_vectors = BLOCK / blocked_lanes<BLOCK>;
+
+template <size_t BLOCK>
+inline VecF32 BlockedLoad(const float* _src) noexcept
+{
+  if constexpr (BLOCK >= VecF32::width)
+    return Load(_src);
+  else
+    return LoadPartial(_src, BLOCK);
+}
+
+template <size_t BLOCK>
+inline void BlockedStore(float* _dst, const VecF32 _a) noexcept
+{
+  if constexpr (BLOCK >= VecF32::width)
+    Store(_dst, _a);
+  else
+    StorePartial(_dst, _a, BLOCK);
+}
+
+// Accumulators start from the bias
+template <size_t BLOCK, size_t PIXELS>
+inline void BlockedBiasF32(const BlockedRowArgs& _args,
+                           VecF32 _acc[PIXELS][blocked_vectors<BLOCK>]) noexcept
+{
+  constexpr size_t lanes = blocked_lanes<BLOCK>;
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  MNT_UNROLL
+  for (size_t v = 0; v < vectors; v++)
+  {
+    const VecF32 bias = _args.bias ? BlockedLoad<BLOCK>(_args.bias + v * lanes) : Zero();
+    MNT_UNROLL
+    for (size_t p = 0; p < PIXELS; p++)
+      _acc[p][v] = bias;
+  }
+}
+
+template <size_t BLOCK, size_t PIXELS>
+inline void BlockedEpilogueF32(const BlockedRowArgs& _args, size_t _ow,
+                               const VecF32 _acc[PIXELS][blocked_vectors<BLOCK>]) noexcept
+{
+  constexpr size_t lanes = blocked_lanes<BLOCK>;
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  float* output = _args.output + _ow * BLOCK;
+
+  MNT_UNROLL
+  for (size_t p = 0; p < PIXELS; p++)
+    MNT_UNROLL
+    for (size_t v = 0; v < vectors; v++)
+      BlockedStore<BLOCK>(output + p * BLOCK + v * lanes, ActivateF32(_acc[p][v], _args.activation));
+}
+
+// Splits an output row into the columns whose whole window is inside the input horizontally,
+// computed _pixels at a time by _strip without bound checks, and the columns at the edges
+template <size_t PIXELS>
+inline void BlockedRowF32(const BlockedRowArgs& _args,
+                          void (*_strip)(const BlockedRowArgs&, size_t) noexcept,
+                          void (*_inner)(const BlockedRowArgs&, size_t) noexcept,
+                          void (*_edge)(const BlockedRowArgs&, size_t) noexcept) noexcept
+{
+  const ptrdiff_t extent = (ptrdiff_t)((_args.kernel_w - 1) * _args.dilation_w);
+  const ptrdiff_t stride = (ptrdiff_t)_args.stride_w;
+  size_t inner_begin = _args.col >= 0 ? 0 : (size_t)((-_args.col + stride - 1) / stride);
+  ptrdiff_t last = (ptrdiff_t)_args.in_width - 1 - extent - _args.col;
+  size_t inner_end = last < 0 ? 0 : std::min(_args.out_width, (size_t)(last / stride + 1));
+  inner_begin = std::min(inner_begin, inner_end);
+
+  size_t ow = 0;
+  for (; ow < inner_begin; ow++)
+    _edge(_args, ow);
+
+  for (; ow + PIXELS <= inner_end; ow += PIXELS)
+    _strip(_args, ow);
+
+  for (; ow < inner_end; ow++)
+    _inner(_args, ow);
+
+  for (; ow < _args.out_width; ow++)
+    _edge(_args, ow);
+}
+
+// PIXELS output pixels starting at _ow, CHECKED tests every input column against the width
+template <size_t BLOCK, size_t PIXELS, bool CHECKED>
+inline void ConvBlockedPixelsF32(const BlockedRowArgs& _args, size_t _ow) noexcept
+{
+  constexpr size_t lanes = blocked_lanes<BLOCK>;
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  const size_t group_length = _args.in_height * _args.in_width * BLOCK;
+  const size_t filter_group_length = _args.kernel_h * _args.kernel_w * BLOCK * BLOCK;
+  const ptrdiff_t first_col = _args.col + (ptrdiff_t)(_ow * _args.stride_w);
+
+  VecF32 acc[PIXELS][vectors];
+  BlockedBiasF32<BLOCK, PIXELS>(_args, acc);
+
+  for (size_t group = 0; group < _args.in_groups; group++)
+  {
+    const float* input = _args.input + group * group_length;
+    const float* filter = _args.filter + group * filter_group_length;
+
+    for (size_t kh = 0; kh < _args.kernel_h; kh++)
+    {
+      const ptrdiff_t h = _args.row + (ptrdiff_t)(kh * _args.dilation_h);
+      if (h < 0 || h >= (ptrdiff_t)_args.in_height)
+        continue;
+
+      for (size_t kw = 0; kw < _args.kernel_w; kw++)
+      {
+        const ptrdiff_t w = first_col + (ptrdiff_t)(kw * _args.dilation_w);
+        if (CHECKED && (w < 0 || w >= (ptrdiff_t)_args.in_width))
+          continue;
+
+        const float* in = input + (h * (ptrdiff_t)_args.in_width + w) * (ptrdiff_t)BLOCK;
+        const float* weights = filter + (kh * _args.kernel_w + kw) * BLOCK * BLOCK;
+        const size_t pixel_stride = _args.stride_w * BLOCK;
+
+        for (size_t ic = 0; ic < BLOCK; ic++)
+        {
+          VecF32 weight[vectors];
+
+          MNT_UNROLL
+          for (size_t v = 0; v < vectors; v++)
+            weight[v] = BlockedLoad<BLOCK>(weights + ic * BLOCK + v * lanes);
+
+          MNT_UNROLL
+          for (size_t p = 0; p < PIXELS; p++)
+          {
+            const VecF32 a = Set(in[p * pixel_stride + ic]);
+            MNT_UNROLL
+            for (size_t v = 0; v < vectors; v++)
+              acc[p][v] = Fma(a, weight[v], acc[p][v]);
+          }
+        }
+      }
+    }
+  }
+
+  BlockedEpilogueF32<BLOCK, PIXELS>(_args, _ow, acc);
+}
+
+// One output row of one group of output channels
+template <size_t BLOCK>
+inline void ConvBlockedRowF32(const BlockedRowArgs& _args) noexcept
+{
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  // About 12 accumulators, so the weights and a broadcast still fit in 16 registers
+  constexpr size_t pixels = vectors >= 12 ? 1 : 12 / vectors;
+
+  BlockedRowF32<pixels>(_args, &ConvBlockedPixelsF32<BLOCK, pixels, false>,
+                        &ConvBlockedPixelsF32<BLOCK, 1, false>, &ConvBlockedPixelsF32<BLOCK, 1, true>);
+}
+
+// One output row of one group of channels, the average is over the items inside the input
+template <size_t BLOCK, bool MAXIMUM>
+inline void PoolBlockedRowF32(const BlockedRowArgs& _args) noexcept
+{
+  constexpr size_t lanes = blocked_lanes<BLOCK>;
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  const size_t h_begin = (size_t)std::max(_args.row, (ptrdiff_t)0);
+  const size_t h_end = (size_t)std::min(_args.row + (ptrdiff_t)_args.kernel_h, (ptrdiff_t)_args.in_height);
+
+  for (size_t ow = 0; ow < _args.out_width; ow++)
+  {
+    const ptrdiff_t first = _args.col + (ptrdiff_t)(ow * _args.stride_w);
+    const size_t w_begin = (size_t)std::max(first, (ptrdiff_t)0);
+    const size_t w_end = (size_t)std::min(first + (ptrdiff_t)_args.kernel_w, (ptrdiff_t)_args.in_width);
+
+    VecF32 acc[vectors];
+    const float* start = _args.input + (h_begin * _args.in_width + w_begin) * BLOCK;
+
+    MNT_UNROLL
+    for (size_t v = 0; v < vectors; v++)
+      acc[v] = MAXIMUM ? BlockedLoad<BLOCK>(start + v * lanes) : Zero();
+
+    for (size_t h = h_begin; h < h_end; h++)
+      for (size_t w = w_begin; w < w_end; w++)
+      {
+        const float* in = _args.input + (h * _args.in_width + w) * BLOCK;
+        MNT_UNROLL
+        for (size_t v = 0; v < vectors; v++)
+          acc[v] = MAXIMUM ? Max(acc[v], BlockedLoad<BLOCK>(in + v * lanes))
+                           : Add(acc[v], BlockedLoad<BLOCK>(in + v * lanes));
+      }
+
+    const VecF32 scale = Set(1.0f / (float)((h_end - h_begin) * (w_end - w_begin)));
+
+    MNT_UNROLL
+    for (size_t v = 0; v < vectors; v++)
+      BlockedStore<BLOCK>(_args.output + ow * BLOCK + v * lanes, MAXIMUM ? acc[v] : Mul(acc[v], scale));
+  }
+}
@@ -0,0 +1,78 @@
+// File Name:     convert.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Conversions between float and the reduced precision and 8-bit types
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// The conversion itself is in the overloads of "Load" and "Store" of the SIMD abstraction,
+// unrolled by 4 vectors like the elementwise kernels
+template <typename SRC, typename DST>
+inline void ConvertF32(const SRC* _x, DST* _y, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+  size_t i = 0;
+
+  for (; i + 4 * width <= _length; i += 4 * width)
+  {
+    VecF32 r0 = Load(_x + i);
+    VecF32 r1 = Load(_x + i + width);
+    VecF32 r2 = Load(_x + i + 2 * width);
+    VecF32 r3 = Load(_x + i + 3 * width);
+    Store(_y + i, r0);
+    Store(_y + i + width, r1);
+    Store(_y + i + 2 * width, r2);
+    Store(_y + i + 3 * width, r3);
+  }
+
+  for (; i + width <= _length; i += width)
+    Store(_y + i, Load(_x + i));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_y + i, LoadPartial(_x + i, rest), rest);
+  }
+}
+
+// _y = _x / _scale + _zero_point, rounded and saturated by "Store", T is int8_t or uint8_t
+template <typename T>
+inline void QuantizeF32(const float* _x, T* _y, size_t _length, float _scale, int32_t _zero_point) noexcept
+{
+  const size_t width = VecF32::width;
+  const VecF32 inverse = Set(1.0f / _scale);
+  const VecF32 zero_point = Set((float)_zero_point);
+  size_t i = 0;
+
+  for (; i + width <= _length; i += width)
+    Store(_y + i, Fma(Load(_x + i), inverse, zero_point));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_y + i, Fma(LoadPartial(_x + i, rest), inverse, zero_point), rest);
+  }
+}
+
+// _y = (_x - _zero_point) * _scale, the difference is an exact integer so the zero point
+// dequantizes to exactly 0, folding it into an Fma would leave the rounding of its product
+template <typename T>
+inline void DequantizeF32(const T* _x, float* _y, size_t _length, float _scale, int32_t _zero_point) noexcept
+{
+  const size_t width = VecF32::width;
+  const VecF32 scale = Set(_scale);
+  const VecF32 zero_point = Set((float)_zero_point);
+  size_t i = 0;
+
+  for (; i + width <= _length; i += width)
+    Store(_y + i, Mul(Sub(Load(_x + i), zero_point), scale));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_y + i, Mul(Sub(LoadPartial(_x + i, rest), zero_point), scale), rest);
+  }
+}
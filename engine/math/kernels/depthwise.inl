@@ -0,0 +1,193 @@
+// File Name:     depthwise.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Depthwise convolution kernels, one filter per channel
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// A depthwise convolution does KH * KW multiply-adds per output, too few to amortize the
+// packing of a GEMM. The kernels keep a strip of outputs in registers instead:
+//   - blocked layouts: vectorized over the channels of a group, every output pixel is one
+//     (or a few) vectors and every weight vector is used for the whole strip of pixels
+//   - plain layout: vectorized over the output columns, for stride 1 the inputs of
+//     consecutive outputs are consecutive; other strides run one output at a time
+// Bias and activation are applied to the accumulators before they are stored.
+// ---------------------
+
+// PIXELS output pixels of a group of channels starting at _ow
+template <size_t BLOCK, size_t PIXELS, bool CHECKED>
+inline void DepthwiseBlockedPixelsF32(const BlockedRowArgs& _args, size_t _ow) noexcept
+{
+  constexpr size_t lanes = blocked_lanes<BLOCK>;
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+
+  const ptrdiff_t first_col = _args.col + (ptrdiff_t)(_ow * _args.stride_w);
+  const size_t pixel_stride = _args.stride_w * BLOCK;
+
+  VecF32 acc[PIXELS][vectors];
+  BlockedBiasF32<BLOCK, PIXELS>(_args, acc);
+
+  for (size_t kh = 0; kh < _args.kernel_h; kh++)
+  {
+    const ptrdiff_t h = _args.row + (ptrdiff_t)(kh * _args.dilation_h);
+    if (h < 0 || h >= (ptrdiff_t)_args.in_height)
+      continue;
+
+    for (size_t kw = 0; kw < _args.kernel_w; kw++)
+    {
+      const ptrdiff_t w = first_col + (ptrdiff_t)(kw * _args.dilation_w);
+      if (CHECKED && (w < 0 || w >= (ptrdiff_t)_args.in_width))
+        continue;
+
+      const float* in = _args.input + (h * (ptrdiff_t)_args.in_width + w) * (ptrdiff_t)BLOCK;
+      const float* weights = _args.filter + (kh * _args.kernel_w + kw) * BLOCK;
+
+      MNT_UNROLL
+      for (size_t v = 0; v < vectors; v++)
+      {
+        const VecF32 weight = BlockedLoad<BLOCK>(weights + v * lanes);
+        MNT_UNROLL
+        for (size_t p = 0; p < PIXELS; p++)
+          acc[p][v] = Fma(BlockedLoad<BLOCK>(in + p * pixel_stride + v * lanes), weight, acc[p][v]);
+      }
+    }
+  }
+
+  BlockedEpilogueF32<BLOCK, PIXELS>(_args, _ow, acc);
+}
+
+// One output row of one group of channels
+template <size_t BLOCK>
+inline void DepthwiseBlockedRowF32(const BlockedRowArgs& _args) noexcept
+{
+  constexpr size_t vectors = blocked_vectors<BLOCK>;
+  constexpr size_t pixels = vectors >= 8 ? 1 : 8 / vectors;
+
+  BlockedRowF32<pixels>(_args, &DepthwiseBlockedPixelsF32<BLOCK, pixels, false>,
+                        &DepthwiseBlockedPixelsF32<BLOCK, 1, false>, &DepthwiseBlockedPixelsF32<BLOCK, 1, true>);
+}
+
+// One output of a channel in the plain layout
+template <bool CHECKED>
+inline void DepthwisePixelF32(const BlockedRowArgs& _args, size_t _ow) noexcept
+{
+  const ptrdiff_t first_col = _args.col + (ptrdiff_t)(_ow * _args.stride_w);
+  float sum = _args.bias ? *_args.bias : 0.0f;
+
+  for (size_t kh = 0; kh < _args.kernel_h; kh++)
+  {
+    const ptrdiff_t h = _args.row + (ptrdiff_t)(kh * _args.dilation_h);
+    if (h < 0 || h >= (ptrdiff_t)_args.in_height)
+      continue;
+
+    const float* in = _args.input + h * (ptrdiff_t)_args.in_width;
+    for (size_t kw = 0; kw < _args.kernel_w; kw++)
+    {
+      const ptrdiff_t w = first_col + (ptrdiff_t)(kw * _args.dilation_w);
+      if (!CHECKED || (w >= 0 && w < (ptrdiff_t)_args.in_width))
+        sum += _args.filter[kh * _args.kernel_w + kw] * in[w];
+    }
+  }
+
+  _args.output[_ow] = mnt::Activate(sum, _args.activation);
+}
+
+// VECTORS vectors of consecutive outputs starting at _ow, stride 1 and inside the input
+template <size_t VECTORS>
+inline void DepthwiseStripF32(const BlockedRowArgs& _args, size_t _ow) noexcept
+{
+  const size_t width = VecF32::width;
+  const ptrdiff_t first_col = _args.col + (ptrdiff_t)_ow;
+
+  VecF32 acc[VECTORS];
+  const VecF32 bias = _args.bias ? Set(*_args.bias) : Zero();
+
+  MNT_UNROLL
+  for (size_t v = 0; v < VECTORS; v++)
+    acc[v] = bias;
+
+  for (size_t kh = 0; kh < _args.kernel_h; kh++)
+  {
+    const ptrdiff_t h = _args.row + (ptrdiff_t)(kh * _args.dilation_h);
+    if (h < 0 || h >= (ptrdiff_t)_args.in_height)
+      continue;
+
+    const float* in = _args.input + h * (ptrdiff_t)_args.in_width + first_col;
+    for (size_t kw = 0; kw < _args.kernel_w; kw++)
+    {
+      const VecF32 weight = Set(_args.filter[kh * _args.kernel_w + kw]);
+      const float* src = in + kw * _args.dilation_w;
+
+      MNT_UNROLL
+      for (size_t v = 0; v < VECTORS; v++)
+        acc[v] = Fma(Load(src + v * width), weight, acc[v]);
+    }
+  }
+
+  MNT_UNROLL
+  for (size_t v = 0; v < VECTORS; v++)
+    Store(_args.output + _ow + v * width, ActivateF32(acc[v], _args.activation));
+}
+
+// _count < width consecutive outputs starting at _ow, stride 1 and inside the input
+inline void DepthwiseTailF32(const BlockedRowArgs& _args, size_t _ow, size_t _count) noexcept
+{
+  const ptrdiff_t first_col = _args.col + (ptrdiff_t)_ow;
+  VecF32 acc = _args.bias ? Set(*_args.bias) : Zero();
+
+  for (size_t kh = 0; kh < _args.kernel_h; kh++)
+  {
+    const ptrdiff_t h = _args.row + (ptrdiff_t)(kh * _args.dilation_h);
+    if (h < 0 || h >= (ptrdiff_t)_args.in_height)
+      continue;
+
+    const float* in = _args.input + h * (ptrdiff_t)_args.in_width + first_col;
+    for (size_t kw = 0; kw < _args.kernel_w; kw++)
+      acc = Fma(LoadPartial(in + kw * _args.dilation_w, _count), Set(_args.filter[kh * _args.kernel_w + kw]), acc);
+  }
+
+  StorePartial(_args.output + _ow, ActivateF32(acc, _args.activation), _count);
+}
+
+inline void DepthwiseRowF32(const BlockedRowArgs& _args) noexcept
+{
+  const size_t width = VecF32::width;
+
+  if (_args.stride_w != 1)
+  {
+    BlockedRowF32<1>(_args, &DepthwisePixelF32<false>, &DepthwisePixelF32<false>, &DepthwisePixelF32<true>);
+    return;
+  }
+
+  // Same split as the blocked kernels, with strips of 4 vectors, then of one vector,
+  // then a partial one
+  const ptrdiff_t extent = (ptrdiff_t)((_args.kernel_w - 1) * _args.dilation_w);
+  size_t inner_begin = _args.col >= 0 ? 0 : (size_t)(-_args.col);
+  ptrdiff_t last = (ptrdiff_t)_args.in_width - 1 - extent - _args.col;
+  size_t inner_end = last < 0 ? 0 : std::min(_args.out_width, (size_t)(last + 1));
+  inner_begin = std::min(inner_begin, inner_end);
+
+  size_t ow = 0;
+  for (; ow < inner_begin; ow++)
+    DepthwisePixelF32<true>(_args, ow);
+
+  for (; ow + 4 * width <= inner_end; ow += 4 * width)
+    DepthwiseStripF32<4>(_args, ow);
+
+  for (; ow + width <= inner_end; ow += width)
+    DepthwiseStripF32<1>(_args, ow);
+
+  if (ow < inner_end)
+  {
+    DepthwiseTailF32(_args, ow, inner_end - ow);
+    ow = inner_end;
+  }
+
+  for (; ow < _args.out_width; ow++)
+    DepthwisePixelF32<true>(_args, ow);
+}
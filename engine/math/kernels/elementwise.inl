@@ -0,0 +1,217 @@
+// File Name:     elementwise.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Elementwise float kernels, written against the SIMD abstraction
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+struct AddOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Add(_a, _b);}};
+struct SubOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Sub(_a, _b);}};
+struct MulOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Mul(_a, _b);}};
+struct DivOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Div(_a, _b);}};
+struct MaxOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Max(_a, _b);}};
+struct MinOp {static VecF32 Apply(const VecF32 _a, const VecF32 _b) noexcept {return Min(_a, _b);}};
+
+// Unrolled by 4 vectors to hide the latency of loads, the tail is handled with partial loads
+template <typename OP>
+inline void BinaryF32(const float* _a, const float* _b, float* _out, const size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+  size_t i = 0;
+
+  for (; i + 4 * width <= _length; i += 4 * width)
+  {
+    VecF32 r0 = OP::Apply(Load(_a + i), Load(_b + i));
+    VecF32 r1 = OP::Apply(Load(_a + i + width), Load(_b + i + width));
+    VecF32 r2 = OP::Apply(Load(_a + i + 2 * width), Load(_b + i + 2 * width));
+    VecF32 r3 = OP::Apply(Load(_a + i + 3 * width), Load(_b + i + 3 * width));
+    Store(_out + i, r0);
+    Store(_out + i + width, r1);
+    Store(_out + i + 2 * width, r2);
+    Store(_out + i + 3 * width, r3);
+  }
+
+  for (; i + width <= _length; i += width)
+    Store(_out + i, OP::Apply(Load(_a + i), Load(_b + i)));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_out + i, OP::Apply(LoadPartial(_a + i, rest), LoadPartial(_b + i, rest)), rest);
+  }
+}
+
+inline void AddF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<AddOp>(_a, _b, _out, _length);}
+
+inline void SubF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<SubOp>(_a, _b, _out, _length);}
+
+inline void MulF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<MulOp>(_a, _b, _out, _length);}
+
+inline void DivF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<DivOp>(_a, _b, _out, _length);}
+
+inline void MaximumF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<MaxOp>(_a, _b, _out, _length);}
+
+inline void MinimumF32(const float* _a, const float* _b, float* _out, size_t _length) noexcept
+{BinaryF32<MinOp>(_a, _b, _out, _length);}
+
+// _y = _op(_x), the tail is handled with partial loads
+template <typename OP>
+inline void MapRowF32(const float* _x, float* _y, size_t _length, const OP& _op) noexcept
+{
+  const size_t width = VecF32::width;
+  size_t i = 0;
+
+  for (; i + width <= _length; i += width)
+    Store(_y + i, _op(Load(_x + i)));
+
+  if (i < _length)
+    StorePartial(_y + i, _op(LoadPartial(_x + i, _length - i)), _length - i);
+}
+
+// _out = _op(_a, _b)
+template <typename OP>
+inline void ZipRowF32(const float* _a, const float* _b, float* _out, size_t _length, const OP& _op) noexcept
+{
+  const size_t width = VecF32::width;
+  size_t i = 0;
+
+  for (; i + width <= _length; i += width)
+    Store(_out + i, _op(Load(_a + i), Load(_b + i)));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_out + i, _op(LoadPartial(_a + i, rest), LoadPartial(_b + i, rest)), rest);
+  }
+}
+
+inline void ExpF32(const float* _x, float* _y, size_t _length) noexcept
+{MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return Exp(_a);});}
+
+inline void LogF32(const float* _x, float* _y, size_t _length) noexcept
+{MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return Log(_a);});}
+
+inline void TanhF32(const float* _x, float* _y, size_t _length) noexcept
+{MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return Tanh(_a);});}
+
+inline void SigmoidF32(const float* _x, float* _y, size_t _length) noexcept
+{MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return Sigmoid(_a);});}
+
+inline void ErfF32(const float* _x, float* _y, size_t _length) noexcept
+{MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return Erf(_a);});}
+
+inline VecF32 ActivateF32(const VecF32 _a, Activation _activation) noexcept
+{
+  switch (_activation)
+  {
+  case Activation::Relu:    return Max(_a, Zero());
+  case Activation::Relu6:   return Min(Max(_a, Zero()), Set(6.0f));
+  case Activation::Sigmoid: return Sigmoid(_a);
+  case Activation::Tanh:    return Tanh(_a);
+  case Activation::Gelu:    return Gelu(_a);
+  case Activation::Silu:    return Silu(_a);
+  default:                  return _a;
+  }
+}
+
+// _x is the input of the activation, or its output for Sigmoid and Tanh
+inline VecF32 ActivateBackwardF32(const VecF32 _x, const VecF32 _dy, Activation _activation) noexcept
+{
+  const VecF32 one = Set(1.0f);
+
+  switch (_activation)
+  {
+  case Activation::Relu:    return SelectLess(Zero(), _x, _dy, Zero());
+  case Activation::Relu6:   return SelectLess(Zero(), _x, SelectLess(_x, Set(6.0f), _dy, Zero()), Zero());
+  case Activation::Sigmoid: return Mul(_dy, Mul(_x, Sub(one, _x)));
+  case Activation::Tanh:    return Mul(_dy, Sub(one, Mul(_x, _x)));
+  case Activation::Gelu:    return Mul(_dy, GeluGrad(_x));
+  case Activation::Silu:    return Mul(_dy, SiluGrad(_x));
+  default:                  return _dy;
+  }
+}
+
+// The switch is resolved once per row, every activation gets its own loop
+template <Activation ACTIVATION>
+inline void ActivationRowF32(const float* _x, float* _y, size_t _length) noexcept
+{
+  MapRowF32(_x, _y, _length, [](const VecF32 _a) noexcept {return ActivateF32(_a, ACTIVATION);});
+}
+
+template <Activation ACTIVATION>
+inline void ActivationBackwardRowF32(const float* _x, const float* _dy, float* _dx, size_t _length) noexcept
+{
+  ZipRowF32(_x, _dy, _dx, _length, [](const VecF32 _a, const VecF32 _b) noexcept
+  {
+    return ActivateBackwardF32(_a, _b, ACTIVATION);
+  });
+}
+
+inline void ActivationF32(const float* _x, float* _y, size_t _length, Activation _activation) noexcept
+{
+  switch (_activation)
+  {
+  case Activation::Relu:    ActivationRowF32<Activation::Relu>(_x, _y, _length); break;
+  case Activation::Relu6:   ActivationRowF32<Activation::Relu6>(_x, _y, _length); break;
+  case Activation::Sigmoid: ActivationRowF32<Activation::Sigmoid>(_x, _y, _length); break;
+  case Activation::Tanh:    ActivationRowF32<Activation::Tanh>(_x, _y, _length); break;
+  case Activation::Gelu:    ActivationRowF32<Activation::Gelu>(_x, _y, _length); break;
+  case Activation::Silu:    ActivationRowF32<Activation::Silu>(_x, _y, _length); break;
+  default:                  std::memmove(_y, _x, _length * sizeof(float)); break;
+  }
+}
+
+inline void ActivationBackwardF32(const float* _x, const float* _dy, float* _dx, size_t _length,
+                                  Activation _activation) noexcept
+{
+  switch (_activation)
+  {
+  case Activation::Relu:    ActivationBackwardRowF32<Activation::Relu>(_x, _dy, _dx, _length); break;
+  case Activation::Relu6:   ActivationBackwardRowF32<Activation::Relu6>(_x, _dy, _dx, _length); break;
+  case Activation::Sigmoid: ActivationBackwardRowF32<Activation::Sigmoid>(_x, _dy, _dx, _length); break;
+  case Activation::Tanh:    ActivationBackwardRowF32<Activation::Tanh>(_x, _dy, _dx, _length); break;
+  case Activation::Gelu:    ActivationBackwardRowF32<Activation::Gelu>(_x, _dy, _dx, _length); break;
+  case Activation::Silu:    ActivationBackwardRowF32<Activation::Silu>(_x, _dy, _dx, _length); break;
+  default:                  std::memmove(_dx, _dy, _length * sizeof(float)); break;
+  }
+}
+
+// x for positive x, _alpha * x otherwise
+inline void LeakyReluF32(const float* _x, float* _y, size_t _length, float _alpha) noexcept
+{
+  const VecF32 alpha = Set(_alpha);
+  MapRowF32(_x, _y, _length, [alpha](const VecF32 _a) noexcept {return SelectLess(_a, Zero(), Mul(_a, alpha), _a);});
+}
+
+inline void LeakyReluBackwardF32(const float* _x, const float* _dy, float* _dx, size_t _length, float _alpha) noexcept
+{
+  const VecF32 alpha = Set(_alpha);
+  ZipRowF32(_x, _dy, _dx, _length, [alpha](const VecF32 _a, const VecF32 _b) noexcept
+  {
+    return SelectLess(Zero(), _a, _b, Mul(_b, alpha));
+  });
+}
+
+inline void BiasActivationF32(float* _data, size_t _length, float _bias, Activation _activation) noexcept
+{
+  const size_t width = VecF32::width;
+  const VecF32 bias = Set(_bias);
+  size_t i = 0;
+
+  for (; i + width <= _length; i += width)
+    Store(_data + i, ActivateF32(Add(Load(_data + i), bias), _activation));
+
+  if (i < _length)
+  {
+    const size_t rest = _length - i;
+    StorePartial(_data + i, ActivateF32(Add(LoadPartial(_data + i, rest), bias), _activation), rest);
+  }
+}
@@ -0,0 +1,170 @@
+// File Name:     extensions.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Kernels for instruction set extensions beyond the ISA levels
+
+// ---------------------
+// Detail Description:
+// The ISA levels of "mnt::CPU" are the baselines that every kernel is compiled for, some CPUs
+// have extensions on top of them that only a few kernels can use, e.g. AVX512-BF16.
+// Those kernels are written here with intrinsics, each one in the target region of its
+// extension, and "Bind" puts them over the table of their level if "CPU::Features()"
+// reports the extension, the rest of the table stays the same.
+// The VNNI extensions only change the integer dot product of the int8 GEMM, so "qgemm.inl"
+// is compiled again in their namespaces, next to a "VecI32" and "DotU8S8" made of VPDPBUSD
+// and the float operations of their level.
+// ---------------------
+
+// ---------------------
+// Note:
+// The AVX512-BF16 conversion treats denormal floats as zero, the vectorized integer
+// rounding of the AVX-512 level keeps them, both round the rest to nearest even
+// ---------------------
+
+// ---------------------
+// Note:
+// VPDPBUSD adds the 4 products of a lane in int32 without saturation, so the weights of the
+// int8 GEMM can use the whole int8 range, the PMADDUBSW kernels of the levels limit them to
+// +-63, see "KernelTable::qgemm_weight_max". The packed layout is the same
+// ---------------------
+
+// =====
+// [Bind(_table, _isa)]: Puts the kernels of the extensions of the CPU over _table, the table of _isa
+// =====
+
+#ifndef ENGINE_MATH_KERNELS_EXTENSIONS_HPP
+#define ENGINE_MATH_KERNELS_EXTENSIONS_HPP
+
+#include "math/simd/simd.hpp"
+#include "math/kernels/registry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#if defined(MNT_SIMD_X86)
+
+MNT_TARGET_AVX512_BF16_BEGIN
+namespace mnt { namespace kernels { namespace extensions {
+
+  inline void FloatToBFloat16AVX512BF16(const float* _x, BFloat16* _y, size_t _length) noexcept
+  {
+    size_t i = 0;
+
+    for (; i + 32 <= _length; i += 32)
+    {
+      const __m512bh y = _mm512_cvtne2ps_pbh(_mm512_loadu_ps(_x + i + 16), _mm512_loadu_ps(_x + i));
+      _mm512_storeu_si512(_y + i, (__m512i)y);
+    }
+
+    for (; i < _length; i += 16)
+    {
+      const __mmask16 mask = simd::avx512::TailMask(_length - i);
+      const __m256bh y = _mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(mask, _x + i));
+      _mm256_mask_storeu_epi16(_y + i, mask, (__m256i)y);
+    }
+  }
+
+}}}
+MNT_TARGET_END
+
+MNT_TARGET_AVX512_VNNI_BEGIN
+namespace mnt { namespace kernels { namespace extensions { namespace avx512_vnni {
+
+  using namespace mnt::simd::avx512;
+
+  struct VecI32
+  {
+    static constexpr size_t width = 16;
+    __m512i v;
+  };
+
+  constexpr int32_t dot_weight_max = 127;
+
+  inline VecI32 ZeroI32() noexcept {return {_mm512_setzero_si512()};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm512_set1_epi32(bytes)};
+  }
+
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {return {_mm512_dpbusd_epi32(_acc.v, _a.v, _mm512_loadu_si512(_b))};}
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm512_add_epi32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {_mm512_cvtepi32_ps(_a.v)};}
+
+  #include "math/kernels/qgemm.inl"
+
+}}}}
+MNT_TARGET_END
+
+MNT_TARGET_AVX_VNNI_BEGIN
+namespace mnt { namespace kernels { namespace extensions { namespace avx_vnni {
+
+  using namespace mnt::simd::avx2;
+
+  struct VecI32
+  {
+    static constexpr size_t width = 8;
+    __m256i v;
+  };
+
+  constexpr int32_t dot_weight_max = 127;
+
+  inline VecI32 ZeroI32() noexcept {return {_mm256_setzero_si256()};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm256_set1_epi32(bytes)};
+  }
+
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {return {_mm256_dpbusd_avx_epi32(_acc.v, _a.v, _mm256_loadu_si256((const __m256i*)_b))};}
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm256_add_epi32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {_mm256_cvtepi32_ps(_a.v)};}
+
+  #include "math/kernels/qgemm.inl"
+
+}}}}
+MNT_TARGET_END
+
+#endif
+
+namespace mnt { namespace kernels { namespace extensions {
+
+  inline void Bind(KernelTable& _table, const ISA _isa) noexcept
+  {
+#if defined(MNT_SIMD_X86)
+    const CPUFeatures& features = CPU::Features();
+
+    if (_isa == ISA::AVX512 && features.avx512bf16)
+      _table.float_to_bfloat16 = &FloatToBFloat16AVX512BF16;
+
+    if (_isa == ISA::AVX512 && features.avx512vnni)
+    {
+      _table.qgemm_nr = avx512_vnni::qgemm_nr;
+      _table.qgemm_weight_max = avx512_vnni::dot_weight_max;
+      _table.qgemm_pack_b = &avx512_vnni::QGemmPackBS8;
+      _table.qgemm = &avx512_vnni::QGemmU8S8;
+    }
+
+    if (_isa == ISA::AVX2 && features.avxvnni)
+    {
+      _table.qgemm_nr = avx_vnni::qgemm_nr;
+      _table.qgemm_weight_max = avx_vnni::dot_weight_max;
+      _table.qgemm_pack_b = &avx_vnni::QGemmPackBS8;
+      _table.qgemm = &avx_vnni::QGemmU8S8;
+    }
+#endif
+  }
+
+}}}
+
+#endif
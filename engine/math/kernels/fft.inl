@@ -0,0 +1,259 @@
+// File Name:     fft.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Stockham passes, real FFT post/pre processing and spectral products
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Complex values are split, real parts and imaginary parts live in separate arrays, so a
+// vector holds the same component of consecutive values. The transforms are batched and
+// every pass reads and writes runs of _run consecutive floats (see "math/fft.hpp"), the
+// kernels vectorize over these runs and never shuffle lanes.
+// ---------------------
+
+struct ComplexF32
+{
+  VecF32 re;
+  VecF32 im;
+};
+
+inline ComplexF32 FftAdd(const ComplexF32& _a, const ComplexF32& _b) noexcept
+{return {Add(_a.re, _b.re), Add(_a.im, _b.im)};}
+
+inline ComplexF32 FftSub(const ComplexF32& _a, const ComplexF32& _b) noexcept
+{return {Sub(_a.re, _b.re), Sub(_a.im, _b.im)};}
+
+inline ComplexF32 FftMul(const ComplexF32& _a, const ComplexF32& _b) noexcept
+{return {Sub(Mul(_a.re, _b.re), Mul(_a.im, _b.im)), Fma(_a.re, _b.im, Mul(_a.im, _b.re))};}
+
+// _a * -i for the forward transform, _a * i for the inverse one
+template <bool INVERSE>
+inline ComplexF32 FftRotate(const ComplexF32& _a) noexcept
+{
+  if constexpr (INVERSE)
+    return {Sub(Zero(), _a.im), _a.re};
+  else
+    return {_a.im, Sub(Zero(), _a.re)};
+}
+
+// DFT of RADIX points in place, with exp(-2 pi i / RADIX) (or its conjugate if INVERSE)
+template <size_t RADIX, bool INVERSE>
+inline void FftButterfly(ComplexF32 _x[RADIX]) noexcept
+{
+  if constexpr (RADIX == 2)
+  {
+    const ComplexF32 a = _x[0];
+    _x[0] = FftAdd(a, _x[1]);
+    _x[1] = FftSub(a, _x[1]);
+  }
+  else if constexpr (RADIX == 3)
+  {
+    const VecF32 half = Set(0.5f), sin60 = Set(0.866025403784438647f);
+    const ComplexF32 sum = FftAdd(_x[1], _x[2]);
+    const ComplexF32 diff = FftRotate<INVERSE>(FftSub(_x[1], _x[2]));
+    const ComplexF32 base = {Sub(_x[0].re, Mul(half, sum.re)), Sub(_x[0].im, Mul(half, sum.im))};
+    const ComplexF32 side = {Mul(sin60, diff.re), Mul(sin60, diff.im)};
+
+    _x[0] = FftAdd(_x[0], sum);
+    _x[1] = FftAdd(base, side);
+    _x[2] = FftSub(base, side);
+  }
+  else if constexpr (RADIX == 4)
+  {
+    const ComplexF32 a = FftAdd(_x[0], _x[2]), b = FftSub(_x[0], _x[2]);
+    const ComplexF32 c = FftAdd(_x[1], _x[3]), d = FftRotate<INVERSE>(FftSub(_x[1], _x[3]));
+
+    _x[0] = FftAdd(a, c);
+    _x[1] = FftAdd(b, d);
+    _x[2] = FftSub(a, c);
+    _x[3] = FftSub(b, d);
+  }
+  else
+  {
+    static_assert(RADIX == 5, "Only radices 2, 3, 4 and 5 are supported");
+
+    const VecF32 c1 = Set(0.309016994374947424f), c2 = Set(-0.809016994374947424f);
+    const VecF32 s1 = Set(0.951056516295153572f), s2 = Set(0.587785252292473129f);
+
+    const ComplexF32 a1 = FftAdd(_x[1], _x[4]), b1 = FftSub(_x[1], _x[4]);
+    const ComplexF32 a2 = FftAdd(_x[2], _x[3]), b2 = FftSub(_x[2], _x[3]);
+
+    const ComplexF32 base1 = {Fma(c2, a2.re, Fma(c1, a1.re, _x[0].re)), Fma(c2, a2.im, Fma(c1, a1.im, _x[0].im))};
+    const ComplexF32 base2 = {Fma(c1, a2.re, Fma(c2, a1.re, _x[0].re)), Fma(c1, a2.im, Fma(c2, a1.im, _x[0].im))};
+    const ComplexF32 side1 = FftRotate<INVERSE>({Fma(s2, b2.re, Mul(s1, b1.re)), Fma(s2, b2.im, Mul(s1, b1.im))});
+    const ComplexF32 side2 = FftRotate<INVERSE>({Sub(Mul(s2, b1.re), Mul(s1, b2.re)), Sub(Mul(s2, b1.im), Mul(s1, b2.im))});
+
+    _x[0] = FftAdd(_x[0], FftAdd(a1, a2));
+    _x[1] = FftAdd(base1, side1);
+    _x[4] = FftSub(base1, side1);
+    _x[2] = FftAdd(base2, side2);
+    _x[3] = FftSub(base2, side2);
+  }
+}
+
+// One pass: for j < _l, the RADIX input runs at (j * RADIX + s) * _run are multiplied by the
+// twiddles w^(j s), transformed, and stored as the output runs at (j + _l * t) * _run
+template <size_t RADIX, bool INVERSE>
+inline void FftPassRadixF32(const float* _in_re, const float* _in_im, float* _out_re, float* _out_im,
+                            size_t _l, size_t _run, const float* _twiddle_re, const float* _twiddle_im) noexcept
+{
+  const size_t width = VecF32::width;
+  const size_t out_stride = _l * _run;
+
+  for (size_t j = 0; j < _l; j++)
+  {
+    ComplexF32 twiddle[RADIX];
+    for (size_t s = 1; s < RADIX; s++)
+    {
+      const float im = _twiddle_im[j * (RADIX - 1) + s - 1];
+      twiddle[s] = {Set(_twiddle_re[j * (RADIX - 1) + s - 1]), Set(INVERSE ? -im : im)};
+    }
+
+    const float* in_re = _in_re + j * RADIX * _run;
+    const float* in_im = _in_im + j * RADIX * _run;
+    float* out_re = _out_re + j * _run;
+    float* out_im = _out_im + j * _run;
+
+    for (size_t i = 0; i < _run; i += width)
+    {
+      const size_t count = std::min(width, _run - i);
+      ComplexF32 x[RADIX];
+
+      MNT_UNROLL
+      for (size_t s = 0; s < RADIX; s++)
+      {
+        const size_t offset = s * _run + i;
+        x[s] = count == width ? ComplexF32{Load(in_re + offset), Load(in_im + offset)}
+                              : ComplexF32{LoadPartial(in_re + offset, count), LoadPartial(in_im + offset, count)};
+        if (s > 0 && j > 0)
+          x[s] = FftMul(x[s], twiddle[s]);
+      }
+
+      FftButterfly<RADIX, INVERSE>(x);
+
+      MNT_UNROLL
+      for (size_t t = 0; t < RADIX; t++)
+      {
+        const size_t offset = t * out_stride + i;
+        if (count == width)
+        {
+          Store(out_re + offset, x[t].re);
+          Store(out_im + offset, x[t].im);
+        }
+        else
+        {
+          StorePartial(out_re + offset, x[t].re, count);
+          StorePartial(out_im + offset, x[t].im, count);
+        }
+      }
+    }
+  }
+}
+
+inline void FftPassF32(const float* _in_re, const float* _in_im, float* _out_re, float* _out_im,
+                       size_t _radix, size_t _l, size_t _run, const float* _twiddle_re,
+                       const float* _twiddle_im, bool _inverse) noexcept
+{
+  auto pass = _inverse ?
+    (_radix == 2 ? &FftPassRadixF32<2, true> : _radix == 3 ? &FftPassRadixF32<3, true> :
+     _radix == 4 ? &FftPassRadixF32<4, true> : &FftPassRadixF32<5, true>) :
+    (_radix == 2 ? &FftPassRadixF32<2, false> : _radix == 3 ? &FftPassRadixF32<3, false> :
+     _radix == 4 ? &FftPassRadixF32<4, false> : &FftPassRadixF32<5, false>);
+
+  pass(_in_re, _in_im, _out_re, _out_im, _l, _run, _twiddle_re, _twiddle_im);
+}
+
+// Z = FFT of the _half complex values z[k] = x[2k] + i x[2k+1], _batch transforms side by side.
+// Bin k of x, k <= _half, is E + w^k O with E = (Z[k] + conj(Z[h-k])) / 2 and
+// O = (Z[k] - conj(Z[h-k])) / 2i, the inverse (_inverse) recovers Z from the bins.
+inline void FftRealF32(const float* _in_re, const float* _in_im, float* _out_re, float* _out_im,
+                       size_t _half, size_t _batch, const float* _twiddle_re, const float* _twiddle_im,
+                       bool _inverse) noexcept
+{
+  const size_t width = VecF32::width;
+  const VecF32 half = Set(0.5f);
+  const size_t bins = _inverse ? _half : _half + 1;
+
+  for (size_t k = 0; k < bins; k++)
+  {
+    // Forward reads Z[k mod h] and Z[(h-k) mod h], inverse reads X[k] and X[h-k]
+    const size_t first = _inverse ? k : k % _half;
+    const size_t second = _inverse ? _half - k : (_half - k) % _half;
+    const ComplexF32 w = {Set(_twiddle_re[k]), Set(_inverse ? -_twiddle_im[k] : _twiddle_im[k])};
+
+    for (size_t i = 0; i < _batch; i += width)
+    {
+      const size_t count = std::min(width, _batch - i);
+      const ComplexF32 a = {LoadPartial(_in_re + first * _batch + i, count), LoadPartial(_in_im + first * _batch + i, count)};
+      const ComplexF32 b = {LoadPartial(_in_re + second * _batch + i, count), LoadPartial(_in_im + second * _batch + i, count)};
+
+      // even = (a + conj(b)) / 2, diff = (a - conj(b)) / 2
+      const ComplexF32 even = {Mul(half, Add(a.re, b.re)), Mul(half, Sub(a.im, b.im))};
+      const ComplexF32 diff = {Mul(half, Sub(a.re, b.re)), Mul(half, Add(a.im, b.im))};
+
+      ComplexF32 result;
+      if (_inverse)
+      {
+        // Z = even + i * conj(w^k) * diff
+        const ComplexF32 odd = FftMul(diff, w);
+        result = {Sub(even.re, odd.im), Add(even.im, odd.re)};
+      }
+      else
+      {
+        // X = even + w^k * diff / i
+        const ComplexF32 odd = FftMul({diff.im, Sub(Zero(), diff.re)}, w);
+        result = FftAdd(even, odd);
+      }
+
+      StorePartial(_out_re + k * _batch + i, result.re, count);
+      StorePartial(_out_im + k * _batch + i, result.im, count);
+    }
+  }
+}
+
+// C[_rows x _cols] = A[_rows x _depth] * B[_depth x _cols], complex and row-major, the rows
+// of A are _a_stride apart, vectorized over the columns of B and C
+inline void ComplexGemmF32(const float* _a_re, const float* _a_im, size_t _a_stride,
+                           const float* _b_re, const float* _b_im, float* _c_re, float* _c_im,
+                           size_t _rows, size_t _depth, size_t _cols) noexcept
+{
+  const size_t width = VecF32::width;
+
+  for (size_t row = 0; row < _rows; row++)
+  {
+    const float* a_re = _a_re + row * _a_stride;
+    const float* a_im = _a_im + row * _a_stride;
+
+    for (size_t col = 0; col < _cols; col += 2 * width)
+    {
+      const size_t count_0 = std::min(width, _cols - col);
+      const size_t count_1 = _cols - col > width ? std::min(width, _cols - col - width) : 0;
+
+      ComplexF32 acc_0 = {Zero(), Zero()}, acc_1 = {Zero(), Zero()};
+
+      for (size_t k = 0; k < _depth; k++)
+      {
+        const ComplexF32 a = {Set(a_re[k]), Set(a_im[k])};
+        const float* b_re = _b_re + k * _cols + col;
+        const float* b_im = _b_im + k * _cols + col;
+
+        acc_0 = FftAdd(acc_0, FftMul(a, {LoadPartial(b_re, count_0), LoadPartial(b_im, count_0)}));
+        if (count_1)
+          acc_1 = FftAdd(acc_1, FftMul(a, {LoadPartial(b_re + width, count_1), LoadPartial(b_im + width, count_1)}));
+      }
+
+      StorePartial(_c_re + row * _cols + col, acc_0.re, count_0);
+      StorePartial(_c_im + row * _cols + col, acc_0.im, count_0);
+      if (count_1)
+      {
+        StorePartial(_c_re + row * _cols + col + width, acc_1.re, count_1);
+        StorePartial(_c_im + row * _cols + col + width, acc_1.im, count_1);
+      }
+    }
+  }
+}
@@ -0,0 +1,302 @@
+// File Name:     gemm.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Packing routines and register-blocked micro-kernel of the float GEMM
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// The micro-kernel computes a gemm_mr x gemm_nr block of C, its accumulators live in
+// registers for the whole depth, so every loaded value of B is used gemm_mr times and
+// every broadcast of A gemm_nr_vectors times. A and B are packed beforehand:
+//   - A in panels of gemm_mr rows, column by column: panel[k * gemm_mr + i]
+//   - B in panels of gemm_nr columns, row by row:    panel[k * gemm_nr + j]
+// so the micro-kernel reads both of them sequentially. Panels at the edges are zero padded.
+// B can also hold Half or BFloat16 items, they are converted to float by the packing and
+// skinny kernels, the math is in float either way.
+// ---------------------
+
+constexpr size_t gemm_nr_vectors = VecF32::width == 1 ? 4 : 2;
+constexpr size_t gemm_nr = gemm_nr_vectors * VecF32::width;
+
+// Accumulators + B vectors + one broadcast have to fit in the register file
+constexpr size_t gemm_mr = (VecF32::width >= 16 || simd_isa == ISA::NEON) ? 8 :
+                           (VecF32::width == 1 ? 4 : 6);
+
+inline void GemmPackAF32(const float* _a, size_t _row_stride, size_t _col_stride,
+                         size_t _rows, size_t _depth, float* _packed) noexcept
+{
+  for (size_t panel = 0; panel < _rows; panel += gemm_mr)
+  {
+    const size_t rows = std::min(gemm_mr, _rows - panel);
+    const float* a = _a + panel * _row_stride;
+
+    if (rows == gemm_mr)
+    {
+      for (size_t k = 0; k < _depth; k++)
+      {
+        MNT_UNROLL
+        for (size_t i = 0; i < gemm_mr; i++)
+          _packed[i] = a[i * _row_stride + k * _col_stride];
+        _packed += gemm_mr;
+      }
+    }
+    else
+    {
+      for (size_t k = 0; k < _depth; k++)
+      {
+        for (size_t i = 0; i < gemm_mr; i++)
+          _packed[i] = i < rows ? a[i * _row_stride + k * _col_stride] : 0.0f;
+        _packed += gemm_mr;
+      }
+    }
+  }
+}
+
+template <typename W>
+inline void GemmPackBF32(const W* _b, size_t _row_stride, size_t _col_stride,
+                         size_t _depth, size_t _cols, float* _packed) noexcept
+{
+  const size_t width = VecF32::width;
+
+  for (size_t panel = 0; panel < _cols; panel += gemm_nr)
+  {
+    const size_t cols = std::min(gemm_nr, _cols - panel);
+    const W* b = _b + panel * _col_stride;
+
+    if (_col_stride == 1 && cols == gemm_nr)
+    {
+      for (size_t k = 0; k < _depth; k++)
+      {
+        MNT_UNROLL
+        for (size_t j = 0; j < gemm_nr_vectors; j++)
+          Store(_packed + j * width, Load(b + k * _row_stride + j * width));
+        _packed += gemm_nr;
+      }
+    }
+    else if (_col_stride == 1)
+    {
+      for (size_t k = 0; k < _depth; k++)
+      {
+        for (size_t j = 0; j < gemm_nr_vectors; j++)
+        {
+          const size_t col = j * width;
+          const size_t count = cols > col ? std::min(width, cols - col) : 0;
+          Store(_packed + col, LoadPartial(b + k * _row_stride + col, count));
+        }
+        _packed += gemm_nr;
+      }
+    }
+    else
+    {
+      for (size_t k = 0; k < _depth; k++)
+      {
+        for (size_t j = 0; j < gemm_nr; j++)
+          _packed[j] = j < cols ? (float)b[k * _row_stride + j * _col_stride] : 0.0f;
+        _packed += gemm_nr;
+      }
+    }
+  }
+}
+
+// C[_rows x _cols] (+)= A panel * B panel, _rows <= gemm_mr and _cols <= gemm_nr
+inline void GemmMicroF32(size_t _depth, const float* _a, const float* _b, float* _c, size_t _ldc,
+                         size_t _rows, size_t _cols, bool _accumulate) noexcept
+{
+  const size_t width = VecF32::width;
+
+  VecF32 acc[gemm_mr][gemm_nr_vectors];
+
+  MNT_UNROLL
+  for (size_t i = 0; i < gemm_mr; i++)
+    MNT_UNROLL
+    for (size_t j = 0; j < gemm_nr_vectors; j++)
+      acc[i][j] = Zero();
+
+  for (size_t k = 0; k < _depth; k++)
+  {
+    VecF32 b[gemm_nr_vectors];
+
+    MNT_UNROLL
+    for (size_t j = 0; j < gemm_nr_vectors; j++)
+      b[j] = Load(_b + j * width);
+
+    MNT_UNROLL
+    for (size_t i = 0; i < gemm_mr; i++)
+    {
+      const VecF32 a = Set(_a[i]);
+      MNT_UNROLL
+      for (size_t j = 0; j < gemm_nr_vectors; j++)
+        acc[i][j] = Fma(a, b[j], acc[i][j]);
+    }
+
+    _a += gemm_mr;
+    _b += gemm_nr;
+  }
+
+  if (_rows == gemm_mr && _cols == gemm_nr)
+  {
+    MNT_UNROLL
+    for (size_t i = 0; i < gemm_mr; i++)
+      MNT_UNROLL
+      for (size_t j = 0; j < gemm_nr_vectors; j++)
+      {
+        float* c = _c + i * _ldc + j * width;
+        Store(c, _accumulate ? Add(acc[i][j], Load(c)) : acc[i][j]);
+      }
+    return;
+  }
+
+  // Edge blocks go through a buffer, indexing the accumulators with runtime bounds
+  // would move all of them out of the registers
+  float block[gemm_mr * gemm_nr];
+
+  MNT_UNROLL
+  for (size_t i = 0; i < gemm_mr; i++)
+    MNT_UNROLL
+    for (size_t j = 0; j < gemm_nr_vectors; j++)
+      Store(block + i * gemm_nr + j * width, acc[i][j]);
+
+  for (size_t i = 0; i < _rows; i++)
+    for (size_t j = 0; j < _cols; j++)
+      _c[i * _ldc + j] = _accumulate ? _c[i * _ldc + j] + block[i * gemm_nr + j] : block[i * gemm_nr + j];
+}
+
+// ---------------------
+// Detail Description:
+// Products with a few rows of A are bound by the memory traffic of B, not by the math, so
+// the skinny kernel streams B once without packing A. B is read in panels of gemm_nr
+// columns, either packed (see "math/packed_matrix.hpp") or straight from a row-major matrix,
+// and "Gemm::Skinny" passes it a few rows of B at a time, so every panel computes all the
+// rows of A, gemm_skinny_rows at a time, while it is still in L1. With a single row there
+// are only gemm_nr_vectors chains of FMAs, so the depth is split in interleaved parts with
+// their own accumulators, enough to cover the latency of FMA.
+// ---------------------
+
+constexpr size_t gemm_skinny_rows = 4;
+
+template <size_t ROWS, bool FULL, typename W>
+inline void GemmSkinnyPanelF32(size_t _depth, const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                               const W* _b, size_t _b_row_stride, size_t _cols,
+                               float* _c, size_t _ldc, bool _accumulate) noexcept
+{
+  const size_t width = VecF32::width;
+  constexpr size_t chains = ROWS * gemm_nr_vectors;
+  constexpr size_t split = chains >= 8 ? 1 : 8 / chains;
+
+  size_t counts[gemm_nr_vectors];
+  for (size_t j = 0; j < gemm_nr_vectors; j++)
+    counts[j] = _cols > j * width ? std::min(width, _cols - j * width) : 0;
+
+  VecF32 acc[split][ROWS][gemm_nr_vectors];
+
+  MNT_UNROLL
+  for (size_t s = 0; s < split; s++)
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+      MNT_UNROLL
+      for (size_t j = 0; j < gemm_nr_vectors; j++)
+        acc[s][i][j] = Zero();
+
+  auto step = [&](size_t _k, VecF32 (&_acc)[ROWS][gemm_nr_vectors])
+  {
+    VecF32 b[gemm_nr_vectors];
+    const W* row = _b + _k * _b_row_stride;
+
+    MNT_UNROLL
+    for (size_t j = 0; j < gemm_nr_vectors; j++)
+      b[j] = FULL ? Load(row + j * width) : LoadPartial(row + j * width, counts[j]);
+
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+    {
+      const VecF32 a = Set(_a[i * _a_row_stride + _k * _a_col_stride]);
+      MNT_UNROLL
+      for (size_t j = 0; j < gemm_nr_vectors; j++)
+        _acc[i][j] = Fma(a, b[j], _acc[i][j]);
+    }
+  };
+
+  size_t k = 0;
+  for (; k + split <= _depth; k += split)
+    MNT_UNROLL
+    for (size_t s = 0; s < split; s++)
+      step(k + s, acc[s]);
+
+  for (; k < _depth; k++)
+    step(k, acc[0]);
+
+  MNT_UNROLL
+  for (size_t s = 1; s < split; s++)
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+      MNT_UNROLL
+      for (size_t j = 0; j < gemm_nr_vectors; j++)
+        acc[0][i][j] = Add(acc[0][i][j], acc[s][i][j]);
+
+  for (size_t i = 0; i < ROWS; i++)
+    for (size_t j = 0; j < gemm_nr_vectors && counts[j]; j++)
+    {
+      float* c = _c + i * _ldc + j * width;
+      VecF32 result = acc[0][i][j];
+
+      if (counts[j] == width)
+        Store(c, _accumulate ? Add(result, Load(c)) : result);
+      else
+        StorePartial(c, _accumulate ? Add(result, LoadPartial(c, counts[j])) : result, counts[j]);
+    }
+}
+
+// C[_rows x _cols] (+)= A * B, panel p of B starts at _b + p * _b_panel_stride and its row k
+// at + k * _b_row_stride, _padded if the panel at the edge is zero padded to gemm_nr columns
+template <typename W>
+inline void GemmSkinnyF32(size_t _rows, size_t _cols, size_t _depth,
+                          const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                          const W* _b, size_t _b_row_stride, size_t _b_panel_stride, bool _padded,
+                          float* _c, size_t _ldc, bool _accumulate) noexcept
+{
+  for (size_t panel = 0; panel < _cols; panel += gemm_nr)
+  {
+    const size_t cols = std::min(gemm_nr, _cols - panel);
+    const W* b = _b + panel / gemm_nr * _b_panel_stride;
+    const bool full = _padded || cols == gemm_nr;
+
+    for (size_t row = 0; row < _rows; row += gemm_skinny_rows)
+    {
+      const float* a = _a + row * _a_row_stride;
+      float* c = _c + row * _ldc + panel;
+
+      switch (std::min(gemm_skinny_rows, _rows - row) + (full ? 0 : gemm_skinny_rows))
+      {
+        case 1:
+          GemmSkinnyPanelF32<1, true, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 2:
+          GemmSkinnyPanelF32<2, true, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 3:
+          GemmSkinnyPanelF32<3, true, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 4:
+          GemmSkinnyPanelF32<4, true, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 5:
+          GemmSkinnyPanelF32<1, false, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 6:
+          GemmSkinnyPanelF32<2, false, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        case 7:
+          GemmSkinnyPanelF32<3, false, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+        default:
+          GemmSkinnyPanelF32<4, false, W>(_depth, a, _a_row_stride, _a_col_stride, b, _b_row_stride, cols, c, _ldc, _accumulate);
+          break;
+      }
+    }
+  }
+}
@@ -0,0 +1,30 @@
+// File Name:     kernels.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The list of kernel bodies compiled for every instruction set
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// Keep "vecmath.inl" the first one, the others use its functions
+// Keep "bind.inl" the last one, it binds the kernels defined by the others
+// ---------------------
+
+#include "math/kernels/vecmath.inl"
+#include "math/kernels/elementwise.inl"
+#include "math/kernels/convert.inl"
+#include "math/kernels/mask.inl"
+#include "math/kernels/random.inl"
+#include "math/kernels/layout.inl"
+#include "math/kernels/gemm.inl"
+#include "math/kernels/qgemm.inl"
+#include "math/kernels/sparse.inl"
+#include "math/kernels/small.inl"
+#include "math/kernels/winograd.inl"
+#include "math/kernels/blocked.inl"
+#include "math/kernels/depthwise.inl"
+#include "math/kernels/fft.inl"
+#include "math/kernels/reduce.inl"
+#include "math/kernels/normalize.inl"
+
+#include "math/kernels/bind.inl"
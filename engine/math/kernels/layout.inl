@@ -0,0 +1,31 @@
+// File Name:     layout.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Float kernels that only move data around
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// Cache-blocked out of place transpose, a tile of source and destination stay in L1
+// while it is copied, so both sides are read and written a full cache line at a time
+inline void TransposeF32(const float* _src, float* _dst, size_t _rows, size_t _cols,
+                         size_t _src_ld, size_t _dst_ld) noexcept
+{
+  const size_t tile = 32;
+
+  for (size_t row_tile = 0; row_tile < _rows; row_tile += tile)
+  {
+    const size_t row_end = std::min(row_tile + tile, _rows);
+
+    for (size_t col_tile = 0; col_tile < _cols; col_tile += tile)
+    {
+      const size_t col_end = std::min(col_tile + tile, _cols);
+
+      for (size_t row = row_tile; row < row_end; row++)
+        for (size_t col = col_tile; col < col_end; col++)
+          _dst[col * _dst_ld + row] = _src[row * _src_ld + col];
+    }
+  }
+}
@@ -0,0 +1,138 @@
+// File Name:     mask.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Float kernels of bit-packed masks
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Bit i of a mask is bit i % 64 of word i / 64, see "math/bitmask.hpp". A word covers 64 items,
+// every vector of items takes its lanes from the word with one shift, "NonZeroBits" turns a
+// vector into bits and "SelectBits" picks lanes by bits, so the kernels read 1 bit per item
+// of the mask and never expand it in memory. Bits of the last word beyond _length are zero.
+// ---------------------
+
+constexpr uint32_t mask_lanes = (uint32_t)((1ull << VecF32::width) - 1);
+
+// Bit i = _x[i] != 0
+inline void MaskPackF32(const float* _x, uint64_t* _bits, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+
+  for (size_t w = 0; w * 64 < _length; w++)
+  {
+    const float* x = _x + w * 64;
+    const size_t count = std::min<size_t>(64, _length - w * 64);
+    uint64_t word = 0;
+    size_t i = 0;
+
+    for (; i + width <= count; i += width)
+      word |= (uint64_t)NonZeroBits(Load(x + i)) << i;
+
+    // The zero lanes of the partial load leave the bits beyond _length clear
+    if (i < count)
+      word |= (uint64_t)NonZeroBits(LoadPartial(x + i, count - i)) << i;
+
+    _bits[w] = word;
+  }
+}
+
+// _y[i] = _op(_x[i] vector, bits of the vector), _x is nullptr for the ops that don`t read it
+template <typename OP>
+inline void MaskedMapF32(const float* _x, const uint64_t* _bits, float* _y, size_t _length, const OP& _op) noexcept
+{
+  const size_t width = VecF32::width;
+
+  for (size_t w = 0; w * 64 < _length; w++)
+  {
+    const size_t begin = w * 64;
+    const size_t count = std::min<size_t>(64, _length - begin);
+    const uint64_t word = _bits[w];
+    size_t i = 0;
+
+    for (; i + width <= count; i += width)
+      Store(_y + begin + i, _op(_x ? Load(_x + begin + i) : Zero(), (uint32_t)(word >> i) & mask_lanes));
+
+    if (i < count)
+      StorePartial(_y + begin + i, _op(_x ? LoadPartial(_x + begin + i, count - i) : Zero(),
+                                       (uint32_t)(word >> i) & mask_lanes), count - i);
+  }
+}
+
+inline void MaskUnpackF32(const uint64_t* _bits, float* _y, size_t _length) noexcept
+{
+  const VecF32 one = Set(1.0f);
+  MaskedMapF32(nullptr, _bits, _y, _length, [one](const VecF32, uint32_t _lanes) noexcept
+  {
+    return SelectBits(_lanes, one, Zero());
+  });
+}
+
+// _y = bit ? _value : _x, e.g. -inf on the masked scores of attention
+inline void MaskedFillF32(const float* _x, const uint64_t* _bits, float* _y, size_t _length, float _value) noexcept
+{
+  const VecF32 value = Set(_value);
+  MaskedMapF32(_x, _bits, _y, _length, [value](const VecF32 _a, uint32_t _lanes) noexcept
+  {
+    return SelectBits(_lanes, value, _a);
+  });
+}
+
+// _y = bit ? _x * _scale : 0, dropout with the bits of the kept items
+inline void MaskedScaleF32(const float* _x, const uint64_t* _bits, float* _y, size_t _length, float _scale) noexcept
+{
+  const VecF32 scale = Set(_scale);
+  MaskedMapF32(_x, _bits, _y, _length, [scale](const VecF32 _a, uint32_t _lanes) noexcept
+  {
+    return SelectBits(_lanes, Mul(_a, scale), Zero());
+  });
+}
+
+// Set bits among the first _length ones
+inline size_t MaskCount(const uint64_t* _bits, size_t _length) noexcept
+{
+  const size_t words = _length / 64;
+  size_t count = 0;
+
+  for (size_t w = 0; w < words; w++)
+    count += std::bitset<64>(_bits[w]).count();
+
+  if (_length % 64)
+    count += std::bitset<64>(_bits[words] & ((1ull << (_length % 64)) - 1)).count();
+
+  return count;
+}
+
+// Copies the items of set bits to _y in order, returns their number. Full words are copied
+// as they are, the others visit their set bits only, the index of the lowest one is the
+// popcount of the bits below it
+inline size_t MaskedSelectF32(const float* _x, const uint64_t* _bits, float* _y, size_t _length) noexcept
+{
+  size_t count = 0;
+
+  for (size_t w = 0; w * 64 < _length; w++)
+  {
+    const size_t begin = w * 64;
+    const size_t items = std::min<size_t>(64, _length - begin);
+    const uint64_t word = items == 64 ? _bits[w] : _bits[w] & ((1ull << items) - 1);
+
+    if (word == 0)
+      continue;
+
+    if (items == 64 && word == ~0ull)
+    {
+      std::memcpy(_y + count, _x + begin, 64 * sizeof(float));
+      count += 64;
+      continue;
+    }
+
+    for (uint64_t bits = word; bits != 0; bits &= bits - 1)
+      _y[count++] = _x[begin + std::bitset<64>((bits & (~bits + 1)) - 1).count()];
+  }
+
+  return count;
+}
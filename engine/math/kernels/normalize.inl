@@ -0,0 +1,389 @@
+// File Name:     normalize.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Fused softmax, log-softmax, LayerNorm and RMSNorm of one row, forward and backward
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Every kernel reads its row twice, once for the statistics and once for the output, and
+// writes only the output. Softmax keeps a running maximum and a running sum of exponentials
+// per lane, every block of 4 vectors moves the maximum once and rescales the sum by
+// e^(old - new), so the exponentials are taken once per item and never overflow.
+// LayerNorm merges the means and the sums of squared distances to them (Chan et al.), unlike
+// the sum of squares minus the squared sum it doesn`t cancel when the mean is far from zero.
+// The backward kernels recompute the statistics in their first pass, along with the sums of
+// the gradients they need.
+// ---------------------
+
+// Maximum of the row and sum of e^(x - maximum)
+inline void SoftmaxStatsF32(const float* _x, size_t _length, float& _maximum, float& _sum) noexcept
+{
+  const size_t width = VecF32::width;
+
+  VecF32 m = Set(-std::numeric_limits<float>::max());
+  VecF32 s = Zero();
+  size_t i = 0;
+
+  for (; i + 4 * width <= _length; i += 4 * width)
+  {
+    const VecF32 x0 = Load(_x + i);
+    const VecF32 x1 = Load(_x + i + width);
+    const VecF32 x2 = Load(_x + i + 2 * width);
+    const VecF32 x3 = Load(_x + i + 3 * width);
+    const VecF32 block = Max(m, Max(Max(x0, x1), Max(x2, x3)));
+
+    const VecF32 e01 = Add(Exp(Sub(x0, block)), Exp(Sub(x1, block)));
+    const VecF32 e23 = Add(Exp(Sub(x2, block)), Exp(Sub(x3, block)));
+    s = Fma(s, Exp(Sub(m, block)), Add(e01, e23));
+    m = block;
+  }
+
+  for (; i + width <= _length; i += width)
+  {
+    const VecF32 x = Load(_x + i);
+    const VecF32 block = Max(m, x);
+    s = Fma(s, Exp(Sub(m, block)), Exp(Sub(x, block)));
+    m = block;
+  }
+
+  float maximum = ReduceMax(m);
+  for (size_t j = i; j < _length; j++)
+    maximum = std::max(maximum, _x[j]);
+
+  float sum = ReduceAdd(Mul(s, Exp(Sub(m, Set(maximum)))));
+  for (; i < _length; i++)
+    sum += std::exp(_x[i] - maximum);
+
+  _maximum = maximum;
+  _sum = sum;
+}
+
+template <bool LOG>
+inline void SoftmaxRowF32(const float* _x, float* _y, size_t _length) noexcept
+{
+  float maximum, sum;
+  SoftmaxStatsF32(_x, _length, maximum, sum);
+
+  if constexpr (LOG)
+  {
+    const VecF32 shift = Set(maximum + std::log(sum));
+    MapRowF32(_x, _y, _length, [shift](const VecF32 _a) noexcept {return Sub(_a, shift);});
+  }
+  else
+  {
+    const VecF32 shift = Set(maximum);
+    const VecF32 scale = Set(1.0f / sum);
+    MapRowF32(_x, _y, _length, [shift, scale](const VecF32 _a) noexcept
+    {
+      return Mul(Exp(Sub(_a, shift)), scale);
+    });
+  }
+}
+
+inline void SoftmaxF32(const float* _x, float* _y, size_t _length) noexcept
+{SoftmaxRowF32<false>(_x, _y, _length);}
+
+inline void LogSoftmaxF32(const float* _x, float* _y, size_t _length) noexcept
+{SoftmaxRowF32<true>(_x, _y, _length);}
+
+// Softmax:      dx = y * (dy - sum(dy * y))
+// Log-softmax:  dx = dy - e^y * sum(dy)
+template <bool LOG>
+inline void SoftmaxBackwardRowF32(const float* _y, const float* _dy, float* _dx, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+
+  VecF32 acc0 = Zero(), acc1 = Zero();
+  size_t i = 0;
+
+  for (; i + 2 * width <= _length; i += 2 * width)
+  {
+    if constexpr (LOG)
+    {
+      acc0 = Add(acc0, Load(_dy + i));
+      acc1 = Add(acc1, Load(_dy + i + width));
+    }
+    else
+    {
+      acc0 = Fma(Load(_dy + i), Load(_y + i), acc0);
+      acc1 = Fma(Load(_dy + i + width), Load(_y + i + width), acc1);
+    }
+  }
+
+  for (; i < _length; i += width)
+  {
+    const size_t count = std::min(width, _length - i);
+    const VecF32 dy = LoadPartial(_dy + i, count);
+    acc0 = LOG ? Add(acc0, dy) : Fma(dy, LoadPartial(_y + i, count), acc0);
+  }
+
+  const VecF32 total = Set(ReduceAdd(Add(acc0, acc1)));
+
+  for (i = 0; i < _length; i += width)
+  {
+    const size_t count = std::min(width, _length - i);
+    const VecF32 y = count == width ? Load(_y + i) : LoadPartial(_y + i, count);
+    const VecF32 dy = count == width ? Load(_dy + i) : LoadPartial(_dy + i, count);
+    const VecF32 dx = LOG ? Sub(dy, Mul(Exp(y), total)) : Mul(y, Sub(dy, total));
+
+    if (count == width)
+      Store(_dx + i, dx);
+    else
+      StorePartial(_dx + i, dx, count);
+  }
+}
+
+inline void SoftmaxBackwardF32(const float* _y, const float* _dy, float* _dx, size_t _length) noexcept
+{SoftmaxBackwardRowF32<false>(_y, _dy, _dx, _length);}
+
+inline void LogSoftmaxBackwardF32(const float* _y, const float* _dy, float* _dx, size_t _length) noexcept
+{SoftmaxBackwardRowF32<true>(_y, _dy, _dx, _length);}
+
+// Statistics of the first pass of a normalization, with g = dy * gamma
+// LayerNorm:  m2 = sum((x - mean)^2) and c = sum(g * (x - mean))
+// RMSNorm:    mean = 0, m2 = sum(x^2) and c = sum(g * x)
+struct RowStats
+{
+  float count;
+  float mean;
+  float m2;
+  float g_mean;   // Backward only
+  float c;        // Backward only
+};
+
+// Chan`s update, _a becomes the statistics of the items of both
+inline void MergeRowStats(RowStats& _a, const RowStats& _b) noexcept
+{
+  if (_b.count == 0.0f)
+    return;
+
+  const float count = _a.count + _b.count;
+  const float weight = _b.count / count;
+  const float delta = _b.mean - _a.mean;
+  const float delta_g = _b.g_mean - _a.g_mean;
+
+  _a.m2 += _b.m2 + delta * delta * _a.count * weight;
+  _a.c += _b.c + delta * delta_g * _a.count * weight;
+  _a.mean += delta * weight;
+  _a.g_mean += delta_g * weight;
+  _a.count = count;
+}
+
+// LayerNorm: every lane keeps the statistics of its own items and merges blocks of 4 vectors
+// into them, then the lanes and the tail are merged one by one
+template <bool RMS, bool GRADIENT>
+inline RowStats RowStatsF32(const float* _x, const float* _gamma, const float* _dy, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+  size_t i = 0;
+
+  if constexpr (RMS)
+  {
+    VecF32 squares = Zero(), gx = Zero();
+
+    for (; i + width <= _length; i += width)
+    {
+      const VecF32 x = Load(_x + i);
+      squares = Fma(x, x, squares);
+      if constexpr (GRADIENT)
+        gx = Fma(Mul(Load(_dy + i), Load(_gamma + i)), x, gx);
+    }
+
+    RowStats stats = {(float)_length, 0.0f, ReduceAdd(squares), 0.0f, ReduceAdd(gx)};
+
+    for (; i < _length; i++)
+    {
+      stats.m2 += _x[i] * _x[i];
+      if constexpr (GRADIENT)
+        stats.c += _dy[i] * _gamma[i] * _x[i];
+    }
+
+    return stats;
+  }
+  else
+  {
+    VecF32 mean = Zero(), m2 = Zero(), g_mean = Zero(), c = Zero();
+    float count = 0.0f;
+
+    auto merge = [&](const VecF32 _mean, const VecF32 _m2, const VecF32 _g_mean, const VecF32 _c, float _count)
+    {
+      const float weight = _count / (count + _count);
+      const VecF32 cross = Set(count * weight);
+      const VecF32 delta = Sub(_mean, mean);
+
+      m2 = Add(m2, Fma(Mul(delta, delta), cross, _m2));
+      mean = Fma(delta, Set(weight), mean);
+
+      if constexpr (GRADIENT)
+      {
+        const VecF32 delta_g = Sub(_g_mean, g_mean);
+        c = Add(c, Fma(Mul(delta, delta_g), cross, _c));
+        g_mean = Fma(delta_g, Set(weight), g_mean);
+      }
+
+      count += _count;
+    };
+
+    const VecF32 quarter = Set(0.25f);
+
+    for (; i + 4 * width <= _length; i += 4 * width)
+    {
+      const VecF32 x0 = Load(_x + i);
+      const VecF32 x1 = Load(_x + i + width);
+      const VecF32 x2 = Load(_x + i + 2 * width);
+      const VecF32 x3 = Load(_x + i + 3 * width);
+
+      const VecF32 block_mean = Mul(Add(Add(x0, x1), Add(x2, x3)), quarter);
+      const VecF32 d0 = Sub(x0, block_mean);
+      const VecF32 d1 = Sub(x1, block_mean);
+      const VecF32 d2 = Sub(x2, block_mean);
+      const VecF32 d3 = Sub(x3, block_mean);
+      const VecF32 block_m2 = Fma(d0, d0, Fma(d1, d1, Fma(d2, d2, Mul(d3, d3))));
+
+      VecF32 block_g = Zero(), block_c = Zero();
+      if constexpr (GRADIENT)
+      {
+        const VecF32 g0 = Mul(Load(_dy + i), Load(_gamma + i));
+        const VecF32 g1 = Mul(Load(_dy + i + width), Load(_gamma + i + width));
+        const VecF32 g2 = Mul(Load(_dy + i + 2 * width), Load(_gamma + i + 2 * width));
+        const VecF32 g3 = Mul(Load(_dy + i + 3 * width), Load(_gamma + i + 3 * width));
+        block_g = Mul(Add(Add(g0, g1), Add(g2, g3)), quarter);
+        block_c = Fma(g0, d0, Fma(g1, d1, Fma(g2, d2, Mul(g3, d3))));
+      }
+
+      merge(block_mean, block_m2, block_g, block_c, 4.0f);
+    }
+
+    for (; i + width <= _length; i += width)
+      merge(Load(_x + i), Zero(), GRADIENT ? Mul(Load(_dy + i), Load(_gamma + i)) : Zero(), Zero(), 1.0f);
+
+    float lane_mean[VecF32::width], lane_m2[VecF32::width], lane_g_mean[VecF32::width], lane_c[VecF32::width];
+    Store(lane_mean, mean);
+    Store(lane_m2, m2);
+    Store(lane_g_mean, g_mean);
+    Store(lane_c, c);
+
+    RowStats stats = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    for (size_t lane = 0; lane < width; lane++)
+      MergeRowStats(stats, {count, lane_mean[lane], lane_m2[lane], lane_g_mean[lane], lane_c[lane]});
+
+    for (; i < _length; i++)
+      MergeRowStats(stats, {1.0f, _x[i], 0.0f, GRADIENT ? _dy[i] * _gamma[i] : 0.0f, 0.0f});
+
+    return stats;
+  }
+}
+
+// 1 / sqrt(variance + _epsilon), the variance of RMSNorm is the mean of the squares
+inline float RowRstd(const RowStats& _stats, float _epsilon) noexcept
+{
+  return 1.0f / std::sqrt(_stats.m2 / _stats.count + _epsilon);
+}
+
+// y = (x - mean) * rstd * gamma + beta, RMSNorm has no mean and no beta
+template <bool RMS>
+inline void NormRowF32(const float* _x, const float* _gamma, const float* _beta, float* _y,
+                       size_t _length, float _epsilon) noexcept
+{
+  const size_t width = VecF32::width;
+
+  const RowStats stats = RowStatsF32<RMS, false>(_x, nullptr, nullptr, _length);
+
+  const VecF32 center = Set(stats.mean);
+  const VecF32 scale = Set(RowRstd(stats, _epsilon));
+
+  for (size_t i = 0; i < _length; i += width)
+  {
+    const size_t count = std::min(width, _length - i);
+    const VecF32 x = count == width ? Load(_x + i) : LoadPartial(_x + i, count);
+    const VecF32 gamma = count == width ? Load(_gamma + i) : LoadPartial(_gamma + i, count);
+    const VecF32 xhat = Mul(Sub(x, center), scale);
+
+    VecF32 y;
+    if constexpr (RMS)
+      y = Mul(xhat, gamma);
+    else
+      y = Fma(xhat, gamma, count == width ? Load(_beta + i) : LoadPartial(_beta + i, count));
+
+    if (count == width)
+      Store(_y + i, y);
+    else
+      StorePartial(_y + i, y, count);
+  }
+}
+
+inline void LayerNormF32(const float* _x, const float* _gamma, const float* _beta, float* _y,
+                         size_t _length, float _epsilon) noexcept
+{NormRowF32<false>(_x, _gamma, _beta, _y, _length, _epsilon);}
+
+inline void RMSNormF32(const float* _x, const float* _gamma, const float* _beta, float* _y,
+                       size_t _length, float _epsilon) noexcept
+{NormRowF32<true>(_x, _gamma, _beta, _y, _length, _epsilon);}
+
+// With g = dy * gamma and xhat = (x - mean) * rstd:
+//   dx = rstd * (g - mean(g) - xhat * mean(g * xhat)), mean(g) is zero for RMSNorm
+//   dgamma += dy * xhat, dbeta += dy
+template <bool RMS>
+inline void NormBackwardRowF32(const float* _x, const float* _gamma, const float* _dy, float* _dx,
+                               float* _dgamma, float* _dbeta, size_t _length, float _epsilon) noexcept
+{
+  const size_t width = VecF32::width;
+
+  const RowStats stats = RowStatsF32<RMS, true>(_x, _gamma, _dy, _length);
+  const float rstd = RowRstd(stats, _epsilon);
+
+  // sum(g * xhat) = rstd * sum(g * (x - mean))
+  const VecF32 center = Set(stats.mean);
+  const VecF32 scale = Set(rstd);
+  const VecF32 g_mean = Set(RMS ? 0.0f : stats.g_mean);
+  const VecF32 g_xhat_mean = Set(rstd * stats.c / (float)_length);
+
+  for (size_t i = 0; i < _length; i += width)
+  {
+    const size_t count = std::min(width, _length - i);
+    const bool full = count == width;
+
+    const VecF32 x = full ? Load(_x + i) : LoadPartial(_x + i, count);
+    const VecF32 dy = full ? Load(_dy + i) : LoadPartial(_dy + i, count);
+    const VecF32 gamma = full ? Load(_gamma + i) : LoadPartial(_gamma + i, count);
+    const VecF32 dgamma = full ? Load(_dgamma + i) : LoadPartial(_dgamma + i, count);
+
+    const VecF32 xhat = Mul(Sub(x, center), scale);
+    const VecF32 g = Sub(Mul(dy, gamma), g_mean);
+    const VecF32 dx = Mul(scale, Sub(g, Mul(xhat, g_xhat_mean)));
+
+    if (full)
+    {
+      Store(_dx + i, dx);
+      Store(_dgamma + i, Fma(dy, xhat, dgamma));
+    }
+    else
+    {
+      StorePartial(_dx + i, dx, count);
+      StorePartial(_dgamma + i, Fma(dy, xhat, dgamma), count);
+    }
+
+    if constexpr (!RMS)
+    {
+      const VecF32 dbeta = Add(full ? Load(_dbeta + i) : LoadPartial(_dbeta + i, count), dy);
+      if (full)
+        Store(_dbeta + i, dbeta);
+      else
+        StorePartial(_dbeta + i, dbeta, count);
+    }
+  }
+}
+
+inline void LayerNormBackwardF32(const float* _x, const float* _gamma, const float* _dy, float* _dx,
+                                 float* _dgamma, float* _dbeta, size_t _length, float _epsilon) noexcept
+{NormBackwardRowF32<false>(_x, _gamma, _dy, _dx, _dgamma, _dbeta, _length, _epsilon);}
+
+inline void RMSNormBackwardF32(const float* _x, const float* _gamma, const float* _dy, float* _dx,
+                               float* _dgamma, float* _dbeta, size_t _length, float _epsilon) noexcept
+{NormBackwardRowF32<true>(_x, _gamma, _dy, _dx, _dgamma, _dbeta, _length, _epsilon);}
@@ -0,0 +1,161 @@
+// File Name:     qgemm.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Packing routine and register-blocked kernel of the int8 GEMM
+
+// ---------------------
+// Detail Description:
+// C = A * B of unsigned 8-bit A and signed 8-bit B, accumulated in int32 and turned into
+// float column by column with C[i][j] = acc[i][j] * _scales[j] + _offsets[j], which holds the
+// scales and the zero point of A, see "math/quantized_matrix.hpp".
+// B is packed in panels of qgemm_nr columns, every panel holds groups of 4 rows, and a group
+// holds the 4 items of column 0, then the 4 of column 1, etc. so a vector of B has the 4 items
+// of every lane next to each other, the layout of PMADDUBSW and VPDPBUSD. With nr = qgemm_nr
+// and the depth rounded up to a multiple of 4 to depth4:
+//
+//   row k, column j -> packed[(j / nr) * depth4 * nr + (k / 4) * 4 * nr + (j % nr) * 4 + k % 4]
+//
+// The 4 bytes of a row of A at the same depths are broadcast to every lane. Padding rows and
+// columns are zero.
+// ---------------------
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp",
+// and once per extension with its own "VecI32" and "DotU8S8" by "extensions.hpp"
+// Rows of A must be readable up to the depth rounded up to a multiple of 4, the extra bytes are
+// multiplied by the zero padding of B. The int32 accumulators overflow past about 66000 depths
+// ---------------------
+
+constexpr size_t qgemm_nr_vectors = 2;
+constexpr size_t qgemm_nr = qgemm_nr_vectors * VecI32::width;
+constexpr size_t qgemm_mr = 4;
+
+inline void QGemmPackBS8(const int8_t* _b, size_t _row_stride, size_t _col_stride,
+                         size_t _depth, size_t _cols, int8_t* _packed) noexcept
+{
+  const size_t depth4 = (_depth + 3) / 4 * 4;
+
+  for (size_t j = 0; j < _cols; j += qgemm_nr)
+  {
+    int8_t* panel = _packed + (j / qgemm_nr) * depth4 * qgemm_nr;
+    std::memset(panel, 0, depth4 * qgemm_nr);
+
+    const size_t cols = std::min(qgemm_nr, _cols - j);
+    for (size_t k = 0; k < _depth; k++)
+      for (size_t c = 0; c < cols; c++)
+        panel[(k / 4) * 4 * qgemm_nr + c * 4 + k % 4] = _b[k * _row_stride + (j + c) * _col_stride];
+  }
+}
+
+// ROWS rows of A times one panel, the depth is split between independent accumulators when
+// there are too few rows to hide the latency of the dot products
+template <size_t ROWS>
+inline void QGemmPanelU8S8(size_t _depth4, const uint8_t* _a, size_t _lda, const int8_t* _b,
+                           const float* _scales, const float* _offsets,
+                           float* _c, size_t _ldc, size_t _cols) noexcept
+{
+  const size_t width = VecI32::width;
+  constexpr size_t chains = ROWS * qgemm_nr_vectors;
+  constexpr size_t split = chains >= 8 ? 1 : 8 / chains;
+
+  VecI32 acc[split][ROWS][qgemm_nr_vectors];
+
+  MNT_UNROLL
+  for (size_t s = 0; s < split; s++)
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+      MNT_UNROLL
+      for (size_t j = 0; j < qgemm_nr_vectors; j++)
+        acc[s][i][j] = ZeroI32();
+
+  auto step = [&](size_t _k, VecI32 (&_acc)[ROWS][qgemm_nr_vectors])
+  {
+    const int8_t* b = _b + _k * qgemm_nr;
+
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+    {
+      const VecI32 a = Broadcast4(_a + i * _lda + _k);
+      MNT_UNROLL
+      for (size_t j = 0; j < qgemm_nr_vectors; j++)
+        _acc[i][j] = DotU8S8(_acc[i][j], a, b + j * 4 * width);
+    }
+  };
+
+  size_t k = 0;
+  for (; k + 4 * split <= _depth4; k += 4 * split)
+    MNT_UNROLL
+    for (size_t s = 0; s < split; s++)
+      step(k + 4 * s, acc[s]);
+
+  for (; k < _depth4; k += 4)
+    step(k, acc[0]);
+
+  MNT_UNROLL
+  for (size_t s = 1; s < split; s++)
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+      MNT_UNROLL
+      for (size_t j = 0; j < qgemm_nr_vectors; j++)
+        acc[0][i][j] = AddI32(acc[0][i][j], acc[s][i][j]);
+
+  MNT_UNROLL
+  for (size_t j = 0; j < qgemm_nr_vectors; j++)
+  {
+    if (j * width >= _cols)
+      break;
+
+    const size_t count = std::min(width, _cols - j * width);
+    const bool full = count == width;
+    const VecF32 scale = full ? Load(_scales + j * width) : LoadPartial(_scales + j * width, count);
+    const VecF32 offset = full ? Load(_offsets + j * width) : LoadPartial(_offsets + j * width, count);
+
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+    {
+      const VecF32 y = Fma(ToFloat(acc[0][i][j]), scale, offset);
+      if (full)
+        Store(_c + i * _ldc + j * width, y);
+      else
+        StorePartial(_c + i * _ldc + j * width, y, count);
+    }
+  }
+}
+
+// Every panel is read from L1/L2 by all the rows of A before the next one, _b is the
+// first panel of the _cols columns, _scales, _offsets and _c start at the same column
+inline void QGemmU8S8(size_t _rows, size_t _cols, size_t _depth, const uint8_t* _a, size_t _lda,
+                      const int8_t* _b, const float* _scales, const float* _offsets,
+                      float* _c, size_t _ldc) noexcept
+{
+  const size_t depth4 = (_depth + 3) / 4 * 4;
+
+  for (size_t j = 0; j < _cols; j += qgemm_nr)
+  {
+    const int8_t* panel = _b + (j / qgemm_nr) * depth4 * qgemm_nr;
+    const size_t cols = std::min(qgemm_nr, _cols - j);
+
+    for (size_t i = 0; i < _rows; i += qgemm_mr)
+    {
+      const uint8_t* a = _a + i * _lda;
+      float* c = _c + i * _ldc + j;
+
+      switch (std::min(qgemm_mr, _rows - i))
+      {
+        case 1:
+          QGemmPanelU8S8<1>(depth4, a, _lda, panel, _scales + j, _offsets + j, c, _ldc, cols);
+          break;
+        case 2:
+          QGemmPanelU8S8<2>(depth4, a, _lda, panel, _scales + j, _offsets + j, c, _ldc, cols);
+          break;
+        case 3:
+          QGemmPanelU8S8<3>(depth4, a, _lda, panel, _scales + j, _offsets + j, c, _ldc, cols);
+          break;
+        default:
+          QGemmPanelU8S8<4>(depth4, a, _lda, panel, _scales + j, _offsets + j, c, _ldc, cols);
+          break;
+      }
+    }
+  }
+}
@@ -0,0 +1,185 @@
+// File Name:     random.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Philox4x32-10 random numbers and the float distributions built on them
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Philox4x32-10 maps a 128-bit counter and a 64-bit key to 4 random words with 10 rounds of
+// 32x32 -> 64-bit products and xors, see "math/random.hpp" for how the stream is laid out.
+// A vector runs the rounds of VecI32::width consecutive blocks, one block per lane, so the
+// 4 words come out as 4 vectors holding word j of every block. A group of 64 values is
+// 16 blocks and its value 16 * j + b is word j of block b, a vector of word j is stored at once
+// and every instruction set writes the same values at the same places.
+//
+// Uniform floats take the top 24 bits of a word. Normal floats use Box-Muller on the pairs of
+// words 0, 1 and 2, 3 of a block: r = sqrt(-2 log(u1)) with u1 in (0, 1], and the angle
+// 2 pi v is built from the sine s of its half pi v, v in [-0.5, 0.5), with sin = 2 s sqrt(1 - s^2)
+// and cos = 1 - 2 s^2, the half angle is in [-pi/2, pi/2) where a short polynomial is enough.
+// ---------------------
+
+constexpr size_t random_group = 64;
+constexpr size_t random_group_blocks = 16;
+
+static_assert(random_group_blocks % VecI32::width == 0, "A group of blocks has to be whole vectors");
+
+// The 4 words of the blocks {_block + lane, _stream} with the key _seed
+inline void PhiloxVectors(uint64_t _seed, uint64_t _stream, uint64_t _block, VecI32 _words[4]) noexcept
+{
+  static const uint32_t lanes[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  // _block is a multiple of the width, the lanes never carry into the high word
+  VecI32 c0 = AddI32(SetI32((uint32_t)_block), LoadI32(lanes));
+  VecI32 c1 = SetI32((uint32_t)(_block >> 32));
+  VecI32 c2 = SetI32((uint32_t)_stream);
+  VecI32 c3 = SetI32((uint32_t)(_stream >> 32));
+
+  uint32_t k0 = (uint32_t)_seed;
+  uint32_t k1 = (uint32_t)(_seed >> 32);
+
+  const VecI32 m0 = SetI32(0xD2511F53u);
+  const VecI32 m1 = SetI32(0xCD9E8D57u);
+
+  for (size_t round = 0; round < 10; round++)
+  {
+    VecI32 high0, low0, high1, low1;
+    MulWideU32(m0, c0, high0, low0);
+    MulWideU32(m1, c2, high1, low1);
+
+    c0 = XorI32(XorI32(high1, c1), SetI32(k0));
+    c1 = low1;
+    c2 = XorI32(XorI32(high0, c3), SetI32(k1));
+    c3 = low0;
+
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+
+  _words[0] = c0;
+  _words[1] = c1;
+  _words[2] = c2;
+  _words[3] = c3;
+}
+
+// _emit(dst, words) stores the 4 vectors of words of the blocks at dst + b, dst + 16 + b, etc.
+// Every group is written in place, the last partial one through a buffer
+template <typename T, typename F>
+inline void RandomGroups(uint64_t _seed, uint64_t _stream, uint64_t _group, T* _out, size_t _length,
+                         const F& _emit) noexcept
+{
+  const size_t width = VecI32::width;
+  T buffer[random_group];
+
+  for (size_t g = 0; g * random_group < _length; g++)
+  {
+    const size_t count = std::min(random_group, _length - g * random_group);
+    T* dst = count == random_group ? _out + g * random_group : buffer;
+
+    for (size_t b = 0; b < random_group_blocks; b += width)
+    {
+      VecI32 words[4];
+      PhiloxVectors(_seed, _stream, (_group + g) * random_group_blocks + b, words);
+      _emit(dst + b, words);
+    }
+
+    if (dst == buffer)
+      std::copy_n(buffer, count, _out + g * random_group);
+  }
+}
+
+inline void RandomBits(uint64_t _seed, uint64_t _stream, uint64_t _group, uint32_t* _out, size_t _length) noexcept
+{
+  RandomGroups(_seed, _stream, _group, _out, _length, [](uint32_t* _dst, const VecI32* _words) noexcept
+  {
+    for (size_t j = 0; j < 4; j++)
+      StoreI32(_dst + j * random_group_blocks, _words[j]);
+  });
+}
+
+inline void RandomUniformF32(uint64_t _seed, uint64_t _stream, uint64_t _group, float* _out, size_t _length,
+                             float _low, float _high) noexcept
+{
+  const VecF32 low = Set(_low);
+  const VecF32 range = Set(_high - _low);
+
+  RandomGroups(_seed, _stream, _group, _out, _length, [&](float* _dst, const VecI32* _words) noexcept
+  {
+    for (size_t j = 0; j < 4; j++)
+      Store(_dst + j * random_group_blocks, Fma(UnitFloat(_words[j]), range, low));
+  });
+}
+
+// The normals of the words _u and _v, see the description, the tails beyond 5.77 sigma are cut
+// by the 24 bits of u1
+inline void BoxMullerF32(const VecI32 _u, const VecI32 _v, VecF32& _z0, VecF32& _z1) noexcept
+{
+  const VecF32 one = Set(1.0f);
+  const VecF32 radius = Sqrt(Mul(Set(-2.0f), Log(Sub(one, UnitFloat(_u)))));
+
+  // sin(x) on [-pi/2, pi/2], Taylor to x^11, error below 6e-8
+  const VecF32 x = Mul(Sub(UnitFloat(_v), Set(0.5f)), Set(3.14159265f));
+  const VecF32 x2 = Mul(x, x);
+  VecF32 p = Set(-2.50521084e-8f);
+  p = Fma(p, x2, Set(2.75573192e-6f));
+  p = Fma(p, x2, Set(-1.98412698e-4f));
+  p = Fma(p, x2, Set(8.33333333e-3f));
+  p = Fma(p, x2, Set(-1.66666667e-1f));
+  const VecF32 s = Fma(Mul(p, x2), x, x);
+
+  const VecF32 s2 = Mul(s, s);
+  const VecF32 c = Sqrt(Max(Sub(one, s2), Zero()));
+
+  _z0 = Mul(radius, Sub(one, Add(s2, s2)));
+  _z1 = Mul(radius, Mul(Add(s, s), c));
+}
+
+inline void RandomNormalF32(uint64_t _seed, uint64_t _stream, uint64_t _group, float* _out, size_t _length,
+                            float _mean, float _stddev) noexcept
+{
+  const VecF32 mean = Set(_mean);
+  const VecF32 stddev = Set(_stddev);
+
+  RandomGroups(_seed, _stream, _group, _out, _length, [&](float* _dst, const VecI32* _words) noexcept
+  {
+    for (size_t j = 0; j < 4; j += 2)
+    {
+      VecF32 z0, z1;
+      BoxMullerF32(_words[j], _words[j + 1], z0, z1);
+      Store(_dst + j * random_group_blocks, Fma(z0, stddev, mean));
+      Store(_dst + (j + 1) * random_group_blocks, Fma(z1, stddev, mean));
+    }
+  });
+}
+
+// Bit i is set with _probability, a group of values is one word of bits, the bits beyond
+// _length are zero
+inline void RandomBernoulli(uint64_t _seed, uint64_t _stream, uint64_t _group, uint64_t* _bits, size_t _length,
+                            float _probability) noexcept
+{
+  const size_t width = VecI32::width;
+  const VecF32 probability = Set(_probability);
+  const VecF32 one = Set(1.0f);
+
+  for (size_t g = 0; g * random_group < _length; g++)
+  {
+    uint64_t word = 0;
+
+    for (size_t b = 0; b < random_group_blocks; b += width)
+    {
+      VecI32 words[4];
+      PhiloxVectors(_seed, _stream, (_group + g) * random_group_blocks + b, words);
+
+      for (size_t j = 0; j < 4; j++)
+        word |= (uint64_t)NonZeroBits(SelectLess(UnitFloat(words[j]), probability, one, Zero()))
+                << (j * random_group_blocks + b);
+    }
+
+    const size_t count = std::min(random_group, _length - g * random_group);
+    _bits[g] = count == random_group ? word : word & ((1ull << count) - 1);
+  }
+}
@@ -0,0 +1,142 @@
+// File Name:     reduce.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Float reductions of contiguous runs and of rows into accumulators
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// A run is summed with 4 vector accumulators, so 4 independent chains of additions hide
+// the latency of the adder. Runs longer than reduce_pairwise_length are split in two halves
+// that are summed recursively (pairwise summation), the rounding error grows with the log of
+// the length instead of the length.
+// ---------------------
+
+constexpr size_t reduce_pairwise_length = 64 * VecF32::width;
+
+// Sum of _op(x) with 4 accumulators, _op is applied to full vectors and to the zero padded
+// tail, so it has to map zero to zero
+template <typename OP>
+inline float ReduceRunF32(const float* _x, size_t _length, const OP& _op) noexcept
+{
+  const size_t width = VecF32::width;
+
+  if (_length > reduce_pairwise_length)
+  {
+    const size_t half = (_length / 2 + 4 * width - 1) / (4 * width) * (4 * width);
+    return ReduceRunF32(_x, half, _op) + ReduceRunF32(_x + half, _length - half, _op);
+  }
+
+  VecF32 acc0 = Zero(), acc1 = Zero(), acc2 = Zero(), acc3 = Zero();
+  size_t i = 0;
+
+  for (; i + 4 * width <= _length; i += 4 * width)
+  {
+    acc0 = Add(acc0, _op(Load(_x + i)));
+    acc1 = Add(acc1, _op(Load(_x + i + width)));
+    acc2 = Add(acc2, _op(Load(_x + i + 2 * width)));
+    acc3 = Add(acc3, _op(Load(_x + i + 3 * width)));
+  }
+
+  for (; i < _length; i += width)
+    acc0 = Add(acc0, _op(LoadPartial(_x + i, std::min(width, _length - i))));
+
+  return ReduceAdd(Add(Add(acc0, acc1), Add(acc2, acc3)));
+}
+
+inline float ReduceSumF32(const float* _x, size_t _length) noexcept
+{
+  return ReduceRunF32(_x, _length, [](const VecF32 _a) noexcept {return _a;});
+}
+
+// Sum of (x - _center)^2, the tail is shifted only on its valid lanes
+inline float ReduceSquaresF32(const float* _x, size_t _length, float _center) noexcept
+{
+  const size_t width = VecF32::width;
+  const size_t body = _length / width * width;
+  const VecF32 center = Set(_center);
+
+  float sum = ReduceRunF32(_x, body, [center](const VecF32 _a) noexcept
+  {
+    const VecF32 diff = Sub(_a, center);
+    return Mul(diff, diff);
+  });
+
+  for (size_t i = body; i < _length; i++)
+    sum += (_x[i] - _center) * (_x[i] - _center);
+
+  return sum;
+}
+
+// _length can`t be zero
+template <bool MAXIMUM>
+inline float ReduceExtremumF32(const float* _x, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+  auto pick = [](const VecF32 _a, const VecF32 _b) noexcept {return MAXIMUM ? Max(_a, _b) : Min(_a, _b);};
+
+  float result = _x[0];
+  size_t i = 0;
+
+  if (_length >= 4 * width)
+  {
+    VecF32 acc0 = Load(_x), acc1 = Load(_x + width), acc2 = Load(_x + 2 * width), acc3 = Load(_x + 3 * width);
+
+    for (i = 4 * width; i + 4 * width <= _length; i += 4 * width)
+    {
+      acc0 = pick(acc0, Load(_x + i));
+      acc1 = pick(acc1, Load(_x + i + width));
+      acc2 = pick(acc2, Load(_x + i + 2 * width));
+      acc3 = pick(acc3, Load(_x + i + 3 * width));
+    }
+
+    const VecF32 acc = pick(pick(acc0, acc1), pick(acc2, acc3));
+    result = MAXIMUM ? ReduceMax(acc) : ReduceMin(acc);
+  }
+
+  for (; i < _length; i++)
+    result = MAXIMUM ? std::max(result, _x[i]) : std::min(result, _x[i]);
+
+  return result;
+}
+
+inline float ReduceMaxF32(const float* _x, size_t _length) noexcept
+{return ReduceExtremumF32<true>(_x, _length);}
+
+inline float ReduceMinF32(const float* _x, size_t _length) noexcept
+{return ReduceExtremumF32<false>(_x, _length);}
+
+// The maximum is found with vectors, then the first item equal to it
+inline size_t ReduceArgMaxF32(const float* _x, size_t _length) noexcept
+{
+  const float maximum = ReduceExtremumF32<true>(_x, _length);
+
+  for (size_t i = 0; i < _length; i++)
+    if (_x[i] == maximum)
+      return i;
+
+  return 0;
+}
+
+// _acc[i] += (_x[i] - _center[i])^2, _center can be nullptr for zero
+inline void SquaresAddF32(const float* _x, const float* _center, float* _acc, size_t _length) noexcept
+{
+  const size_t width = VecF32::width;
+
+  for (size_t i = 0; i < _length; i += width)
+  {
+    const size_t count = std::min(width, _length - i);
+    const VecF32 x = count == width ? Load(_x + i) : LoadPartial(_x + i, count);
+    const VecF32 diff = _center ? Sub(x, count == width ? Load(_center + i) : LoadPartial(_center + i, count)) : x;
+    const VecF32 acc = count == width ? Load(_acc + i) : LoadPartial(_acc + i, count);
+
+    if (count == width)
+      Store(_acc + i, Fma(diff, diff, acc));
+    else
+      StorePartial(_acc + i, Fma(diff, diff, acc), count);
+  }
+}
@@ -0,0 +1,353 @@
+// File Name:     reference.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Plain templated kernels for any item type
+
+// ---------------------
+// Detail Description:
+// The SIMD kernels of KernelRegistry only exist for float, the backends use these
+// templates for the other types (double, integers, etc.), they follow the same
+// signatures as the kernels in KernelTable so backends can switch between them
+// with a single "if constexpr"
+// ---------------------
+
+#ifndef ENGINE_MATH_KERNELS_REFERENCE_HPP
+#define ENGINE_MATH_KERNELS_REFERENCE_HPP
+
+#include "configs.hpp"
+
+#include "math/activation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+
+namespace mnt { namespace kernels { namespace reference {
+
+  template <typename T>
+  inline void Add(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = _a[i] + _b[i];
+  }
+
+  template <typename T>
+  inline void Sub(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = _a[i] - _b[i];
+  }
+
+  template <typename T>
+  inline void Mul(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = _a[i] * _b[i];
+  }
+
+  template <typename T>
+  inline void Div(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = _a[i] / _b[i];
+  }
+
+  template <typename T>
+  inline void Maximum(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = std::max(_a[i], _b[i]);
+  }
+
+  template <typename T>
+  inline void Minimum(const T* _a, const T* _b, T* _out, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _out[i] = std::min(_a[i], _b[i]);
+  }
+
+  template <typename T>
+  inline void Transpose(const T* _src, T* _dst, size_t _rows, size_t _cols,
+                        size_t _src_ld, size_t _dst_ld) noexcept
+  {
+    const size_t tile = 32;
+
+    for (size_t row_tile = 0; row_tile < _rows; row_tile += tile)
+      for (size_t col_tile = 0; col_tile < _cols; col_tile += tile)
+        for (size_t row = row_tile; row < std::min(row_tile + tile, _rows); row++)
+          for (size_t col = col_tile; col < std::min(col_tile + tile, _cols); col++)
+            _dst[col * _dst_ld + row] = _src[row * _src_ld + col];
+  }
+
+  // C = A * B (+ C), item (i, j) of A is at _a[i * _a_row_stride + j * _a_col_stride], same for B
+  template <typename T>
+  inline void Gemm(size_t _m, size_t _n, size_t _k,
+                   const T* _a, size_t _a_row_stride, size_t _a_col_stride,
+                   const T* _b, size_t _b_row_stride, size_t _b_col_stride,
+                   T* _c, size_t _ldc, bool _accumulate) noexcept
+  {
+    for (size_t i=0; i<_m; i++)
+    {
+      T* c = _c + i * _ldc;
+      if (!_accumulate)
+        for (size_t j=0; j<_n; j++)
+          c[j] = T(0);
+
+      for (size_t p=0; p<_k; p++)
+      {
+        const T a = _a[i * _a_row_stride + p * _a_col_stride];
+        for (size_t j=0; j<_n; j++)
+          c[j] += a * _b[p * _b_row_stride + j * _b_col_stride];
+      }
+    }
+  }
+
+  // Pairwise sum of (x - _center)^2
+  template <typename T>
+  inline T ReduceSquares(const T* _x, size_t _length, T _center) noexcept
+  {
+    if (_length > 64)
+      return ReduceSquares(_x, _length / 2, _center) + ReduceSquares(_x + _length / 2, _length - _length / 2, _center);
+
+    T sum = T(0);
+    for (size_t i=0; i<_length; i++)
+      sum += (_x[i] - _center) * (_x[i] - _center);
+
+    return sum;
+  }
+
+  // Pairwise sum
+  template <typename T>
+  inline T ReduceSum(const T* _x, size_t _length) noexcept
+  {
+    if (_length > 64)
+      return ReduceSum(_x, _length / 2) + ReduceSum(_x + _length / 2, _length - _length / 2);
+
+    T sum = T(0);
+    for (size_t i=0; i<_length; i++)
+      sum += _x[i];
+
+    return sum;
+  }
+
+  template <typename T>
+  inline T ReduceMax(const T* _x, size_t _length) noexcept
+  {
+    return *std::max_element(_x, _x + _length);
+  }
+
+  template <typename T>
+  inline T ReduceMin(const T* _x, size_t _length) noexcept
+  {
+    return *std::min_element(_x, _x + _length);
+  }
+
+  template <typename T>
+  inline size_t ReduceArgMax(const T* _x, size_t _length) noexcept
+  {
+    return std::max_element(_x, _x + _length) - _x;
+  }
+
+  template <typename T>
+  inline void SquaresAdd(const T* _x, const T* _center, T* _acc, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+    {
+      const T diff = _center ? _x[i] - _center[i] : _x[i];
+      _acc[i] += diff * diff;
+    }
+  }
+
+  template <typename T>
+  inline void ActivationRow(const T* _x, T* _y, size_t _length, Activation _activation) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _y[i] = mnt::Activate(_x[i], _activation);
+  }
+
+  template <typename T>
+  inline void ActivationBackwardRow(const T* _x, const T* _dy, T* _dx, size_t _length,
+                                    Activation _activation) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _dx[i] = mnt::ActivateBackward(_x[i], _dy[i], _activation);
+  }
+
+  template <typename T>
+  inline void LeakyRelu(const T* _x, T* _y, size_t _length, T _alpha) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _y[i] = _x[i] < T(0) ? _x[i] * _alpha : _x[i];
+  }
+
+  template <typename T>
+  inline void LeakyReluBackward(const T* _x, const T* _dy, T* _dx, size_t _length, T _alpha) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _dx[i] = _x[i] > T(0) ? _dy[i] : _dy[i] * _alpha;
+  }
+
+  // Two passes over the row, the statistics of the backward ones are recomputed
+  template <typename T, bool LOG>
+  inline void Softmax(const T* _x, T* _y, size_t _length) noexcept
+  {
+    const T maximum = *std::max_element(_x, _x + _length);
+
+    T sum = T(0);
+    for (size_t i=0; i<_length; i++)
+      sum += std::exp(_x[i] - maximum);
+
+    for (size_t i=0; i<_length; i++)
+      _y[i] = LOG ? _x[i] - maximum - std::log(sum) : std::exp(_x[i] - maximum) / sum;
+  }
+
+  template <typename T, bool LOG>
+  inline void SoftmaxBackward(const T* _y, const T* _dy, T* _dx, size_t _length) noexcept
+  {
+    T total = T(0);
+    for (size_t i=0; i<_length; i++)
+      total += LOG ? _dy[i] : _dy[i] * _y[i];
+
+    for (size_t i=0; i<_length; i++)
+      _dx[i] = LOG ? _dy[i] - std::exp(_y[i]) * total : _y[i] * (_dy[i] - total);
+  }
+
+  template <typename T, bool RMS>
+  inline void NormStats(const T* _x, size_t _length, T _epsilon, T& _mean, T& _rstd) noexcept
+  {
+    T mean = T(0);
+    if (!RMS)
+    {
+      for (size_t i=0; i<_length; i++)
+        mean += _x[i];
+      mean /= (T)_length;
+    }
+
+    T variance = T(0);
+    for (size_t i=0; i<_length; i++)
+      variance += (_x[i] - mean) * (_x[i] - mean);
+
+    _mean = mean;
+    _rstd = T(1) / std::sqrt(variance / (T)_length + _epsilon);
+  }
+
+  template <typename T, bool RMS>
+  inline void Norm(const T* _x, const T* _gamma, const T* _beta, T* _y, size_t _length, T _epsilon) noexcept
+  {
+    T mean, rstd;
+    NormStats<T, RMS>(_x, _length, _epsilon, mean, rstd);
+
+    for (size_t i=0; i<_length; i++)
+      _y[i] = (_x[i] - mean) * rstd * _gamma[i] + (RMS ? T(0) : _beta[i]);
+  }
+
+  template <typename T, bool RMS>
+  inline void NormBackward(const T* _x, const T* _gamma, const T* _dy, T* _dx,
+                           T* _dgamma, T* _dbeta, size_t _length, T _epsilon) noexcept
+  {
+    T mean, rstd;
+    NormStats<T, RMS>(_x, _length, _epsilon, mean, rstd);
+
+    T g_sum = T(0);
+    T g_xhat = T(0);
+    for (size_t i=0; i<_length; i++)
+    {
+      const T g = _dy[i] * _gamma[i];
+      g_sum += g;
+      g_xhat += g * (_x[i] - mean) * rstd;
+    }
+
+    const T g_mean = RMS ? T(0) : g_sum / (T)_length;
+    const T g_xhat_mean = g_xhat / (T)_length;
+
+    for (size_t i=0; i<_length; i++)
+    {
+      const T xhat = (_x[i] - mean) * rstd;
+      _dx[i] = rstd * (_dy[i] * _gamma[i] - g_mean - xhat * g_xhat_mean);
+      _dgamma[i] += _dy[i] * xhat;
+      if (!RMS)
+        _dbeta[i] += _dy[i];
+    }
+  }
+
+  // Bit i of a mask is bit i % 64 of _bits[i / 64]
+  template <typename T>
+  inline void MaskPack(const T* _x, uint64_t* _bits, size_t _length) noexcept
+  {
+    for (size_t w=0; w*64<_length; w++)
+    {
+      uint64_t word = 0;
+      for (size_t i=w*64; i<std::min(_length, w*64 + 64); i++)
+        word |= (uint64_t)!(_x[i] == T(0)) << (i % 64);
+      _bits[w] = word;
+    }
+  }
+
+  template <typename T>
+  inline void MaskUnpack(const uint64_t* _bits, T* _y, size_t _length) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _y[i] = ((_bits[i / 64] >> (i % 64)) & 1) ? T(1) : T(0);
+  }
+
+  template <typename T>
+  inline void MaskedFill(const T* _x, const uint64_t* _bits, T* _y, size_t _length, T _value) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _y[i] = ((_bits[i / 64] >> (i % 64)) & 1) ? _value : _x[i];
+  }
+
+  template <typename T>
+  inline void MaskedScale(const T* _x, const uint64_t* _bits, T* _y, size_t _length, T _scale) noexcept
+  {
+    for (size_t i=0; i<_length; i++)
+      _y[i] = ((_bits[i / 64] >> (i % 64)) & 1) ? _x[i] * _scale : T(0);
+  }
+
+  template <typename T>
+  inline size_t MaskedSelect(const T* _x, const uint64_t* _bits, T* _y, size_t _length) noexcept
+  {
+    size_t count = 0;
+    for (size_t i=0; i<_length; i++)
+      if ((_bits[i / 64] >> (i % 64)) & 1)
+        _y[count++] = _x[i];
+    return count;
+  }
+
+  template <typename T>
+  inline void Spmm(size_t _block_rows, size_t _block_cols, const T* _blocks,
+                   const TSPARSE_INDEX_TYPE* _indices, size_t _count, const T* _b, size_t _ldb,
+                   T* _c, size_t _ldc, size_t _n) noexcept
+  {
+    for (size_t i=0; i<_block_rows; i++)
+      std::fill(_c + i * _ldc, _c + i * _ldc + _n, T(0));
+
+    for (size_t p=0; p<_count; p++)
+      for (size_t i=0; i<_block_rows; i++)
+        for (size_t q=0; q<_block_cols; q++)
+        {
+          const T a = _blocks[(p * _block_rows + i) * _block_cols + q];
+          const T* b = _b + ((size_t)_indices[p] * _block_cols + q) * _ldb;
+          for (size_t j=0; j<_n; j++)
+            _c[i * _ldc + j] += a * b[j];
+        }
+  }
+
+  template <typename T>
+  inline void Sddmm(const T* _a, const T* _b, size_t _ldb, size_t _depth,
+                    const TSPARSE_INDEX_TYPE* _indices, const T* _values, T* _out, size_t _count) noexcept
+  {
+    for (size_t p=0; p<_count; p++)
+    {
+      const T* b = _b + (size_t)_indices[p] * _ldb;
+      T dot = T(0);
+      for (size_t k=0; k<_depth; k++)
+        dot += _a[k] * b[k];
+      _out[p] = _values[p] * dot;
+    }
+  }
+
+}}}
+
+#endif
@@ -0,0 +1,253 @@
+// File Name:     registry.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime binding of the best kernel variants for the running CPU
+
+// ---------------------
+// Detail Description:
+// Every float kernel is compiled once per supported instruction set (see "variants.hpp"),
+// and each instruction set fills a KernelTable of function pointers with its own variants.
+// KernelRegistry picks the table that matches "mnt::CPU::Active()" at the first call and
+// keeps it for the lifetime of the process, so the cost of dispatching is a single
+// indirect call per operation, not per element.
+// ---------------------
+
+// ---------------------
+// Note:
+// To add a new kernel: add its function pointer to KernelTable, write its body in a file
+// included by "kernels.inl" using the SIMD abstraction, and bind it in "bind.inl".
+// Kernels for extensions beyond the ISA levels go in "extensions.hpp"
+// ---------------------
+
+// =====
+// [Get()]: Returns the table of the active instruction set, it is bound only once
+// =====
+
+// =====
+// [Get(_isa)]: Returns the table of a specific instruction set, mainly for testing and
+// benchmarking, if _isa is not compiled in or not supported by the CPU, the generic table is returned
+// =====
+
+#ifndef ENGINE_MATH_KERNELS_REGISTRY_HPP
+#define ENGINE_MATH_KERNELS_REGISTRY_HPP
+
+#include "configs.hpp"
+
+#include "math/activation.hpp"
+#include "math/half.hpp"
+
+#include "utils/cpu.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mnt {
+
+  // One output row of a window operation, see "blocked.inl" and "depthwise.inl"
+  // Convolution: input is the image and filter [in_groups][kernel_h][kernel_w][block in][block out]
+  // Depthwise and pooling: input is the group of channels and filter [kernel_h][kernel_w][block]
+  // The plain depthwise kernel is the same with a block of one channel
+  struct BlockedRowArgs
+  {
+    const float* input;
+    const float* filter;  // Convolution only
+    const float* bias;    // Convolution only, a block of items or nullptr
+    float* output;        // The output row of one group of channels
+    size_t in_groups;     // Convolution only
+    size_t in_height;
+    size_t in_width;
+    size_t out_width;
+    size_t kernel_h;
+    size_t kernel_w;
+    size_t stride_w;
+    size_t dilation_h;    // Convolution only
+    size_t dilation_w;    // Convolution only
+    ptrdiff_t row;        // Input row of the first kernel row, negative inside the padding
+    ptrdiff_t col;        // Input column of the first kernel column of output column 0
+    Activation activation;  // Convolution only
+  };
+
+  struct KernelTable
+  {
+    ISA isa = ISA::Generic;
+
+    // Elementwise, _out can alias the inputs
+    void (*add)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+    void (*sub)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+    void (*mul)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+    void (*div)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+    void (*maximum)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+    void (*minimum)(const float* _a, const float* _b, float* _out, size_t _length) noexcept = nullptr;
+
+    // Epilogue, _data = activation(_data + _bias)
+    void (*bias_activation)(float* _data, size_t _length, float _bias, Activation _activation) noexcept = nullptr;
+
+    // Elementwise math, see "vecmath.inl" for the accuracy of every function
+    void (*exp)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*log)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*tanh)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*sigmoid)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*erf)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+
+    // Activations and their gradients, _x of the backward ones is the input of the
+    // activation, except for Sigmoid and Tanh where it is the output
+    void (*activation)(const float* _x, float* _y, size_t _length, Activation _activation) noexcept = nullptr;
+    void (*activation_backward)(const float* _x, const float* _dy, float* _dx, size_t _length,
+                                Activation _activation) noexcept = nullptr;
+    void (*leaky_relu)(const float* _x, float* _y, size_t _length, float _alpha) noexcept = nullptr;
+    void (*leaky_relu_backward)(const float* _x, const float* _dy, float* _dx, size_t _length,
+                                float _alpha) noexcept = nullptr;
+
+    // Bit-packed masks, see "mask.inl" and "math/bitmask.hpp", bit i is bit i % 64 of _bits[i / 64],
+    // pack sets the bits of the non-zero items and unpack writes 1 and 0
+    void (*mask_pack)(const float* _x, uint64_t* _bits, size_t _length) noexcept = nullptr;
+    void (*mask_unpack)(const uint64_t* _bits, float* _y, size_t _length) noexcept = nullptr;
+    size_t (*mask_count)(const uint64_t* _bits, size_t _length) noexcept = nullptr;
+    // _y = bit ? _value : _x and _y = bit ? _x * _scale : 0, _y can alias _x
+    void (*masked_fill)(const float* _x, const uint64_t* _bits, float* _y, size_t _length, float _value) noexcept = nullptr;
+    void (*masked_scale)(const float* _x, const uint64_t* _bits, float* _y, size_t _length, float _scale) noexcept = nullptr;
+    // Copies the items of the set bits in order, returns their number
+    size_t (*masked_select)(const float* _x, const uint64_t* _bits, float* _y, size_t _length) noexcept = nullptr;
+
+    // Philox4x32-10 values of the groups of 64 from _group on, see "random.inl" and "math/random.hpp",
+    // every instruction set gives the same bits and Bernoulli bits
+    void (*random_bits)(uint64_t _seed, uint64_t _stream, uint64_t _group, uint32_t* _out, size_t _length) noexcept = nullptr;
+    void (*random_uniform)(uint64_t _seed, uint64_t _stream, uint64_t _group, float* _out, size_t _length,
+                           float _low, float _high) noexcept = nullptr;
+    void (*random_normal)(uint64_t _seed, uint64_t _stream, uint64_t _group, float* _out, size_t _length,
+                          float _mean, float _stddev) noexcept = nullptr;
+    void (*random_bernoulli)(uint64_t _seed, uint64_t _stream, uint64_t _group, uint64_t* _bits, size_t _length,
+                             float _probability) noexcept = nullptr;
+
+    // Layout, _src is a _rows x _cols row-major matrix and _dst a _cols x _rows one,
+    // _src_ld and _dst_ld are the distances between the rows of each
+    void (*transpose)(const float* _src, float* _dst, size_t _rows, size_t _cols,
+                      size_t _src_ld, size_t _dst_ld) noexcept = nullptr;
+
+    // Conversions of reduced precision items, see "math/half.hpp", _x and _y don`t overlap
+    void (*half_to_float)(const Half* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*float_to_half)(const float* _x, Half* _y, size_t _length) noexcept = nullptr;
+    void (*bfloat16_to_float)(const BFloat16* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*float_to_bfloat16)(const float* _x, BFloat16* _y, size_t _length) noexcept = nullptr;
+
+    // GEMM building blocks, see "gemm.inl" for the packed layouts and "math/gemm.hpp" for the driver
+    // Item (i, j) of a matrix is at _x[i * _row_stride + j * _col_stride], so transposed
+    // operands are packed without a copy
+    size_t gemm_mr = 1;
+    size_t gemm_nr = 1;
+    void (*gemm_pack_a)(const float* _a, size_t _row_stride, size_t _col_stride,
+                        size_t _rows, size_t _depth, float* _packed) noexcept = nullptr;
+    void (*gemm_pack_b)(const float* _b, size_t _row_stride, size_t _col_stride,
+                        size_t _depth, size_t _cols, float* _packed) noexcept = nullptr;
+    void (*gemm_micro)(size_t _depth, const float* _packed_a, const float* _packed_b,
+                       float* _c, size_t _ldc, size_t _rows, size_t _cols, bool _accumulate) noexcept = nullptr;
+    // A few rows of A times B read in panels of gemm_nr columns, see "gemm.inl"
+    void (*gemm_skinny)(size_t _rows, size_t _cols, size_t _depth,
+                        const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                        const float* _b, size_t _b_row_stride, size_t _b_panel_stride, bool _padded,
+                        float* _c, size_t _ldc, bool _accumulate) noexcept = nullptr;
+    // The same with a B of Half or BFloat16 items, converted to float as they are read
+    void (*gemm_pack_b_f16)(const Half* _b, size_t _row_stride, size_t _col_stride,
+                            size_t _depth, size_t _cols, float* _packed) noexcept = nullptr;
+    void (*gemm_pack_b_bf16)(const BFloat16* _b, size_t _row_stride, size_t _col_stride,
+                             size_t _depth, size_t _cols, float* _packed) noexcept = nullptr;
+    void (*gemm_skinny_f16)(size_t _rows, size_t _cols, size_t _depth,
+                            const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                            const Half* _b, size_t _b_row_stride, size_t _b_panel_stride, bool _padded,
+                            float* _c, size_t _ldc, bool _accumulate) noexcept = nullptr;
+    void (*gemm_skinny_bf16)(size_t _rows, size_t _cols, size_t _depth,
+                             const float* _a, size_t _a_row_stride, size_t _a_col_stride,
+                             const BFloat16* _b, size_t _b_row_stride, size_t _b_panel_stride, bool _padded,
+                             float* _c, size_t _ldc, bool _accumulate) noexcept = nullptr;
+
+    // Quantization of 8-bit items, see "math/quantize.hpp", q = saturate(round(x / _scale) + _zero_point)
+    // and x = (q - _zero_point) * _scale
+    void (*quantize_s8)(const float* _x, int8_t* _y, size_t _length, float _scale, int32_t _zero_point) noexcept = nullptr;
+    void (*quantize_u8)(const float* _x, uint8_t* _y, size_t _length, float _scale, int32_t _zero_point) noexcept = nullptr;
+    void (*dequantize_s8)(const int8_t* _x, float* _y, size_t _length, float _scale, int32_t _zero_point) noexcept = nullptr;
+    void (*dequantize_u8)(const uint8_t* _x, float* _y, size_t _length, float _scale, int32_t _zero_point) noexcept = nullptr;
+
+    // Int8 GEMM, see "qgemm.inl" for the packed layout and the output, A is unsigned and B signed,
+    // the kernel is exact for items of B within +-qgemm_weight_max
+    size_t qgemm_nr = 1;
+    int32_t qgemm_weight_max = 127;
+    void (*qgemm_pack_b)(const int8_t* _b, size_t _row_stride, size_t _col_stride,
+                         size_t _depth, size_t _cols, int8_t* _packed) noexcept = nullptr;
+    void (*qgemm)(size_t _rows, size_t _cols, size_t _depth, const uint8_t* _a, size_t _lda,
+                  const int8_t* _b, const float* _scales, const float* _offsets,
+                  float* _c, size_t _ldc) noexcept = nullptr;
+
+    // Sparse times dense products of one block row or one row, see "sparse.inl" and "math/sparse.hpp",
+    // CSR matrices are BSR ones with 1x1 blocks
+    void (*spmm)(size_t _block_rows, size_t _block_cols, const float* _blocks,
+                 const TSPARSE_INDEX_TYPE* _indices, size_t _count, const float* _b, size_t _ldb,
+                 float* _c, size_t _ldc, size_t _n) noexcept = nullptr;
+    void (*sddmm)(const float* _a, const float* _b, size_t _ldb, size_t _depth,
+                  const TSPARSE_INDEX_TYPE* _indices, const float* _values, float* _out, size_t _count) noexcept = nullptr;
+
+    // Winograd F(4x4, 3x3) transforms of _count tiles, row r of the input/output is at
+    // _x + r * _x_stride and holds item r of every tile, see "winograd.inl"
+    void (*winograd_input)(const float* _d, size_t _d_stride, float* _v, size_t _v_stride,
+                           size_t _count) noexcept = nullptr;
+    void (*winograd_output)(const float* _m, size_t _m_stride, float* _y, size_t _y_stride,
+                            size_t _count) noexcept = nullptr;
+
+    // FFT building blocks on split complex values of _batch transforms side by side,
+    // see "fft.inl" and "math/fft.hpp"
+    void (*fft_pass)(const float* _in_re, const float* _in_im, float* _out_re, float* _out_im,
+                     size_t _radix, size_t _l, size_t _run, const float* _twiddle_re,
+                     const float* _twiddle_im, bool _inverse) noexcept = nullptr;
+    void (*fft_real)(const float* _in_re, const float* _in_im, float* _out_re, float* _out_im,
+                     size_t _half, size_t _batch, const float* _twiddle_re, const float* _twiddle_im,
+                     bool _inverse) noexcept = nullptr;
+    void (*complex_gemm)(const float* _a_re, const float* _a_im, size_t _a_stride,
+                         const float* _b_re, const float* _b_im, float* _c_re, float* _c_im,
+                         size_t _rows, size_t _depth, size_t _cols) noexcept = nullptr;
+
+    // Reductions of a contiguous run, see "reduce.inl", the sums are pairwise,
+    // max, min and argmax need at least one item, argmax returns the first maximum
+    float (*reduce_sum)(const float* _x, size_t _length) noexcept = nullptr;
+    float (*reduce_squares)(const float* _x, size_t _length, float _center) noexcept = nullptr;
+    float (*reduce_max)(const float* _x, size_t _length) noexcept = nullptr;
+    float (*reduce_min)(const float* _x, size_t _length) noexcept = nullptr;
+    size_t (*reduce_argmax)(const float* _x, size_t _length) noexcept = nullptr;
+
+    // Reduction of rows into accumulators, _acc[i] += (_x[i] - _center[i])^2, _center can be nullptr
+    void (*squares_add)(const float* _x, const float* _center, float* _acc, size_t _length) noexcept = nullptr;
+
+    // Normalizations of one row, see "normalize.inl", RMSNorm ignores _beta and _dbeta,
+    // the backward kernels accumulate into _dgamma and _dbeta
+    void (*softmax)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*log_softmax)(const float* _x, float* _y, size_t _length) noexcept = nullptr;
+    void (*softmax_backward)(const float* _y, const float* _dy, float* _dx, size_t _length) noexcept = nullptr;
+    void (*log_softmax_backward)(const float* _y, const float* _dy, float* _dx, size_t _length) noexcept = nullptr;
+    void (*layer_norm)(const float* _x, const float* _gamma, const float* _beta, float* _y,
+                       size_t _length, float _epsilon) noexcept = nullptr;
+    void (*rms_norm)(const float* _x, const float* _gamma, const float* _beta, float* _y,
+                     size_t _length, float _epsilon) noexcept = nullptr;
+    void (*layer_norm_backward)(const float* _x, const float* _gamma, const float* _dy, float* _dx,
+                                float* _dgamma, float* _dbeta, size_t _length, float _epsilon) noexcept = nullptr;
+    void (*rms_norm_backward)(const float* _x, const float* _gamma, const float* _dy, float* _dx,
+                              float* _dgamma, float* _dbeta, size_t _length, float _epsilon) noexcept = nullptr;
+
+    // Depthwise convolution of one output row of one channel in the plain layout
+    void (*depthwise)(const BlockedRowArgs& _args) noexcept = nullptr;
+
+    // Window kernels on blocked layouts, index 0 for NCHW8c and 1 for NCHW16c
+    void (*conv_blocked[2])(const BlockedRowArgs& _args) noexcept = {nullptr, nullptr};
+    void (*depthwise_blocked[2])(const BlockedRowArgs& _args) noexcept = {nullptr, nullptr};
+    void (*max_pool_blocked[2])(const BlockedRowArgs& _args) noexcept = {nullptr, nullptr};
+    void (*avg_pool_blocked[2])(const BlockedRowArgs& _args) noexcept = {nullptr, nullptr};
+  };
+
+  class KernelRegistry
+  {
+  public:
+    static const KernelTable& Get() noexcept;
+    static const KernelTable& Get(ISA _isa) noexcept;
+  };
+}
+
+#include "math/kernels/registry.inl"
+
+#endif
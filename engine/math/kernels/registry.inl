@@ -0,0 +1,63 @@
+// File Name:     registry.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime binding of the best kernel variants for the running CPU
+
+#ifndef ENGINE_MATH_KERNELS_REGISTRY_INL
+#define ENGINE_MATH_KERNELS_REGISTRY_INL
+
+#include "math/kernels/registry.hpp"
+#include "math/kernels/variants.hpp"
+#include "math/kernels/extensions.hpp"
+
+using namespace mnt;
+
+inline const KernelTable& KernelRegistry::Get(ISA _isa) noexcept
+{
+  // Tables are filled once, in a thread safe manner, and never change
+  static const struct Tables
+  {
+    KernelTable generic;
+    KernelTable sse4;
+    KernelTable avx2;
+    KernelTable avx512;
+    KernelTable neon;
+
+    Tables() noexcept
+    {
+      kernels::generic::Bind(generic);
+#if defined(MNT_SIMD_X86)
+      kernels::sse4::Bind(sse4);
+      kernels::avx2::Bind(avx2);
+      kernels::extensions::Bind(avx2, ISA::AVX2);
+      kernels::avx512::Bind(avx512);
+      kernels::extensions::Bind(avx512, ISA::AVX512);
+#elif defined(MNT_SIMD_NEON)
+      kernels::neon::Bind(neon);
+#endif
+    }
+  } tables;
+
+  if (!CPU::Supports(_isa))
+    return tables.generic;
+
+  switch (_isa)
+  {
+#if defined(MNT_SIMD_X86)
+  case ISA::SSE4:   return tables.sse4;
+  case ISA::AVX2:   return tables.avx2;
+  case ISA::AVX512: return tables.avx512;
+#elif defined(MNT_SIMD_NEON)
+  case ISA::NEON:   return tables.neon;
+#endif
+  default:          return tables.generic;
+  }
+};
+
+inline const KernelTable& KernelRegistry::Get() noexcept
+{
+  static const KernelTable& table = Get(CPU::Active());
+  return table;
+};
+
+#endif
@@ -0,0 +1,93 @@
+// File Name:     small.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Float kernels of matrices whose sizes are known at compile time
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// A 4x4 or 16x16 product is smaller than the packing, blocking and dispatching of the GEMM
+// driver around it, so these kernels skip all of it: every loop runs over template
+// parameters and is unrolled, the accumulators of a group of rows live in registers for
+// the whole depth, rows of B are loaded straight from memory and the last vector of a row
+// is a partial one when N is not a multiple of the width. They are templates, so they are
+// not in KernelTable, "math/static_kernels.hpp" binds one variant per size at the first call,
+// and kernels of this file can call them directly.
+// ---------------------
+
+// Vectors that fit in the register file, with some left for the compiler
+constexpr size_t small_registers = (VecF32::width >= 16 || simd_isa == ISA::NEON) ? 28 : 14;
+
+// C[ROWS x N] (+)= A[ROWS x K] * B[K x N], row-major, A and C rows are _lda and _ldc apart
+template <size_t ROWS, size_t K, size_t N>
+inline void SmallRowsF32(const float* _a, size_t _lda, const float* _b, float* _c, size_t _ldc,
+                         bool _accumulate) noexcept
+{
+  constexpr size_t width = VecF32::width;
+  constexpr size_t vectors = (N + width - 1) / width;
+  constexpr size_t tail = N - (vectors - 1) * width;
+
+  VecF32 acc[ROWS][vectors];
+
+  MNT_UNROLL
+  for (size_t i = 0; i < ROWS; i++)
+    MNT_UNROLL
+    for (size_t j = 0; j < vectors; j++)
+      acc[i][j] = Zero();
+
+  MNT_UNROLL
+  for (size_t k = 0; k < K; k++)
+  {
+    VecF32 b[vectors];
+
+    MNT_UNROLL
+    for (size_t j = 0; j < vectors; j++)
+      b[j] = (j + 1 < vectors || tail == width) ? Load(_b + k * N + j * width)
+                                                : LoadPartial(_b + k * N + j * width, tail);
+
+    MNT_UNROLL
+    for (size_t i = 0; i < ROWS; i++)
+    {
+      const VecF32 a = Set(_a[i * _lda + k]);
+      MNT_UNROLL
+      for (size_t j = 0; j < vectors; j++)
+        acc[i][j] = Fma(a, b[j], acc[i][j]);
+    }
+  }
+
+  MNT_UNROLL
+  for (size_t i = 0; i < ROWS; i++)
+    MNT_UNROLL
+    for (size_t j = 0; j < vectors; j++)
+    {
+      float* c = _c + i * _ldc + j * width;
+
+      if (j + 1 < vectors || tail == width)
+        Store(c, _accumulate ? Add(acc[i][j], Load(c)) : acc[i][j]);
+      else
+        StorePartial(c, _accumulate ? Add(acc[i][j], LoadPartial(c, tail)) : acc[i][j], tail);
+    }
+}
+
+// C[M x N] (+)= A[M x K] * B[K x N], all of them row-major and contiguous
+template <size_t M, size_t K, size_t N>
+inline void SmallMatMulF32(const float* _a, const float* _b, float* _c, bool _accumulate) noexcept
+{
+  constexpr size_t vectors = (N + VecF32::width - 1) / VecF32::width;
+
+  // Accumulators of the group, one row of B and a broadcast of A
+  constexpr size_t fit = small_registers > 2 * vectors ? (small_registers - 1) / vectors - 1 : 1;
+  constexpr size_t group = fit < M ? fit : M;
+  constexpr size_t rest = M % group;
+
+  MNT_UNROLL
+  for (size_t i = 0; i + group <= M; i += group)
+    SmallRowsF32<group, K, N>(_a + i * K, K, _b, _c + i * N, N, _accumulate);
+
+  if constexpr (rest > 0)
+    SmallRowsF32<rest, K, N>(_a + (M - rest) * K, K, _b, _c + (M - rest) * N, N, _accumulate);
+}
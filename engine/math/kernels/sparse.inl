@@ -0,0 +1,174 @@
+// File Name:     sparse.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Float kernels of sparse times dense products
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// SpMM computes the rows of C = A * B for one block row of a BSR matrix A, CSR is the case of
+// 1x1 blocks. The columns of C are split in tiles of 4 vectors (then 1), a tile keeps the
+// accumulators of up to 4 rows of the block in registers for all the blocks of the row, and
+// every row of B is loaded once per block and used by all those rows, so the loads of B per
+// FMA drop with the height of the blocks. Only the rows of B matching a non-zero are read.
+//
+// SDDMM computes the non-zeros of out = pattern .* (A * B^T) for one row of the pattern,
+// the dot products of the row of A with 4 rows of B share the loads of A.
+// ---------------------
+
+// C[ROWS x tile] = sum over the blocks of block[ROWS x bc] * B[bc x tile], _blocks points to
+// the first row of the group in block 0, the last vector is partial unless FULL
+template <size_t ROWS, size_t VECS, bool FULL>
+inline void SpmmTileF32(const float* _blocks, size_t _block_size, size_t _block_cols,
+                        const TSPARSE_INDEX_TYPE* _indices, size_t _count, const float* _b, size_t _ldb,
+                        float* _c, size_t _ldc, size_t _tail) noexcept
+{
+  constexpr size_t width = VecF32::width;
+
+  VecF32 acc[ROWS][VECS];
+
+  MNT_UNROLL
+  for (size_t i = 0; i < ROWS; i++)
+    MNT_UNROLL
+    for (size_t v = 0; v < VECS; v++)
+      acc[i][v] = Zero();
+
+  for (size_t p = 0; p < _count; p++)
+  {
+    const float* block = _blocks + p * _block_size;
+    const float* rows = _b + (size_t)_indices[p] * _block_cols * _ldb;
+
+    for (size_t q = 0; q < _block_cols; q++)
+    {
+      VecF32 b[VECS];
+
+      MNT_UNROLL
+      for (size_t v = 0; v < VECS; v++)
+        b[v] = (FULL || v + 1 < VECS) ? Load(rows + q * _ldb + v * width)
+                                      : LoadPartial(rows + q * _ldb + v * width, _tail);
+
+      MNT_UNROLL
+      for (size_t i = 0; i < ROWS; i++)
+      {
+        const VecF32 a = Set(block[i * _block_cols + q]);
+        MNT_UNROLL
+        for (size_t v = 0; v < VECS; v++)
+          acc[i][v] = Fma(a, b[v], acc[i][v]);
+      }
+    }
+  }
+
+  MNT_UNROLL
+  for (size_t i = 0; i < ROWS; i++)
+    MNT_UNROLL
+    for (size_t v = 0; v < VECS; v++)
+      if (FULL || v + 1 < VECS)
+        Store(_c + i * _ldc + v * width, acc[i][v]);
+      else
+        StorePartial(_c + i * _ldc + v * width, acc[i][v], _tail);
+}
+
+template <size_t ROWS>
+inline void SpmmRowsF32(const float* _blocks, size_t _block_size, size_t _block_cols,
+                        const TSPARSE_INDEX_TYPE* _indices, size_t _count, const float* _b, size_t _ldb,
+                        float* _c, size_t _ldc, size_t _n) noexcept
+{
+  constexpr size_t width = VecF32::width;
+  size_t j = 0;
+
+  for (; j + 4 * width <= _n; j += 4 * width)
+    SpmmTileF32<ROWS, 4, true>(_blocks, _block_size, _block_cols, _indices, _count, _b + j, _ldb, _c + j, _ldc, width);
+
+  for (; j + width <= _n; j += width)
+    SpmmTileF32<ROWS, 1, true>(_blocks, _block_size, _block_cols, _indices, _count, _b + j, _ldb, _c + j, _ldc, width);
+
+  if (j < _n)
+    SpmmTileF32<ROWS, 1, false>(_blocks, _block_size, _block_cols, _indices, _count, _b + j, _ldb, _c + j, _ldc, _n - j);
+}
+
+// The _block_rows rows of C of one block row, _count blocks of _block_rows x _block_cols at _blocks,
+// block p multiplies the rows of B from _indices[p] * _block_cols on, B and C have _n columns
+inline void SpmmF32(size_t _block_rows, size_t _block_cols, const float* _blocks,
+                    const TSPARSE_INDEX_TYPE* _indices, size_t _count, const float* _b, size_t _ldb,
+                    float* _c, size_t _ldc, size_t _n) noexcept
+{
+  const size_t block_size = _block_rows * _block_cols;
+
+  for (size_t r = 0; r < _block_rows; r += 4)
+  {
+    const float* blocks = _blocks + r * _block_cols;
+    float* c = _c + r * _ldc;
+
+    switch (std::min<size_t>(4, _block_rows - r))
+    {
+      case 4: SpmmRowsF32<4>(blocks, block_size, _block_cols, _indices, _count, _b, _ldb, c, _ldc, _n); break;
+      case 3: SpmmRowsF32<3>(blocks, block_size, _block_cols, _indices, _count, _b, _ldb, c, _ldc, _n); break;
+      case 2: SpmmRowsF32<2>(blocks, block_size, _block_cols, _indices, _count, _b, _ldb, c, _ldc, _n); break;
+      default: SpmmRowsF32<1>(blocks, block_size, _block_cols, _indices, _count, _b, _ldb, c, _ldc, _n); break;
+    }
+  }
+}
+
+// Dots of _a with ROWS rows of B of _depth items
+template <size_t ROWS>
+inline void SddmmDotsF32(const float* _a, const float* const* _rows, size_t _depth, float* _dots) noexcept
+{
+  const size_t width = VecF32::width;
+
+  VecF32 acc[ROWS];
+
+  MNT_UNROLL
+  for (size_t t = 0; t < ROWS; t++)
+    acc[t] = Zero();
+
+  size_t k = 0;
+  for (; k + width <= _depth; k += width)
+  {
+    const VecF32 a = Load(_a + k);
+    MNT_UNROLL
+    for (size_t t = 0; t < ROWS; t++)
+      acc[t] = Fma(a, Load(_rows[t] + k), acc[t]);
+  }
+
+  if (k < _depth)
+  {
+    const VecF32 a = LoadPartial(_a + k, _depth - k);
+    MNT_UNROLL
+    for (size_t t = 0; t < ROWS; t++)
+      acc[t] = Fma(a, LoadPartial(_rows[t] + k, _depth - k), acc[t]);
+  }
+
+  MNT_UNROLL
+  for (size_t t = 0; t < ROWS; t++)
+    _dots[t] = ReduceAdd(acc[t]);
+}
+
+// _out[p] = _values[p] * dot(_a, row _indices[p] of B), for the _count non-zeros of one row
+inline void SddmmF32(const float* _a, const float* _b, size_t _ldb, size_t _depth,
+                     const TSPARSE_INDEX_TYPE* _indices, const float* _values, float* _out, size_t _count) noexcept
+{
+  size_t p = 0;
+
+  for (; p + 4 <= _count; p += 4)
+  {
+    const float* rows[4] = {_b + (size_t)_indices[p] * _ldb, _b + (size_t)_indices[p + 1] * _ldb,
+                            _b + (size_t)_indices[p + 2] * _ldb, _b + (size_t)_indices[p + 3] * _ldb};
+    float dots[4];
+    SddmmDotsF32<4>(_a, rows, _depth, dots);
+
+    for (size_t t = 0; t < 4; t++)
+      _out[p + t] = _values[p + t] * dots[t];
+  }
+
+  for (; p < _count; p++)
+  {
+    const float* row = _b + (size_t)_indices[p] * _ldb;
+    float dot;
+    SddmmDotsF32<1>(_a, &row, _depth, &dot);
+    _out[p] = _values[p] * dot;
+  }
+}
@@ -0,0 +1,71 @@
+// File Name:     variants.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Compiles the kernel bodies once per instruction set
+
+// ---------------------
+// Detail Description:
+// "kernels.inl" is included several times, each time inside a different namespace
+// (mnt::kernels::generic, sse4, avx2, avx512, neon) that sees the matching SIMD
+// namespace, and inside the matching target region, so the same source turns into
+// one machine code variant per instruction set.
+// ---------------------
+
+// ---------------------
+// Note:
+// The bodies are included inside a namespace, so they must not include any header,
+// everything they need is included here, before the first namespace is opened
+// ---------------------
+
+#ifndef ENGINE_MATH_KERNELS_VARIANTS_HPP
+#define ENGINE_MATH_KERNELS_VARIANTS_HPP
+
+#include "math/simd/simd.hpp"
+#include "math/kernels/registry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <bitset>
+
+namespace mnt { namespace kernels { namespace generic {
+  using namespace mnt::simd::generic;
+  #include "math/kernels/kernels.inl"
+}}}
+
+#if defined(MNT_SIMD_X86)
+
+MNT_TARGET_SSE4_BEGIN
+namespace mnt { namespace kernels { namespace sse4 {
+  using namespace mnt::simd::sse4;
+  #include "math/kernels/kernels.inl"
+}}}
+MNT_TARGET_END
+
+MNT_TARGET_AVX2_BEGIN
+namespace mnt { namespace kernels { namespace avx2 {
+  using namespace mnt::simd::avx2;
+  #include "math/kernels/kernels.inl"
+}}}
+MNT_TARGET_END
+
+MNT_TARGET_AVX512_BEGIN
+namespace mnt { namespace kernels { namespace avx512 {
+  using namespace mnt::simd::avx512;
+  #include "math/kernels/kernels.inl"
+}}}
+MNT_TARGET_END
+
+#elif defined(MNT_SIMD_NEON)
+
+namespace mnt { namespace kernels { namespace neon {
+  using namespace mnt::simd::neon;
+  #include "math/kernels/kernels.inl"
+}}}
+
+#endif
+
+#endif
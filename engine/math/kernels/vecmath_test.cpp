@@ -0,0 +1,203 @@
+// File Name:     vecmath_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Accuracy and speed of the vector math functions on every instruction set
+
+// ---------------------
+// Detail Description:
+// Every function is evaluated on a linear sweep of its range and on a sweep of magnitudes,
+// and compared with the double precision function of the standard library. The error is in
+// ulp of the float result, denormal results are measured in ulp of the smallest denormal.
+// The derivatives cross zero where they cancel, their error is in ulp of 1 below 1.
+// The speed is compared with a scalar loop of the float function of the standard library.
+// ---------------------
+
+#include "math/kernels/registry.hpp"
+
+#include "utils/cpu.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <vector>
+
+using namespace mnt;
+
+namespace {
+
+  struct Function
+  {
+    const char* name;
+    float low;
+    float high;
+    double floor;          // The error is in ulp of max(|f(x)|, floor)
+    double bound;          // The maximum error documented in "vecmath.inl", in ulp
+    std::function<void(const KernelTable&, const float*, float*, size_t)> kernel;
+    std::function<double(double)> exact;
+    std::function<float(float)> scalar;
+  };
+
+  double Ulps(float _value, double _exact, double _floor)
+  {
+    if (std::isnan(_exact))
+      return std::isnan(_value) ? 0.0 : std::numeric_limits<double>::infinity();
+
+    const float rounded = (float)_exact;
+    if (std::isinf(rounded))
+      return rounded == _value ? 0.0 : std::numeric_limits<double>::infinity();
+
+    const double magnitude = std::max({(double)std::fabs(rounded), _floor, (double)std::numeric_limits<float>::min()});
+    const double ulp = std::nextafter((float)magnitude, std::numeric_limits<float>::infinity()) - (float)magnitude;
+    return std::fabs((double)_value - _exact) / ulp;
+  }
+
+  // A linear sweep of [_low, _high] and the magnitudes from 1e-30 inside it, both signs
+  std::vector<float> Inputs(float _low, float _high)
+  {
+    const size_t count = 1 << 20;
+    std::vector<float> inputs;
+
+    for (size_t i = 0; i < count; i++)
+      inputs.push_back(_low + (_high - _low) * ((float)i / (float)(count - 1)));
+
+    for (size_t i = 0; i < count; i++)
+    {
+      const float magnitude = std::pow(10.0f, -30.0f + 60.0f * ((float)i / (float)(count - 1)));
+      if (magnitude <= _high)
+        inputs.push_back(magnitude);
+      if (-magnitude >= _low)
+        inputs.push_back(-magnitude);
+    }
+
+    return inputs;
+  }
+
+  double Seconds(const std::function<void()>& _function)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++)
+      _function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / 10;
+  }
+
+  double Phi(double _x) {return std::erfc(-_x / std::sqrt(2.0)) / 2.0;}
+  double Sigmoid(double _x) {return 1.0 / (1.0 + std::exp(-_x));}
+}
+
+int main()
+{
+  const std::vector<Function> functions = {
+    {"exp", -103.0f, 88.0f, 0.0, 1.5,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.exp(_x, _y, _n);},
+     [](double _x) {return std::exp(_x);}, [](float _x) {return std::exp(_x);}},
+    {"log", 1e-30f, 1e30f, 0.0, 1.5,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.log(_x, _y, _n);},
+     [](double _x) {return std::log(_x);}, [](float _x) {return std::log(_x);}},
+    {"tanh", -10.0f, 10.0f, 0.0, 3.0,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.tanh(_x, _y, _n);},
+     [](double _x) {return std::tanh(_x);}, [](float _x) {return std::tanh(_x);}},
+    {"sigmoid", -87.0f, 30.0f, 0.0, 3.0,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.sigmoid(_x, _y, _n);},
+     [](double _x) {return Sigmoid(_x);}, [](float _x) {return 1.0f / (1.0f + std::exp(-_x));}},
+    {"erf", -6.0f, 6.0f, 0.0, 3.0,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.erf(_x, _y, _n);},
+     [](double _x) {return std::erf(_x);}, [](float _x) {return std::erf(_x);}},
+    {"gelu", -13.0f, 10.0f, 0.0, 7.5,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.activation(_x, _y, _n, Activation::Gelu);},
+     [](double _x) {return _x * Phi(_x);}, [](float _x) {return _x * std::erfc(-_x * 0.70710678f) / 2.0f;}},
+    {"silu", -87.0f, 30.0f, 0.0, 3.5,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n) {_t.activation(_x, _y, _n, Activation::Silu);},
+     [](double _x) {return _x * Sigmoid(_x);}, [](float _x) {return _x / (1.0f + std::exp(-_x));}},
+    {"gelu'", -13.0f, 10.0f, 1.0, 2.0,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n)
+     {
+       const std::vector<float> ones(_n, 1.0f);
+       _t.activation_backward(_x, ones.data(), _y, _n, Activation::Gelu);
+     },
+     [](double _x) {return Phi(_x) + _x * std::exp(-_x * _x / 2.0) / std::sqrt(2.0 * M_PI);},
+     [](float _x) {return std::erfc(-_x * 0.70710678f) / 2.0f + _x * std::exp(-_x * _x / 2.0f) * 0.39894228f;}},
+    {"silu'", -87.0f, 30.0f, 1.0, 2.0,
+     [](const KernelTable& _t, const float* _x, float* _y, size_t _n)
+     {
+       const std::vector<float> ones(_n, 1.0f);
+       _t.activation_backward(_x, ones.data(), _y, _n, Activation::Silu);
+     },
+     [](double _x) {return Sigmoid(_x) * (1.0 + _x * (1.0 - Sigmoid(_x)));},
+     [](float _x) {const float s = 1.0f / (1.0f + std::exp(-_x)); return s * (1.0f + _x * (1.0f - s));}},
+  };
+
+  const ISA isas[] = {ISA::Generic, ISA::SSE4, ISA::AVX2, ISA::AVX512, ISA::NEON};
+  const size_t length = 1 << 16;
+  std::vector<float> bench(length), out(length);
+  for (size_t i = 0; i < length; i++)
+    bench[i] = -8.0f + 16.0f * (float)i / (float)length;
+
+  int failures = 0;
+
+  for (const ISA isa : isas)
+  {
+    const KernelTable& table = KernelRegistry::Get(isa);
+    if (table.isa != isa)
+      continue;
+
+    std::printf("%s\n", CPU::ISAName(isa));
+    std::printf("  %-8s %10s %14s %14s %8s\n", "function", "max ulp", "at", "ns per item", "speedup");
+
+    for (const Function& function : functions)
+    {
+      const std::vector<float> inputs = Inputs(function.low, function.high);
+      std::vector<float> outputs(inputs.size());
+      function.kernel(table, inputs.data(), outputs.data(), inputs.size());
+
+      double worst = 0.0;
+      float at = 0.0f;
+      for (size_t i = 0; i < inputs.size(); i++)
+      {
+        const double error = Ulps(outputs[i], function.exact((double)inputs[i]), function.floor);
+        if (error > worst)
+        {
+          worst = error;
+          at = inputs[i];
+        }
+      }
+
+      const double vector = Seconds([&]() {function.kernel(table, bench.data(), out.data(), length);});
+      const double scalar = Seconds([&]()
+      {
+        for (size_t i = 0; i < length; i++)
+          out[i] = function.scalar(bench[i]);
+      });
+
+      std::printf("  %-8s %10.2f %14g %14.3f %8.1f\n", function.name, worst, at,
+                  vector * 1e9 / length, scalar / vector);
+
+      // The bounds documented in "vecmath.inl" hold on every instruction set
+      if (worst > function.bound)
+      {
+        std::printf("  %s exceeds its bound of %g ulp\n", function.name, function.bound);
+        failures++;
+      }
+    }
+
+    // Special values
+    const float specials[] = {0.0f, -0.0f, std::numeric_limits<float>::infinity(),
+                              -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+    float results[5];
+
+    table.exp(specials, results, 5);
+    failures += !(results[0] == 1.0f && std::isinf(results[2]) && results[3] == 0.0f && std::isnan(results[4]));
+    table.log(specials, results, 5);
+    failures += !(std::isinf(results[0]) && results[0] < 0.0f && std::isinf(results[2]) && std::isnan(results[4]));
+    table.tanh(specials, results, 5);
+    failures += !(results[0] == 0.0f && results[2] == 1.0f && results[3] == -1.0f && std::isnan(results[4]));
+    table.erf(specials, results, 5);
+    failures += !(results[0] == 0.0f && results[2] == 1.0f && results[3] == -1.0f && std::isnan(results[4]));
+  }
+
+  std::printf("%s\n", failures ? "FAILED" : "OK");
+
+  return failures ? 1 : 0;
+}
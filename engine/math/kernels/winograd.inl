@@ -0,0 +1,125 @@
+// File Name:     winograd.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Input and output transforms of Winograd F(4x4, 3x3)
+
+// ---------------------
+// Note:
+// No include guard on purpose, it is included once per instruction set by "variants.hpp"
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Both transforms are vectorized over tiles, the caller gathers the items of _count tiles
+// into rows (row r holds item r of every tile) and the kernels read and write whole rows:
+//   - input:  36 rows of 6x6 input blocks  -> 36 rows of BT d B
+//   - output: 36 rows of the GEMM results  -> 16 rows of AT m A (4x4 output blocks)
+// ---------------------
+
+inline VecF32 WinogradLoad(const float* _src, size_t _count) noexcept
+{
+  return _count == VecF32::width ? Load(_src) : LoadPartial(_src, _count);
+}
+
+inline void WinogradStore(float* _dst, const VecF32 _a, size_t _count) noexcept
+{
+  if (_count == VecF32::width)
+    Store(_dst, _a);
+  else
+    StorePartial(_dst, _a, _count);
+}
+
+// BT = [ 4   0  -5   0   1   0 ]
+//      [ 0  -4  -4   1   1   0 ]
+//      [ 0   4  -4  -1   1   0 ]
+//      [ 0  -2  -1   2   1   0 ]
+//      [ 0   2  -1  -2   1   0 ]
+//      [ 0   4   0  -5   0   1 ]
+inline void WinogradRowBT(const VecF32 _d[6], VecF32 _r[6]) noexcept
+{
+  const VecF32 two = Set(2.0f), four = Set(4.0f), five = Set(5.0f);
+
+  _r[0] = Add(Sub(Mul(four, _d[0]), Mul(five, _d[2])), _d[4]);
+  _r[1] = Sub(Add(_d[3], _d[4]), Mul(four, Add(_d[1], _d[2])));
+  _r[2] = Add(Mul(four, Sub(_d[1], _d[2])), Sub(_d[4], _d[3]));
+  _r[3] = Add(Mul(two, Sub(_d[3], _d[1])), Sub(_d[4], _d[2]));
+  _r[4] = Add(Mul(two, Sub(_d[1], _d[3])), Sub(_d[4], _d[2]));
+  _r[5] = Add(Sub(Mul(four, _d[1]), Mul(five, _d[3])), _d[5]);
+}
+
+// AT = [ 1   1   1   1   1   0 ]
+//      [ 0   1  -1   2  -2   0 ]
+//      [ 0   1   1   4   4   0 ]
+//      [ 0   1  -1   8  -8   1 ]
+inline void WinogradRowAT(const VecF32 _m[6], VecF32 _r[4]) noexcept
+{
+  const VecF32 sum_12 = Add(_m[1], _m[2]), diff_12 = Sub(_m[1], _m[2]);
+  const VecF32 sum_34 = Add(_m[3], _m[4]), diff_34 = Sub(_m[3], _m[4]);
+
+  _r[0] = Add(Add(_m[0], sum_12), sum_34);
+  _r[1] = Fma(Set(2.0f), diff_34, diff_12);
+  _r[2] = Fma(Set(4.0f), sum_34, sum_12);
+  _r[3] = Add(Fma(Set(8.0f), diff_34, diff_12), _m[5]);
+}
+
+inline void WinogradInputF32(const float* _d, size_t _d_stride, float* _v, size_t _v_stride,
+                             size_t _count) noexcept
+{
+  for (size_t j = 0; j < _count; j += VecF32::width)
+  {
+    const size_t count = std::min(VecF32::width, _count - j);
+
+    // BT d, column by column
+    VecF32 t[6][6];
+    for (size_t x = 0; x < 6; x++)
+    {
+      VecF32 column[6], result[6];
+      for (size_t y = 0; y < 6; y++)
+        column[y] = WinogradLoad(_d + (y * 6 + x) * _d_stride + j, count);
+
+      WinogradRowBT(column, result);
+      for (size_t y = 0; y < 6; y++)
+        t[y][x] = result[y];
+    }
+
+    // (BT d) B, row by row
+    for (size_t y = 0; y < 6; y++)
+    {
+      VecF32 result[6];
+      WinogradRowBT(t[y], result);
+      for (size_t x = 0; x < 6; x++)
+        WinogradStore(_v + (y * 6 + x) * _v_stride + j, result[x], count);
+    }
+  }
+}
+
+inline void WinogradOutputF32(const float* _m, size_t _m_stride, float* _y, size_t _y_stride,
+                              size_t _count) noexcept
+{
+  for (size_t j = 0; j < _count; j += VecF32::width)
+  {
+    const size_t count = std::min(VecF32::width, _count - j);
+
+    // AT m, column by column
+    VecF32 t[4][6];
+    for (size_t x = 0; x < 6; x++)
+    {
+      VecF32 column[6], result[4];
+      for (size_t y = 0; y < 6; y++)
+        column[y] = WinogradLoad(_m + (y * 6 + x) * _m_stride + j, count);
+
+      WinogradRowAT(column, result);
+      for (size_t y = 0; y < 4; y++)
+        t[y][x] = result[y];
+    }
+
+    // (AT m) A, row by row
+    for (size_t y = 0; y < 4; y++)
+    {
+      VecF32 result[4];
+      WinogradRowAT(t[y], result);
+      for (size_t x = 0; x < 4; x++)
+        WinogradStore(_y + (y * 4 + x) * _y_stride + j, result[x], count);
+    }
+  }
+}
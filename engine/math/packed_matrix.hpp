@@ -0,0 +1,61 @@
+// File Name:     packed_matrix.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The right operand of matrix products, packed once for the kernels that read it
+
+// ---------------------
+// Detail Description:
+// Float matrices are stored in blocks of MNT_GEMM_SKINNY_KC rows, a block holds panels of
+// gemm_nr columns of the active KernelTable one after the other, every panel row by row,
+// and the panel at the edge is zero padded. With kc = MNT_GEMM_SKINNY_KC, nr = gemm_nr, the
+// columns rounded up to cols and the rows of the block rows:
+//
+//   row k, column j -> data[(k / kc) * kc * cols + (j / nr) * rows * nr + (k % kc) * nr + j % nr]
+//
+// The skinny kernels stream it from start to end, and the panels of the packed GEMM are
+// copied from it a block at a time. The other types keep a row-major copy.
+// ---------------------
+
+// ---------------------
+// Note:
+// The layout depends on the instruction set chosen by KernelRegistry, a PackedMatrix can`t be
+// saved and loaded on another machine, pack the weights again when they are loaded
+// ---------------------
+
+#ifndef ENGINE_MATH_PACKED_MATRIX_HPP
+#define ENGINE_MATH_PACKED_MATRIX_HPP
+
+#include "math/tensor.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mnt {
+
+  template <typename T>
+  class PackedMatrix
+  {
+  public:
+    // _matrix is a plain tensor of rank 2 or a view of one
+    explicit PackedMatrix(Tensor<T>& _matrix);
+
+    size_t Rows() const noexcept;
+    size_t Cols() const noexcept;
+
+    // Columns per panel, 0 for the row-major copy
+    size_t PanelWidth() const noexcept;
+
+    const T* Data() const noexcept;
+
+  private:
+    size_t m_rows;
+    size_t m_cols;
+    size_t m_panel_width = 0;
+
+    std::vector<T> m_data;
+  };
+}
+
+#include "math/packed_matrix.inl"
+
+#endif
@@ -0,0 +1,78 @@
+// File Name:     packed_matrix.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The right operand of matrix products, packed once for the kernels that read it
+
+#ifndef ENGINE_MATH_PACKED_MATRIX_INL
+#define ENGINE_MATH_PACKED_MATRIX_INL
+
+#include "math/packed_matrix.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace mnt;
+
+template <typename T>
+PackedMatrix<T>::PackedMatrix(Tensor<T>& _matrix)
+{
+  if (_matrix.Rank() != 2 || _matrix.MemoryLayout() != Layout::Plain)
+    MNT_THROW("PackedMatrix needs a plain tensor of rank 2");
+
+  const TensorStrides strides = _matrix.Strides();
+  m_rows = _matrix.Shape()[0];
+  m_cols = _matrix.Shape()[1];
+
+  const T* src = _matrix.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const KernelTable& table = KernelRegistry::Get();
+    m_panel_width = table.gemm_nr;
+
+    const size_t kc = MNT_GEMM_SKINNY_KC;
+    const size_t cols = (m_cols + m_panel_width - 1) / m_panel_width * m_panel_width;
+    m_data.resize(cols * m_rows);
+
+    for (size_t k=0; k<m_rows; k+=kc)
+      table.gemm_pack_b(src + k * strides[0], strides[0], strides[1], std::min(kc, m_rows - k), m_cols,
+                        m_data.data() + k * cols);
+  }
+  else
+  {
+    m_data.resize(m_rows * m_cols);
+
+    for (size_t i=0; i<m_rows; i++)
+      for (size_t j=0; j<m_cols; j++)
+        m_data[i * m_cols + j] = src[i * strides[0] + j * strides[1]];
+  }
+}
+
+template <typename T>
+size_t PackedMatrix<T>::Rows() const noexcept
+{
+  return m_rows;
+}
+
+template <typename T>
+size_t PackedMatrix<T>::Cols() const noexcept
+{
+  return m_cols;
+}
+
+template <typename T>
+size_t PackedMatrix<T>::PanelWidth() const noexcept
+{
+  return m_panel_width;
+}
+
+template <typename T>
+const T* PackedMatrix<T>::Data() const noexcept
+{
+  return m_data.data();
+}
+
+#endif
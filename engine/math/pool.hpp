@@ -0,0 +1,63 @@
+// File Name:     pool.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Parameters, geometry and plain kernels of 2-D pooling
+
+// ---------------------
+// Note:
+// Windows that fall partly in the padding only see the valid items, the average is taken
+// over the valid items, and a max window always has at least one valid item
+// ---------------------
+
+#ifndef ENGINE_MATH_POOL_HPP
+#define ENGINE_MATH_POOL_HPP
+
+#include "configs.hpp"
+
+#include "math/shape.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mnt {
+
+  struct Pool2DParams
+  {
+    size_t kernel_h = 2;
+    size_t kernel_w = 2;
+    size_t stride_h = 2;
+    size_t stride_w = 2;
+    size_t padding_h = 0;
+    size_t padding_w = 0;
+  };
+
+  struct Pool2DGeometry
+  {
+    size_t batch;
+    size_t channels;
+    size_t in_height;
+    size_t in_width;
+    size_t out_height;
+    size_t out_width;
+
+    Pool2DParams params;
+
+    // Throws if the shape or the parameters are not valid
+    Pool2DGeometry(const TensorShape& _input_shape, const Pool2DParams& _params);
+
+    // Window rows [_begin, _end) of output row _oh that fall inside the input, same for columns
+    void Rows(size_t _oh, size_t& _begin, size_t& _end) const noexcept;
+    void Cols(size_t _ow, size_t& _begin, size_t& _end) const noexcept;
+  };
+
+  // Pools the plane _plane (= image * channels + channel) of a plain tensor
+  template <typename T>
+  void MaxPool2DPlane(const T* _input, T* _output, const Pool2DGeometry& _geometry, size_t _plane) noexcept;
+
+  template <typename T>
+  void AvgPool2DPlane(const T* _input, T* _output, const Pool2DGeometry& _geometry, size_t _plane) noexcept;
+}
+
+#include "math/pool.inl"
+
+#endif
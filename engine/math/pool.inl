@@ -0,0 +1,108 @@
+// File Name:     pool.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Parameters, geometry and plain kernels of 2-D pooling
+
+#ifndef ENGINE_MATH_POOL_INL
+#define ENGINE_MATH_POOL_INL
+
+#include "math/pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+
+using namespace mnt;
+
+inline Pool2DGeometry::Pool2DGeometry(const TensorShape& _input_shape, const Pool2DParams& _params)
+  : params(_params)
+{
+  if (_input_shape.size() != 4)
+    MNT_THROW("Pooling needs an input of shape {N, C, H, W}");
+
+  batch = _input_shape[0];
+  channels = _input_shape[1];
+  in_height = _input_shape[2];
+  in_width = _input_shape[3];
+
+  if (params.kernel_h == 0 || params.kernel_w == 0 || params.stride_h == 0 || params.stride_w == 0)
+    MNT_THROW("Pooling windows and strides must be at least 1");
+
+  // Every window has at least one item inside the input
+  if (params.padding_h >= params.kernel_h || params.padding_w >= params.kernel_w)
+    MNT_THROW("Pooling padding must be smaller than the window");
+
+  if (params.kernel_h > in_height + 2 * params.padding_h || params.kernel_w > in_width + 2 * params.padding_w)
+    MNT_THROW("Pooling window is bigger than the padded input");
+
+  out_height = (in_height + 2 * params.padding_h - params.kernel_h) / params.stride_h + 1;
+  out_width = (in_width + 2 * params.padding_w - params.kernel_w) / params.stride_w + 1;
+};
+
+inline void Pool2DGeometry::Rows(size_t _oh, size_t& _begin, size_t& _end) const noexcept
+{
+  const ptrdiff_t first = (ptrdiff_t)(_oh * params.stride_h) - (ptrdiff_t)params.padding_h;
+  _begin = (size_t)std::max(first, (ptrdiff_t)0);
+  _end = (size_t)std::min(first + (ptrdiff_t)params.kernel_h, (ptrdiff_t)in_height);
+};
+
+inline void Pool2DGeometry::Cols(size_t _ow, size_t& _begin, size_t& _end) const noexcept
+{
+  const ptrdiff_t first = (ptrdiff_t)(_ow * params.stride_w) - (ptrdiff_t)params.padding_w;
+  _begin = (size_t)std::max(first, (ptrdiff_t)0);
+  _end = (size_t)std::min(first + (ptrdiff_t)params.kernel_w, (ptrdiff_t)in_width);
+};
+
+template <typename T>
+void mnt::MaxPool2DPlane(const T* _input, T* _output, const Pool2DGeometry& _geometry, size_t _plane) noexcept
+{
+  const T* input = _input + _plane * _geometry.in_height * _geometry.in_width;
+  T* output = _output + _plane * _geometry.out_height * _geometry.out_width;
+
+  for (size_t oh = 0; oh < _geometry.out_height; oh++)
+  {
+    size_t h_begin, h_end;
+    _geometry.Rows(oh, h_begin, h_end);
+
+    for (size_t ow = 0; ow < _geometry.out_width; ow++)
+    {
+      size_t w_begin, w_end;
+      _geometry.Cols(ow, w_begin, w_end);
+
+      T result = input[h_begin * _geometry.in_width + w_begin];
+      for (size_t h = h_begin; h < h_end; h++)
+        for (size_t w = w_begin; w < w_end; w++)
+          result = std::max(result, input[h * _geometry.in_width + w]);
+
+      output[oh * _geometry.out_width + ow] = result;
+    }
+  }
+};
+
+template <typename T>
+void mnt::AvgPool2DPlane(const T* _input, T* _output, const Pool2DGeometry& _geometry, size_t _plane) noexcept
+{
+  const T* input = _input + _plane * _geometry.in_height * _geometry.in_width;
+  T* output = _output + _plane * _geometry.out_height * _geometry.out_width;
+
+  for (size_t oh = 0; oh < _geometry.out_height; oh++)
+  {
+    size_t h_begin, h_end;
+    _geometry.Rows(oh, h_begin, h_end);
+
+    for (size_t ow = 0; ow < _geometry.out_width; ow++)
+    {
+      size_t w_begin, w_end;
+      _geometry.Cols(ow, w_begin, w_end);
+
+      T sum = T(0);
+      for (size_t h = h_begin; h < h_end; h++)
+        for (size_t w = w_begin; w < w_end; w++)
+          sum += input[h * _geometry.in_width + w];
+
+      output[oh * _geometry.out_width + ow] = sum / T((h_end - h_begin) * (w_end - w_begin));
+    }
+  }
+};
+
+#endif
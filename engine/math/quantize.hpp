@@ -0,0 +1,143 @@
+// File Name:     quantize.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   8-bit quantized tensors and the calibration of their ranges
+
+// ---------------------
+// Detail Description:
+// A quantized item q of int8_t or uint8_t stands for the float (q - zero_point) * scale.
+// Weights are usually signed and symmetric (zero_point = 0) with one scale per output channel,
+// activations unsigned with one scale and zero point for the whole tensor, which maps the
+// range seen during calibration to [0, 255]. Float 0 is always exactly representable, so
+// zero padding stays zero.
+// QuantizedTensor holds the items and the params, per tensor or per channel along one axis,
+// the int8 matrix products take their right operand as a QuantizedMatrix, see
+// "math/quantized_matrix.hpp" and "MatMul" of "math/backend.hpp".
+// ---------------------
+
+// ---------------------
+// Note:
+// Post-training calibration: run the float model on a few representative batches, let a
+// Calibrator per activation "Observe" its values, then use "Params" of every Calibrator to
+// quantize that activation, e.g. with "QuantizedMatrix::SetInputParams". Without calibration
+// the int8 MatMul chooses the params of every input from its own range, which costs one
+// more pass over the input
+// ---------------------
+
+// =====
+// [ChooseQuantParams<T>(_min, _max, _symmetric)]: The params that map [_min, _max], widened to
+// include 0, to the items of T. Symmetric params map [-m, m] with m = max(|_min|, |_max|) to
+// [-127, 127], or to [1, 255] around 128 for uint8_t. Throws if the range is not finite
+// =====
+
+// =====
+// [FindRange(_x, _length, _min, _max)]: The smallest and largest of _length floats, 0 and 0 if
+// _length is 0, in parallel for long inputs
+// =====
+
+// =====
+// [QuantizedTensor(_tensor, _params)]: Quantizes a contiguous float tensor with one set of params
+// =====
+
+// =====
+// [QuantizedTensor(_tensor, _axis, _symmetric)]: Quantizes a contiguous float tensor in the plain
+// layout with params chosen from the range of every index of _axis
+// =====
+
+// =====
+// [Calibrator(_momentum)]: With a _momentum of 0 the range is the smallest and largest value ever
+// observed, otherwise it is a moving average of the ranges of the observed tensors,
+// range = _momentum * range + (1 - _momentum) * new range, which ignores rare outliers
+// =====
+
+#ifndef ENGINE_MATH_QUANTIZE_HPP
+#define ENGINE_MATH_QUANTIZE_HPP
+
+#include "math/tensor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+
+namespace mnt {
+
+  struct QuantParams
+  {
+    float scale = 1.0f;
+    int32_t zero_point = 0;
+  };
+
+  // Smallest and largest items of T
+  template <typename T>
+  constexpr int32_t QuantMin() noexcept {return std::is_signed<T>::value ? -128 : 0;};
+  template <typename T>
+  constexpr int32_t QuantMax() noexcept {return std::is_signed<T>::value ? 127 : 255;};
+
+  template <typename T>
+  QuantParams ChooseQuantParams(float _min, float _max, bool _symmetric = false);
+
+  void FindRange(const float* _x, size_t _length, float& _min, float& _max);
+
+  template <typename T>
+  class QuantizedTensor
+  {
+    static_assert(std::is_same<T, int8_t>::value || std::is_same<T, uint8_t>::value,
+                  "Quantized items are int8_t or uint8_t");
+
+  public:
+    QuantizedTensor(Tensor<float>& _tensor, const QuantParams& _params);
+    QuantizedTensor(Tensor<float>& _tensor, size_t _axis, bool _symmetric = std::is_signed<T>::value);
+
+    Tensor<float> Dequantize();
+
+    Tensor<T>& Data() noexcept;
+
+    // One set of params, or one per index of "Axis"
+    const std::vector<QuantParams>& Params() const noexcept;
+    bool PerChannel() const noexcept;
+    size_t Axis() const noexcept;
+
+    // The quantization kernels of KernelRegistry for T
+    static void Quantize(const float* _x, T* _y, size_t _length, const QuantParams& _params);
+    static void Dequantize(const T* _x, float* _y, size_t _length, const QuantParams& _params);
+
+  private:
+    // Calls _function(channel, offset, length) for every contiguous run of items of one channel
+    template <typename F>
+    void ForEachRun(const F& _function) const;
+
+  private:
+    Tensor<T> m_data;
+    std::vector<QuantParams> m_params;
+    size_t m_axis = 0;
+    bool m_per_channel = false;
+  };
+
+  class Calibrator
+  {
+  public:
+    explicit Calibrator(float _momentum = 0.0f);
+
+    void Observe(Tensor<float>& _tensor);
+
+    template <typename T>
+    QuantParams Params(bool _symmetric = std::is_signed<T>::value) const;
+
+    float Min() const noexcept;
+    float Max() const noexcept;
+    size_t Observations() const noexcept;
+
+    void Reset() noexcept;
+
+  private:
+    float m_momentum;
+    float m_min = 0.0f;
+    float m_max = 0.0f;
+    size_t m_observations = 0;
+  };
+}
+
+#include "math/quantize.inl"
+
+#endif
@@ -0,0 +1,289 @@
+// File Name:     quantize.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   8-bit quantized tensors and the calibration of their ranges
+
+#ifndef ENGINE_MATH_QUANTIZE_INL
+#define ENGINE_MATH_QUANTIZE_INL
+
+#include "math/quantize.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+
+using namespace mnt;
+
+template <typename T>
+QuantParams mnt::ChooseQuantParams(float _min, float _max, bool _symmetric)
+{
+  if (!std::isfinite(_min) || !std::isfinite(_max) || _min > _max)
+    MNT_THROW(("Can`t quantize the range [" + std::to_string(_min) + ", " + std::to_string(_max) + "]").c_str());
+
+  const float min = std::min(_min, 0.0f);
+  const float max = std::max(_max, 0.0f);
+
+  QuantParams params;
+
+  if (_symmetric)
+  {
+    const float bound = std::max(-min, max);
+    params.scale = bound > 0.0f ? bound / 127.0f : 1.0f;
+    params.zero_point = std::is_signed<T>::value ? 0 : 128;
+    return params;
+  }
+
+  if (max == min)
+    return params;
+
+  // The zero point is rounded, so 0 is exact and the ends of the range are off by half a step at most
+  params.scale = (max - min) / (float)(QuantMax<T>() - QuantMin<T>());
+  const float zero_point = std::nearbyint((float)QuantMin<T>() - min / params.scale);
+  params.zero_point = (int32_t)std::min(std::max(zero_point, (float)QuantMin<T>()), (float)QuantMax<T>());
+
+  return params;
+}
+
+inline void mnt::FindRange(const float* _x, size_t _length, float& _min, float& _max)
+{
+  if (_length == 0)
+  {
+    _min = _max = 0.0f;
+    return;
+  }
+
+  const KernelTable& table = KernelRegistry::Get();
+
+  const std::pair<float, float> range = ParallelReduce(0, _length, std::make_pair(_x[0], _x[0]),
+    [&](size_t _begin, size_t _end)
+    {
+      return std::make_pair(table.reduce_min(_x + _begin, _end - _begin), table.reduce_max(_x + _begin, _end - _begin));
+    },
+    [](const std::pair<float, float>& _a, const std::pair<float, float>& _b)
+    {
+      return std::make_pair(std::min(_a.first, _b.first), std::max(_a.second, _b.second));
+    }, 1);
+
+  _min = range.first;
+  _max = range.second;
+};
+
+template <typename T>
+QuantizedTensor<T>::QuantizedTensor(Tensor<float>& _tensor, const QuantParams& _params) :
+  m_data(_tensor.Shape(), _tensor.MemoryLayout())
+{
+  if (!_tensor.IsContiguous())
+    MNT_THROW("QuantizedTensor needs a contiguous tensor, \"Reorder\" makes a contiguous copy");
+
+  m_params.push_back(_params);
+
+  const float* x = _tensor.Data();
+  T* y = m_data.Data();
+
+  ParallelFor(0, m_data.Length(), [&](size_t _begin, size_t _end)
+  {
+    Quantize(x + _begin, y + _begin, _end - _begin, _params);
+  }, 1);
+}
+
+template <typename T>
+QuantizedTensor<T>::QuantizedTensor(Tensor<float>& _tensor, size_t _axis, bool _symmetric) :
+  m_data(_tensor.Shape()), m_axis(_axis), m_per_channel(true)
+{
+  if (!_tensor.IsContiguous() || _tensor.MemoryLayout() != Layout::Plain)
+    MNT_THROW("QuantizedTensor needs a contiguous tensor in the plain layout");
+
+  if (_axis >= _tensor.Rank())
+    MNT_THROW(("Axis " + std::to_string(_axis) + " is out of the shape " + _tensor.ShapeStr()).c_str());
+
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t channels = _tensor.Shape()[_axis];
+  const float* x = _tensor.Data();
+  T* y = m_data.Data();
+
+  std::vector<float> mins(channels, 0.0f);
+  std::vector<float> maxs(channels, 0.0f);
+  std::vector<bool> seen(channels, false);
+
+  ForEachRun([&](size_t _channel, size_t _offset, size_t _length)
+  {
+    const float min = table.reduce_min(x + _offset, _length);
+    const float max = table.reduce_max(x + _offset, _length);
+    mins[_channel] = seen[_channel] ? std::min(mins[_channel], min) : min;
+    maxs[_channel] = seen[_channel] ? std::max(maxs[_channel], max) : max;
+    seen[_channel] = true;
+  });
+
+  m_params.resize(channels);
+  for (size_t c=0; c<channels; c++)
+    m_params[c] = ChooseQuantParams<T>(mins[c], maxs[c], _symmetric);
+
+  ForEachRun([&](size_t _channel, size_t _offset, size_t _length)
+  {
+    Quantize(x + _offset, y + _offset, _length, m_params[_channel]);
+  });
+}
+
+template <typename T>
+Tensor<float> QuantizedTensor<T>::Dequantize()
+{
+  Tensor<float> result(m_data.Shape(), m_data.MemoryLayout());
+
+  const T* x = m_data.Data();
+  float* y = result.Data();
+
+  if (m_per_channel)
+    ForEachRun([&](size_t _channel, size_t _offset, size_t _length)
+    {
+      Dequantize(x + _offset, y + _offset, _length, m_params[_channel]);
+    });
+  else
+    ParallelFor(0, result.Length(), [&](size_t _begin, size_t _end)
+    {
+      Dequantize(x + _begin, y + _begin, _end - _begin, m_params[0]);
+    }, 1);
+
+  return result;
+}
+
+// The runs of a channel are the items of one index of the axis under one index of the axes before it
+template <typename T>
+template <typename F>
+void QuantizedTensor<T>::ForEachRun(const F& _function) const
+{
+  const TensorShape& shape = m_data.Shape();
+  const size_t channels = shape[m_axis];
+
+  size_t outer = 1;
+  size_t inner = 1;
+  for (size_t d=0; d<m_axis; d++)
+    outer *= shape[d];
+  for (size_t d=m_axis+1; d<shape.size(); d++)
+    inner *= shape[d];
+
+  if (inner == 0)
+    return;
+
+  for (size_t o=0; o<outer; o++)
+    for (size_t c=0; c<channels; c++)
+      _function(c, (o * channels + c) * inner, inner);
+}
+
+template <typename T>
+Tensor<T>& QuantizedTensor<T>::Data() noexcept
+{
+  return m_data;
+}
+
+template <typename T>
+const std::vector<QuantParams>& QuantizedTensor<T>::Params() const noexcept
+{
+  return m_params;
+}
+
+template <typename T>
+bool QuantizedTensor<T>::PerChannel() const noexcept
+{
+  return m_per_channel;
+}
+
+template <typename T>
+size_t QuantizedTensor<T>::Axis() const noexcept
+{
+  return m_axis;
+}
+
+template <typename T>
+void QuantizedTensor<T>::Quantize(const float* _x, T* _y, size_t _length, const QuantParams& _params)
+{
+  const KernelTable& table = KernelRegistry::Get();
+
+  if constexpr (std::is_signed<T>::value)
+    table.quantize_s8(_x, _y, _length, _params.scale, _params.zero_point);
+  else
+    table.quantize_u8(_x, _y, _length, _params.scale, _params.zero_point);
+}
+
+template <typename T>
+void QuantizedTensor<T>::Dequantize(const T* _x, float* _y, size_t _length, const QuantParams& _params)
+{
+  const KernelTable& table = KernelRegistry::Get();
+
+  if constexpr (std::is_signed<T>::value)
+    table.dequantize_s8(_x, _y, _length, _params.scale, _params.zero_point);
+  else
+    table.dequantize_u8(_x, _y, _length, _params.scale, _params.zero_point);
+}
+
+inline Calibrator::Calibrator(float _momentum)
+{
+  if (!(_momentum >= 0.0f && _momentum < 1.0f))
+    MNT_THROW("The momentum of a Calibrator must be in [0, 1)");
+
+  m_momentum = _momentum;
+};
+
+inline void Calibrator::Observe(Tensor<float>& _tensor)
+{
+  if (!_tensor.IsContiguous())
+    MNT_THROW("Calibrator needs a contiguous tensor, \"Reorder\" makes a contiguous copy");
+
+  if (_tensor.Length() == 0)
+    return;
+
+  float min, max;
+  FindRange(_tensor.Data(), _tensor.Length(), min, max);
+
+  if (m_observations == 0)
+  {
+    m_min = min;
+    m_max = max;
+  }
+  else if (m_momentum == 0.0f)
+  {
+    m_min = std::min(m_min, min);
+    m_max = std::max(m_max, max);
+  }
+  else
+  {
+    m_min = m_momentum * m_min + (1.0f - m_momentum) * min;
+    m_max = m_momentum * m_max + (1.0f - m_momentum) * max;
+  }
+
+  m_observations++;
+};
+
+template <typename T>
+QuantParams Calibrator::Params(bool _symmetric) const
+{
+  return ChooseQuantParams<T>(m_min, m_max, _symmetric);
+}
+
+inline float Calibrator::Min() const noexcept
+{
+  return m_min;
+};
+
+inline float Calibrator::Max() const noexcept
+{
+  return m_max;
+};
+
+inline size_t Calibrator::Observations() const noexcept
+{
+  return m_observations;
+};
+
+inline void Calibrator::Reset() noexcept
+{
+  m_min = m_max = 0.0f;
+  m_observations = 0;
+};
+
+#endif
@@ -0,0 +1,316 @@
+// File Name:     quantize_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the int8 quantization and the int8 MatMul on every instruction set
+
+// ---------------------
+// Detail Description:
+// The int8 MatMul accumulates in int32, so given the same quantized items it has to match a
+// naive product of the dequantized items to float rounding. The inputs of 255 times weights
+// of the largest magnitude are the worst case of PMADDUBSW, a pair of their products is
+// 2 * 255 * 127 with weights of +-127, past the int16 it saturates to, and only the limit of
+// +-qgemm_weight_max on the ISA levels keeps it exact.
+// The quantization kernels are compared with the rounding of a naive loop, a value that ends
+// within a hair of a tie can round either way, the ISA levels without FMA round twice.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/kernels/registry.hpp"
+#include "math/test_utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  template <typename T>
+  void CheckQuantizeKernels(Checks& _checks, const char* _type)
+  {
+    Tensor<float> tensor({1003});
+    Fill(tensor, 1, -3.0, 5.0);
+    tensor[0] = 0.0f;
+    tensor[1] = 100.0f;
+    tensor[2] = -100.0f;
+
+    const QuantParams params = ChooseQuantParams<T>(-2.0f, 4.0f);
+    std::vector<T> quantized(tensor.Length());
+    std::vector<float> dequantized(tensor.Length());
+
+    QuantizedTensor<T>::Quantize(tensor.Data(), quantized.data(), tensor.Length(), params);
+    QuantizedTensor<T>::Dequantize(quantized.data(), dequantized.data(), tensor.Length(), params);
+
+    size_t wrong = 0;
+    for (size_t i=0; i<tensor.Length(); i++)
+    {
+      const double exact = (double)tensor[i] / params.scale + params.zero_point;
+      const double clamped = std::min(std::max(exact, (double)QuantMin<T>()), (double)QuantMax<T>());
+      const double rounded = std::nearbyint(clamped);
+      const bool tie = std::fabs(clamped - std::floor(clamped) - 0.5) < 1e-4;
+
+      if (quantized[i] != rounded && !(tie && std::fabs(quantized[i] - clamped) < 1.0))
+        wrong++;
+
+      const double expected = ((double)quantized[i] - params.zero_point) * params.scale;
+      if (std::fabs(dequantized[i] - expected) > 1e-6 * std::fmax(1.0, std::fabs(expected)))
+        wrong++;
+    }
+
+    _checks.Expect(wrong == 0, std::string(_type) + " quantization kernels got " + std::to_string(wrong) + " items wrong");
+    _checks.Expect(quantized[0] == params.zero_point && dequantized[0] == 0.0f, std::string(_type) + " 0 isn`t exact");
+    _checks.Expect(quantized[1] == QuantMax<T>() && quantized[2] == QuantMin<T>(),
+                   std::string(_type) + " quantization doesn`t saturate");
+  }
+
+  template <typename T>
+  void CheckQuantizedTensor(Checks& _checks, const char* _type)
+  {
+    Tensor<float> tensor({3, 5, 37});
+    Fill(tensor, 2, -1.0, 1.0);
+
+    // Channels of very different ranges, one all zero
+    for (size_t o=0; o<3; o++)
+      for (size_t c=0; c<5; c++)
+        for (size_t i=0; i<37; i++)
+          tensor[(o * 5 + c) * 37 + i] *= c == 4 ? 0.0f : std::pow(10.0f, (float)c - 2.0f);
+
+    QuantizedTensor<T> per_tensor(tensor, ChooseQuantParams<T>(-100.0f, 100.0f));
+    QuantizedTensor<T> per_channel(tensor, 1);
+
+    _checks.Expect(per_channel.PerChannel() && per_channel.Params().size() == 5,
+                   std::string(_type) + " per channel params");
+
+    Tensor<float> restored_tensor = per_tensor.Dequantize();
+    Tensor<float> restored_channel = per_channel.Dequantize();
+
+    size_t wrong = 0;
+    for (size_t o=0; o<3; o++)
+      for (size_t c=0; c<5; c++)
+        for (size_t i=0; i<37; i++)
+        {
+          const size_t index = (o * 5 + c) * 37 + i;
+          const float step_tensor = per_tensor.Params()[0].scale;
+          const float step_channel = per_channel.Params()[c].scale;
+
+          wrong += std::fabs(restored_tensor[index] - tensor[index]) > 0.5001f * step_tensor;
+          wrong += std::fabs(restored_channel[index] - tensor[index]) > 0.5001f * step_channel;
+        }
+
+    _checks.Expect(wrong == 0, std::string(_type) + " quantized tensors are off by more than half a step at " +
+                               std::to_string(wrong) + " items");
+
+    Tensor<float> view = tensor.Shapeshift({0, 2, 1});
+    _checks.Throws([&]() {QuantizedTensor<T> quantized(view, ChooseQuantParams<T>(-1.0f, 1.0f));},
+                   std::string(_type) + " quantization of a view");
+    _checks.Throws([&]() {QuantizedTensor<T> quantized(tensor, 3);}, std::string(_type) + " quantization along axis 3");
+  }
+
+  void CheckParams(Checks& _checks)
+  {
+    const QuantParams unsigned_params = ChooseQuantParams<uint8_t>(0.5f, 3.0f);
+    const QuantParams signed_params = ChooseQuantParams<int8_t>(-2.0f, 1.0f, true);
+
+    _checks.Expect(unsigned_params.zero_point == 0, "the range is widened to 0");
+    _checks.Near(unsigned_params.scale, 3.0 / 255.0, 1e-6, "scale of [0, 3]");
+    _checks.Expect(signed_params.zero_point == 0, "symmetric int8 params have a zero point of 0");
+    _checks.Near(signed_params.scale, 2.0 / 127.0, 1e-6, "scale of [-2, 2]");
+    _checks.Expect(ChooseQuantParams<uint8_t>(-1.0f, 1.0f, true).zero_point == 128,
+                   "symmetric uint8 params have a zero point of 128");
+
+    _checks.Throws([&]() {ChooseQuantParams<uint8_t>(0.0f, INFINITY);}, "params of an infinite range");
+    _checks.Throws([&]() {ChooseQuantParams<uint8_t>(0.0f, NAN);}, "params of a NaN range");
+    _checks.Throws([&]() {ChooseQuantParams<uint8_t>(1.0f, -1.0f);}, "params of an empty range");
+
+    Tensor<float> first({100});
+    Tensor<float> second({100});
+    Fill(first, 3, -1.0, 2.0);
+    Fill(second, 4, -3.0, 1.0);
+    first[0] = -1.0f;
+    first[1] = 2.0f;
+    second[0] = -3.0f;
+    second[1] = 1.0f;
+
+    Calibrator plain;
+    Calibrator moving(0.5f);
+    for (Tensor<float>* tensor : {&first, &second})
+    {
+      plain.Observe(*tensor);
+      moving.Observe(*tensor);
+    }
+
+    _checks.Expect(plain.Min() == -3.0f && plain.Max() == 2.0f, "range of a plain Calibrator");
+    _checks.Expect(moving.Min() == -2.0f && moving.Max() == 1.5f, "range of a moving average Calibrator");
+    _checks.Expect(plain.Observations() == 2, "observations of a Calibrator");
+    _checks.Throws([&]() {Calibrator calibrator(1.0f);}, "Calibrator of momentum 1");
+  }
+
+  // The product the int8 MatMul stands for, A quantized with _params and the dequantized weights
+  std::vector<double> NaiveQuantizedMatMul(const Tensor<float>& _tensor, const Tensor<float>& _weights,
+                                           const QuantParams& _params)
+  {
+    const size_t k = _weights.Shape()[0];
+    const size_t n = _weights.Shape()[1];
+    const size_t m = _tensor.Length() / k;
+
+    std::vector<double> output(m * n, 0.0);
+
+    for (size_t i=0; i<m; i++)
+      for (size_t p=0; p<k; p++)
+      {
+        const float x = std::fma(_tensor.Data()[i * k + p], 1.0f / _params.scale, (float)_params.zero_point);
+        const double q = std::nearbyint(std::min(std::max(x, 0.0f), 255.0f));
+        const double a = (q - _params.zero_point) * _params.scale;
+
+        for (size_t j=0; j<n; j++)
+          output[i * n + j] += a * _weights.Data()[p * n + j];
+      }
+
+    return output;
+  }
+
+  void CheckQuantizedMatrix(Checks& _checks)
+  {
+    const int32_t limit = KernelRegistry::Get().qgemm_weight_max;
+    _checks.Expect(limit == 63 || limit == 127, "weights are limited to " + std::to_string(limit));
+
+    Tensor<float> weights({45, 70});
+    Fill(weights, 5);
+    weights[3 * 70 + 2] = 4.0f;
+
+    QuantizedMatrix matrix(weights);
+    Tensor<float> dequantized = matrix.Dequantize();
+
+    size_t wrong = 0;
+    for (size_t j=0; j<70; j++)
+    {
+      const float scale = matrix.Scales()[j];
+      int32_t sum = 0;
+
+      for (size_t i=0; i<45; i++)
+      {
+        const float q = dequantized[i * 70 + j] / scale;
+        wrong += std::fabs(q) > limit + 1e-3f || std::fabs(q - std::nearbyint(q)) > 1e-3f;
+        wrong += std::fabs(dequantized[i * 70 + j] - weights[i * 70 + j]) > 0.5001f * scale;
+        sum += (int32_t)std::nearbyint(q);
+      }
+
+      wrong += sum != matrix.Sums()[j];
+    }
+
+    _checks.Expect(wrong == 0, "quantized weights are wrong at " + std::to_string(wrong) + " items");
+    _checks.Expect(dequantized[3 * 70 + 2] == 4.0f, "the largest weight of a column isn`t exact");
+
+    Tensor<float> infinite({2, 2});
+    infinite[3] = INFINITY;
+    Tensor<float> vector({4});
+    _checks.Throws([&]() {QuantizedMatrix quantized(infinite);}, "QuantizedMatrix of infinity");
+    _checks.Throws([&]() {QuantizedMatrix quantized(vector);}, "QuantizedMatrix of a vector");
+  }
+
+  void CheckMatMul(Checks& _checks, const TensorShape& _shape, size_t _n, bool _calibrated, const std::string& _what)
+  {
+    DefaultBackend<float> backend;
+
+    const size_t k = _shape.back();
+    Tensor<float> tensor(_shape);
+    Tensor<float> weights({(TSHAPE_TYPE)k, (TSHAPE_TYPE)_n});
+    Fill(tensor, 6, -0.5, 2.0);
+    Fill(weights, 7);
+
+    QuantizedMatrix matrix(weights);
+    Tensor<float> dequantized = matrix.Dequantize();
+
+    float min, max;
+    min = max = 0.0f;
+    for (size_t i=0; i<tensor.Length(); i++)
+    {
+      min = std::min(min, tensor[i]);
+      max = std::max(max, tensor[i]);
+    }
+
+    QuantParams params = ChooseQuantParams<uint8_t>(min, max);
+    if (_calibrated)
+    {
+      params = ChooseQuantParams<uint8_t>(-0.25f, 1.5f);
+      matrix.SetInputParams(params);
+    }
+
+    Tensor<float> result = backend.MatMul(tensor, matrix);
+
+    TensorShape shape = _shape;
+    shape.back() = (TSHAPE_TYPE)_n;
+    _checks.Expect(result.Shape() == shape, _what + " has the shape " + result.ShapeStr());
+    _checks.Items(result, NaiveQuantizedMatMul(tensor, dequantized, params), 1e-4, _what);
+
+    // The double product multiplies by the dequantized weights without quantizing the input
+    DefaultBackend<double> backend_double;
+    Tensor<double> tensor_double(_shape);
+    for (size_t i=0; i<tensor.Length(); i++)
+      tensor_double[i] = tensor[i];
+
+    Tensor<double> result_double = backend_double.MatMul(tensor_double, matrix);
+    std::vector<double> expected(result_double.Length(), 0.0);
+    const size_t m = tensor.Length() / k;
+    for (size_t i=0; i<m; i++)
+      for (size_t p=0; p<k; p++)
+        for (size_t j=0; j<_n; j++)
+          expected[i * _n + j] += tensor_double[i * k + p] * (double)dequantized[p * _n + j];
+
+    _checks.Items(result_double, expected, 1e-6, "double " + _what);
+  }
+
+  // Inputs of 255 and weights of the largest magnitude, every pair of products is as large as it gets
+  void CheckSaturation(Checks& _checks)
+  {
+    DefaultBackend<float> backend;
+
+    const size_t m = 5, k = 67, n = 37;
+    Tensor<float> tensor({(TSHAPE_TYPE)m, (TSHAPE_TYPE)k});
+    Tensor<float> weights({(TSHAPE_TYPE)k, (TSHAPE_TYPE)n});
+
+    for (size_t i=0; i<tensor.Length(); i++)
+      tensor[i] = i % 7 == 6 ? -1.0f : 1.0f;
+
+    // Columns of all +1, all -1, and of alternating signs
+    for (size_t p=0; p<k; p++)
+      for (size_t j=0; j<n; j++)
+        weights[p * n + j] = j % 3 == 0 ? 1.0f : j % 3 == 1 ? -1.0f : p % 2 ? 1.0f : -1.0f;
+
+    QuantizedMatrix matrix(weights);
+    matrix.SetInputParams(ChooseQuantParams<uint8_t>(-1.0f, 1.0f));
+
+    Tensor<float> result = backend.MatMul(tensor, matrix);
+    _checks.Items(result, NaiveQuantizedMatMul(tensor, matrix.Dequantize(), matrix.InputParams()), 1e-4,
+                  "MatMul of the largest int8 items");
+
+    Tensor<float> wrong_depth({4, 66});
+    _checks.Throws([&]() {backend.MatMul(wrong_depth, matrix);}, "int8 MatMul of another depth");
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckQuantizeKernels<int8_t>(checks, "int8");
+    CheckQuantizeKernels<uint8_t>(checks, "uint8");
+    CheckQuantizedTensor<int8_t>(checks, "int8");
+    CheckQuantizedTensor<uint8_t>(checks, "uint8");
+    CheckParams(checks);
+    CheckQuantizedMatrix(checks);
+
+    CheckMatMul(checks, {33, 100}, 70, false, "int8 MatMul");
+    CheckMatMul(checks, {2, 3, 19}, 5, true, "int8 MatMul calibrated");
+    CheckMatMul(checks, {1, 1000}, 129, false, "int8 MatMul of one long row");
+    CheckMatMul(checks, {200, 3}, 300, true, "int8 MatMul of a short depth");
+    CheckSaturation(checks);
+
+    return checks.Failures();
+  });
+}
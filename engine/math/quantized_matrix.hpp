@@ -0,0 +1,81 @@
+// File Name:     quantized_matrix.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The int8 right operand of matrix products, quantized and packed once
+
+// ---------------------
+// Detail Description:
+// The weights of a layer, a float matrix of {rows, cols}, are quantized column by column
+// with symmetric params, every output has its own scale and the zero point is 0, and packed
+// in the layout of "KernelTable::qgemm_pack_b". The sums of the quantized items of every
+// column are kept as well, the product with an unsigned A of zero point z is
+//
+//   C[i][j] = scale_a * scale_b[j] * (sum_k A[i][k] * B[k][j] - z * sum_k B[k][j])
+//
+// so the zero point of A costs nothing in the inner loop. The params of A can be set once
+// from calibration, see "math/quantize.hpp", otherwise "Gemm::Quantized" has to be given them
+// and "MatMul" chooses them from every input.
+// ---------------------
+
+// ---------------------
+// Note:
+// Weights are quantized to +-qgemm_weight_max of the active KernelTable, 127 with VNNI and
+// 63 with the PMADDUBSW kernels of the ISA levels, which add pairs of products in int16,
+// so like PackedMatrix, a QuantizedMatrix can`t be saved and loaded on another machine
+// ---------------------
+
+#ifndef ENGINE_MATH_QUANTIZED_MATRIX_HPP
+#define ENGINE_MATH_QUANTIZED_MATRIX_HPP
+
+#include "math/tensor.hpp"
+#include "math/quantize.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mnt {
+
+  class QuantizedMatrix
+  {
+  public:
+    // _matrix is a plain tensor of rank 2 or a view of one
+    explicit QuantizedMatrix(Tensor<float>& _matrix);
+
+    size_t Rows() const noexcept;
+    size_t Cols() const noexcept;
+
+    // Columns per panel of the packed items
+    size_t PanelWidth() const noexcept;
+
+    const int8_t* Data() const noexcept;
+
+    // Per column, the scale and the sum of the quantized items
+    const float* Scales() const noexcept;
+    const int32_t* Sums() const noexcept;
+
+    // The float matrix the quantized items stand for
+    Tensor<float> Dequantize() const;
+
+    // Quantization of the left operand, e.g. from a Calibrator
+    void SetInputParams(const QuantParams& _params) noexcept;
+    bool HasInputParams() const noexcept;
+    const QuantParams& InputParams() const noexcept;
+
+  private:
+    size_t m_rows;
+    size_t m_cols;
+    size_t m_panel_width;
+
+    std::vector<int8_t> m_data;
+    std::vector<float> m_scales;
+    std::vector<int32_t> m_sums;
+
+    QuantParams m_input_params;
+    bool m_has_input_params = false;
+  };
+}
+
+#include "math/quantized_matrix.inl"
+
+#endif
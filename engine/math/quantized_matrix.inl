@@ -0,0 +1,128 @@
+// File Name:     quantized_matrix.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   The int8 right operand of matrix products, quantized and packed once
+
+#ifndef ENGINE_MATH_QUANTIZED_MATRIX_INL
+#define ENGINE_MATH_QUANTIZED_MATRIX_INL
+
+#include "math/quantized_matrix.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mnt;
+
+inline QuantizedMatrix::QuantizedMatrix(Tensor<float>& _matrix)
+{
+  if (_matrix.Rank() != 2 || _matrix.MemoryLayout() != Layout::Plain || _matrix.Storage() != MemoryKind::Linear)
+    MNT_THROW("QuantizedMatrix needs a plain tensor of rank 2");
+
+  const KernelTable& table = KernelRegistry::Get();
+  const TensorStrides strides = _matrix.Strides();
+  const float* src = _matrix.Data();
+
+  m_rows = _matrix.Shape()[0];
+  m_cols = _matrix.Shape()[1];
+  m_panel_width = table.qgemm_nr;
+
+  const float limit = (float)table.qgemm_weight_max;
+  std::vector<int8_t> items(m_rows * m_cols);
+  m_scales.assign(m_cols, 1.0f);
+  m_sums.assign(m_cols, 0);
+
+  for (size_t j=0; j<m_cols; j++)
+  {
+    float bound = 0.0f;
+    for (size_t i=0; i<m_rows; i++)
+      bound = std::max(bound, std::fabs(src[i * strides[0] + j * strides[1]]));
+
+    if (!std::isfinite(bound))
+      MNT_THROW("QuantizedMatrix can`t quantize infinity or NaN");
+
+    if (bound > 0.0f)
+      m_scales[j] = bound / limit;
+
+    const float inverse = 1.0f / m_scales[j];
+    for (size_t i=0; i<m_rows; i++)
+    {
+      const float q = std::nearbyint(src[i * strides[0] + j * strides[1]] * inverse);
+      const int8_t item = (int8_t)std::min(std::max(q, -limit), limit);
+      items[i * m_cols + j] = item;
+      m_sums[j] += item;
+    }
+  }
+
+  const size_t depth4 = (m_rows + 3) / 4 * 4;
+  const size_t cols = (m_cols + m_panel_width - 1) / m_panel_width * m_panel_width;
+  m_data.resize(depth4 * cols);
+
+  table.qgemm_pack_b(items.data(), m_cols, 1, m_rows, m_cols, m_data.data());
+};
+
+inline size_t QuantizedMatrix::Rows() const noexcept
+{
+  return m_rows;
+};
+
+inline size_t QuantizedMatrix::Cols() const noexcept
+{
+  return m_cols;
+};
+
+inline size_t QuantizedMatrix::PanelWidth() const noexcept
+{
+  return m_panel_width;
+};
+
+inline const int8_t* QuantizedMatrix::Data() const noexcept
+{
+  return m_data.data();
+};
+
+inline const float* QuantizedMatrix::Scales() const noexcept
+{
+  return m_scales.data();
+};
+
+inline const int32_t* QuantizedMatrix::Sums() const noexcept
+{
+  return m_sums.data();
+};
+
+// Reads the items back from the packed layout, see "math/kernels/qgemm.inl"
+inline Tensor<float> QuantizedMatrix::Dequantize() const
+{
+  Tensor<float> result({(TSHAPE_TYPE)m_rows, (TSHAPE_TYPE)m_cols});
+  float* dst = result.Data();
+
+  const size_t nr = m_panel_width;
+  const size_t depth4 = (m_rows + 3) / 4 * 4;
+
+  for (size_t i=0; i<m_rows; i++)
+    for (size_t j=0; j<m_cols; j++)
+      dst[i * m_cols + j] = m_scales[j] * m_data[(j / nr) * depth4 * nr + (i / 4) * 4 * nr + (j % nr) * 4 + i % 4];
+
+  return result;
+};
+
+inline void QuantizedMatrix::SetInputParams(const QuantParams& _params) noexcept
+{
+  m_input_params = _params;
+  m_has_input_params = true;
+};
+
+inline bool QuantizedMatrix::HasInputParams() const noexcept
+{
+  return m_has_input_params;
+};
+
+inline const QuantParams& QuantizedMatrix::InputParams() const noexcept
+{
+  return m_input_params;
+};
+
+#endif
@@ -0,0 +1,132 @@
+// File Name:     random.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Counter-based random numbers for initializers and dropout
+
+// ---------------------
+// Detail Description:
+// Philox4x32-10 is a counter-based generator: the 4 words of block n of a stream are a pure
+// function of (seed, stream, n), there is no state to carry from one value to the next. Any
+// thread can produce any slice of the stream directly, so the fills run in parallel and give
+// the same values for every number of threads.
+//
+// The stream is laid out in groups of 64 values, 16 blocks of 4 words, value 16 * j + b of a
+// group is word j of its block b. It lets a vector of blocks store word j of all of them at
+// once, see "math/kernels/random.inl", and "Philox::operator()" gives the value at any offset
+// with the same order.
+//
+// Generator keeps an offset into one stream and every fill takes the next whole groups of it,
+// a fill always starts at a group boundary. Float values come from the kernels, uniform ones
+// are the top 24 bits of a word, normal ones Box-Muller on pairs of words, Bernoulli bits
+// compare a uniform float with p. Other item types use the same words with scalar code.
+// ---------------------
+
+// ---------------------
+// Note:
+// Bits and Bernoulli bits are exactly the same on every instruction set, floats may differ in
+// the last bits between instruction sets with and without FMA and, for normal ones, because of
+// the vectorized log. Normal values are limited to 5.77 standard deviations by the 24 bits of
+// their uniform input
+// ---------------------
+
+// =====
+// [Philox(_seed, _stream)]: Independent streams of the same seed, e.g. one per layer or one
+// per device, never overlap
+// =====
+
+// =====
+// [Block(_counter, _key, _out)]: The reference scalar Philox4x32-10 of one block
+// =====
+
+// =====
+// [Generate(_offset, _out, _count)]: The _count values of the stream from _offset on
+// =====
+
+// =====
+// [Generator(_seed, _stream)]: Fills tensors from the stream (_seed, _stream) starting at offset 0
+// =====
+
+// =====
+// [Uniform(_tensor, _low, _high)]: Values in [_low, _high), for integer items _high - _low has
+// to fit 32 bits, double items use two words for 53 bits. Throws on a tensor that is not
+// contiguous
+// =====
+
+// =====
+// [Normal(_tensor, _mean, _stddev)]: Values of the normal distribution, floating point items only
+// =====
+
+// =====
+// [Bernoulli(_mask, _probability)]: Every bit is set with _probability, e.g. the kept items of
+// dropout for "Dropout" of "math/backend.hpp". The overload for tensors writes ones and zeros
+// =====
+
+// =====
+// [Seek(_offset)]: Moves to any offset of the stream, e.g. to replay the masks of a step
+// =====
+
+#ifndef ENGINE_MATH_RANDOM_HPP
+#define ENGINE_MATH_RANDOM_HPP
+
+#include "math/tensor.hpp"
+#include "math/bitmask.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mnt {
+
+  class Philox
+  {
+  public:
+    explicit Philox(uint64_t _seed, uint64_t _stream = 0) noexcept;
+
+    static void Block(const uint32_t _counter[4], const uint32_t _key[2], uint32_t _out[4]) noexcept;
+
+    uint32_t operator () (uint64_t _offset) const noexcept;
+    void Generate(uint64_t _offset, uint32_t* _out, size_t _count) const;
+
+    inline uint64_t Seed() const noexcept {return m_seed;};
+    inline uint64_t Stream() const noexcept {return m_stream;};
+
+  private:
+    uint64_t m_seed;
+    uint64_t m_stream;
+  };
+
+  class Generator
+  {
+  public:
+    explicit Generator(uint64_t _seed, uint64_t _stream = 0) noexcept;
+
+    template <typename T>
+    void Uniform(Tensor<T>& _tensor, T _low = T(0), T _high = T(1));
+    template <typename T>
+    void Normal(Tensor<T>& _tensor, T _mean = T(0), T _stddev = T(1));
+    template <typename T>
+    void Bernoulli(Tensor<T>& _tensor, float _probability);
+    void Bernoulli(BitMask& _mask, float _probability);
+
+    inline const Philox& Engine() const noexcept {return m_engine;};
+    inline uint64_t Offset() const noexcept {return m_offset;};
+    inline void Seek(uint64_t _offset) noexcept {m_offset = _offset;};
+
+  private:
+    // Takes the next whole groups for _length values, returns the first group
+    uint64_t Reserve(size_t _length) noexcept;
+
+    template <typename T>
+    static void CheckTensor(const Tensor<T>& _tensor);
+
+    // Words of the groups from _group on, in parallel
+    void Words(uint64_t _group, uint32_t* _out, size_t _length) const;
+
+  private:
+    Philox m_engine;
+    uint64_t m_offset = 0;
+  };
+}
+
+#include "math/random.inl"
+
+#endif
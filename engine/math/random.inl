@@ -0,0 +1,274 @@
+// File Name:     random.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Counter-based random numbers for initializers and dropout
+
+#ifndef ENGINE_MATH_RANDOM_INL
+#define ENGINE_MATH_RANDOM_INL
+
+#include "math/random.hpp"
+#include "math/kernels/registry.hpp"
+#include "math/kernels/reference.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace mnt;
+
+namespace mnt { namespace random_detail {
+
+  // Values per group and blocks per group, see "math/kernels/random.inl"
+  constexpr size_t group = 64;
+  constexpr size_t group_blocks = 16;
+
+  // Estimated cycles of one group
+  constexpr size_t group_cost = 512;
+
+  inline constexpr size_t Groups(size_t _length) noexcept {return (_length + group - 1) / group;};
+}}
+
+inline Philox::Philox(uint64_t _seed, uint64_t _stream) noexcept :
+  m_seed(_seed), m_stream(_stream)
+{
+};
+
+inline void Philox::Block(const uint32_t _counter[4], const uint32_t _key[2], uint32_t _out[4]) noexcept
+{
+  uint32_t c0 = _counter[0], c1 = _counter[1], c2 = _counter[2], c3 = _counter[3];
+  uint32_t k0 = _key[0], k1 = _key[1];
+
+  for (size_t round = 0; round < 10; round++)
+  {
+    const uint64_t product0 = (uint64_t)0xD2511F53u * c0;
+    const uint64_t product1 = (uint64_t)0xCD9E8D57u * c2;
+
+    c0 = (uint32_t)(product1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)product1;
+    c2 = (uint32_t)(product0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)product0;
+
+    k0 += 0x9E3779B9u;
+    k1 += 0xBB67AE85u;
+  }
+
+  _out[0] = c0;
+  _out[1] = c1;
+  _out[2] = c2;
+  _out[3] = c3;
+};
+
+inline uint32_t Philox::operator () (uint64_t _offset) const noexcept
+{
+  const uint64_t position = _offset % random_detail::group;
+  const uint64_t block = _offset / random_detail::group * random_detail::group_blocks
+                       + position % random_detail::group_blocks;
+
+  const uint32_t counter[4] = {(uint32_t)block, (uint32_t)(block >> 32), (uint32_t)m_stream, (uint32_t)(m_stream >> 32)};
+  const uint32_t key[2] = {(uint32_t)m_seed, (uint32_t)(m_seed >> 32)};
+
+  uint32_t words[4];
+  Block(counter, key, words);
+
+  return words[position / random_detail::group_blocks];
+};
+
+inline void Philox::Generate(uint64_t _offset, uint32_t* _out, size_t _count) const
+{
+  // The values before the first group boundary one by one, the groups with the kernel
+  size_t head = 0;
+  for (; head < _count && (_offset + head) % random_detail::group; head++)
+    _out[head] = (*this)(_offset + head);
+
+  const size_t length = _count - head;
+  const uint64_t first = (_offset + head) / random_detail::group;
+  uint32_t* out = _out + head;
+  const auto kernel = KernelRegistry::Get().random_bits;
+
+  ParallelFor(0, random_detail::Groups(length), [&](size_t _begin, size_t _end)
+  {
+    const size_t begin = _begin * random_detail::group;
+    kernel(m_seed, m_stream, first + _begin, out + begin, std::min(_end * random_detail::group, length) - begin);
+  }, random_detail::group_cost);
+};
+
+inline Generator::Generator(uint64_t _seed, uint64_t _stream) noexcept :
+  m_engine(_seed, _stream)
+{
+};
+
+inline uint64_t Generator::Reserve(size_t _length) noexcept
+{
+  const uint64_t first = (m_offset + random_detail::group - 1) / random_detail::group;
+  m_offset = (first + random_detail::Groups(_length)) * random_detail::group;
+  return first;
+};
+
+template <typename T>
+void Generator::CheckTensor(const Tensor<T>& _tensor)
+{
+  if (_tensor.Length() > 0 && !_tensor.IsContiguous())
+    MNT_THROW(("Can`t fill the tensor " + _tensor.ShapeStr() + ", it is not contiguous").c_str());
+}
+
+inline void Generator::Words(uint64_t _group, uint32_t* _out, size_t _length) const
+{
+  m_engine.Generate(_group * random_detail::group, _out, _length);
+};
+
+template <typename T>
+void Generator::Uniform(Tensor<T>& _tensor, T _low, T _high)
+{
+  static_assert(std::is_arithmetic<T>::value, "Uniform values are of arithmetic types");
+
+  CheckTensor(_tensor);
+
+  const size_t length = _tensor.Length();
+  T* y = _tensor.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const uint64_t first = Reserve(length);
+    const auto kernel = KernelRegistry::Get().random_uniform;
+    const uint64_t seed = m_engine.Seed();
+    const uint64_t stream = m_engine.Stream();
+
+    ParallelFor(0, random_detail::Groups(length), [&](size_t _begin, size_t _end)
+    {
+      const size_t begin = _begin * random_detail::group;
+      kernel(seed, stream, first + _begin, y + begin, std::min(_end * random_detail::group, length) - begin, _low, _high);
+    }, random_detail::group_cost);
+  }
+  else if constexpr (std::is_floating_point<T>::value)
+  {
+    // 53 bits of two words per value
+    std::vector<uint32_t> words(2 * length);
+    Words(Reserve(2 * length), words.data(), 2 * length);
+
+    ParallelFor(0, length, [&](size_t _begin, size_t _end)
+    {
+      for (size_t i=_begin; i<_end; i++)
+      {
+        const uint64_t bits = ((uint64_t)(words[2 * i] >> 5) << 26) | (words[2 * i + 1] >> 6);
+        y[i] = _low + (_high - _low) * (T)((double)bits * 0x1.0p-53);
+      }
+    });
+  }
+  else
+  {
+    if (!(_low < _high) || (uint64_t)_high - (uint64_t)_low > 0xFFFFFFFFull)
+      MNT_THROW(("Can`t draw integers from [" + std::to_string(_low) + ", " + std::to_string(_high) + ")").c_str());
+
+    const uint64_t range = (uint64_t)_high - (uint64_t)_low;
+    std::vector<uint32_t> words(length);
+    Words(Reserve(length), words.data(), length);
+
+    // The high word of the product is in [0, range)
+    ParallelFor(0, length, [&](size_t _begin, size_t _end)
+    {
+      for (size_t i=_begin; i<_end; i++)
+        y[i] = (T)(_low + (T)((words[i] * range) >> 32));
+    });
+  }
+}
+
+template <typename T>
+void Generator::Normal(Tensor<T>& _tensor, T _mean, T _stddev)
+{
+  static_assert(std::is_floating_point<T>::value, "Normal values are of floating point types");
+
+  CheckTensor(_tensor);
+
+  const size_t length = _tensor.Length();
+  const uint64_t first = Reserve(length);
+  T* y = _tensor.Data();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    const auto kernel = KernelRegistry::Get().random_normal;
+    const uint64_t seed = m_engine.Seed();
+    const uint64_t stream = m_engine.Stream();
+
+    ParallelFor(0, random_detail::Groups(length), [&](size_t _begin, size_t _end)
+    {
+      const size_t begin = _begin * random_detail::group;
+      kernel(seed, stream, first + _begin, y + begin, std::min(_end * random_detail::group, length) - begin, _mean, _stddev);
+    }, random_detail::group_cost);
+  }
+  else
+  {
+    // The same pairs as the kernel, words j and j + 1 of a block, so whole groups of words
+    const size_t groups = random_detail::Groups(length);
+    std::vector<uint32_t> words(groups * random_detail::group);
+    Words(first, words.data(), words.size());
+
+    const double pi = 3.14159265358979323846;
+
+    ParallelFor(0, length, [&](size_t _begin, size_t _end)
+    {
+      for (size_t i=_begin; i<_end; i++)
+      {
+        // Values 16 * j + b of word j, the first of a pair has an even j
+        const bool second = (i % random_detail::group / random_detail::group_blocks) % 2;
+        const size_t u = second ? i - random_detail::group_blocks : i;
+        const size_t v = u + random_detail::group_blocks;
+
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - words[u] * 0x1.0p-32));
+        const double angle = 2.0 * pi * (words[v] * 0x1.0p-32 - 0.5);
+
+        y[i] = _mean + _stddev * (T)(radius * (second ? std::sin(angle) : std::cos(angle)));
+      }
+    });
+  }
+}
+
+inline void Generator::Bernoulli(BitMask& _mask, float _probability)
+{
+  if (!(_probability >= 0.0f && _probability <= 1.0f))
+    MNT_THROW(("Probability " + std::to_string(_probability) + " is out of [0, 1]").c_str());
+
+  const size_t length = _mask.Length();
+  const uint64_t first = Reserve(length);
+  const auto kernel = KernelRegistry::Get().random_bernoulli;
+  const uint64_t seed = m_engine.Seed();
+  const uint64_t stream = m_engine.Stream();
+  uint64_t* bits = _mask.Data();
+
+  // A group is one word of the mask
+  ParallelFor(0, _mask.Words(), [&](size_t _begin, size_t _end)
+  {
+    const size_t begin = _begin * random_detail::group;
+    kernel(seed, stream, first + _begin, bits + _begin, std::min(_end * random_detail::group, length) - begin, _probability);
+  }, random_detail::group_cost);
+};
+
+template <typename T>
+void Generator::Bernoulli(Tensor<T>& _tensor, float _probability)
+{
+  CheckTensor(_tensor);
+
+  BitMask mask(_tensor.Shape());
+  Bernoulli(mask, _probability);
+
+  auto kernel = &kernels::reference::MaskUnpack<T>;
+  if constexpr (std::is_same<T, float>::value)
+    kernel = KernelRegistry::Get().mask_unpack;
+
+  const size_t length = _tensor.Length();
+  const uint64_t* bits = mask.Data();
+  T* y = _tensor.Data();
+
+  ParallelFor(0, mask.Words(), [&](size_t _begin, size_t _end)
+  {
+    const size_t begin = _begin * 64;
+    kernel(bits + _begin, y + begin, std::min(_end * 64, length) - begin);
+  }, 64);
+}
+
+#endif
@@ -0,0 +1,130 @@
+// File Name:     reduce.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Reductions over any axes of strided tensors
+
+// ---------------------
+// Detail Description:
+// The axes of size 1 are dropped, the kept axes stay in their order, the reduced axes are
+// sorted by stride, and neighbours that are contiguous in memory are merged, e.g. the last two
+// axes of a plain tensor are one axis. Then one of three loops runs:
+//   - Runs:     the innermost reduced axis has stride 1, every output reduces contiguous runs
+//               with the reduction kernels of KernelRegistry
+//   - Rows:     the innermost kept axis has stride 1, the outputs are contiguous, rows of
+//               MNT_REDUCE_COLUMNS items are accumulated into vectors of outputs
+//   - Strided:  neither, runs are read with a stride, one item at a time
+// ---------------------
+
+// ---------------------
+// Detail Description:
+// Float sums are pairwise inside runs of up to MNT_REDUCE_SEGMENT items and the rows are
+// summed in blocks of MNT_REDUCE_BLOCK, the partial sums of the runs and blocks are then
+// accumulated in double, so the error doesn`t grow with the length of the reduction.
+// Variance is computed in two passes, the mean first and then the squares of the distances
+// to it, which doesn`t cancel like the sum of squares minus the squared sum does.
+// ---------------------
+
+// ---------------------
+// Note:
+// The threads split the outputs, or the reduced items if there are less than
+// MNT_REDUCE_SPLIT_OUTPUTS outputs. In that case the partial results of chunks are combined
+// in the order of chunks, but the chunks depend on the number of threads. With
+// "ReduceParams::deterministic" they are MNT_REDUCE_DETERMINISTIC_GRAIN items whatever the
+// number of threads, so the results are bitwise reproducible on any machine with the same
+// instruction set
+// ---------------------
+
+#ifndef ENGINE_MATH_REDUCE_HPP
+#define ENGINE_MATH_REDUCE_HPP
+
+#include "configs.hpp"
+
+#include "math/shape.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mnt {
+
+  struct ReduceParams
+  {
+    // Empty for all the axes
+    std::vector<size_t> axes;
+
+    // The reduced axes stay in the shape with size 1, otherwise they are removed,
+    // the reduction of all the axes has shape {1}
+    bool keep_dims = false;
+
+    // Results don`t depend on the number of threads
+    bool deterministic = false;
+
+    // Variance only, the sum of the squares is divided by (count - correction)
+    size_t correction = 0;
+  };
+
+  struct ReduceGeometry
+  {
+    TensorShape out_shape;
+    size_t outputs;
+    size_t count;          // Items per output
+
+    // Merged axes, the outputs are row-major over the kept ones
+    TensorStrides kept_extents;
+    TensorStrides kept_strides;
+
+    // Merged axes, largest stride first
+    TensorStrides reduced_extents;
+    TensorStrides reduced_strides;
+
+    // Every index and offset of the input fits in 32 bits, see "FitsIndex32"
+    bool index_32;
+
+    // Throws if the axes are out of range or repeated
+    ReduceGeometry(const TensorShape& _shape, const TensorStrides& _strides,
+                   const std::vector<size_t>& _axes, bool _keep_dims);
+
+    // True if the innermost kept axis has stride 1
+    bool IsRows() const noexcept;
+
+    // Offset of the first item of output _output
+    size_t KeptOffset(size_t _output) const noexcept;
+
+    // Offset of item _index of the first _axes reduced axes, row-major over them
+    size_t ReducedOffset(size_t _index, size_t _axes) const noexcept;
+
+  private:
+    // Row-major _index over the first _axes of _extents to an offset, in INDEX arithmetic
+    template <typename INDEX>
+    static size_t Offset(INDEX _index, const size_t* _extents, const size_t* _strides, size_t _axes) noexcept;
+  };
+
+  template <typename T>
+  class Reducer
+  {
+  public:
+    // Sum of the items of every output, or of (x - _center[output])^2 if _squares,
+    // _center can be nullptr for zero
+    static void Sum(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                    bool _deterministic, bool _squares = false, const T* _center = nullptr);
+
+    // Max or min, the geometry can`t have empty reduced axes
+    static void Extremum(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                         bool _maximum, bool _deterministic);
+
+    // Index of the first maximum along the only reduced axis, an axis of size 1 gives 0
+    static void ArgMax(const T* _input, const ReduceGeometry& _geometry, TSHAPE_TYPE* _output);
+
+  private:
+    // Partial results, kernels and accumulators of each reduction
+    struct SumOp;
+    struct ExtremumOp;
+
+    template <typename OP>
+    static void Run(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                    bool _deterministic, const OP& _op);
+  };
+}
+
+#include "math/reduce.inl"
+
+#endif
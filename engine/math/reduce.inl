@@ -0,0 +1,526 @@
+// File Name:     reduce.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Reductions over any axes of strided tensors
+
+#ifndef ENGINE_MATH_REDUCE_INL
+#define ENGINE_MATH_REDUCE_INL
+
+#include "math/reduce.hpp"
+#include "math/kernels/registry.hpp"
+#include "math/kernels/reference.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace mnt;
+
+inline ReduceGeometry::ReduceGeometry(const TensorShape& _shape, const TensorStrides& _strides,
+                                      const std::vector<size_t>& _axes, bool _keep_dims)
+{
+  const size_t rank = _shape.size();
+
+  SmallVector<bool, MNT_TENSOR_INLINE_RANK> reduced(rank, _axes.empty());
+  for (size_t axis : _axes)
+  {
+    if (axis >= rank || reduced[axis])
+      MNT_THROW(("Invalid axes to reduce a tensor of rank " + std::to_string(rank)).c_str());
+    reduced[axis] = true;
+  }
+
+  outputs = 1;
+  count = 1;
+  struct Axis
+  {
+    size_t stride;
+    size_t extent;
+  };
+  SmallVector<Axis, MNT_TENSOR_INLINE_RANK> reduced_axes;
+
+  for (size_t i=0; i<rank; i++)
+  {
+    if (reduced[i])
+    {
+      count *= _shape[i];
+      if (_keep_dims)
+        out_shape.push_back(1);
+      if (_shape[i] != 1)
+        reduced_axes.push_back({_strides[i], (size_t)_shape[i]});
+      continue;
+    }
+
+    outputs *= _shape[i];
+    out_shape.push_back(_shape[i]);
+
+    if (_shape[i] == 1)
+      continue;
+
+    if (!kept_extents.empty() && kept_strides.back() == _shape[i] * _strides[i])
+    {
+      kept_extents.back() *= _shape[i];
+      kept_strides.back() = _strides[i];
+    }
+    else
+    {
+      kept_extents.push_back(_shape[i]);
+      kept_strides.push_back(_strides[i]);
+    }
+  }
+
+  if (out_shape.empty())
+    out_shape.push_back(1);
+
+  // The largest offset of the input is the sum of (extent - 1) * stride
+  size_t span = 1;
+  for (size_t i=0; i<rank; i++)
+    span += _shape[i] ? (_shape[i] - 1) * _strides[i] : 0;
+  index_32 = FitsIndex32(span) && FitsIndex32(outputs) && FitsIndex32(count);
+
+  // The order of the reduced items doesn`t matter, the smallest stride goes last
+  std::stable_sort(reduced_axes.begin(), reduced_axes.end(),
+                   [](const Axis& _a, const Axis& _b) {return _a.stride > _b.stride;});
+
+  for (const Axis& axis : reduced_axes)
+  {
+    if (!reduced_extents.empty() && reduced_strides.back() == axis.extent * axis.stride)
+    {
+      reduced_extents.back() *= axis.extent;
+      reduced_strides.back() = axis.stride;
+    }
+    else
+    {
+      reduced_extents.push_back(axis.extent);
+      reduced_strides.push_back(axis.stride);
+    }
+  }
+};
+
+inline bool ReduceGeometry::IsRows() const noexcept
+{
+  return !kept_strides.empty() && kept_strides.back() == 1;
+};
+
+inline size_t ReduceGeometry::KeptOffset(size_t _output) const noexcept
+{
+  if (index_32)
+    return Offset<uint32_t>((uint32_t)_output, kept_extents.data(), kept_strides.data(), kept_extents.size());
+
+  return Offset<size_t>(_output, kept_extents.data(), kept_strides.data(), kept_extents.size());
+};
+
+inline size_t ReduceGeometry::ReducedOffset(size_t _index, size_t _axes) const noexcept
+{
+  if (index_32)
+    return Offset<uint32_t>((uint32_t)_index, reduced_extents.data(), reduced_strides.data(), _axes);
+
+  return Offset<size_t>(_index, reduced_extents.data(), reduced_strides.data(), _axes);
+};
+
+template <typename INDEX>
+size_t ReduceGeometry::Offset(INDEX _index, const size_t* _extents, const size_t* _strides, size_t _axes) noexcept
+{
+  INDEX offset = 0;
+  for (size_t i=_axes; i-- > 0;)
+  {
+    const INDEX extent = (INDEX)_extents[i];
+    offset += (_index % extent) * (INDEX)_strides[i];
+    _index /= extent;
+  }
+
+  return offset;
+}
+
+// Float partial sums are kept in double
+template <typename T>
+struct Reducer<T>::SumOp
+{
+  using Partial = double;
+
+  bool squares;
+  const T* center;
+
+  Partial Identity() const noexcept {return 0.0;}
+  T Start() const noexcept {return T(0);}
+  Partial Lift(const T _value) const noexcept {return (Partial)_value;}
+  void Combine(Partial& _a, const Partial& _b) const noexcept {_a += _b;}
+  T Finish(const Partial& _partial) const noexcept {return (T)_partial;}
+
+  // _length items _stride apart that belong to output _output
+  Partial Run(const T* _x, size_t _length, size_t _stride, size_t _output) const noexcept
+  {
+    const T shift = center ? center[_output] : T(0);
+
+    if (_stride == 1)
+    {
+      if constexpr (std::is_same<T, float>::value)
+      {
+        const KernelTable& table = KernelRegistry::Get();
+        return squares ? table.reduce_squares(_x, _length, shift) : table.reduce_sum(_x, _length);
+      }
+      else
+      {
+        return squares ? kernels::reference::ReduceSquares(_x, _length, shift) :
+                         kernels::reference::ReduceSum(_x, _length);
+      }
+    }
+
+    Partial sum = 0.0;
+    for (size_t i=0; i<_length; i++)
+    {
+      const Partial value = (Partial)_x[i * _stride] - (Partial)shift;
+      sum += squares ? value * value : value;
+    }
+
+    return sum;
+  }
+
+  // A row of the outputs [_output, _output + _length) is accumulated into _acc
+  void Accumulate(T* _acc, const T* _x, size_t _length, size_t _output) const noexcept
+  {
+    const T* shift = center ? center + _output : nullptr;
+
+    if constexpr (std::is_same<T, float>::value)
+    {
+      const KernelTable& table = KernelRegistry::Get();
+      if (squares)
+        table.squares_add(_x, shift, _acc, _length);
+      else
+        table.add(_acc, _x, _acc, _length);
+    }
+    else
+    {
+      if (squares)
+        kernels::reference::SquaresAdd(_x, shift, _acc, _length);
+      else
+        kernels::reference::Add(_acc, _x, _acc, _length);
+    }
+  }
+};
+
+template <typename T>
+struct Reducer<T>::ExtremumOp
+{
+  using Partial = T;
+
+  bool maximum;
+
+  Partial Identity() const noexcept
+  {
+    if constexpr (std::numeric_limits<T>::has_infinity)
+      return maximum ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+    else
+      return maximum ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+  }
+
+  T Start() const noexcept {return Identity();}
+  Partial Lift(const T _value) const noexcept {return _value;}
+  void Combine(Partial& _a, const Partial& _b) const noexcept {_a = maximum ? std::max(_a, _b) : std::min(_a, _b);}
+  T Finish(const Partial& _partial) const noexcept {return _partial;}
+
+  // Every output reduces the same way, the index of the output isn`t needed
+  Partial Run(const T* _x, size_t _length, size_t _stride, size_t) const noexcept
+  {
+    if (_stride == 1)
+    {
+      if constexpr (std::is_same<T, float>::value)
+      {
+        const KernelTable& table = KernelRegistry::Get();
+        return maximum ? table.reduce_max(_x, _length) : table.reduce_min(_x, _length);
+      }
+      else
+      {
+        return maximum ? kernels::reference::ReduceMax(_x, _length) : kernels::reference::ReduceMin(_x, _length);
+      }
+    }
+
+    Partial result = Identity();
+    for (size_t i=0; i<_length; i++)
+      Combine(result, _x[i * _stride]);
+
+    return result;
+  }
+
+  void Accumulate(T* _acc, const T* _x, size_t _length, size_t) const noexcept
+  {
+    if constexpr (std::is_same<T, float>::value)
+    {
+      const KernelTable& table = KernelRegistry::Get();
+      (maximum ? table.maximum : table.minimum)(_acc, _x, _acc, _length);
+    }
+    else
+    {
+      (maximum ? &kernels::reference::Maximum<T> : &kernels::reference::Minimum<T>)(_acc, _x, _acc, _length);
+    }
+  }
+};
+
+template <typename T>
+void Reducer<T>::Sum(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                     bool _deterministic, bool _squares, const T* _center)
+{
+  Run(_input, _geometry, _output, _deterministic, SumOp{_squares, _center});
+}
+
+template <typename T>
+void Reducer<T>::Extremum(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                          bool _maximum, bool _deterministic)
+{
+  Run(_input, _geometry, _output, _deterministic, ExtremumOp{_maximum});
+}
+
+template <typename T>
+template <typename OP>
+void Reducer<T>::Run(const T* _input, const ReduceGeometry& _geometry, T* _output,
+                     bool _deterministic, const OP& _op)
+{
+  using Partial = typename OP::Partial;
+
+  const ReduceGeometry& geometry = _geometry;
+  const size_t outputs = geometry.outputs;
+  const size_t count = geometry.count;
+
+  if (outputs == 0)
+    return;
+
+  if (count == 0)
+  {
+    std::fill(_output, _output + outputs, _op.Finish(_op.Identity()));
+    return;
+  }
+
+  // Few outputs, the threads split the reduced items and combine partial results
+  const bool split = outputs < MNT_REDUCE_SPLIT_OUTPUTS;
+
+  auto combine = [&](std::vector<Partial> _a, const std::vector<Partial>& _b)
+  {
+    for (size_t i=0; i<_a.size(); i++)
+      _op.Combine(_a[i], _b[i]);
+    return _a;
+  };
+
+  if (geometry.IsRows())
+  {
+    const size_t columns = geometry.kept_extents.back();
+    const size_t groups = outputs / columns;
+    const size_t axes = geometry.reduced_extents.size();
+
+    // Rows [_row_begin, _row_end) of the columns [_col_begin, _col_end) of a group of outputs,
+    // blocks of rows are accumulated in T and then combined into _partials
+    auto rows = [&](size_t _group, size_t _col_begin, size_t _col_end, size_t _row_begin, size_t _row_end,
+                    Partial* _partials)
+    {
+      T acc[MNT_REDUCE_COLUMNS];
+      const size_t first = _group * columns + _col_begin;
+      const size_t length = _col_end - _col_begin;
+      const T* input = _input + geometry.KeptOffset(first);
+
+      for (size_t block = _row_begin; block < _row_end; block += MNT_REDUCE_BLOCK)
+      {
+        std::fill(acc, acc + length, _op.Start());
+
+        for (size_t row = block; row < std::min(block + MNT_REDUCE_BLOCK, _row_end); row++)
+          _op.Accumulate(acc, input + geometry.ReducedOffset(row, axes), length, first);
+
+        for (size_t i=0; i<length; i++)
+          _op.Combine(_partials[i], _op.Lift(acc[i]));
+      }
+    };
+
+    const size_t blocks = (columns + MNT_REDUCE_COLUMNS - 1) / MNT_REDUCE_COLUMNS;
+
+    if (!split)
+    {
+      ParallelFor(0, groups * blocks, [&](size_t _begin, size_t _end)
+      {
+        Partial partials[MNT_REDUCE_COLUMNS];
+
+        for (size_t task = _begin; task < _end; task++)
+        {
+          const size_t group = task / blocks;
+          const size_t col_begin = (task % blocks) * MNT_REDUCE_COLUMNS;
+          const size_t col_end = std::min(col_begin + MNT_REDUCE_COLUMNS, columns);
+
+          std::fill(partials, partials + (col_end - col_begin), _op.Identity());
+          rows(group, col_begin, col_end, 0, count, partials);
+
+          for (size_t i=0; i<col_end-col_begin; i++)
+            _output[group * columns + col_begin + i] = _op.Finish(partials[i]);
+        }
+      }, MNT_REDUCE_COLUMNS * count);
+
+      return;
+    }
+
+    const size_t grain = _deterministic ? std::max((size_t)1, MNT_REDUCE_DETERMINISTIC_GRAIN / outputs) : 0;
+
+    std::vector<Partial> partials = ParallelReduce(0, count, std::vector<Partial>(outputs, _op.Identity()),
+                                                   [&](size_t _begin, size_t _end)
+    {
+      std::vector<Partial> chunk(outputs, _op.Identity());
+      for (size_t group = 0; group < groups; group++)
+        for (size_t col = 0; col < columns; col += MNT_REDUCE_COLUMNS)
+          rows(group, col, std::min(col + MNT_REDUCE_COLUMNS, columns), _begin, _end,
+               chunk.data() + group * columns + col);
+      return chunk;
+    }, combine, outputs, grain);
+
+    for (size_t i=0; i<outputs; i++)
+      _output[i] = _op.Finish(partials[i]);
+
+    return;
+  }
+
+  // Runs along the innermost reduced axis, in segments of up to MNT_REDUCE_SEGMENT items
+  const size_t axes = geometry.reduced_extents.size();
+  const size_t run = axes ? geometry.reduced_extents.back() : 1;
+  const size_t stride = axes ? geometry.reduced_strides.back() : 1;
+  const size_t segments = (run + MNT_REDUCE_SEGMENT - 1) / MNT_REDUCE_SEGMENT;
+  const size_t pieces = count / run * segments;
+
+  auto runs = [&](size_t _index, size_t _piece_begin, size_t _piece_end)
+  {
+    const T* input = _input + geometry.KeptOffset(_index);
+    Partial partial = _op.Identity();
+
+    for (size_t piece = _piece_begin; piece < _piece_end; piece++)
+    {
+      const size_t start = (piece % segments) * MNT_REDUCE_SEGMENT;
+      const T* x = input + (axes ? geometry.ReducedOffset(piece / segments, axes - 1) : 0) + start * stride;
+
+      _op.Combine(partial, _op.Run(x, std::min((size_t)MNT_REDUCE_SEGMENT, run - start), stride, _index));
+    }
+
+    return partial;
+  };
+
+  if (!split)
+  {
+    ParallelFor(0, outputs, [&](size_t _begin, size_t _end)
+    {
+      for (size_t output = _begin; output < _end; output++)
+        _output[output] = _op.Finish(runs(output, 0, pieces));
+    }, count);
+
+    return;
+  }
+
+  const size_t piece_length = std::min(run, (size_t)MNT_REDUCE_SEGMENT);
+  const size_t grain = _deterministic ?
+    std::max((size_t)1, MNT_REDUCE_DETERMINISTIC_GRAIN / (outputs * piece_length)) : 0;
+
+  std::vector<Partial> partials = ParallelReduce(0, pieces, std::vector<Partial>(outputs, _op.Identity()),
+                                                 [&](size_t _begin, size_t _end)
+  {
+    std::vector<Partial> chunk(outputs);
+    for (size_t output = 0; output < outputs; output++)
+      chunk[output] = runs(output, _begin, _end);
+    return chunk;
+  }, combine, outputs * piece_length, grain);
+
+  for (size_t i=0; i<outputs; i++)
+    _output[i] = _op.Finish(partials[i]);
+}
+
+template <typename T>
+void Reducer<T>::ArgMax(const T* _input, const ReduceGeometry& _geometry, TSHAPE_TYPE* _output)
+{
+  const ReduceGeometry& geometry = _geometry;
+
+  if (geometry.reduced_extents.size() > 1)
+    MNT_THROW("ArgMax reduces a single axis");
+
+  if (geometry.outputs == 0)
+    return;
+
+  if (geometry.count == 0)
+    MNT_THROW("ArgMax of an empty axis");
+
+  const size_t length = geometry.count;
+  const size_t stride = geometry.reduced_extents.empty() ? 1 : geometry.reduced_strides[0];
+
+  if (geometry.IsRows())
+  {
+    // The maximum of every column with vectors, then the first row that reaches it, the
+    // comparisons are almost never true, so the branch is predictable
+    const size_t columns = geometry.kept_extents.back();
+    const size_t blocks = (columns + MNT_REDUCE_COLUMNS - 1) / MNT_REDUCE_COLUMNS;
+
+    ParallelFor(0, geometry.outputs / columns * blocks, [&](size_t _begin, size_t _end)
+    {
+      T best[MNT_REDUCE_COLUMNS];
+      TSHAPE_TYPE index[MNT_REDUCE_COLUMNS];
+
+      for (size_t task = _begin; task < _end; task++)
+      {
+        const size_t col_begin = (task % blocks) * MNT_REDUCE_COLUMNS;
+        const size_t cols = std::min((size_t)MNT_REDUCE_COLUMNS, columns - col_begin);
+        const size_t first = task / blocks * columns + col_begin;
+        const T* input = _input + geometry.KeptOffset(first);
+
+        std::copy(input, input + cols, best);
+        for (size_t row = 1; row < length; row++)
+        {
+          if constexpr (std::is_same<T, float>::value)
+            KernelRegistry::Get().maximum(best, input + row * stride, best, cols);
+          else
+            kernels::reference::Maximum(best, input + row * stride, best, cols);
+        }
+
+        const TSHAPE_TYPE none = std::numeric_limits<TSHAPE_TYPE>::max();
+        std::fill(index, index + cols, none);
+
+        size_t found = 0;
+        for (size_t row = 0; row < length && found < cols; row++)
+        {
+          const T* x = input + row * stride;
+          for (size_t i=0; i<cols; i++)
+            if (x[i] == best[i] && index[i] == none)
+            {
+              index[i] = (TSHAPE_TYPE)row;
+              found++;
+            }
+        }
+
+        // Columns of NaN never match
+        std::replace(index, index + cols, none, (TSHAPE_TYPE)0);
+        std::copy(index, index + cols, _output + first);
+      }
+    }, MNT_REDUCE_COLUMNS * length);
+
+    return;
+  }
+
+  ParallelFor(0, geometry.outputs, [&](size_t _begin, size_t _end)
+  {
+    for (size_t output = _begin; output < _end; output++)
+    {
+      const T* x = _input + geometry.KeptOffset(output);
+
+      size_t index = 0;
+      if (stride == 1)
+      {
+        if constexpr (std::is_same<T, float>::value)
+          index = KernelRegistry::Get().reduce_argmax(x, length);
+        else
+          index = kernels::reference::ReduceArgMax(x, length);
+      }
+      else
+      {
+        for (size_t i=1; i<length; i++)
+          if (x[i * stride] > x[index * stride])
+            index = i;
+      }
+
+      _output[output] = (TSHAPE_TYPE)index;
+    }
+  }, length);
+}
+
+#endif
@@ -0,0 +1,382 @@
+// File Name:     reduce_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the reductions on every instruction set
+
+// ---------------------
+// Detail Description:
+// Sum, Mean, Max, Min, Norm, Variance and ArgMax are compared with naive loops in double over
+// the multi-index of every item, which read views of Shapeshift with their strides. The
+// lengths are odd, so the vector kernels always have a tail. Tensors in block storage are
+// checked against the same items in linear storage. The deterministic reductions run once on
+// one thread and once on four, and must give the same bits.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/test_utils.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  enum class Op
+  {
+    Sum = 0,
+    Mean,
+    Max,
+    Min,
+    Norm,
+    Variance
+  };
+
+  const char* OpName(Op _op)
+  {
+    static const char* names[] = {"Sum", "Mean", "Max", "Min", "Norm", "Variance"};
+    return names[(size_t)_op];
+  }
+
+  std::string AxesStr(const std::vector<size_t>& _axes)
+  {
+    std::string str = "{";
+    for (size_t a=0; a<_axes.size(); a++)
+      str += (a ? ", " : "") + std::to_string(_axes[a]);
+    return str + "}";
+  }
+
+  // The items of every output, the outputs are row-major over the kept axes
+  template <typename T>
+  std::vector<std::vector<double>> Groups(const Tensor<T>& _tensor, const std::vector<size_t>& _axes,
+                                          bool _keep_dims, TensorShape& _shape)
+  {
+    const TensorShape& shape = _tensor.Shape();
+    const TensorStrides strides = _tensor.Strides();
+    const size_t rank = shape.size();
+
+    std::vector<bool> reduced(rank, _axes.empty());
+    for (size_t axis : _axes)
+      reduced[axis] = true;
+
+    _shape = TensorShape();
+    size_t outputs = 1;
+    for (size_t d=0; d<rank; d++)
+    {
+      if (!reduced[d])
+        outputs *= shape[d];
+      if (!reduced[d] || _keep_dims)
+        _shape.push_back(reduced[d] ? 1 : shape[d]);
+    }
+    if (_shape.empty())
+      _shape.push_back(1);
+
+    std::vector<std::vector<double>> groups(outputs);
+    std::vector<size_t> index(rank, 0);
+    size_t length = 1;
+    for (size_t d=0; d<rank; d++)
+      length *= shape[d];
+
+    for (size_t i=0; i<length; i++)
+    {
+      size_t offset = 0;
+      size_t output = 0;
+      for (size_t d=0; d<rank; d++)
+      {
+        offset += index[d] * strides[d];
+        if (!reduced[d])
+          output = output * shape[d] + index[d];
+      }
+      groups[output].push_back((double)_tensor.Data()[offset]);
+
+      for (size_t d=rank; d-- > 0;)
+      {
+        if (++index[d] < shape[d])
+          break;
+        index[d] = 0;
+      }
+    }
+
+    return groups;
+  }
+
+  double Naive(const std::vector<double>& _items, Op _op, size_t _correction)
+  {
+    double sum = 0.0;
+    double squares = 0.0;
+    for (double x : _items)
+    {
+      sum += x;
+      squares += x * x;
+    }
+
+    const double mean = sum / (double)_items.size();
+    double distances = 0.0;
+    for (double x : _items)
+      distances += (x - mean) * (x - mean);
+
+    switch (_op)
+    {
+      case Op::Sum:       return sum;
+      case Op::Mean:      return mean;
+      case Op::Max:       return *std::max_element(_items.begin(), _items.end());
+      case Op::Min:       return *std::min_element(_items.begin(), _items.end());
+      case Op::Norm:      return std::sqrt(squares);
+      case Op::Variance:  return distances / (double)(_items.size() - _correction);
+    }
+
+    return 0.0;
+  }
+
+  template <typename T>
+  Tensor<T> Reduce(DefaultBackend<T>& _backend, Tensor<T>& _tensor, Op _op, const ReduceParams& _params)
+  {
+    switch (_op)
+    {
+      case Op::Sum:       return _backend.Sum(_tensor, _params);
+      case Op::Mean:      return _backend.Mean(_tensor, _params);
+      case Op::Max:       return _backend.Max(_tensor, _params);
+      case Op::Min:       return _backend.Min(_tensor, _params);
+      case Op::Norm:      return _backend.Norm(_tensor, _params);
+      case Op::Variance:  return _backend.Variance(_tensor, _params);
+    }
+
+    return _backend.Sum(_tensor, _params);
+  }
+
+  // _reference holds the items of _tensor in linear storage, for the naive loops
+  template <typename T>
+  void CheckOps(Checks& _checks, Tensor<T>& _tensor, const Tensor<T>& _reference, const std::vector<size_t>& _axes,
+                const std::string& _what)
+  {
+    DefaultBackend<T> backend;
+    const double tolerance = std::is_same<T, float>::value ? 1e-4 : 1e-9;
+
+    for (bool keep_dims : {false, true})
+      for (Op op : {Op::Sum, Op::Mean, Op::Max, Op::Min, Op::Norm, Op::Variance})
+      {
+        ReduceParams params;
+        params.axes = _axes;
+        params.keep_dims = keep_dims;
+        params.correction = op == Op::Variance && keep_dims ? 1 : 0;
+
+        const std::string what = _what + " " + OpName(op) + " of axes " + AxesStr(_axes) +
+                                 (keep_dims ? " keeping the axes" : "");
+
+        TensorShape shape;
+        const std::vector<std::vector<double>> groups = Groups(_reference, _axes, keep_dims, shape);
+
+        // A single item has no variance after the correction
+        if (params.correction && groups[0].size() <= params.correction)
+          continue;
+
+        std::vector<double> expected;
+        for (const std::vector<double>& group : groups)
+          expected.push_back(Naive(group, op, params.correction));
+
+        Tensor<T> result = Reduce(backend, _tensor, op, params);
+        _checks.Expect(result.Shape() == shape, what + " has the shape " + result.ShapeStr());
+        if (result.Shape() == shape)
+          _checks.Items(result, expected, tolerance, what);
+      }
+  }
+
+  template <typename T>
+  void CheckOps(Checks& _checks, Tensor<T>& _tensor, const std::vector<size_t>& _axes, const std::string& _what)
+  {
+    CheckOps(_checks, _tensor, _tensor, _axes, _what);
+  }
+
+  template <typename T>
+  void CheckArgMax(Checks& _checks, Tensor<T>& _tensor, const Tensor<T>& _reference, const std::string& _what)
+  {
+    DefaultBackend<T> backend;
+
+    for (size_t axis=0; axis<_tensor.Rank(); axis++)
+    {
+      const std::string what = _what + " ArgMax of axis " + std::to_string(axis);
+
+      TensorShape shape;
+      const std::vector<std::vector<double>> groups = Groups(_reference, {axis}, false, shape);
+
+      std::vector<double> expected;
+      for (const std::vector<double>& group : groups)
+        expected.push_back((double)(std::max_element(group.begin(), group.end()) - group.begin()));
+
+      Tensor<TSHAPE_TYPE> result = backend.ArgMax(_tensor, axis);
+      _checks.Expect(result.Shape() == shape, what + " has the shape " + result.ShapeStr());
+      if (result.Shape() == shape)
+        _checks.Items(result, expected, 0.0, what);
+    }
+  }
+
+  template <typename T>
+  void CheckArgMax(Checks& _checks, Tensor<T>& _tensor, const std::string& _what)
+  {
+    CheckArgMax(_checks, _tensor, _tensor, _what);
+  }
+
+  template <typename T>
+  void CheckShape(Checks& _checks, const char* _type, const TensorShape& _shape,
+                  const std::vector<std::vector<size_t>>& _axes, uint32_t _seed)
+  {
+    Tensor<T> tensor(_shape);
+    Fill(tensor, _seed);
+
+    const std::string what = std::string(_type) + " " + tensor.ShapeStr();
+    for (const std::vector<size_t>& axes : _axes)
+      CheckOps(_checks, tensor, axes, what);
+    CheckArgMax(_checks, tensor, what);
+  }
+
+  // Views of Shapeshift, the reduced axes aren`t the last ones of the stored items
+  template <typename T>
+  void CheckViews(Checks& _checks, const char* _type)
+  {
+    Tensor<T> tensor({5, 6, 19});
+    Fill(tensor, 11);
+
+    Tensor<T> view = tensor.Shapeshift({2, 0, 1});
+    const std::string what = std::string(_type) + " view {2, 0, 1} of " + tensor.ShapeStr();
+    for (const std::vector<size_t>& axes : std::vector<std::vector<size_t>>{{}, {0}, {1}, {2}, {0, 2}, {1, 2}})
+      CheckOps(_checks, view, axes, what);
+    CheckArgMax(_checks, view, what);
+
+    Tensor<T> matrix({37, 129});
+    Fill(matrix, 12);
+
+    Tensor<T> transposed = matrix.Shapeshift({1, 0});
+    const std::string matrix_what = std::string(_type) + " transposed " + matrix.ShapeStr();
+    for (const std::vector<size_t>& axes : std::vector<std::vector<size_t>>{{}, {0}, {1}})
+      CheckOps(_checks, transposed, axes, matrix_what);
+    CheckArgMax(_checks, transposed, matrix_what);
+  }
+
+  // Block storage and views of it are copied to linear storage by the reductions
+  template <typename T>
+  void CheckBlocks(Checks& _checks, const char* _type)
+  {
+    Tensor<T> tensor({5, 6, 19});
+    Fill(tensor, 14);
+
+    Tensor<T> blocks = OnBlocks(tensor);
+    const std::string what = std::string(_type) + " blocks of " + tensor.ShapeStr();
+    for (const std::vector<size_t>& axes : std::vector<std::vector<size_t>>{{}, {0}, {2}, {0, 2}})
+      CheckOps(_checks, blocks, tensor, axes, what);
+    CheckArgMax(_checks, blocks, tensor, what);
+
+    Tensor<T> view = tensor.Shapeshift({2, 0, 1});
+    Tensor<T> blocks_view = blocks.Shapeshift({2, 0, 1});
+    const std::string view_what = std::string(_type) + " view {2, 0, 1} of the blocks of " + tensor.ShapeStr();
+    for (const std::vector<size_t>& axes : std::vector<std::vector<size_t>>{{}, {0}, {1, 2}})
+      CheckOps(_checks, blocks_view, view, axes, view_what);
+    CheckArgMax(_checks, blocks_view, view, view_what);
+  }
+
+  template <typename T>
+  bool SameBits(const Tensor<T>& _tensor_1, const Tensor<T>& _tensor_2)
+  {
+    return _tensor_1.Shape() == _tensor_2.Shape() &&
+           std::memcmp(_tensor_1.Data(), _tensor_2.Data(), _tensor_1.Length() * sizeof(T)) == 0;
+  }
+
+  // Long enough to be split between the threads
+  template <typename T>
+  void CheckDeterministic(Checks& _checks, const char* _type)
+  {
+    DefaultBackend<T> backend;
+
+    Tensor<T> tensor({3, 300001});
+    Fill(tensor, 13);
+    Tensor<T> view = tensor.Shapeshift({1, 0});
+
+    for (const std::vector<size_t>& axes : std::vector<std::vector<size_t>>{{}, {1}})
+      for (Op op : {Op::Sum, Op::Mean, Op::Norm, Op::Variance})
+      {
+        ReduceParams params;
+        params.axes = axes;
+        params.deterministic = true;
+
+        const std::string what = std::string(_type) + " deterministic " + OpName(op) + " of axes " + AxesStr(axes);
+
+        ThreadPool::Init(1, false);
+        Tensor<T> single = Reduce(backend, tensor, op, params);
+        ThreadPool::Init(4, false);
+        Tensor<T> parallel = Reduce(backend, tensor, op, params);
+
+        _checks.Expect(SameBits(single, parallel), what + " depends on the number of threads");
+
+        TensorShape shape;
+        std::vector<double> expected;
+        for (const std::vector<double>& group : Groups(tensor, axes, false, shape))
+          expected.push_back(Naive(group, op, 0));
+        _checks.Items(parallel, expected, std::is_same<T, float>::value ? 1e-3 : 1e-9, what);
+      }
+
+    // The reduced axis of the view is the first one of the stored items
+    ReduceParams params;
+    params.axes = {0};
+    params.deterministic = true;
+
+    ThreadPool::Init(1, false);
+    Tensor<T> single = backend.Sum(view, params);
+    ThreadPool::Init(4, false);
+    Tensor<T> parallel = backend.Sum(view, params);
+
+    _checks.Expect(SameBits(single, parallel), std::string(_type) + " deterministic Sum of a view depends on the "
+                                                                    "number of threads");
+  }
+
+  template <typename T>
+  void CheckFailures(Checks& _checks, const char* _type)
+  {
+    DefaultBackend<T> backend;
+
+    Tensor<T> empty({4, 0});
+    Tensor<T> blocked({1, 8, 3, 3}, Layout::NCHW8c);
+    Tensor<T> matrix({4, 5});
+
+    ReduceParams rows;
+    rows.axes = {1};
+    _checks.Throws([&]() {backend.Max(empty, rows);}, std::string(_type) + " Max of an empty axis");
+    _checks.Throws([&]() {backend.Sum(blocked);}, std::string(_type) + " Sum of a blocked tensor");
+    _checks.Throws([&]() {backend.ArgMax(matrix, 2);}, std::string(_type) + " ArgMax of an axis out of the range");
+  }
+
+  template <typename T>
+  void CheckReductions(Checks& _checks, const char* _type)
+  {
+    CheckShape<T>(_checks, _type, {1}, {{}, {0}}, 1);
+    CheckShape<T>(_checks, _type, {7}, {{}, {0}}, 2);
+    CheckShape<T>(_checks, _type, {33}, {{}}, 3);
+    CheckShape<T>(_checks, _type, {1027}, {{}}, 4);
+    CheckShape<T>(_checks, _type, {3, 5, 17}, {{}, {0}, {1}, {2}, {0, 2}, {1, 2}, {0, 1}}, 5);
+    CheckShape<T>(_checks, _type, {4, 31, 9}, {{0}, {1}, {2}, {0, 2}}, 6);
+    CheckShape<T>(_checks, _type, {2, 3, 4, 5}, {{1, 3}, {0, 2}, {3}}, 7);
+    CheckShape<T>(_checks, _type, {63, 1031}, {{}, {0}, {1}}, 8);
+
+    CheckViews<T>(_checks, _type);
+    CheckBlocks<T>(_checks, _type);
+    CheckDeterministic<T>(_checks, _type);
+    CheckFailures<T>(_checks, _type);
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckReductions<float>(checks, "float");
+    CheckReductions<double>(checks, "double");
+
+    return checks.Failures();
+  });
+}
@@ -0,0 +1,147 @@
+// File Name:     shape.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Small-buffer vectors for the shapes and strides of tensors
+
+// ---------------------
+// Detail Description:
+// A tensor and every view or temporary of it carry a shape, and most operations compute a few
+// more shapes and strides, with std::vector each one of them is a small heap allocation.
+// SmallVector<T, N> keeps up to N items inside the object and only moves them to the heap
+// beyond that, so the metadata of tensors of rank <= MNT_TENSOR_INLINE_RANK never touches
+// the heap. It has the subset of the interface of std::vector the engine uses, with the same
+// names, so the code that builds shapes reads the same with both.
+// ---------------------
+
+// ---------------------
+// Note:
+// Items are copied with memcpy, only trivially copyable types are allowed. Converting to and
+// from std::vector is implicit for the APIs that take one, but it allocates, hot paths should
+// keep TensorShape and TensorStrides
+// ---------------------
+
+// ---------------------
+// Note:
+// Extents and their products are 64 bits, the arithmetic that builds lengths out of extents
+// goes through the checked functions below, so a shape whose length doesn`t fit in size_t
+// throws instead of wrapping around to a small allocation. Loops that divide offsets into
+// indices use 32-bit arithmetic when "FitsIndex32" says the tensor is small enough, a 32-bit
+// division is several times cheaper than a 64-bit one on most x86 cores
+// ---------------------
+
+// =====
+// [CheckedAdd/CheckedMul(_a, _b)]: _a + _b and _a * _b, throw if the result doesn`t fit in size_t
+// =====
+
+// =====
+// [ShapeLength(_shape)]: Number of items of a tensor of _shape, throws on overflow
+// =====
+
+// =====
+// [FitsIndex32(_length)]: True if every index and offset below _length fits in uint32_t
+// =====
+
+#ifndef ENGINE_MATH_SHAPE_HPP
+#define ENGINE_MATH_SHAPE_HPP
+
+#include "configs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <initializer_list>
+#include <type_traits>
+
+namespace mnt {
+
+  template <typename T, size_t N>
+  class SmallVector
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector copies its items with memcpy");
+
+  public:
+    SmallVector() noexcept = default;
+    explicit SmallVector(size_t _size, const T& _value = T());
+    SmallVector(std::initializer_list<T> _items);
+    SmallVector(const std::vector<T>& _items);
+
+    template <typename ITERATOR, typename = std::enable_if_t<!std::is_integral<ITERATOR>::value>>
+    SmallVector(ITERATOR _begin, ITERATOR _end);
+
+    SmallVector(const SmallVector& _other);
+    SmallVector(SmallVector&& _other) noexcept;
+    SmallVector& operator = (const SmallVector& _other);
+    SmallVector& operator = (SmallVector&& _other) noexcept;
+
+    operator std::vector<T> () const;
+
+    T& operator [] (const size_t _index) noexcept {return Items()[_index];};
+    const T& operator [] (const size_t _index) const noexcept {return Items()[_index];};
+
+    T* data() noexcept {return Items();};
+    const T* data() const noexcept {return Items();};
+
+    T* begin() noexcept {return Items();};
+    T* end() noexcept {return Items() + m_size;};
+    const T* begin() const noexcept {return Items();};
+    const T* end() const noexcept {return Items() + m_size;};
+
+    T& front() noexcept {return Items()[0];};
+    T& back() noexcept {return Items()[m_size - 1];};
+    const T& front() const noexcept {return Items()[0];};
+    const T& back() const noexcept {return Items()[m_size - 1];};
+
+    size_t size() const noexcept {return m_size;};
+    bool empty() const noexcept {return m_size == 0;};
+
+    void push_back(const T& _value);
+    void pop_back() noexcept {m_size--;};
+    void resize(size_t _size, const T& _value = T());
+    void clear() noexcept {m_size = 0;};
+
+    friend bool operator == (const SmallVector& _a, const SmallVector& _b) noexcept
+    {
+      if (_a.m_size != _b.m_size)
+        return false;
+      for (size_t i=0; i<_a.m_size; i++)
+        if (!(_a[i] == _b[i]))
+          return false;
+      return true;
+    };
+
+    friend bool operator != (const SmallVector& _a, const SmallVector& _b) noexcept
+    {
+      return !(_a == _b);
+    };
+
+  private:
+    T* Items() noexcept {return m_heap ? m_heap.get() : m_inline;};
+    const T* Items() const noexcept {return m_heap ? m_heap.get() : m_inline;};
+
+    // Makes room for _capacity items, keeps the current ones
+    void Reserve(size_t _capacity);
+
+  private:
+    T m_inline[N];
+    std::unique_ptr<T[]> m_heap;
+    size_t m_size = 0;
+    size_t m_capacity = N;
+  };
+
+  using TensorShape = SmallVector<TSHAPE_TYPE, MNT_TENSOR_INLINE_RANK>;
+  using TensorStrides = SmallVector<size_t, MNT_TENSOR_INLINE_RANK>;
+
+  static_assert(std::is_unsigned<TSHAPE_TYPE>::value && sizeof(TSHAPE_TYPE) >= sizeof(uint32_t) &&
+                sizeof(TSHAPE_TYPE) <= sizeof(size_t), "TSHAPE_TYPE must be an unsigned type of 32 to 64 bits");
+
+  size_t CheckedAdd(size_t _a, size_t _b);
+  size_t CheckedMul(size_t _a, size_t _b);
+  size_t ShapeLength(const TensorShape& _shape);
+
+  constexpr bool FitsIndex32(size_t _length) noexcept {return _length <= (size_t)UINT32_MAX;};
+}
+
+#include "math/shape.inl"
+
+#endif
@@ -0,0 +1,165 @@
+// File Name:     shape.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Small-buffer vectors for the shapes and strides of tensors
+
+#ifndef ENGINE_MATH_SHAPE_INL
+#define ENGINE_MATH_SHAPE_INL
+
+#include "math/shape.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mnt;
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(size_t _size, const T& _value)
+{
+  resize(_size, _value);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(std::initializer_list<T> _items) : SmallVector(_items.begin(), _items.end())
+{
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const std::vector<T>& _items) : SmallVector(_items.begin(), _items.end())
+{
+}
+
+template <typename T, size_t N>
+template <typename ITERATOR, typename>
+SmallVector<T, N>::SmallVector(ITERATOR _begin, ITERATOR _end)
+{
+  Reserve((size_t)std::distance(_begin, _end));
+  for (; _begin != _end; ++_begin)
+    Items()[m_size++] = (T)*_begin;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(const SmallVector& _other)
+{
+  *this = _other;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& _other) noexcept
+{
+  *this = std::move(_other);
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator = (const SmallVector& _other)
+{
+  if (this == &_other)
+    return *this;
+
+  m_size = 0;
+  Reserve(_other.m_size);
+  if (_other.m_size)
+    std::memcpy(Items(), _other.Items(), _other.m_size * sizeof(T));
+  m_size = _other.m_size;
+
+  return *this;
+}
+
+// The heap buffer changes hands, inline items are copied
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator = (SmallVector&& _other) noexcept
+{
+  if (this == &_other)
+    return *this;
+
+  if (_other.m_heap)
+  {
+    m_heap = std::move(_other.m_heap);
+    m_capacity = _other.m_capacity;
+  }
+  else
+  {
+    m_heap.reset();
+    m_capacity = N;
+    if (_other.m_size)
+      std::memcpy(m_inline, _other.m_inline, _other.m_size * sizeof(T));
+  }
+
+  m_size = _other.m_size;
+  _other.m_size = 0;
+  _other.m_capacity = N;
+
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::operator std::vector<T> () const
+{
+  return std::vector<T>(begin(), end());
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::push_back(const T& _value)
+{
+  // _value may be an item of this vector
+  const T value = _value;
+
+  if (m_size == m_capacity)
+    Reserve(2 * m_capacity);
+
+  Items()[m_size++] = value;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::resize(size_t _size, const T& _value)
+{
+  const T value = _value;
+
+  Reserve(_size);
+  for (size_t i=m_size; i<_size; i++)
+    Items()[i] = value;
+  m_size = _size;
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Reserve(size_t _capacity)
+{
+  if (_capacity <= m_capacity)
+    return;
+
+  std::unique_ptr<T[]> heap(new T[_capacity]);
+  if (m_size)
+    std::memcpy(heap.get(), Items(), m_size * sizeof(T));
+
+  m_heap = std::move(heap);
+  m_capacity = _capacity;
+}
+
+inline size_t mnt::CheckedAdd(size_t _a, size_t _b)
+{
+  if (_a > SIZE_MAX - _b)
+    MNT_THROW("Shape arithmetic overflows size_t");
+
+  return _a + _b;
+};
+
+inline size_t mnt::CheckedMul(size_t _a, size_t _b)
+{
+  if (_a != 0 && _b > SIZE_MAX / _a)
+    MNT_THROW("Shape arithmetic overflows size_t");
+
+  return _a * _b;
+};
+
+inline size_t mnt::ShapeLength(const TensorShape& _shape)
+{
+  size_t length = 1;
+  for (size_t extent : _shape)
+    length = CheckedMul(length, extent);
+
+  return length;
+};
+
+#endif
@@ -0,0 +1,232 @@
+// File Name:     avx2.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   AVX2 + FMA implementation of the SIMD abstraction, 8 float lanes
+
+#ifndef ENGINE_MATH_SIMD_AVX2_HPP
+#define ENGINE_MATH_SIMD_AVX2_HPP
+
+MNT_TARGET_AVX2_BEGIN
+
+namespace mnt { namespace simd { namespace avx2 {
+
+  constexpr ISA simd_isa = ISA::AVX2;
+
+  struct VecF32
+  {
+    static constexpr size_t width = 8;
+    __m256 v;
+  };
+
+  // Lane i is enabled if i < _count
+  inline __m256i TailMask(const size_t _count) noexcept
+  {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)_count),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  }
+
+  inline VecF32 Zero() noexcept {return {_mm256_setzero_ps()};}
+  inline VecF32 Set(const float _value) noexcept {return {_mm256_set1_ps(_value)};}
+
+  inline VecF32 Load(const float* _src) noexcept {return {_mm256_loadu_ps(_src)};}
+  inline void Store(float* _dst, const VecF32 _a) noexcept {_mm256_storeu_ps(_dst, _a.v);}
+
+  inline VecF32 LoadPartial(const float* _src, const size_t _count) noexcept
+  {return {_mm256_maskload_ps(_src, TailMask(_count))};}
+  inline void StorePartial(float* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm256_maskstore_ps(_dst, TailMask(_count), _a.v);}
+
+  inline VecF32 Add(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_add_ps(_a.v, _b.v)};}
+  inline VecF32 Sub(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_sub_ps(_a.v, _b.v)};}
+  inline VecF32 Mul(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_mul_ps(_a.v, _b.v)};}
+  inline VecF32 Div(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_div_ps(_a.v, _b.v)};}
+
+  inline VecF32 Fma(const VecF32 _a, const VecF32 _b, const VecF32 _c) noexcept
+  {return {_mm256_fmadd_ps(_a.v, _b.v, _c.v)};}
+
+  inline VecF32 Max(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_max_ps(_a.v, _b.v)};}
+  inline VecF32 Min(const VecF32 _a, const VecF32 _b) noexcept {return {_mm256_min_ps(_a.v, _b.v)};}
+  inline VecF32 Abs(const VecF32 _a) noexcept
+  {return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), _a.v)};}
+  inline VecF32 Sqrt(const VecF32 _a) noexcept {return {_mm256_sqrt_ps(_a.v)};}
+
+  inline VecF32 Round(const VecF32 _a) noexcept
+  {return {_mm256_round_ps(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};}
+
+  // The exponent is split in two halves, each one is a normal float
+  inline VecF32 Ldexp(const VecF32 _a, const VecF32 _n) noexcept
+  {
+    const __m256i n = _mm256_cvtps_epi32(_n.v);
+    const __m256i half = _mm256_srai_epi32(n, 1);
+    const __m256i bias = _mm256_set1_epi32(127);
+    const __m256 scale_1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, bias), 23));
+    const __m256 scale_2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(n, half), bias), 23));
+    return {_mm256_mul_ps(_mm256_mul_ps(_a.v, scale_1), scale_2)};
+  }
+
+  inline VecF32 SelectLess(const VecF32 _a, const VecF32 _b, const VecF32 _x, const VecF32 _y) noexcept
+  {return {_mm256_blendv_ps(_y.v, _x.v, _mm256_cmp_ps(_a.v, _b.v, _CMP_LT_OQ))};}
+
+  inline uint32_t NonZeroBits(const VecF32 _a) noexcept
+  {return (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(_a.v, _mm256_setzero_ps(), _CMP_NEQ_UQ));}
+
+  inline VecF32 SelectBits(const uint32_t _bits, const VecF32 _x, const VecF32 _y) noexcept
+  {
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)_bits), lanes), lanes);
+    return {_mm256_blendv_ps(_y.v, _x.v, _mm256_castsi256_ps(mask))};
+  }
+
+  inline VecF32 Exponent(const VecF32 _a) noexcept
+  {
+    const __m256i biased = _mm256_srli_epi32(_mm256_castps_si256(_a.v), 23);
+    return {_mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(127)))};
+  }
+
+  inline VecF32 Mantissa(const VecF32 _a) noexcept
+  {
+    const __m256 fraction = _mm256_and_ps(_a.v, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF)));
+    return {_mm256_or_ps(fraction, _mm256_set1_ps(1.0f))};
+  }
+
+  // Reduced precision items, Half with F16C
+  inline VecF32 Load(const Half* _src) noexcept
+  {return {_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)_src))};}
+  inline void Store(Half* _dst, const VecF32 _a) noexcept
+  {_mm_storeu_si128((__m128i*)_dst, _mm256_cvtps_ph(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));}
+
+  inline VecF32 Load(const BFloat16* _src) noexcept
+  {
+    const __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)_src));
+    return {_mm256_castsi256_ps(_mm256_slli_epi32(h, 16))};
+  }
+
+  // The same as "FloatToBFloat16" in "math/half.inl"
+  inline void Store(BFloat16* _dst, const VecF32 _a) noexcept
+  {
+    const __m256i bits = _mm256_castps_si256(_a.v);
+    const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+    const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7FFF)), odd), 16);
+    const __m256i quiet = _mm256_or_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(0x40));
+    const __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(_a.v, _a.v, _CMP_UNORD_Q));
+    const __m256i result = _mm256_blendv_epi8(rounded, quiet, nan);
+
+    // Packing works within 128-bit lanes, the two halves are then brought together
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+    _mm_storeu_si128((__m128i*)_dst, _mm256_castsi256_si128(packed));
+  }
+
+  // 8-bit integer items, stored rounded to nearest even and saturated, NaN stores the lowest value
+  inline VecF32 Load(const int8_t* _src) noexcept
+  {return {_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)_src)))};}
+  inline VecF32 Load(const uint8_t* _src) noexcept
+  {return {_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)_src)))};}
+
+  inline void Store(int8_t* _dst, const VecF32 _a) noexcept
+  {
+    const __m256i items = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_a.v, _mm256_set1_ps(-128.0f)), _mm256_set1_ps(127.0f)));
+    const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(items), _mm256_extracti128_si256(items, 1));
+    _mm_storel_epi64((__m128i*)_dst, _mm_packs_epi16(words, words));
+  }
+
+  inline void Store(uint8_t* _dst, const VecF32 _a) noexcept
+  {
+    const __m256i items = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_a.v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f)));
+    const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(items), _mm256_extracti128_si256(items, 1));
+    _mm_storel_epi64((__m128i*)_dst, _mm_packus_epi16(words, words));
+  }
+
+  // 16-bit and 8-bit items have no masked load/store, partial lanes go through a small stack buffer
+  template <typename T>
+  inline VecF32 LoadPartial(const T* _src, const size_t _count) noexcept
+  {
+    T buffer[8] = {};
+    for (size_t i=0; i<_count && i<8; i++)
+      buffer[i] = _src[i];
+    return Load(buffer);
+  }
+
+  template <typename T>
+  inline void StorePartial(T* _dst, const VecF32 _a, const size_t _count) noexcept
+  {
+    T buffer[8];
+    Store(buffer, _a);
+    for (size_t i=0; i<_count && i<8; i++)
+      _dst[i] = buffer[i];
+  }
+
+  // Integer lanes for the int8 GEMM, see "math/kernels/qgemm.inl"
+  struct VecI32
+  {
+    static constexpr size_t width = 8;
+    __m256i v;
+  };
+
+  // VPMADDUBSW saturates the sums of pairs of products to int16, see "sse4.hpp"
+  constexpr int32_t dot_weight_max = 63;
+
+  inline VecI32 ZeroI32() noexcept {return {_mm256_setzero_si256()};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm256_set1_epi32(bytes)};
+  }
+
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {
+    const __m256i pairs = _mm256_maddubs_epi16(_a.v, _mm256_loadu_si256((const __m256i*)_b));
+    return {_mm256_add_epi32(_acc.v, _mm256_madd_epi16(pairs, _mm256_set1_epi16(1)))};
+  }
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm256_add_epi32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {_mm256_cvtepi32_ps(_a.v)};}
+
+  inline VecI32 SetI32(const uint32_t _value) noexcept {return {_mm256_set1_epi32((int)_value)};}
+  inline VecI32 LoadI32(const uint32_t* _src) noexcept {return {_mm256_loadu_si256((const __m256i*)_src)};}
+  inline void StoreI32(uint32_t* _dst, const VecI32 _a) noexcept {_mm256_storeu_si256((__m256i*)_dst, _a.v);}
+  inline VecI32 XorI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm256_xor_si256(_a.v, _b.v)};}
+
+  inline void MulWideU32(const VecI32 _a, const VecI32 _b, VecI32& _high, VecI32& _low) noexcept
+  {
+    const __m256i even = _mm256_mul_epu32(_a.v, _b.v);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(_a.v, 32), _mm256_srli_epi64(_b.v, 32));
+    _high = {_mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA)};
+    _low = {_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA)};
+  }
+
+  inline VecF32 UnitFloat(const VecI32 _a) noexcept
+  {return {_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(_a.v, 8)), _mm256_set1_ps(1.0f / 16777216.0f))};}
+
+  inline float ReduceAdd(const VecF32 _a) noexcept
+  {
+    __m128 sums = _mm_add_ps(_mm256_castps256_ps128(_a.v), _mm256_extractf128_ps(_a.v, 1));
+    __m128 shuffled = _mm_movehdup_ps(sums);
+    sums = _mm_add_ps(sums, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+    return _mm_cvtss_f32(sums);
+  }
+
+  inline float ReduceMax(const VecF32 _a) noexcept
+  {
+    __m128 max = _mm_max_ps(_mm256_castps256_ps128(_a.v), _mm256_extractf128_ps(_a.v, 1));
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    max = _mm_max_ss(max, _mm_movehdup_ps(max));
+    return _mm_cvtss_f32(max);
+  }
+
+  inline float ReduceMin(const VecF32 _a) noexcept
+  {
+    __m128 min = _mm_min_ps(_mm256_castps256_ps128(_a.v), _mm256_extractf128_ps(_a.v, 1));
+    min = _mm_min_ps(min, _mm_movehl_ps(min, min));
+    min = _mm_min_ss(min, _mm_movehdup_ps(min));
+    return _mm_cvtss_f32(min);
+  }
+
+}}}
+
+MNT_TARGET_END
+
+#endif
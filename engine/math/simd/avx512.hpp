@@ -0,0 +1,176 @@
+// File Name:     avx512.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   AVX-512 (F, BW, DQ, VL) implementation of the SIMD abstraction, 16 float lanes
+
+#ifndef ENGINE_MATH_SIMD_AVX512_HPP
+#define ENGINE_MATH_SIMD_AVX512_HPP
+
+MNT_TARGET_AVX512_BEGIN
+
+namespace mnt { namespace simd { namespace avx512 {
+
+  constexpr ISA simd_isa = ISA::AVX512;
+
+  struct VecF32
+  {
+    static constexpr size_t width = 16;
+    __m512 v;
+  };
+
+  // Lane i is enabled if i < _count
+  inline __mmask16 TailMask(const size_t _count) noexcept
+  {
+    return _count >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << _count) - 1);
+  }
+
+  inline VecF32 Zero() noexcept {return {_mm512_setzero_ps()};}
+  inline VecF32 Set(const float _value) noexcept {return {_mm512_set1_ps(_value)};}
+
+  inline VecF32 Load(const float* _src) noexcept {return {_mm512_loadu_ps(_src)};}
+  inline void Store(float* _dst, const VecF32 _a) noexcept {_mm512_storeu_ps(_dst, _a.v);}
+
+  inline VecF32 LoadPartial(const float* _src, const size_t _count) noexcept
+  {return {_mm512_maskz_loadu_ps(TailMask(_count), _src)};}
+  inline void StorePartial(float* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm512_mask_storeu_ps(_dst, TailMask(_count), _a.v);}
+
+  inline VecF32 Add(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_add_ps(_a.v, _b.v)};}
+  inline VecF32 Sub(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_sub_ps(_a.v, _b.v)};}
+  inline VecF32 Mul(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_mul_ps(_a.v, _b.v)};}
+  inline VecF32 Div(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_div_ps(_a.v, _b.v)};}
+
+  inline VecF32 Fma(const VecF32 _a, const VecF32 _b, const VecF32 _c) noexcept
+  {return {_mm512_fmadd_ps(_a.v, _b.v, _c.v)};}
+
+  inline VecF32 Max(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_max_ps(_a.v, _b.v)};}
+  inline VecF32 Min(const VecF32 _a, const VecF32 _b) noexcept {return {_mm512_min_ps(_a.v, _b.v)};}
+  inline VecF32 Abs(const VecF32 _a) noexcept {return {_mm512_abs_ps(_a.v)};}
+  inline VecF32 Sqrt(const VecF32 _a) noexcept {return {_mm512_sqrt_ps(_a.v)};}
+
+  inline VecF32 Round(const VecF32 _a) noexcept
+  {return {_mm512_roundscale_ps(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};}
+  inline VecF32 Ldexp(const VecF32 _a, const VecF32 _n) noexcept {return {_mm512_scalef_ps(_a.v, _n.v)};}
+
+  inline VecF32 SelectLess(const VecF32 _a, const VecF32 _b, const VecF32 _x, const VecF32 _y) noexcept
+  {return {_mm512_mask_blend_ps(_mm512_cmp_ps_mask(_a.v, _b.v, _CMP_LT_OQ), _y.v, _x.v)};}
+
+  // The bits are the mask registers themselves
+  inline uint32_t NonZeroBits(const VecF32 _a) noexcept
+  {return _mm512_cmp_ps_mask(_a.v, _mm512_setzero_ps(), _CMP_NEQ_UQ);}
+
+  inline VecF32 SelectBits(const uint32_t _bits, const VecF32 _x, const VecF32 _y) noexcept
+  {return {_mm512_mask_blend_ps((__mmask16)_bits, _y.v, _x.v)};}
+
+  inline VecF32 Exponent(const VecF32 _a) noexcept {return {_mm512_getexp_ps(_a.v)};}
+  inline VecF32 Mantissa(const VecF32 _a) noexcept
+  {return {_mm512_getmant_ps(_a.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero)};}
+
+  // Reduced precision items, Half with F16C
+  inline VecF32 Load(const Half* _src) noexcept
+  {return {_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)_src))};}
+  inline VecF32 LoadPartial(const Half* _src, const size_t _count) noexcept
+  {return {_mm512_cvtph_ps(_mm256_maskz_loadu_epi16(TailMask(_count), _src))};}
+
+  inline void Store(Half* _dst, const VecF32 _a) noexcept
+  {_mm256_storeu_si256((__m256i*)_dst, _mm512_cvtps_ph(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));}
+  inline void StorePartial(Half* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm256_mask_storeu_epi16(_dst, TailMask(_count), _mm512_cvtps_ph(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));}
+
+  inline VecF32 Load(const BFloat16* _src) noexcept
+  {return {_mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)_src)), 16))};}
+  inline VecF32 LoadPartial(const BFloat16* _src, const size_t _count) noexcept
+  {return {_mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(TailMask(_count), _src)), 16))};}
+
+  // The same as "FloatToBFloat16" in "math/half.inl", AVX512-BF16 is not part of this level,
+  // see "math/kernels/extensions.hpp"
+  inline __m512i RoundBFloat16(const VecF32 _a) noexcept
+  {
+    const __m512i bits = _mm512_castps_si512(_a.v);
+    const __m512i odd = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+    const __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(bits, _mm512_set1_epi32(0x7FFF)), odd), 16);
+    const __m512i quiet = _mm512_or_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(0x40));
+    return _mm512_mask_blend_epi32(_mm512_cmp_ps_mask(_a.v, _a.v, _CMP_UNORD_Q), rounded, quiet);
+  }
+
+  inline void Store(BFloat16* _dst, const VecF32 _a) noexcept
+  {_mm256_storeu_si256((__m256i*)_dst, _mm512_cvtepi32_epi16(RoundBFloat16(_a)));}
+  inline void StorePartial(BFloat16* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm512_mask_cvtepi32_storeu_epi16(_dst, TailMask(_count), RoundBFloat16(_a));}
+
+  // 8-bit integer items, stored rounded to nearest even and saturated, NaN stores the lowest value
+  inline VecF32 Load(const int8_t* _src) noexcept
+  {return {_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)_src)))};}
+  inline VecF32 LoadPartial(const int8_t* _src, const size_t _count) noexcept
+  {return {_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_maskz_loadu_epi8(TailMask(_count), _src)))};}
+  inline VecF32 Load(const uint8_t* _src) noexcept
+  {return {_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)_src)))};}
+  inline VecF32 LoadPartial(const uint8_t* _src, const size_t _count) noexcept
+  {return {_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(TailMask(_count), _src)))};}
+
+  inline __m512i RoundInt8(const VecF32 _a, const float _min, const float _max) noexcept
+  {return _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(_a.v, _mm512_set1_ps(_min)), _mm512_set1_ps(_max)));}
+
+  inline void Store(int8_t* _dst, const VecF32 _a) noexcept
+  {_mm_storeu_si128((__m128i*)_dst, _mm512_cvtepi32_epi8(RoundInt8(_a, -128.0f, 127.0f)));}
+  inline void StorePartial(int8_t* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm512_mask_cvtepi32_storeu_epi8(_dst, TailMask(_count), RoundInt8(_a, -128.0f, 127.0f));}
+  inline void Store(uint8_t* _dst, const VecF32 _a) noexcept
+  {_mm_storeu_si128((__m128i*)_dst, _mm512_cvtepi32_epi8(RoundInt8(_a, 0.0f, 255.0f)));}
+  inline void StorePartial(uint8_t* _dst, const VecF32 _a, const size_t _count) noexcept
+  {_mm512_mask_cvtepi32_storeu_epi8(_dst, TailMask(_count), RoundInt8(_a, 0.0f, 255.0f));}
+
+  // Integer lanes for the int8 GEMM, see "math/kernels/qgemm.inl"
+  struct VecI32
+  {
+    static constexpr size_t width = 16;
+    __m512i v;
+  };
+
+  // VPMADDUBSW saturates the sums of pairs of products to int16, see "sse4.hpp",
+  // AVX512-VNNI is not part of this level, see "math/kernels/extensions.hpp"
+  constexpr int32_t dot_weight_max = 63;
+
+  inline VecI32 ZeroI32() noexcept {return {_mm512_setzero_si512()};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm512_set1_epi32(bytes)};
+  }
+
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {
+    const __m512i pairs = _mm512_maddubs_epi16(_a.v, _mm512_loadu_si512(_b));
+    return {_mm512_add_epi32(_acc.v, _mm512_madd_epi16(pairs, _mm512_set1_epi16(1)))};
+  }
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm512_add_epi32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {_mm512_cvtepi32_ps(_a.v)};}
+
+  inline VecI32 SetI32(const uint32_t _value) noexcept {return {_mm512_set1_epi32((int)_value)};}
+  inline VecI32 LoadI32(const uint32_t* _src) noexcept {return {_mm512_loadu_si512(_src)};}
+  inline void StoreI32(uint32_t* _dst, const VecI32 _a) noexcept {_mm512_storeu_si512(_dst, _a.v);}
+  inline VecI32 XorI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm512_xor_si512(_a.v, _b.v)};}
+
+  inline void MulWideU32(const VecI32 _a, const VecI32 _b, VecI32& _high, VecI32& _low) noexcept
+  {
+    const __m512i even = _mm512_mul_epu32(_a.v, _b.v);
+    const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(_a.v, 32), _mm512_srli_epi64(_b.v, 32));
+    _high = {_mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd)};
+    _low = {_mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32))};
+  }
+
+  inline VecF32 UnitFloat(const VecI32 _a) noexcept
+  {return {_mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(_a.v, 8)), _mm512_set1_ps(1.0f / 16777216.0f))};}
+
+  inline float ReduceAdd(const VecF32 _a) noexcept {return _mm512_reduce_add_ps(_a.v);}
+  inline float ReduceMax(const VecF32 _a) noexcept {return _mm512_reduce_max_ps(_a.v);}
+  inline float ReduceMin(const VecF32 _a) noexcept {return _mm512_reduce_min_ps(_a.v);}
+
+}}}
+
+MNT_TARGET_END
+
+#endif
@@ -0,0 +1,186 @@
+// File Name:     generic.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Scalar implementation of the SIMD abstraction
+
+// ---------------------
+// Detail Description:
+// A "vector" of one lane, it is the reference for the other instruction sets and
+// the fallback on machines without any supported SIMD extension
+// ---------------------
+
+#ifndef ENGINE_MATH_SIMD_GENERIC_HPP
+#define ENGINE_MATH_SIMD_GENERIC_HPP
+
+namespace mnt { namespace simd { namespace generic {
+
+  constexpr ISA simd_isa = ISA::Generic;
+
+  struct VecF32
+  {
+    static constexpr size_t width = 1;
+    float v;
+  };
+
+  inline VecF32 Zero() noexcept {return {0.0f};}
+  inline VecF32 Set(const float _value) noexcept {return {_value};}
+
+  inline VecF32 Load(const float* _src) noexcept {return {*_src};}
+  inline void Store(float* _dst, const VecF32 _a) noexcept {*_dst = _a.v;}
+
+  // Loads/Stores the first _count lanes, the rest of the lanes are zero
+  inline VecF32 LoadPartial(const float* _src, const size_t _count) noexcept
+  {return {_count ? *_src : 0.0f};}
+  inline void StorePartial(float* _dst, const VecF32 _a, const size_t _count) noexcept
+  {if (_count) *_dst = _a.v;}
+
+  inline VecF32 Add(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v + _b.v};}
+  inline VecF32 Sub(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v - _b.v};}
+  inline VecF32 Mul(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v * _b.v};}
+  inline VecF32 Div(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v / _b.v};}
+
+  // _a * _b + _c
+  inline VecF32 Fma(const VecF32 _a, const VecF32 _b, const VecF32 _c) noexcept
+  {return {_a.v * _b.v + _c.v};}
+
+  inline VecF32 Max(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v > _b.v ? _a.v : _b.v};}
+  inline VecF32 Min(const VecF32 _a, const VecF32 _b) noexcept {return {_a.v < _b.v ? _a.v : _b.v};}
+  inline VecF32 Abs(const VecF32 _a) noexcept {return {std::fabs(_a.v)};}
+  inline VecF32 Sqrt(const VecF32 _a) noexcept {return {std::sqrt(_a.v)};}
+
+  // Nearest integer, ties to even, |_a| < 2^22, adding 1.5 * 2^23 drops the fraction
+  inline VecF32 Round(const VecF32 _a) noexcept {return {(_a.v + 12582912.0f) - 12582912.0f};}
+
+  // _a * 2^_n, _n holds integers in [-252, 254], the exponent is split in two halves,
+  // each one is a normal float
+  inline VecF32 Ldexp(const VecF32 _a, const VecF32 _n) noexcept
+  {
+    const int32_t n = (int32_t)_n.v;
+    const int32_t half = n >> 1;
+    const uint32_t bits_1 = (uint32_t)(half + 127) << 23;
+    const uint32_t bits_2 = (uint32_t)(n - half + 127) << 23;
+
+    float scale_1, scale_2;
+    std::memcpy(&scale_1, &bits_1, sizeof(float));
+    std::memcpy(&scale_2, &bits_2, sizeof(float));
+    return {_a.v * scale_1 * scale_2};
+  }
+
+  // _a < _b ? _x : _y, per lane
+  inline VecF32 SelectLess(const VecF32 _a, const VecF32 _b, const VecF32 _x, const VecF32 _y) noexcept
+  {return {_a.v < _b.v ? _x.v : _y.v};}
+
+  // Bit i is set if lane i is not zero, NaN included
+  inline uint32_t NonZeroBits(const VecF32 _a) noexcept {return _a.v != 0.0f;}
+
+  // Bit i of _bits ? _x : _y, per lane
+  inline VecF32 SelectBits(const uint32_t _bits, const VecF32 _x, const VecF32 _y) noexcept
+  {return {(_bits & 1) ? _x.v : _y.v};}
+
+  // _a = Mantissa(_a) * 2^Exponent(_a) with the mantissa in [1, 2), positive normal floats only
+  inline VecF32 Exponent(const VecF32 _a) noexcept
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &_a.v, sizeof(float));
+    return {(float)((int32_t)(bits >> 23) - 127)};
+  }
+
+  inline VecF32 Mantissa(const VecF32 _a) noexcept
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &_a.v, sizeof(float));
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+
+    float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(float));
+    return {mantissa};
+  }
+
+  // Reduced precision items, converted to and from float lanes
+  inline VecF32 Load(const Half* _src) noexcept {return {(float)*_src};}
+  inline void Store(Half* _dst, const VecF32 _a) noexcept {*_dst = Half(_a.v);}
+  inline VecF32 LoadPartial(const Half* _src, const size_t _count) noexcept
+  {return {_count ? (float)*_src : 0.0f};}
+  inline void StorePartial(Half* _dst, const VecF32 _a, const size_t _count) noexcept
+  {if (_count) *_dst = Half(_a.v);}
+
+  inline VecF32 Load(const BFloat16* _src) noexcept {return {(float)*_src};}
+  inline void Store(BFloat16* _dst, const VecF32 _a) noexcept {*_dst = BFloat16(_a.v);}
+  inline VecF32 LoadPartial(const BFloat16* _src, const size_t _count) noexcept
+  {return {_count ? (float)*_src : 0.0f};}
+  inline void StorePartial(BFloat16* _dst, const VecF32 _a, const size_t _count) noexcept
+  {if (_count) *_dst = BFloat16(_a.v);}
+
+  // 8-bit integer items, stored rounded to nearest even and saturated, NaN stores the lowest value
+  inline VecF32 Load(const int8_t* _src) noexcept {return {(float)*_src};}
+  inline void Store(int8_t* _dst, const VecF32 _a) noexcept
+  {*_dst = (int8_t)std::nearbyint(std::min(std::max(-128.0f, _a.v), 127.0f));}
+  inline VecF32 LoadPartial(const int8_t* _src, const size_t _count) noexcept
+  {return {_count ? (float)*_src : 0.0f};}
+  inline void StorePartial(int8_t* _dst, const VecF32 _a, const size_t _count) noexcept
+  {if (_count) Store(_dst, _a);}
+
+  inline VecF32 Load(const uint8_t* _src) noexcept {return {(float)*_src};}
+  inline void Store(uint8_t* _dst, const VecF32 _a) noexcept
+  {*_dst = (uint8_t)std::nearbyint(std::min(std::max(0.0f, _a.v), 255.0f));}
+  inline VecF32 LoadPartial(const uint8_t* _src, const size_t _count) noexcept
+  {return {_count ? (float)*_src : 0.0f};}
+  inline void StorePartial(uint8_t* _dst, const VecF32 _a, const size_t _count) noexcept
+  {if (_count) Store(_dst, _a);}
+
+  // Integer lanes for the int8 GEMM, see "math/kernels/qgemm.inl"
+  struct VecI32
+  {
+    static constexpr size_t width = 1;
+    int32_t v;
+  };
+
+  // Largest magnitude of the signed bytes for which "DotU8S8" is exact
+  constexpr int32_t dot_weight_max = 127;
+
+  inline VecI32 ZeroI32() noexcept {return {0};}
+
+  // The 4 bytes at _src in every lane
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {bytes};
+  }
+
+  // Lane i adds the 4 products of the unsigned bytes of lane i of _a and the signed _b[4i .. 4i+3]
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {
+    uint8_t a[4];
+    std::memcpy(a, &_a.v, sizeof(int32_t));
+    return {_acc.v + a[0] * _b[0] + a[1] * _b[1] + a[2] * _b[2] + a[3] * _b[3]};
+  }
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_a.v + _b.v};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {(float)_a.v};}
+
+  // Unsigned lanes for the Philox generator, see "math/kernels/random.inl"
+  inline VecI32 SetI32(const uint32_t _value) noexcept {return {(int32_t)_value};}
+  inline VecI32 LoadI32(const uint32_t* _src) noexcept {return {(int32_t)*_src};}
+  inline void StoreI32(uint32_t* _dst, const VecI32 _a) noexcept {*_dst = (uint32_t)_a.v;}
+  inline VecI32 XorI32(const VecI32 _a, const VecI32 _b) noexcept {return {_a.v ^ _b.v};}
+
+  // High and low halves of the 64-bit products of the unsigned lanes
+  inline void MulWideU32(const VecI32 _a, const VecI32 _b, VecI32& _high, VecI32& _low) noexcept
+  {
+    const uint64_t product = (uint64_t)(uint32_t)_a.v * (uint32_t)_b.v;
+    _high = {(int32_t)(uint32_t)(product >> 32)};
+    _low = {(int32_t)(uint32_t)product};
+  }
+
+  // The top 24 bits of the unsigned lanes as floats in [0, 1), exact
+  inline VecF32 UnitFloat(const VecI32 _a) noexcept
+  {return {(float)((uint32_t)_a.v >> 8) * (1.0f / 16777216.0f)};}
+
+  inline float ReduceAdd(const VecF32 _a) noexcept {return _a.v;}
+  inline float ReduceMax(const VecF32 _a) noexcept {return _a.v;}
+  inline float ReduceMin(const VecF32 _a) noexcept {return _a.v;}
+
+}}}
+
+#endif
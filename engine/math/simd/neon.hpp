@@ -0,0 +1,235 @@
+// File Name:     neon.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   ARMv8 NEON implementation of the SIMD abstraction, 4 float lanes
+
+// ---------------------
+// Note:
+// Advanced SIMD is part of the ARMv8-A baseline, so no target region is needed
+// ---------------------
+
+#ifndef ENGINE_MATH_SIMD_NEON_HPP
+#define ENGINE_MATH_SIMD_NEON_HPP
+
+namespace mnt { namespace simd { namespace neon {
+
+  constexpr ISA simd_isa = ISA::NEON;
+
+  struct VecF32
+  {
+    static constexpr size_t width = 4;
+    float32x4_t v;
+  };
+
+  inline VecF32 Zero() noexcept {return {vdupq_n_f32(0.0f)};}
+  inline VecF32 Set(const float _value) noexcept {return {vdupq_n_f32(_value)};}
+
+  inline VecF32 Load(const float* _src) noexcept {return {vld1q_f32(_src)};}
+  inline void Store(float* _dst, const VecF32 _a) noexcept {vst1q_f32(_dst, _a.v);}
+
+  // NEON has no masked load/store, partial lanes go through a small stack buffer
+  inline VecF32 LoadPartial(const float* _src, const size_t _count) noexcept
+  {
+    float buffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i=0; i<_count && i<4; i++)
+      buffer[i] = _src[i];
+    return {vld1q_f32(buffer)};
+  }
+
+  inline void StorePartial(float* _dst, const VecF32 _a, const size_t _count) noexcept
+  {
+    float buffer[4];
+    vst1q_f32(buffer, _a.v);
+    for (size_t i=0; i<_count && i<4; i++)
+      _dst[i] = buffer[i];
+  }
+
+  inline VecF32 Add(const VecF32 _a, const VecF32 _b) noexcept {return {vaddq_f32(_a.v, _b.v)};}
+  inline VecF32 Sub(const VecF32 _a, const VecF32 _b) noexcept {return {vsubq_f32(_a.v, _b.v)};}
+  inline VecF32 Mul(const VecF32 _a, const VecF32 _b) noexcept {return {vmulq_f32(_a.v, _b.v)};}
+  inline VecF32 Div(const VecF32 _a, const VecF32 _b) noexcept {return {vdivq_f32(_a.v, _b.v)};}
+
+  // vfmaq_f32(c, a, b) = c + a * b
+  inline VecF32 Fma(const VecF32 _a, const VecF32 _b, const VecF32 _c) noexcept
+  {return {vfmaq_f32(_c.v, _a.v, _b.v)};}
+
+  inline VecF32 Max(const VecF32 _a, const VecF32 _b) noexcept {return {vmaxq_f32(_a.v, _b.v)};}
+  inline VecF32 Min(const VecF32 _a, const VecF32 _b) noexcept {return {vminq_f32(_a.v, _b.v)};}
+  inline VecF32 Abs(const VecF32 _a) noexcept {return {vabsq_f32(_a.v)};}
+  inline VecF32 Sqrt(const VecF32 _a) noexcept {return {vsqrtq_f32(_a.v)};}
+
+  inline VecF32 Round(const VecF32 _a) noexcept {return {vrndnq_f32(_a.v)};}
+
+  // The exponent is split in two halves, each one is a normal float
+  inline VecF32 Ldexp(const VecF32 _a, const VecF32 _n) noexcept
+  {
+    const int32x4_t n = vcvtnq_s32_f32(_n.v);
+    const int32x4_t half = vshrq_n_s32(n, 1);
+    const int32x4_t bias = vdupq_n_s32(127);
+    const float32x4_t scale_1 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(half, bias), 23));
+    const float32x4_t scale_2 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vsubq_s32(n, half), bias), 23));
+    return {vmulq_f32(vmulq_f32(_a.v, scale_1), scale_2)};
+  }
+
+  inline VecF32 SelectLess(const VecF32 _a, const VecF32 _b, const VecF32 _x, const VecF32 _y) noexcept
+  {return {vbslq_f32(vcltq_f32(_a.v, _b.v), _x.v, _y.v)};}
+
+  inline uint32_t NonZeroBits(const VecF32 _a) noexcept
+  {
+    const uint32x4_t lanes = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(vmvnq_u32(vceqq_f32(_a.v, vdupq_n_f32(0.0f))), lanes));
+  }
+
+  inline VecF32 SelectBits(const uint32_t _bits, const VecF32 _x, const VecF32 _y) noexcept
+  {
+    const uint32x4_t lanes = {1, 2, 4, 8};
+    return {vbslq_f32(vtstq_u32(vdupq_n_u32(_bits), lanes), _x.v, _y.v)};
+  }
+
+  inline VecF32 Exponent(const VecF32 _a) noexcept
+  {
+    const int32x4_t biased = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(_a.v), 23));
+    return {vcvtq_f32_s32(vsubq_s32(biased, vdupq_n_s32(127)))};
+  }
+
+  inline VecF32 Mantissa(const VecF32 _a) noexcept
+  {
+    const uint32x4_t fraction = vandq_u32(vreinterpretq_u32_f32(_a.v), vdupq_n_u32(0x007FFFFF));
+    return {vreinterpretq_f32_u32(vorrq_u32(fraction, vdupq_n_u32(0x3F800000)))};
+  }
+
+  // Reduced precision items, ARMv8 converts Half natively
+  inline VecF32 Load(const Half* _src) noexcept
+  {return {vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16((const uint16_t*)_src)))};}
+  inline void Store(Half* _dst, const VecF32 _a) noexcept
+  {vst1_u16((uint16_t*)_dst, vreinterpret_u16_f16(vcvt_f16_f32(_a.v)));}
+
+  inline VecF32 Load(const BFloat16* _src) noexcept
+  {return {vreinterpretq_f32_u32(vshlq_n_u32(vmovl_u16(vld1_u16((const uint16_t*)_src)), 16))};}
+
+  // The same as "FloatToBFloat16" in "math/half.inl"
+  inline void Store(BFloat16* _dst, const VecF32 _a) noexcept
+  {
+    const uint32x4_t bits = vreinterpretq_u32_f32(_a.v);
+    const uint32x4_t odd = vandq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(1));
+    const uint32x4_t rounded = vshrq_n_u32(vaddq_u32(vaddq_u32(bits, vdupq_n_u32(0x7FFF)), odd), 16);
+    const uint32x4_t quiet = vorrq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(0x40));
+    vst1_u16((uint16_t*)_dst, vmovn_u32(vbslq_u32(vceqq_f32(_a.v, _a.v), rounded, quiet)));
+  }
+
+  // 8-bit integer items, stored rounded to nearest even and saturated, NaN stores the lowest value
+  inline VecF32 Load(const int8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    const int16x8_t words = vmovl_s8(vreinterpret_s8_s32(vdup_n_s32(bytes)));
+    return {vcvtq_f32_s32(vmovl_s16(vget_low_s16(words)))};
+  }
+
+  inline VecF32 Load(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    const uint16x8_t words = vmovl_u8(vreinterpret_u8_s32(vdup_n_s32(bytes)));
+    return {vcvtq_f32_u32(vmovl_u16(vget_low_u16(words)))};
+  }
+
+  // FMAXNM returns the number if the other operand is NaN
+  inline void Store(int8_t* _dst, const VecF32 _a) noexcept
+  {
+    const int32x4_t items = vcvtnq_s32_f32(vminq_f32(vmaxnmq_f32(_a.v, vdupq_n_f32(-128.0f)), vdupq_n_f32(127.0f)));
+    const int16x4_t words = vmovn_s32(items);
+    const int32_t bytes = vget_lane_s32(vreinterpret_s32_s8(vmovn_s16(vcombine_s16(words, words))), 0);
+    std::memcpy(_dst, &bytes, sizeof(int32_t));
+  }
+
+  inline void Store(uint8_t* _dst, const VecF32 _a) noexcept
+  {
+    const uint32x4_t items = vcvtnq_u32_f32(vminq_f32(vmaxnmq_f32(_a.v, vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f)));
+    const uint16x4_t words = vmovn_u32(items);
+    const int32_t bytes = vget_lane_s32(vreinterpret_s32_u8(vmovn_u16(vcombine_u16(words, words))), 0);
+    std::memcpy(_dst, &bytes, sizeof(int32_t));
+  }
+
+  template <typename T>
+  inline VecF32 LoadPartial(const T* _src, const size_t _count) noexcept
+  {
+    T buffer[4] = {};
+    for (size_t i=0; i<_count && i<4; i++)
+      buffer[i] = _src[i];
+    return Load(buffer);
+  }
+
+  template <typename T>
+  inline void StorePartial(T* _dst, const VecF32 _a, const size_t _count) noexcept
+  {
+    T buffer[4];
+    Store(buffer, _a);
+    for (size_t i=0; i<_count && i<4; i++)
+      _dst[i] = buffer[i];
+  }
+
+  // Integer lanes for the int8 GEMM, see "math/kernels/qgemm.inl"
+  struct VecI32
+  {
+    static constexpr size_t width = 4;
+    int32x4_t v;
+  };
+
+  // Bytes are widened to 16 bits and the products to 32 bits, no saturation
+  constexpr int32_t dot_weight_max = 127;
+
+  inline VecI32 ZeroI32() noexcept {return {vdupq_n_s32(0)};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {vdupq_n_s32(bytes)};
+  }
+
+  // Every lane of _a holds the same 4 bytes, the products of lane i are summed pairwise
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {
+    const int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(vreinterpretq_u8_s32(_a.v))));
+    const int8x16_t b = vld1q_s8(_b);
+    const int16x8_t b_low = vmovl_s8(vget_low_s8(b));
+    const int16x8_t b_high = vmovl_high_s8(b);
+
+    const int32x4_t p0 = vmull_s16(vget_low_s16(a), vget_low_s16(b_low));
+    const int32x4_t p1 = vmull_s16(vget_high_s16(a), vget_high_s16(b_low));
+    const int32x4_t p2 = vmull_s16(vget_low_s16(a), vget_low_s16(b_high));
+    const int32x4_t p3 = vmull_s16(vget_high_s16(a), vget_high_s16(b_high));
+
+    return {vaddq_s32(_acc.v, vpaddq_s32(vpaddq_s32(p0, p1), vpaddq_s32(p2, p3)))};
+  }
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {vaddq_s32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {vcvtq_f32_s32(_a.v)};}
+
+  inline VecI32 SetI32(const uint32_t _value) noexcept {return {vreinterpretq_s32_u32(vdupq_n_u32(_value))};}
+  inline VecI32 LoadI32(const uint32_t* _src) noexcept {return {vreinterpretq_s32_u32(vld1q_u32(_src))};}
+  inline void StoreI32(uint32_t* _dst, const VecI32 _a) noexcept {vst1q_u32(_dst, vreinterpretq_u32_s32(_a.v));}
+  inline VecI32 XorI32(const VecI32 _a, const VecI32 _b) noexcept {return {veorq_s32(_a.v, _b.v)};}
+
+  // The high halves are the odd words of the 64-bit products
+  inline void MulWideU32(const VecI32 _a, const VecI32 _b, VecI32& _high, VecI32& _low) noexcept
+  {
+    const uint32x4_t a = vreinterpretq_u32_s32(_a.v);
+    const uint32x4_t b = vreinterpretq_u32_s32(_b.v);
+    const uint32x4_t low = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), vget_low_u32(b)));
+    const uint32x4_t high = vreinterpretq_u32_u64(vmull_high_u32(a, b));
+    _high = {vreinterpretq_s32_u32(vuzp2q_u32(low, high))};
+    _low = {vreinterpretq_s32_u32(vmulq_u32(a, b))};
+  }
+
+  inline VecF32 UnitFloat(const VecI32 _a) noexcept
+  {return {vmulq_n_f32(vcvtq_f32_u32(vshrq_n_u32(vreinterpretq_u32_s32(_a.v), 8)), 1.0f / 16777216.0f)};}
+
+  inline float ReduceAdd(const VecF32 _a) noexcept {return vaddvq_f32(_a.v);}
+  inline float ReduceMax(const VecF32 _a) noexcept {return vmaxvq_f32(_a.v);}
+  inline float ReduceMin(const VecF32 _a) noexcept {return vminvq_f32(_a.v);}
+
+}}}
+
+#endif
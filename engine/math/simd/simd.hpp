@@ -0,0 +1,121 @@
+// File Name:     simd.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Thin SIMD abstraction used to write kernels once for all instruction sets
+
+// ---------------------
+// Detail Description:
+// Each instruction set has its own namespace (mnt::simd::generic, sse4, avx2, avx512, neon)
+// with the same set of types and free functions, e.g. "VecF32", "Load", "Add", "Fma", etc.
+// "Load" and "Store" also have overloads for Half, BFloat16, int8_t and uint8_t items that
+// convert them to and from the float lanes, and "VecI32" has the few integer operations of
+// the int8 GEMM and of the Philox generator. "NonZeroBits" and "SelectBits" move between
+// lanes and the low bits of an integer, one bit per lane, for the bit-packed masks of
+// "math/bitmask.hpp".
+// Kernel bodies are written against these names and compiled once per instruction set
+// (see "math/kernels/variants.hpp"), the best variant is bound at runtime by KernelRegistry.
+// ---------------------
+
+// ---------------------
+// Note:
+// The binary is compiled for the baseline ISA, code that uses newer instructions is wrapped
+// between "MNT_TARGET_<ISA>_BEGIN" and "MNT_TARGET_END", which set the target of all functions
+// defined in between, on GCC and Clang. MSVC doesn`t need it, intrinsics are always available.
+// Such code must never run unless "mnt::CPU::Supports" confirms the ISA, extensions beyond the
+// ISA levels, e.g. "MNT_TARGET_AVX512_BF16_BEGIN" or "MNT_TARGET_AVX512_VNNI_BEGIN", unless
+// "mnt::CPU::Features" reports them.
+// ---------------------
+
+// ---------------------
+// Note:
+// The intrinsic headers have to be included before any target region, never include
+// a header inside a region, because all of its inline functions would inherit the target
+// ---------------------
+
+#ifndef ENGINE_MATH_SIMD_SIMD_HPP
+#define ENGINE_MATH_SIMD_SIMD_HPP
+
+#include "utils/platform.hpp"
+#include "utils/cpu.hpp"
+
+#include "math/half.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#if defined(MNT_ARCH_X86_64)
+  #define MNT_SIMD_X86
+  #include <immintrin.h>
+#elif defined(MNT_ARCH_ARM64)
+  #define MNT_SIMD_NEON
+  #include <arm_neon.h>
+#endif
+
+#if defined(__clang__)
+  #define MNT_TARGET_SSE4_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"sse4.1,ssse3,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_AVX2_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"avx2,fma,f16c,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_AVX512_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_AVX512_BF16_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"avx512bf16,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_AVX512_VNNI_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"avx512vnni,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_AVX_VNNI_BEGIN \
+    _Pragma("clang attribute push (__attribute__((target(\"avxvnni,avx2,fma,f16c,popcnt\"))), apply_to = function)")
+  #define MNT_TARGET_END _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+  #define MNT_TARGET_SSE4_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"sse4.1,ssse3,popcnt\")")
+  #define MNT_TARGET_AVX2_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma,f16c,popcnt\")")
+  #define MNT_TARGET_AVX512_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\")")
+  #define MNT_TARGET_AVX512_BF16_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx512bf16,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\")")
+  #define MNT_TARGET_AVX512_VNNI_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx512vnni,avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,f16c,popcnt\")")
+  #define MNT_TARGET_AVX_VNNI_BEGIN \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avxvnni,avx2,fma,f16c,popcnt\")")
+  #define MNT_TARGET_END _Pragma("GCC pop_options")
+#else
+  #define MNT_TARGET_SSE4_BEGIN
+  #define MNT_TARGET_AVX2_BEGIN
+  #define MNT_TARGET_AVX512_BEGIN
+  #define MNT_TARGET_AVX512_BF16_BEGIN
+  #define MNT_TARGET_AVX512_VNNI_BEGIN
+  #define MNT_TARGET_AVX_VNNI_BEGIN
+  #define MNT_TARGET_END
+#endif
+
+// Fully unrolls the next loop, for kernels that keep an array of accumulators in registers
+#if defined(__clang__)
+  #define MNT_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+  #define MNT_UNROLL _Pragma("GCC unroll 16")
+#else
+  #define MNT_UNROLL
+#endif
+
+// Starts loading the cache line of _address, for reads the hardware prefetcher can`t predict
+#if defined(__GNUC__) || defined(__clang__)
+  #define MNT_PREFETCH(_address) __builtin_prefetch(_address)
+#else
+  #define MNT_PREFETCH(_address)
+#endif
+
+#include "math/simd/generic.hpp"
+
+#if defined(MNT_SIMD_X86)
+  #include "math/simd/sse4.hpp"
+  #include "math/simd/avx2.hpp"
+  #include "math/simd/avx512.hpp"
+#elif defined(MNT_SIMD_NEON)
+  #include "math/simd/neon.hpp"
+#endif
+
+#endif
@@ -0,0 +1,282 @@
+// File Name:     sse4.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   SSE4.1 implementation of the SIMD abstraction, 4 float lanes
+
+#ifndef ENGINE_MATH_SIMD_SSE4_HPP
+#define ENGINE_MATH_SIMD_SSE4_HPP
+
+MNT_TARGET_SSE4_BEGIN
+
+namespace mnt { namespace simd { namespace sse4 {
+
+  constexpr ISA simd_isa = ISA::SSE4;
+
+  struct VecF32
+  {
+    static constexpr size_t width = 4;
+    __m128 v;
+  };
+
+  inline VecF32 Zero() noexcept {return {_mm_setzero_ps()};}
+  inline VecF32 Set(const float _value) noexcept {return {_mm_set1_ps(_value)};}
+
+  inline VecF32 Load(const float* _src) noexcept {return {_mm_loadu_ps(_src)};}
+  inline void Store(float* _dst, const VecF32 _a) noexcept {_mm_storeu_ps(_dst, _a.v);}
+
+  // SSE has no masked load/store, partial lanes go through a small stack buffer
+  inline VecF32 LoadPartial(const float* _src, const size_t _count) noexcept
+  {
+    alignas(16) float buffer[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i=0; i<_count && i<4; i++)
+      buffer[i] = _src[i];
+    return {_mm_load_ps(buffer)};
+  }
+
+  inline void StorePartial(float* _dst, const VecF32 _a, const size_t _count) noexcept
+  {
+    alignas(16) float buffer[4];
+    _mm_store_ps(buffer, _a.v);
+    for (size_t i=0; i<_count && i<4; i++)
+      _dst[i] = buffer[i];
+  }
+
+  inline VecF32 Add(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_add_ps(_a.v, _b.v)};}
+  inline VecF32 Sub(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_sub_ps(_a.v, _b.v)};}
+  inline VecF32 Mul(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_mul_ps(_a.v, _b.v)};}
+  inline VecF32 Div(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_div_ps(_a.v, _b.v)};}
+
+  // No FMA on SSE4 machines, two roundings instead of one
+  inline VecF32 Fma(const VecF32 _a, const VecF32 _b, const VecF32 _c) noexcept
+  {return {_mm_add_ps(_mm_mul_ps(_a.v, _b.v), _c.v)};}
+
+  inline VecF32 Max(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_max_ps(_a.v, _b.v)};}
+  inline VecF32 Min(const VecF32 _a, const VecF32 _b) noexcept {return {_mm_min_ps(_a.v, _b.v)};}
+  inline VecF32 Abs(const VecF32 _a) noexcept
+  {return {_mm_andnot_ps(_mm_set1_ps(-0.0f), _a.v)};}
+  inline VecF32 Sqrt(const VecF32 _a) noexcept {return {_mm_sqrt_ps(_a.v)};}
+
+  inline VecF32 Round(const VecF32 _a) noexcept
+  {return {_mm_round_ps(_a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};}
+
+  // The exponent is split in two halves, each one is a normal float
+  inline VecF32 Ldexp(const VecF32 _a, const VecF32 _n) noexcept
+  {
+    const __m128i n = _mm_cvtps_epi32(_n.v);
+    const __m128i half = _mm_srai_epi32(n, 1);
+    const __m128i bias = _mm_set1_epi32(127);
+    const __m128 scale_1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(half, bias), 23));
+    const __m128 scale_2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(n, half), bias), 23));
+    return {_mm_mul_ps(_mm_mul_ps(_a.v, scale_1), scale_2)};
+  }
+
+  inline VecF32 SelectLess(const VecF32 _a, const VecF32 _b, const VecF32 _x, const VecF32 _y) noexcept
+  {return {_mm_blendv_ps(_y.v, _x.v, _mm_cmplt_ps(_a.v, _b.v))};}
+
+  // cmpneq is unordered, NaN lanes are set
+  inline uint32_t NonZeroBits(const VecF32 _a) noexcept
+  {return (uint32_t)_mm_movemask_ps(_mm_cmpneq_ps(_a.v, _mm_setzero_ps()));}
+
+  inline VecF32 SelectBits(const uint32_t _bits, const VecF32 _x, const VecF32 _y) noexcept
+  {
+    const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32((int)_bits), lanes), lanes);
+    return {_mm_blendv_ps(_y.v, _x.v, _mm_castsi128_ps(mask))};
+  }
+
+  inline VecF32 Exponent(const VecF32 _a) noexcept
+  {
+    const __m128i biased = _mm_srli_epi32(_mm_castps_si128(_a.v), 23);
+    return {_mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(127)))};
+  }
+
+  inline VecF32 Mantissa(const VecF32 _a) noexcept
+  {
+    const __m128 fraction = _mm_and_ps(_a.v, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF)));
+    return {_mm_or_ps(fraction, _mm_set1_ps(1.0f))};
+  }
+
+  inline float ReduceAdd(const VecF32 _a) noexcept
+  {
+    __m128 shuffled = _mm_movehdup_ps(_a.v);
+    __m128 sums = _mm_add_ps(_a.v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+    return _mm_cvtss_f32(sums);
+  }
+
+  // Reduced precision items, SSE4 has no F16C, Half is converted with integer operations,
+  // the same as "HalfToFloat" and "FloatToHalf" in "math/half.inl"
+  inline VecF32 Load(const Half* _src) noexcept
+  {
+    const __m128i h = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)_src));
+    const __m128i exponent_mantissa = _mm_and_si128(h, _mm_set1_epi32(0x7FFF));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, exponent_mantissa), 16);
+
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponent_mantissa, 13)),
+                                     _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+    const __m128i infinity_nan = _mm_and_si128(_mm_cmpgt_epi32(exponent_mantissa, _mm_set1_epi32(0x7BFF)),
+                                               _mm_set1_epi32(255 << 23));
+
+    return {_mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, infinity_nan)))};
+  }
+
+  inline void Store(Half* _dst, const VecF32 _a) noexcept
+  {
+    const __m128 sign = _mm_and_ps(_a.v, _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u)));
+    const __m128 absolute = _mm_xor_ps(_a.v, sign);
+    const __m128i bits = _mm_castps_si128(absolute);
+
+    // NaN, infinity and overflow
+    const __m128i nan_bit = _mm_and_si128(_mm_castps_si128(_mm_cmpunord_ps(absolute, absolute)), _mm_set1_epi32(0x200));
+    const __m128i special = _mm_or_si128(nan_bit, _mm_set1_epi32(0x7C00));
+    const __m128i regular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), bits);
+
+    // Subnormal results
+    const __m128i magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(magic))), magic);
+    const __m128i is_subnormal = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), bits);
+
+    // Normal results
+    const __m128i odd = _mm_srli_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+    const __m128i rounded = _mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), odd);
+    const __m128i normal = _mm_srli_epi32(rounded, 13);
+
+    __m128i result = _mm_blendv_epi8(normal, subnormal, is_subnormal);
+    result = _mm_blendv_epi8(special, result, regular);
+    result = _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+
+    _mm_storel_epi64((__m128i*)_dst, _mm_packus_epi32(result, result));
+  }
+
+  inline VecF32 Load(const BFloat16* _src) noexcept
+  {
+    const __m128i h = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)_src));
+    return {_mm_castsi128_ps(_mm_slli_epi32(h, 16))};
+  }
+
+  inline void Store(BFloat16* _dst, const VecF32 _a) noexcept
+  {
+    const __m128i bits = _mm_castps_si128(_a.v);
+    const __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+    const __m128i rounded = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0x7FFF)), odd), 16);
+    const __m128i quiet = _mm_or_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x40));
+    const __m128i result = _mm_blendv_epi8(rounded, quiet, _mm_castps_si128(_mm_cmpunord_ps(_a.v, _a.v)));
+
+    _mm_storel_epi64((__m128i*)_dst, _mm_packus_epi32(result, result));
+  }
+
+  // 8-bit integer items, stored rounded to nearest even and saturated, NaN stores the lowest value
+  inline VecF32 Load(const int8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(bytes)))};
+  }
+
+  inline VecF32 Load(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)))};
+  }
+
+  inline void Store(int8_t* _dst, const VecF32 _a) noexcept
+  {
+    const __m128i items = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_a.v, _mm_set1_ps(-128.0f)), _mm_set1_ps(127.0f)));
+    const __m128i words = _mm_packs_epi32(items, items);
+    const int32_t bytes = _mm_cvtsi128_si32(_mm_packs_epi16(words, words));
+    std::memcpy(_dst, &bytes, sizeof(int32_t));
+  }
+
+  inline void Store(uint8_t* _dst, const VecF32 _a) noexcept
+  {
+    const __m128i items = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_a.v, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+    const __m128i words = _mm_packs_epi32(items, items);
+    const int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+    std::memcpy(_dst, &bytes, sizeof(int32_t));
+  }
+
+  template <typename T>
+  inline VecF32 LoadPartial(const T* _src, const size_t _count) noexcept
+  {
+    T buffer[4] = {};
+    for (size_t i=0; i<_count && i<4; i++)
+      buffer[i] = _src[i];
+    return Load(buffer);
+  }
+
+  template <typename T>
+  inline void StorePartial(T* _dst, const VecF32 _a, const size_t _count) noexcept
+  {
+    T buffer[4];
+    Store(buffer, _a);
+    for (size_t i=0; i<_count && i<4; i++)
+      _dst[i] = buffer[i];
+  }
+
+  // Integer lanes for the int8 GEMM, see "math/kernels/qgemm.inl"
+  struct VecI32
+  {
+    static constexpr size_t width = 4;
+    __m128i v;
+  };
+
+  // PMADDUBSW adds pairs of products in int16 with saturation, with |_b| <= 63 the sum of a
+  // pair stays below 32767, so "DotU8S8" is exact
+  constexpr int32_t dot_weight_max = 63;
+
+  inline VecI32 ZeroI32() noexcept {return {_mm_setzero_si128()};}
+
+  inline VecI32 Broadcast4(const uint8_t* _src) noexcept
+  {
+    int32_t bytes;
+    std::memcpy(&bytes, _src, sizeof(int32_t));
+    return {_mm_set1_epi32(bytes)};
+  }
+
+  inline VecI32 DotU8S8(const VecI32 _acc, const VecI32 _a, const int8_t* _b) noexcept
+  {
+    const __m128i pairs = _mm_maddubs_epi16(_a.v, _mm_loadu_si128((const __m128i*)_b));
+    return {_mm_add_epi32(_acc.v, _mm_madd_epi16(pairs, _mm_set1_epi16(1)))};
+  }
+
+  inline VecI32 AddI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm_add_epi32(_a.v, _b.v)};}
+  inline VecF32 ToFloat(const VecI32 _a) noexcept {return {_mm_cvtepi32_ps(_a.v)};}
+
+  inline VecI32 SetI32(const uint32_t _value) noexcept {return {_mm_set1_epi32((int)_value)};}
+  inline VecI32 LoadI32(const uint32_t* _src) noexcept {return {_mm_loadu_si128((const __m128i*)_src)};}
+  inline void StoreI32(uint32_t* _dst, const VecI32 _a) noexcept {_mm_storeu_si128((__m128i*)_dst, _a.v);}
+  inline VecI32 XorI32(const VecI32 _a, const VecI32 _b) noexcept {return {_mm_xor_si128(_a.v, _b.v)};}
+
+  // PMULUDQ multiplies the even lanes, the odd ones are shifted down first
+  inline void MulWideU32(const VecI32 _a, const VecI32 _b, VecI32& _high, VecI32& _low) noexcept
+  {
+    const __m128i even = _mm_mul_epu32(_a.v, _b.v);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(_a.v, 32), _mm_srli_epi64(_b.v, 32));
+    _high = {_mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC)};
+    _low = {_mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC)};
+  }
+
+  inline VecF32 UnitFloat(const VecI32 _a) noexcept
+  {return {_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(_a.v, 8)), _mm_set1_ps(1.0f / 16777216.0f))};}
+
+  inline float ReduceMax(const VecF32 _a) noexcept
+  {
+    __m128 max = _mm_max_ps(_a.v, _mm_movehl_ps(_a.v, _a.v));
+    max = _mm_max_ss(max, _mm_movehdup_ps(max));
+    return _mm_cvtss_f32(max);
+  }
+
+  inline float ReduceMin(const VecF32 _a) noexcept
+  {
+    __m128 min = _mm_min_ps(_a.v, _mm_movehl_ps(_a.v, _a.v));
+    min = _mm_min_ss(min, _mm_movehdup_ps(min));
+    return _mm_cvtss_f32(min);
+  }
+
+}}}
+
+MNT_TARGET_END
+
+#endif
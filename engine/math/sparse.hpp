@@ -0,0 +1,218 @@
+// File Name:     sparse.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Sparse matrices in the COO, CSR and BSR formats
+
+// ---------------------
+// Detail Description:
+// A sparse matrix of {rows, cols} stores only its non-zeros, so its memory and the work of the
+// operations on it scale with the number of non-zeros (nnz) instead of rows * cols:
+//
+//   COO: the row, the column and the value of every non-zero, in any order, the format to
+//        build a matrix from a list of features, duplicates are added up by the conversion to CSR
+//   CSR: the non-zeros row by row, sorted by column, row i has the non-zeros
+//        [offsets[i], offsets[i + 1]) of the indices (their columns) and of the values
+//   BSR: CSR of dense blocks of block_rows x block_cols items, block row i has the blocks
+//        [offsets[i], offsets[i + 1]), the indices are their block columns and every block
+//        stores its items row by row, pruned weights with structure fill whole blocks, and the
+//        products reuse every row of the dense operand for all the rows of a block
+//
+// The arrays are held in LinearHeapMemory through MemoryRef, like the items of Tensor, and
+// matrices computed on the structure of another one, e.g. by "SDDMM", share its offsets and
+// indices. The products and the elementwise ops are in "math/backend.hpp".
+// ---------------------
+
+// ---------------------
+// Note:
+// Column indices are TSPARSE_INDEX_TYPE, see "configs.hpp", row offsets are size_t. Items equal
+// to T(0) are not stored by the conversions from dense matrices, but the ops keep the zeros they
+// compute, e.g. a + (-a), a stored zero is valid everywhere
+// ---------------------
+
+// =====
+// [SparseArray(_length)]: An array of _length uninitialized items, copies share the items
+// =====
+
+// =====
+// [SparseCOO(_rows, _cols, _nnz, _row_indices, _col_indices, _values)]: Copies _nnz non-zeros,
+// throws if one of them is out of the matrix
+// =====
+
+// =====
+// [SparseCSR(_structure, _values)]: A matrix with the non-zeros of _structure and _values
+// instead of its values, the offsets and the indices are shared
+// =====
+
+// =====
+// [SparseBSR(_dense/_csr, _block_rows, _block_cols)]: Keeps every block with a non-zero,
+// the rows and the columns must be multiples of the block size
+// =====
+
+#ifndef ENGINE_MATH_SPARSE_HPP
+#define ENGINE_MATH_SPARSE_HPP
+
+#include "configs.hpp"
+
+#include "memory/memory_ref.hpp"
+
+#include "math/tensor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mnt {
+
+  using SparseIndex = TSPARSE_INDEX_TYPE;
+
+  static_assert(std::is_unsigned<SparseIndex>::value, "TSPARSE_INDEX_TYPE must be an unsigned type");
+
+  template <typename T>
+  class SparseArray
+  {
+  public:
+    explicit SparseArray(size_t _length = 0);
+
+    inline T* Data() noexcept {return m_data;};
+    inline const T* Data() const noexcept {return m_data;};
+    inline size_t Length() const noexcept {return m_length;};
+
+    inline T& operator [] (const size_t _index) noexcept {return m_data[_index];};
+    inline const T& operator [] (const size_t _index) const noexcept {return m_data[_index];};
+
+  private:
+    MemoryRef<T> m_memory;
+    T* m_data = nullptr;
+    size_t m_length = 0;
+  };
+
+  template <typename T>
+  class SparseCSR;
+
+  template <typename T>
+  class SparseBSR;
+
+  template <typename T>
+  class SparseCOO
+  {
+  public:
+    SparseCOO(size_t _rows, size_t _cols, size_t _nnz,
+              const SparseIndex* _row_indices, const SparseIndex* _col_indices, const T* _values);
+    explicit SparseCOO(Tensor<T>& _dense);
+    explicit SparseCOO(const SparseCSR<T>& _csr);
+
+    SparseCOO(const SparseCOO&) = delete;
+    SparseCOO& operator = (const SparseCOO&) = delete;
+    SparseCOO(SparseCOO&&) noexcept = default;
+    SparseCOO& operator = (SparseCOO&&) noexcept = default;
+
+    Tensor<T> ToDense() const;
+
+    inline size_t Rows() const noexcept {return m_rows;};
+    inline size_t Cols() const noexcept {return m_cols;};
+    inline size_t NonZeros() const noexcept {return m_values.Length();};
+
+    inline const SparseIndex* RowIndices() const noexcept {return m_row_indices.Data();};
+    inline const SparseIndex* ColIndices() const noexcept {return m_col_indices.Data();};
+    inline T* Values() noexcept {return m_values.Data();};
+    inline const T* Values() const noexcept {return m_values.Data();};
+
+  private:
+    size_t m_rows;
+    size_t m_cols;
+
+    SparseArray<SparseIndex> m_row_indices;
+    SparseArray<SparseIndex> m_col_indices;
+    SparseArray<T> m_values;
+  };
+
+  template <typename T>
+  class SparseCSR
+  {
+  public:
+    // The arrays must already be a valid CSR matrix, e.g. built by the ops
+    SparseCSR(size_t _rows, size_t _cols, SparseArray<size_t> _offsets,
+              SparseArray<SparseIndex> _indices, SparseArray<T> _values);
+    SparseCSR(const SparseCSR& _structure, SparseArray<T> _values);
+    explicit SparseCSR(Tensor<T>& _dense);
+    explicit SparseCSR(const SparseCOO<T>& _coo);
+    explicit SparseCSR(const SparseBSR<T>& _bsr);
+
+    SparseCSR(const SparseCSR&) = delete;
+    SparseCSR& operator = (const SparseCSR&) = delete;
+    SparseCSR(SparseCSR&&) noexcept = default;
+    SparseCSR& operator = (SparseCSR&&) noexcept = default;
+
+    Tensor<T> ToDense() const;
+
+    inline size_t Rows() const noexcept {return m_rows;};
+    inline size_t Cols() const noexcept {return m_cols;};
+    inline size_t NonZeros() const noexcept {return m_values.Length();};
+
+    // Rows() + 1 offsets
+    inline const size_t* Offsets() const noexcept {return m_offsets.Data();};
+    inline const SparseIndex* Indices() const noexcept {return m_indices.Data();};
+    inline T* Values() noexcept {return m_values.Data();};
+    inline const T* Values() const noexcept {return m_values.Data();};
+
+  private:
+    size_t m_rows;
+    size_t m_cols;
+
+    SparseArray<size_t> m_offsets;
+    SparseArray<SparseIndex> m_indices;
+    SparseArray<T> m_values;
+  };
+
+  template <typename T>
+  class SparseBSR
+  {
+  public:
+    SparseBSR(Tensor<T>& _dense, size_t _block_rows, size_t _block_cols);
+    SparseBSR(const SparseCSR<T>& _csr, size_t _block_rows, size_t _block_cols);
+
+    SparseBSR(const SparseBSR&) = delete;
+    SparseBSR& operator = (const SparseBSR&) = delete;
+    SparseBSR(SparseBSR&&) noexcept = default;
+    SparseBSR& operator = (SparseBSR&&) noexcept = default;
+
+    Tensor<T> ToDense() const;
+
+    inline size_t Rows() const noexcept {return m_rows;};
+    inline size_t Cols() const noexcept {return m_cols;};
+    inline size_t BlockRows() const noexcept {return m_block_rows;};
+    inline size_t BlockCols() const noexcept {return m_block_cols;};
+    inline size_t NonZeroBlocks() const noexcept {return m_indices.Length();};
+
+    // Rows() / BlockRows() + 1 offsets, block p is at Values() + p * BlockRows() * BlockCols()
+    inline const size_t* Offsets() const noexcept {return m_offsets.Data();};
+    inline const SparseIndex* Indices() const noexcept {return m_indices.Data();};
+    inline T* Values() noexcept {return m_values.Data();};
+    inline const T* Values() const noexcept {return m_values.Data();};
+
+  private:
+    // Checks the sizes, fills the offsets with _no_of_blocks(block_row) blocks per block row
+    // and allocates the indices and the values, returns the number of blocks
+    template <typename F>
+    size_t Structure(size_t _rows, size_t _cols, const F& _no_of_blocks, size_t _cost);
+
+  private:
+    size_t m_rows;
+    size_t m_cols;
+    size_t m_block_rows;
+    size_t m_block_cols;
+
+    SparseArray<size_t> m_offsets;
+    SparseArray<SparseIndex> m_indices;
+    SparseArray<T> m_values;
+  };
+
+  // Calls _function(begin, end) on chunks of the rows of a CSR or BSR matrix, in parallel,
+  // chunks hold about the same number of rows plus non-zeros, times _cost cycles
+  template <typename F>
+  void ForEachSparseRows(const size_t* _offsets, size_t _rows, const F& _function, size_t _cost = 1);
+}
+
+#include "math/sparse.inl"
+
+#endif
@@ -0,0 +1,514 @@
+// File Name:     sparse.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Sparse matrices in the COO, CSR and BSR formats
+
+#ifndef ENGINE_MATH_SPARSE_INL
+#define ENGINE_MATH_SPARSE_INL
+
+#include "math/sparse.hpp"
+
+#include "memory/linear/linear_heap.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+
+namespace mnt { namespace sparse_detail {
+
+  // Throws if the columns of a matrix can`t be told apart by SparseIndex
+  inline void CheckColumns(size_t _cols)
+  {
+    if (_cols > 0 && _cols - 1 > (size_t)std::numeric_limits<SparseIndex>::max())
+      MNT_THROW(("A sparse matrix of " + std::to_string(_cols) +
+                 " columns needs a wider TSPARSE_INDEX_TYPE").c_str());
+  };
+
+  // Rows and columns of a contiguous plain matrix
+  template <typename T>
+  inline void CheckDense(const Tensor<T>& _dense, size_t& _rows, size_t& _cols)
+  {
+    if (_dense.Rank() != 2 || _dense.MemoryLayout() != Layout::Plain)
+      MNT_THROW(("Shape " + _dense.ShapeStr() + " is not a plain matrix").c_str());
+
+    if (!_dense.IsContiguous())
+      MNT_THROW("Sparse matrices are built from contiguous tensors in linear storage");
+
+    _rows = _dense.Shape()[0];
+    _cols = _dense.Shape()[1];
+    CheckColumns(_cols);
+  };
+
+  template <typename T>
+  inline Tensor<T> Zeros(size_t _rows, size_t _cols)
+  {
+    Tensor<T> dense({(TSHAPE_TYPE)_rows, (TSHAPE_TYPE)_cols});
+    std::fill_n(dense.Data(), dense.Length(), T(0));
+    return dense;
+  }
+
+  // Turns counts in _offsets[1..rows] into offsets, returns the total
+  inline size_t Accumulate(size_t* _offsets, size_t _rows) noexcept
+  {
+    _offsets[0] = 0;
+    for (size_t i=0; i<_rows; i++)
+      _offsets[i + 1] += _offsets[i];
+
+    return _offsets[_rows];
+  };
+}}
+
+template <typename T>
+SparseArray<T>::SparseArray(size_t _length)
+{
+  if (_length == 0)
+    return;
+
+  // The allocation is in bytes
+  CheckedMul(_length, sizeof(T));
+
+  LinearHeapMemory<T>* memory = new LinearHeapMemory<T>(_length);
+  m_memory = MemoryRef<T>(memory);
+  m_data = memory->Data();
+  m_length = _length;
+}
+
+template <typename F>
+void mnt::ForEachSparseRows(const size_t* _offsets, size_t _rows, const F& _function, size_t _cost)
+{
+  if (_rows == 0)
+    return;
+
+  const size_t nnz = _offsets[_rows];
+
+  // Row i starts at key offsets[i] + i, a chunk of keys runs the rows that start in it,
+  // so empty rows and long rows weigh the same as their work
+  auto first_row = [&](size_t _key) noexcept
+  {
+    size_t low = 0, high = _rows;
+    while (low < high)
+    {
+      const size_t middle = (low + high) / 2;
+      if (_offsets[middle] + middle < _key)
+        low = middle + 1;
+      else
+        high = middle;
+    }
+    return low;
+  };
+
+  ParallelFor(0, nnz + _rows, [&](size_t _begin, size_t _end)
+  {
+    const size_t begin = first_row(_begin);
+    const size_t end = _end == nnz + _rows ? _rows : first_row(_end);
+    if (begin < end)
+      _function(begin, end);
+  }, _cost);
+}
+
+template <typename T>
+SparseCOO<T>::SparseCOO(size_t _rows, size_t _cols, size_t _nnz,
+                        const SparseIndex* _row_indices, const SparseIndex* _col_indices, const T* _values)
+  : m_rows(_rows), m_cols(_cols), m_row_indices(_nnz), m_col_indices(_nnz), m_values(_nnz)
+{
+  for (size_t p=0; p<_nnz; p++)
+    if (_row_indices[p] >= _rows || _col_indices[p] >= _cols)
+      MNT_THROW(("Non-zero (" + std::to_string(_row_indices[p]) + ", " + std::to_string(_col_indices[p]) +
+                 ") is out of a matrix of " + std::to_string(_rows) + " x " + std::to_string(_cols)).c_str());
+
+  std::copy_n(_row_indices, _nnz, m_row_indices.Data());
+  std::copy_n(_col_indices, _nnz, m_col_indices.Data());
+  std::copy_n(_values, _nnz, m_values.Data());
+}
+
+template <typename T>
+SparseCOO<T>::SparseCOO(Tensor<T>& _dense) : SparseCOO(SparseCSR<T>(_dense))
+{
+}
+
+template <typename T>
+SparseCOO<T>::SparseCOO(const SparseCSR<T>& _csr)
+  : m_rows(_csr.Rows()), m_cols(_csr.Cols()),
+    m_row_indices(_csr.NonZeros()), m_col_indices(_csr.NonZeros()), m_values(_csr.NonZeros())
+{
+  const size_t* offsets = _csr.Offsets();
+
+  std::copy_n(_csr.Indices(), NonZeros(), m_col_indices.Data());
+  std::copy_n(_csr.Values(), NonZeros(), m_values.Data());
+
+  ForEachSparseRows(offsets, m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      std::fill(m_row_indices.Data() + offsets[i], m_row_indices.Data() + offsets[i + 1], (SparseIndex)i);
+  });
+}
+
+// Duplicates are added up, like the conversion to CSR
+template <typename T>
+Tensor<T> SparseCOO<T>::ToDense() const
+{
+  Tensor<T> dense = sparse_detail::Zeros<T>(m_rows, m_cols);
+  T* data = dense.Data();
+
+  for (size_t p=0; p<NonZeros(); p++)
+    data[(size_t)m_row_indices[p] * m_cols + m_col_indices[p]] += m_values[p];
+
+  return dense;
+}
+
+template <typename T>
+SparseCSR<T>::SparseCSR(size_t _rows, size_t _cols, SparseArray<size_t> _offsets,
+                        SparseArray<SparseIndex> _indices, SparseArray<T> _values)
+  : m_rows(_rows), m_cols(_cols),
+    m_offsets(std::move(_offsets)), m_indices(std::move(_indices)), m_values(std::move(_values))
+{
+  if (m_offsets.Length() != _rows + 1 || m_offsets[_rows] != m_indices.Length() ||
+      m_indices.Length() != m_values.Length())
+    MNT_THROW("The arrays of a CSR matrix don`t match its rows and non-zeros");
+}
+
+template <typename T>
+SparseCSR<T>::SparseCSR(const SparseCSR& _structure, SparseArray<T> _values)
+  : m_rows(_structure.m_rows), m_cols(_structure.m_cols),
+    m_offsets(_structure.m_offsets), m_indices(_structure.m_indices), m_values(std::move(_values))
+{
+  if (m_values.Length() != m_indices.Length())
+    MNT_THROW(("A CSR matrix of " + std::to_string(m_indices.Length()) + " non-zeros can`t take " +
+               std::to_string(m_values.Length()) + " values").c_str());
+}
+
+template <typename T>
+SparseCSR<T>::SparseCSR(Tensor<T>& _dense)
+{
+  sparse_detail::CheckDense(_dense, m_rows, m_cols);
+
+  const T* data = _dense.Data();
+  m_offsets = SparseArray<size_t>(m_rows + 1);
+  size_t* offsets = m_offsets.Data();
+
+  // Counts the non-zeros of every row, then writes them at the offsets
+  ParallelFor(0, m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      offsets[i + 1] = (size_t)std::count_if(data + i * m_cols, data + (i + 1) * m_cols,
+                                             [](const T& _x) {return !(_x == T(0));});
+  }, m_cols);
+
+  const size_t nnz = sparse_detail::Accumulate(offsets, m_rows);
+  m_indices = SparseArray<SparseIndex>(nnz);
+  m_values = SparseArray<T>(nnz);
+
+  ParallelFor(0, m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t p = offsets[i];
+      for (size_t j=0; j<m_cols; j++)
+        if (!(data[i * m_cols + j] == T(0)))
+        {
+          m_indices[p] = (SparseIndex)j;
+          m_values[p++] = data[i * m_cols + j];
+        }
+    }
+  }, m_cols);
+}
+
+// Non-zeros are bucketed by row with a counting sort, every row is sorted by column and
+// its duplicates are added up
+template <typename T>
+SparseCSR<T>::SparseCSR(const SparseCOO<T>& _coo) : m_rows(_coo.Rows()), m_cols(_coo.Cols())
+{
+  sparse_detail::CheckColumns(m_cols);
+
+  const size_t nnz = _coo.NonZeros();
+  const SparseIndex* rows = _coo.RowIndices();
+  const SparseIndex* cols = _coo.ColIndices();
+  const T* values = _coo.Values();
+
+  std::vector<size_t> buckets(m_rows + 1, 0);
+  for (size_t p=0; p<nnz; p++)
+    buckets[rows[p] + 1]++;
+  sparse_detail::Accumulate(buckets.data(), m_rows);
+
+  std::vector<size_t> order(nnz);
+  std::vector<size_t> next(buckets.begin(), buckets.end() - 1);
+  for (size_t p=0; p<nnz; p++)
+    order[next[rows[p]]++] = p;
+
+  m_offsets = SparseArray<size_t>(m_rows + 1);
+  size_t* offsets = m_offsets.Data();
+
+  // Equal columns keep the order of the input, so the sums don`t depend on the threads
+  ForEachSparseRows(buckets.data(), m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      std::sort(order.data() + buckets[i], order.data() + buckets[i + 1], [&](size_t _a, size_t _b)
+      {
+        return cols[_a] < cols[_b] || (cols[_a] == cols[_b] && _a < _b);
+      });
+
+      size_t count = 0;
+      for (size_t q=buckets[i]; q<buckets[i + 1]; q++)
+        if (q == buckets[i] || cols[order[q]] != cols[order[q - 1]])
+          count++;
+      offsets[i + 1] = count;
+    }
+  }, 8);
+
+  const size_t unique = sparse_detail::Accumulate(offsets, m_rows);
+  m_indices = SparseArray<SparseIndex>(unique);
+  m_values = SparseArray<T>(unique);
+
+  ForEachSparseRows(buckets.data(), m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t p = offsets[i];
+      for (size_t q=buckets[i]; q<buckets[i + 1]; q++)
+      {
+        if (q == buckets[i] || cols[order[q]] != cols[order[q - 1]])
+        {
+          m_indices[p] = cols[order[q]];
+          m_values[p++] = values[order[q]];
+        }
+        else
+        {
+          m_values[p - 1] += values[order[q]];
+        }
+      }
+    }
+  });
+}
+
+// Items equal to zero inside the blocks are dropped
+template <typename T>
+SparseCSR<T>::SparseCSR(const SparseBSR<T>& _bsr) : m_rows(_bsr.Rows()), m_cols(_bsr.Cols())
+{
+  const size_t br = _bsr.BlockRows();
+  const size_t bc = _bsr.BlockCols();
+  const size_t* block_offsets = _bsr.Offsets();
+  const SparseIndex* block_indices = _bsr.Indices();
+  const T* blocks = _bsr.Values();
+
+  m_offsets = SparseArray<size_t>(m_rows + 1);
+  size_t* offsets = m_offsets.Data();
+
+  const size_t cost = _bsr.NonZeroBlocks() * br * bc / std::max<size_t>(m_rows, 1) + 1;
+
+  auto for_each_item = [&](size_t _row, const auto& _function)
+  {
+    const size_t block_row = _row / br;
+    for (size_t p=block_offsets[block_row]; p<block_offsets[block_row + 1]; p++)
+    {
+      const T* row = blocks + (p * br + _row % br) * bc;
+      for (size_t j=0; j<bc; j++)
+        if (!(row[j] == T(0)))
+          _function((size_t)block_indices[p] * bc + j, row[j]);
+    }
+  };
+
+  ParallelFor(0, m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t count = 0;
+      for_each_item(i, [&](size_t, const T&) {count++;});
+      offsets[i + 1] = count;
+    }
+  }, cost);
+
+  const size_t nnz = sparse_detail::Accumulate(offsets, m_rows);
+  m_indices = SparseArray<SparseIndex>(nnz);
+  m_values = SparseArray<T>(nnz);
+
+  ParallelFor(0, m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t p = offsets[i];
+      for_each_item(i, [&](size_t _col, const T& _value)
+      {
+        m_indices[p] = (SparseIndex)_col;
+        m_values[p++] = _value;
+      });
+    }
+  }, cost);
+}
+
+template <typename T>
+Tensor<T> SparseCSR<T>::ToDense() const
+{
+  Tensor<T> dense = sparse_detail::Zeros<T>(m_rows, m_cols);
+  T* data = dense.Data();
+
+  ForEachSparseRows(Offsets(), m_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      for (size_t p=m_offsets[i]; p<m_offsets[i + 1]; p++)
+        data[i * m_cols + m_indices[p]] = m_values[p];
+  });
+
+  return dense;
+}
+
+template <typename T>
+template <typename F>
+size_t SparseBSR<T>::Structure(size_t _rows, size_t _cols, const F& _no_of_blocks, size_t _cost)
+{
+  if (m_block_rows == 0 || m_block_cols == 0 || _rows % m_block_rows != 0 || _cols % m_block_cols != 0)
+    MNT_THROW(("A matrix of " + std::to_string(_rows) + " x " + std::to_string(_cols) +
+               " can`t be split in blocks of " + std::to_string(m_block_rows) + " x " +
+               std::to_string(m_block_cols)).c_str());
+
+  m_rows = _rows;
+  m_cols = _cols;
+  sparse_detail::CheckColumns(_cols / m_block_cols);
+
+  const size_t block_rows = _rows / m_block_rows;
+  m_offsets = SparseArray<size_t>(block_rows + 1);
+
+  ParallelFor(0, block_rows, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      m_offsets[i + 1] = _no_of_blocks(i);
+  }, _cost);
+
+  const size_t blocks = sparse_detail::Accumulate(m_offsets.Data(), block_rows);
+  m_indices = SparseArray<SparseIndex>(blocks);
+  m_values = SparseArray<T>(CheckedMul(blocks, m_block_rows * m_block_cols));
+
+  return blocks;
+}
+
+template <typename T>
+SparseBSR<T>::SparseBSR(Tensor<T>& _dense, size_t _block_rows, size_t _block_cols)
+  : m_block_rows(_block_rows), m_block_cols(_block_cols)
+{
+  size_t rows, cols;
+  sparse_detail::CheckDense(_dense, rows, cols);
+
+  const T* data = _dense.Data();
+  const size_t br = _block_rows;
+  const size_t bc = _block_cols;
+
+  auto has_non_zeros = [&](size_t _block_row, size_t _block_col)
+  {
+    for (size_t r=0; r<br; r++)
+    {
+      const T* row = data + (_block_row * br + r) * cols + _block_col * bc;
+      if (std::any_of(row, row + bc, [](const T& _x) {return !(_x == T(0));}))
+        return true;
+    }
+    return false;
+  };
+
+  Structure(rows, cols, [&](size_t _block_row)
+  {
+    size_t count = 0;
+    for (size_t jb=0; jb<cols / bc; jb++)
+      count += has_non_zeros(_block_row, jb);
+    return count;
+  }, br * cols);
+
+  ParallelFor(0, rows / br, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+    {
+      size_t p = m_offsets[i];
+      for (size_t jb=0; jb<cols / bc; jb++)
+      {
+        if (!has_non_zeros(i, jb))
+          continue;
+
+        m_indices[p] = (SparseIndex)jb;
+        for (size_t r=0; r<br; r++)
+          std::copy_n(data + (i * br + r) * cols + jb * bc, bc, m_values.Data() + (p * br + r) * bc);
+        p++;
+      }
+    }
+  }, br * cols);
+}
+
+template <typename T>
+SparseBSR<T>::SparseBSR(const SparseCSR<T>& _csr, size_t _block_rows, size_t _block_cols)
+  : m_block_rows(_block_rows), m_block_cols(_block_cols)
+{
+  const size_t* offsets = _csr.Offsets();
+  const SparseIndex* indices = _csr.Indices();
+  const T* values = _csr.Values();
+  const size_t br = _block_rows;
+  const size_t bc = _block_cols;
+
+  // Sorted block columns with a non-zero in a block row
+  auto block_columns = [&](size_t _block_row, std::vector<SparseIndex>& _columns)
+  {
+    _columns.clear();
+    for (size_t i=_block_row * br; i<(_block_row + 1) * br; i++)
+      for (size_t p=offsets[i]; p<offsets[i + 1]; p++)
+        _columns.push_back((SparseIndex)(indices[p] / bc));
+
+    std::sort(_columns.begin(), _columns.end());
+    _columns.erase(std::unique(_columns.begin(), _columns.end()), _columns.end());
+  };
+
+  const size_t cost = _csr.NonZeros() / std::max<size_t>(_csr.Rows(), 1) * br + 1;
+
+  Structure(_csr.Rows(), _csr.Cols(), [&](size_t _block_row)
+  {
+    thread_local std::vector<SparseIndex> columns;
+    block_columns(_block_row, columns);
+    return columns.size();
+  }, cost);
+
+  ParallelFor(0, m_rows / br, [&](size_t _begin, size_t _end)
+  {
+    std::vector<SparseIndex> columns;
+    for (size_t i=_begin; i<_end; i++)
+    {
+      block_columns(i, columns);
+      std::copy(columns.begin(), columns.end(), m_indices.Data() + m_offsets[i]);
+      std::fill(m_values.Data() + m_offsets[i] * br * bc, m_values.Data() + m_offsets[i + 1] * br * bc, T(0));
+
+      // Rows are sorted by column, so the block of every non-zero is found by walking the blocks once
+      for (size_t r=0; r<br; r++)
+      {
+        size_t q = m_offsets[i];
+        for (size_t p=offsets[i * br + r]; p<offsets[i * br + r + 1]; p++)
+        {
+          while (m_indices[q] != indices[p] / bc)
+            q++;
+          m_values[(q * br + r) * bc + indices[p] % bc] = values[p];
+        }
+      }
+    }
+  }, cost);
+}
+
+template <typename T>
+Tensor<T> SparseBSR<T>::ToDense() const
+{
+  Tensor<T> dense = sparse_detail::Zeros<T>(m_rows, m_cols);
+  T* data = dense.Data();
+  const size_t br = m_block_rows;
+  const size_t bc = m_block_cols;
+
+  ForEachSparseRows(Offsets(), m_rows / br, [&](size_t _begin, size_t _end)
+  {
+    for (size_t i=_begin; i<_end; i++)
+      for (size_t p=m_offsets[i]; p<m_offsets[i + 1]; p++)
+        for (size_t r=0; r<br; r++)
+          std::copy_n(m_values.Data() + (p * br + r) * bc, bc, data + (i * br + r) * m_cols + m_indices[p] * bc);
+  }, br * bc);
+
+  return dense;
+}
+
+#endif
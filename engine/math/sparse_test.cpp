@@ -0,0 +1,259 @@
+// File Name:     sparse_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the sparse matrices and their ops on every instruction set
+
+// ---------------------
+// Detail Description:
+// Every sparse matrix is built from a dense one with a share of its items set to zero, whole
+// rows and blocks included, and every op is compared with the naive loop of its dense
+// operands. The widths of the dense operands leave partial vectors, so the tails of the SpMM
+// kernels run as well.
+// ---------------------
+
+#include "math/backends/default.hpp"
+#include "math/test_utils.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  // A random matrix with items set to zero with the probability 1 - _density, and the row _empty_row
+  template <typename T>
+  Tensor<T> Sparse(size_t _rows, size_t _cols, double _density, uint32_t _seed, size_t _empty_row = SIZE_MAX)
+  {
+    Tensor<T> tensor({(TSHAPE_TYPE)_rows, (TSHAPE_TYPE)_cols});
+    Fill(tensor, _seed);
+
+    std::mt19937 generator(_seed + 1000);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (size_t i=0; i<_rows; i++)
+      for (size_t j=0; j<_cols; j++)
+        if (uniform(generator) >= _density || i == _empty_row)
+          tensor[i * _cols + j] = T(0);
+
+    return tensor;
+  }
+
+  template <typename T>
+  std::vector<double> Items(const Tensor<T>& _tensor)
+  {
+    return std::vector<double>(_tensor.Data(), _tensor.Data() + _tensor.Length());
+  }
+
+  template <typename T>
+  std::vector<double> NaiveMatMul(const Tensor<T>& _tensor_1, const Tensor<T>& _tensor_2)
+  {
+    const size_t m = _tensor_1.Shape()[0], k = _tensor_1.Shape()[1], n = _tensor_2.Shape()[1];
+    std::vector<double> output(m * n, 0.0);
+
+    for (size_t i=0; i<m; i++)
+      for (size_t p=0; p<k; p++)
+        for (size_t j=0; j<n; j++)
+          output[i * n + j] += (double)_tensor_1.Data()[i * k + p] * (double)_tensor_2.Data()[p * n + j];
+
+    return output;
+  }
+
+  template <typename T>
+  void CheckFormats(Checks& _checks, const std::string& _type)
+  {
+    Tensor<T> dense = Sparse<T>(23, 17, 0.2, 1, 5);
+
+    size_t non_zeros = 0;
+    for (size_t i=0; i<dense.Length(); i++)
+      non_zeros += dense[i] != T(0);
+
+    SparseCSR<T> csr(dense);
+    SparseCOO<T> coo(dense);
+    SparseCOO<T> coo_of_csr(csr);
+    SparseCSR<T> csr_of_coo(coo);
+
+    _checks.Expect(csr.NonZeros() == non_zeros && coo.NonZeros() == non_zeros,
+                   _type + " sparse matrices store " + std::to_string(csr.NonZeros()) + " non-zeros");
+    _checks.Expect(csr.Offsets()[6] == csr.Offsets()[5], _type + " CSR of an empty row");
+    _checks.Items(csr.ToDense(), Items(dense), 0.0, _type + " CSR of a dense matrix");
+    _checks.Items(coo.ToDense(), Items(dense), 0.0, _type + " COO of a dense matrix");
+    _checks.Items(coo_of_csr.ToDense(), Items(dense), 0.0, _type + " COO of a CSR matrix");
+    _checks.Items(csr_of_coo.ToDense(), Items(dense), 0.0, _type + " CSR of a COO matrix");
+
+    // Unsorted non-zeros with a duplicate, which the conversion to CSR adds up
+    const SparseIndex rows[] = {2, 0, 2, 1, 2};
+    const SparseIndex cols[] = {3, 1, 0, 1, 3};
+    const T values[] = {T(1), T(2), T(3), T(4), T(5)};
+    SparseCOO<T> unsorted(3, 4, 5, rows, cols, values);
+    SparseCSR<T> summed(unsorted);
+
+    _checks.Expect(summed.NonZeros() == 4, _type + " CSR keeps " + std::to_string(summed.NonZeros()) +
+                                           " non-zeros of a duplicate");
+    _checks.Items(summed.ToDense(), {0, 2, 0, 0, 0, 4, 0, 0, 3, 0, 0, 6}, 0.0, _type + " CSR of unsorted duplicates");
+
+    const SparseIndex outside[] = {0, 4};
+    _checks.Throws([&]() {SparseCOO<T> wrong(3, 4, 2, rows, outside, values);}, _type + " COO of a column out of the matrix");
+    _checks.Throws([&]() {SparseCOO<T> wrong(2, 4, 2, rows, cols, values);}, _type + " COO of a row out of the matrix");
+
+    Tensor<T> vector({7});
+    _checks.Throws([&]() {SparseCSR<T> wrong(vector);}, _type + " CSR of a vector");
+
+    // BSR of blocks that fill the matrix, of blocks of a single row or item, and of empty blocks
+    const size_t blocks[][2] = {{4, 4}, {2, 8}, {1, 1}, {8, 3}};
+    for (const auto& block : blocks)
+    {
+      Tensor<T> matrix = Sparse<T>(16, 24, 0.05, 2, 3);
+      SparseCSR<T> matrix_csr(matrix);
+      SparseBSR<T> bsr(matrix, block[0], block[1]);
+      SparseBSR<T> bsr_of_csr(matrix_csr, block[0], block[1]);
+      SparseCSR<T> csr_of_bsr(bsr);
+
+      const std::string what = _type + " BSR of blocks " + std::to_string(block[0]) + "x" + std::to_string(block[1]);
+      _checks.Items(bsr.ToDense(), Items(matrix), 0.0, what);
+      _checks.Items(bsr_of_csr.ToDense(), Items(matrix), 0.0, what + " of a CSR matrix");
+      _checks.Items(csr_of_bsr.ToDense(), Items(matrix), 0.0, "CSR of a " + what);
+      _checks.Expect(bsr.NonZeroBlocks() == bsr_of_csr.NonZeroBlocks(), what + " keeps other blocks of a CSR matrix");
+    }
+
+    // Shapes that don`t divide by the block size
+    Tensor<T> uneven = Sparse<T>(10, 12, 0.5, 3);
+    SparseCSR<T> uneven_csr(uneven);
+    _checks.Throws([&]() {SparseBSR<T> wrong(uneven, 4, 4);}, _type + " BSR of 10 rows in blocks of 4");
+    _checks.Throws([&]() {SparseBSR<T> wrong(uneven, 5, 8);}, _type + " BSR of 12 columns in blocks of 8");
+    _checks.Throws([&]() {SparseBSR<T> wrong(uneven_csr, 3, 3);}, _type + " BSR of a CSR matrix of 10 rows in blocks of 3");
+    _checks.Throws([&]() {SparseBSR<T> wrong(uneven, 0, 2);}, _type + " BSR of empty blocks");
+  }
+
+  template <typename T>
+  void CheckProducts(Checks& _checks, const std::string& _type)
+  {
+    DefaultBackend<T> backend;
+
+    for (const size_t n : {1, 7, 16, 64, 130})
+    {
+      Tensor<T> sparse = Sparse<T>(48, 40, 0.15, 4, 7);
+      Tensor<T> dense = Sparse<T>(40, n, 1.0, 5);
+      const std::vector<double> expected = NaiveMatMul(sparse, dense);
+      const std::string what = " of " + std::to_string(n) + " columns";
+
+      SparseCSR<T> csr(sparse);
+      _checks.Items(backend.SpMM(csr, dense), expected, 1e-5, _type + " SpMM CSR" + what);
+
+      SparseBSR<T> bsr_4(sparse, 4, 4);
+      SparseBSR<T> bsr_8(sparse, 8, 2);
+      _checks.Items(backend.SpMM(bsr_4, dense), expected, 1e-5, _type + " SpMM BSR 4x4" + what);
+      _checks.Items(backend.SpMM(bsr_8, dense), expected, 1e-5, _type + " SpMM BSR 8x2" + what);
+    }
+
+    // The non-zeros of the pattern times the rows of _a by the rows of _b
+    Tensor<T> pattern = Sparse<T>(31, 45, 0.2, 6, 0);
+    Tensor<T> a = Sparse<T>(31, 19, 1.0, 7);
+    Tensor<T> b = Sparse<T>(45, 19, 1.0, 8);
+    SparseCSR<T> pattern_csr(pattern);
+    SparseCSR<T> sampled = backend.SDDMM(pattern_csr, a, b);
+
+    std::vector<double> expected(31 * 45, 0.0);
+    for (size_t i=0; i<31; i++)
+      for (size_t j=0; j<45; j++)
+        if (pattern[i * 45 + j] != T(0))
+        {
+          double sum = 0.0;
+          for (size_t p=0; p<19; p++)
+            sum += (double)a[i * 19 + p] * (double)b[j * 19 + p];
+          expected[i * 45 + j] = (double)pattern[i * 45 + j] * sum;
+        }
+
+    _checks.Expect(sampled.Offsets() == pattern_csr.Offsets() && sampled.Indices() == pattern_csr.Indices(),
+                   _type + " SDDMM doesn`t share the structure of the pattern");
+    _checks.Items(sampled.ToDense(), expected, 1e-5, _type + " SDDMM");
+
+    Tensor<T> wrong_rows = Sparse<T>(41, 5, 1.0, 9);
+    Tensor<T> wrong_depth = Sparse<T>(45, 18, 1.0, 9);
+    SparseCSR<T> csr(pattern);
+    Tensor<T> blocked = Sparse<T>(32, 40, 0.2, 9);
+    SparseBSR<T> bsr(blocked, 4, 4);
+    _checks.Throws([&]() {backend.SpMM(csr, wrong_rows);}, _type + " SpMM CSR of another depth");
+    _checks.Throws([&]() {backend.SpMM(bsr, wrong_rows);}, _type + " SpMM BSR of another depth");
+    _checks.Throws([&]() {backend.SDDMM(pattern_csr, a, wrong_depth);}, _type + " SDDMM of another depth");
+    _checks.Throws([&]() {backend.SDDMM(pattern_csr, wrong_rows, b);}, _type + " SDDMM of other rows");
+  }
+
+  template <typename T>
+  void CheckElementwise(Checks& _checks, const std::string& _type)
+  {
+    DefaultBackend<T> backend;
+
+    Tensor<T> dense_1 = Sparse<T>(29, 33, 0.3, 10, 2);
+    Tensor<T> dense_2 = Sparse<T>(29, 33, 0.3, 11, 4);
+    Tensor<T> dense = Sparse<T>(29, 33, 1.0, 12);
+
+    // Shared non-zeros that cancel, a - a is a stored zero
+    for (size_t j=0; j<33; j++)
+      dense_2[8 * 33 + j] = dense_1[8 * 33 + j];
+
+    SparseCSR<T> sparse_1(dense_1);
+    SparseCSR<T> sparse_2(dense_2);
+
+    std::vector<double> sum(dense_1.Length()), difference(dense_1.Length());
+    std::vector<double> product(dense_1.Length()), masked(dense_1.Length());
+
+    for (size_t i=0; i<dense_1.Length(); i++)
+    {
+      sum[i] = (double)dense_1[i] + (double)dense_2[i];
+      difference[i] = (double)dense_1[i] - (double)dense_2[i];
+      product[i] = (double)dense_1[i] * (double)dense_2[i];
+      masked[i] = (double)dense_1[i] * (double)dense[i];
+    }
+
+    SparseCSR<T> added = backend.Add(sparse_1, sparse_2);
+    SparseCSR<T> subtracted = backend.Sub(sparse_1, sparse_2);
+    SparseCSR<T> multiplied = backend.Mul(sparse_1, sparse_2);
+    SparseCSR<T> multiplied_dense = backend.Mul(sparse_1, dense);
+
+    _checks.Items(added.ToDense(), sum, 1e-6, _type + " sparse Add");
+    _checks.Items(subtracted.ToDense(), difference, 1e-6, _type + " sparse Sub");
+    _checks.Items(multiplied.ToDense(), product, 1e-6, _type + " sparse Mul");
+    _checks.Items(multiplied_dense.ToDense(), masked, 1e-6, _type + " sparse Mul of a dense matrix");
+
+    // The union, the intersection and the non-zeros of the sparse operand
+    size_t either = 0, both = 0;
+    for (size_t i=0; i<dense_1.Length(); i++)
+    {
+      either += dense_1[i] != T(0) || dense_2[i] != T(0);
+      both += dense_1[i] != T(0) && dense_2[i] != T(0);
+    }
+
+    _checks.Expect(added.NonZeros() == either && subtracted.NonZeros() == either,
+                   _type + " sparse Add and Sub keep " + std::to_string(added.NonZeros()) + " non-zeros");
+    _checks.Expect(multiplied.NonZeros() == both, _type + " sparse Mul keeps " + std::to_string(multiplied.NonZeros()) +
+                                                  " non-zeros");
+    _checks.Expect(multiplied_dense.NonZeros() == sparse_1.NonZeros(), _type + " sparse Mul of a dense matrix keeps " +
+                                                                       std::to_string(multiplied_dense.NonZeros()));
+
+    Tensor<T> other_shape = Sparse<T>(29, 32, 0.3, 13);
+    SparseCSR<T> other(other_shape);
+    _checks.Throws([&]() {backend.Add(sparse_1, other);}, _type + " sparse Add of another shape");
+    _checks.Throws([&]() {backend.Mul(sparse_1, other);}, _type + " sparse Mul of another shape");
+    _checks.Throws([&]() {backend.Mul(sparse_1, other_shape);}, _type + " sparse Mul of a dense matrix of another shape");
+  }
+}
+
+int main(int, char** _argv)
+{
+  return RunOnEveryISA(_argv[0], []()
+  {
+    Checks checks;
+
+    CheckFormats<float>(checks, "float");
+    CheckFormats<double>(checks, "double");
+    CheckProducts<float>(checks, "float");
+    CheckProducts<double>(checks, "double");
+    CheckElementwise<float>(checks, "float");
+    CheckElementwise<double>(checks, "double");
+
+    return checks.Failures();
+  });
+}
@@ -0,0 +1,44 @@
+// File Name:     static_kernels.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime binding of the kernels whose sizes are known at compile time
+
+// ---------------------
+// Detail Description:
+// The kernels of "math/kernels/small.inl" are templates, one function per size and instruction
+// set, so they can`t be listed in KernelTable. Every size binds the variant of the active
+// instruction set at its first call and keeps it for the lifetime of the process, like
+// KernelRegistry does, so a call costs a single indirect call and nothing is allocated.
+// ---------------------
+
+// ---------------------
+// Note:
+// The kernels are meant for sizes up to ~16, the accumulators of larger ones don`t fit in
+// the registers, use "Gemm::Run" for them
+// ---------------------
+
+// =====
+// [MatMul<M, K, N>(_a, _b, _c, _accumulate)]: C[M x N] = A[M x K] * B[K x N] (+ C), all of
+// them row-major and contiguous, C must not overlap A or B
+// =====
+
+#ifndef ENGINE_MATH_STATIC_KERNELS_HPP
+#define ENGINE_MATH_STATIC_KERNELS_HPP
+
+#include "math/kernels/registry.hpp"
+
+#include <cstddef>
+
+namespace mnt {
+
+  class StaticKernels
+  {
+  public:
+    template <size_t M, size_t K, size_t N>
+    static void MatMul(const float* _a, const float* _b, float* _c, bool _accumulate = false) noexcept;
+  };
+}
+
+#include "math/static_kernels.inl"
+
+#endif
@@ -0,0 +1,40 @@
+// File Name:     static_kernels.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime binding of the kernels whose sizes are known at compile time
+
+#ifndef ENGINE_MATH_STATIC_KERNELS_INL
+#define ENGINE_MATH_STATIC_KERNELS_INL
+
+#include "math/static_kernels.hpp"
+#include "math/kernels/variants.hpp"
+
+using namespace mnt;
+
+template <size_t M, size_t K, size_t N>
+void StaticKernels::MatMul(const float* _a, const float* _b, float* _c, bool _accumulate) noexcept
+{
+  static_assert(M > 0 && K > 0 && N > 0, "Empty matrices have no kernel");
+
+  using Kernel = void (*)(const float*, const float*, float*, bool) noexcept;
+
+  // Bound once per size, in a thread safe manner
+  static const Kernel kernel = []() noexcept -> Kernel
+  {
+    switch (KernelRegistry::Get().isa)
+    {
+#if defined(MNT_SIMD_X86)
+    case ISA::SSE4:   return &kernels::sse4::SmallMatMulF32<M, K, N>;
+    case ISA::AVX2:   return &kernels::avx2::SmallMatMulF32<M, K, N>;
+    case ISA::AVX512: return &kernels::avx512::SmallMatMulF32<M, K, N>;
+#elif defined(MNT_SIMD_NEON)
+    case ISA::NEON:   return &kernels::neon::SmallMatMulF32<M, K, N>;
+#endif
+    default:          return &kernels::generic::SmallMatMulF32<M, K, N>;
+    }
+  }();
+
+  kernel(_a, _b, _c, _accumulate);
+}
+
+#endif
@@ -0,0 +1,118 @@
+// File Name:     static_tensor.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Tensors with a shape known at compile time, stored inline
+
+// ---------------------
+// Detail Description:
+// StaticTensor<T, DIMS...> holds its items in a plain array member, row-major, so it lives
+// on the stack or inside another object, and creating, copying or destroying one never
+// touches the heap. Its shape, strides and length are compile time constants, and the
+// operations below are unrolled for the exact size, the float products go through the fixed
+// size kernels of "math/static_kernels.hpp". Meant for the small matrices of transforms,
+// rotations, filters, etc. where a Tensor would cost more than the math.
+// ---------------------
+
+// ---------------------
+// Note:
+// Tensors larger than 64 bytes are aligned to a cache line, the smaller ones to their type
+// ---------------------
+
+// =====
+// [StaticTensor(_items)]: Fills the tensor in row-major order, the items that are not given
+// are zero, more items than Length() throw
+// =====
+
+// =====
+// [StaticTensor(_tensor)]: Copies a plain tensor of the same shape, or a view of one
+// =====
+
+// =====
+// [operator () (_indices...)]: Item at the given index of every axis, no bounds checks
+// =====
+
+// =====
+// [ToTensor()]: A heap allocated copy, for the operations of Backend
+// =====
+
+// =====
+// [MatMul(_a, _b)]: Matrix product of two tensors of rank 2
+// =====
+
+// =====
+// [Add/Sub/Mul(_a, _b)]: Item by item, same shape only
+// =====
+
+#ifndef ENGINE_MATH_STATIC_TENSOR_HPP
+#define ENGINE_MATH_STATIC_TENSOR_HPP
+
+#include "configs.hpp"
+
+#include "math/tensor.hpp"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+namespace mnt {
+
+  template <typename T, size_t... DIMS>
+  class StaticTensor
+  {
+    static_assert(sizeof...(DIMS) > 0, "StaticTensor needs at least one axis");
+
+  public:
+    static constexpr size_t rank = sizeof...(DIMS);
+    static constexpr size_t length = (DIMS * ...);
+    static constexpr size_t alignment = length * sizeof(T) >= 64 ? 64 : alignof(T);
+
+  public:
+    // All items are zero
+    StaticTensor() noexcept;
+    StaticTensor(std::initializer_list<T> _items);
+    explicit StaticTensor(Tensor<T>& _tensor);
+
+    T& operator [] (const size_t _index) noexcept;
+    const T& operator [] (const size_t _index) const noexcept;
+
+    template <typename... INDICES>
+    T& operator () (const INDICES... _indices) noexcept;
+    template <typename... INDICES>
+    const T& operator () (const INDICES... _indices) const noexcept;
+
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+
+    static constexpr size_t Length() noexcept;
+    static constexpr size_t Rank() noexcept;
+    static constexpr std::array<TSHAPE_TYPE, rank> Shape() noexcept;
+    static constexpr std::array<size_t, rank> Strides() noexcept;
+
+    Tensor<T> ToTensor() const;
+
+  private:
+    template <typename... INDICES>
+    static constexpr size_t Offset(const INDICES... _indices) noexcept;
+
+  private:
+    alignas(alignment) T m_data[length];
+  };
+
+  template <typename T, size_t M, size_t K, size_t N>
+  StaticTensor<T, M, N> MatMul(const StaticTensor<T, M, K>& _a, const StaticTensor<T, K, N>& _b) noexcept;
+
+  // Swaps the two axes
+  template <typename T, size_t ROWS, size_t COLS>
+  StaticTensor<T, COLS, ROWS> Transpose(const StaticTensor<T, ROWS, COLS>& _a) noexcept;
+
+  template <typename T, size_t... DIMS>
+  StaticTensor<T, DIMS...> Add(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept;
+  template <typename T, size_t... DIMS>
+  StaticTensor<T, DIMS...> Sub(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept;
+  template <typename T, size_t... DIMS>
+  StaticTensor<T, DIMS...> Mul(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept;
+}
+
+#include "math/static_tensor.inl"
+
+#endif
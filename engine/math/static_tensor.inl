@@ -0,0 +1,213 @@
+// File Name:     static_tensor.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Tensors with a shape known at compile time, stored inline
+
+#ifndef ENGINE_MATH_STATIC_TENSOR_INL
+#define ENGINE_MATH_STATIC_TENSOR_INL
+
+#include "math/static_tensor.hpp"
+#include "math/static_kernels.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+using namespace mnt;
+
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...>::StaticTensor() noexcept : m_data{}
+{
+}
+
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...>::StaticTensor(std::initializer_list<T> _items) : m_data{}
+{
+  if (_items.size() > length)
+    MNT_THROW("Too many items for the shape of the StaticTensor");
+
+  std::copy(_items.begin(), _items.end(), m_data);
+}
+
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...>::StaticTensor(Tensor<T>& _tensor)
+{
+  if (_tensor.MemoryLayout() != Layout::Plain || _tensor.Rank() != rank)
+    MNT_THROW("StaticTensor needs a plain tensor of the same rank");
+
+  const TensorShape& shape = _tensor.Shape();
+  for (size_t axis=0; axis<rank; axis++)
+    if (shape[axis] != Shape()[axis])
+      MNT_THROW("StaticTensor needs a tensor of the same shape");
+
+  // Views are gathered item by item
+  const TensorStrides strides = _tensor.Strides();
+  const T* src = _tensor.Data();
+
+  for (size_t i=0; i<length; i++)
+  {
+    size_t offset = 0;
+    size_t rest = i;
+    for (size_t axis=rank; axis-- > 0;)
+    {
+      offset += rest % shape[axis] * strides[axis];
+      rest /= shape[axis];
+    }
+    m_data[i] = src[offset];
+  }
+}
+
+template <typename T, size_t... DIMS>
+T& StaticTensor<T, DIMS...>::operator [] (const size_t _index) noexcept
+{
+  return m_data[_index];
+}
+
+template <typename T, size_t... DIMS>
+const T& StaticTensor<T, DIMS...>::operator [] (const size_t _index) const noexcept
+{
+  return m_data[_index];
+}
+
+template <typename T, size_t... DIMS>
+template <typename... INDICES>
+T& StaticTensor<T, DIMS...>::operator () (const INDICES... _indices) noexcept
+{
+  return m_data[Offset(_indices...)];
+}
+
+template <typename T, size_t... DIMS>
+template <typename... INDICES>
+const T& StaticTensor<T, DIMS...>::operator () (const INDICES... _indices) const noexcept
+{
+  return m_data[Offset(_indices...)];
+}
+
+template <typename T, size_t... DIMS>
+T* StaticTensor<T, DIMS...>::Data() noexcept
+{
+  return m_data;
+}
+
+template <typename T, size_t... DIMS>
+const T* StaticTensor<T, DIMS...>::Data() const noexcept
+{
+  return m_data;
+}
+
+template <typename T, size_t... DIMS>
+constexpr size_t StaticTensor<T, DIMS...>::Length() noexcept
+{
+  return length;
+}
+
+template <typename T, size_t... DIMS>
+constexpr size_t StaticTensor<T, DIMS...>::Rank() noexcept
+{
+  return rank;
+}
+
+template <typename T, size_t... DIMS>
+constexpr std::array<TSHAPE_TYPE, StaticTensor<T, DIMS...>::rank> StaticTensor<T, DIMS...>::Shape() noexcept
+{
+  return {{(TSHAPE_TYPE)DIMS...}};
+}
+
+template <typename T, size_t... DIMS>
+constexpr std::array<size_t, StaticTensor<T, DIMS...>::rank> StaticTensor<T, DIMS...>::Strides() noexcept
+{
+  constexpr size_t dims[rank] = {DIMS...};
+
+  std::array<size_t, rank> strides{};
+  size_t stride = 1;
+  for (size_t axis=rank; axis-- > 0;)
+  {
+    strides[axis] = stride;
+    stride *= dims[axis];
+  }
+  return strides;
+}
+
+template <typename T, size_t... DIMS>
+Tensor<T> StaticTensor<T, DIMS...>::ToTensor() const
+{
+  Tensor<T> tensor({(TSHAPE_TYPE)DIMS...});
+  std::copy(m_data, m_data + length, tensor.Data());
+  return tensor;
+}
+
+template <typename T, size_t... DIMS>
+template <typename... INDICES>
+constexpr size_t StaticTensor<T, DIMS...>::Offset(const INDICES... _indices) noexcept
+{
+  static_assert(sizeof...(INDICES) == rank, "One index per axis");
+
+  constexpr size_t dims[rank] = {DIMS...};
+  const size_t indices[rank] = {(size_t)_indices...};
+
+  size_t offset = 0;
+  for (size_t axis=0; axis<rank; axis++)
+    offset = offset * dims[axis] + indices[axis];
+  return offset;
+}
+
+template <typename T, size_t M, size_t K, size_t N>
+StaticTensor<T, M, N> mnt::MatMul(const StaticTensor<T, M, K>& _a, const StaticTensor<T, K, N>& _b) noexcept
+{
+  StaticTensor<T, M, N> c;
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    StaticKernels::MatMul<M, K, N>(_a.Data(), _b.Data(), c.Data());
+  }
+  else
+  {
+    for (size_t i=0; i<M; i++)
+      for (size_t k=0; k<K; k++)
+        for (size_t j=0; j<N; j++)
+          c(i, j) += _a(i, k) * _b(k, j);
+  }
+
+  return c;
+}
+
+template <typename T, size_t ROWS, size_t COLS>
+StaticTensor<T, COLS, ROWS> mnt::Transpose(const StaticTensor<T, ROWS, COLS>& _a) noexcept
+{
+  StaticTensor<T, COLS, ROWS> t;
+  for (size_t i=0; i<ROWS; i++)
+    for (size_t j=0; j<COLS; j++)
+      t(j, i) = _a(i, j);
+  return t;
+}
+
+// The loops have a constant length, the compiler unrolls and vectorizes them
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...> mnt::Add(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept
+{
+  StaticTensor<T, DIMS...> c;
+  for (size_t i=0; i<c.length; i++)
+    c[i] = _a[i] + _b[i];
+  return c;
+}
+
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...> mnt::Sub(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept
+{
+  StaticTensor<T, DIMS...> c;
+  for (size_t i=0; i<c.length; i++)
+    c[i] = _a[i] - _b[i];
+  return c;
+}
+
+template <typename T, size_t... DIMS>
+StaticTensor<T, DIMS...> mnt::Mul(const StaticTensor<T, DIMS...>& _a, const StaticTensor<T, DIMS...>& _b) noexcept
+{
+  StaticTensor<T, DIMS...> c;
+  for (size_t i=0; i<c.length; i++)
+    c[i] = _a[i] * _b[i];
+  return c;
+}
+
+#endif
@@ -3,38 +3,125 @@
 // Date:          22th Mar 2021
 // Description:
 
+// ---------------------
+// Note:
+// The shape is always the logical one, e.g. {N, C, H, W}, the layout only changes how the items
+// are stored. In the blocked layouts NCHW8c and NCHW16c, channels are grouped by 8 or 16 and the
+// channels of a group are stored next to each other for every pixel: [N][C/8][H][W][8], the last
+// group is padded with zeros. Convolutions vectorize over the channels of a group, so a chain of
+// layers can stay blocked and only convert at the boundaries of the network (Backend::Reorder).
+// ---------------------
+
+// ---------------------
+// Note:
+// Shapes and strides are small-buffer vectors (see "math/shape.hpp") and the memory is shared
+// through the intrusive count of MemoryRef, so views and moves don`t allocate anything, a new
+// tensor only allocates its memory. Tensors can be moved but not copied, "Shapeshift" makes a
+// view that shares the memory.
+// ---------------------
+
+// ---------------------
+// Note:
+// Tensors built from a shape store their items in a LinearHeapMemory, and keep a pointer to
+// them, so "operator []" and "Data" never make a virtual call and loops over them vectorize.
+// Tensors built on an existing memory can also use a BlockMemory, then "Data" is nullptr and
+// the items are reached block by block through "Spans", operations check the kind of storage
+// once and work on the raw pointers of the spans.
+// ---------------------
+
 #ifndef ENGINE_MATH_TENSOR_HPP
 #define ENGINE_MATH_TENSOR_HPP
 
 #include "configs.hpp"
 
-#include "memory/memory.hpp"
+#include "memory/memory_ref.hpp"
+
+#include "math/shape.hpp"
 
-#include <vector>
+#include <cstdint>
 #include <string>
-#include <memory>
 
 namespace mnt {
+
+  enum class Layout : uint8_t
+  {
+    Plain = 0,  // Row-major, any rank
+    NCHW8c,     // Rank 4 only
+    NCHW16c     // Rank 4 only
+  };
+
+  // Number of channels in a group, 1 for the plain layout
+  size_t LayoutBlock(Layout _layout) noexcept;
+
   template <typename T>
   class Tensor
   {
   public:
-    Tensor(const std::vector<TSHAPE_TYPE>& _shape);
+    // Contiguous runs of the stored items, in order
+    using SpanList = SmallVector<MemorySpan<T>, 4>;
+
+  public:
+    Tensor(const TensorShape& _shape, Layout _layout = Layout::Plain);
+
+    // A plain tensor on the items of _memory, which must hold exactly the items of _shape
+    Tensor(const TensorShape& _shape, MemoryRef<T> _memory);
+
+    Tensor(const Tensor&) = delete;
+    Tensor& operator = (const Tensor&) = delete;
+    Tensor(Tensor&&) noexcept = default;
+    Tensor& operator = (Tensor&&) noexcept = default;
 
     T& operator [] (const size_t _index) noexcept;
     const T& operator [] (const size_t _index) const noexcept;
 
-    Tensor Shapeshift(const std::vector<TSHAPE_TYPE>& _perm);
+    // Pointer to the first item, items are stored contiguously in the order of the layout,
+    // nullptr if the storage is not linear
+    T* Data() noexcept;
+    const T* Data() const noexcept;
 
-    std::string ShapeStr();
-    std::vector<TSHAPE_TYPE> Shape();
-    size_t Rank();
+    // Data() and Length(), the length is 0 if the storage is not linear
+    MemorySpan<T> Span() noexcept;
+
+    // The runs of items of any kind of storage, a single one for linear storage
+    SpanList Spans();
+
+    MemoryKind Storage() const noexcept;
+
+    // Number of stored items, the product of the shape plus the padding of blocked layouts
+    size_t Length() const noexcept;
+
+    Layout MemoryLayout() const noexcept;
+
+    // Distance in items between consecutive indices of every axis, plain layout only
+    TensorStrides Strides() const;
+
+    // False for the views of Shapeshift, their items are not stored in row-major order,
+    // and for the storages that are not linear
+    bool IsContiguous() const noexcept;
+
+    // A view of the same items with permuted axes, axis i of the view is axis _perm[i] of
+    // this tensor, nothing is copied, "Backend::Reorder" makes a contiguous copy of it
+    Tensor Shapeshift(const TensorShape& _perm);
+
+    std::string ShapeStr() const;
+    const TensorShape& Shape() const noexcept;
+    size_t Rank() const noexcept;
+
+  private:
+    // Views are built by Shapeshift
+    Tensor() = default;
 
   private:
-    std::shared_ptr<MNTMemory<T>> m_memory;
+    MemoryRef<T> m_memory;
+
+    // The items of linear storage, nullptr otherwise
+    T* m_data = nullptr;
+
+    TensorShape m_shape;
+    Layout m_layout = Layout::Plain;
 
-    std::vector<TSHAPE_TYPE> m_shape;
-    std::unique_ptr<std::vector<TSHAPE_TYPE>> m_shapeshifter;
+    // Axis i of a view is axis m_shapeshifter[i] of the stored items
+    TensorShape m_shapeshifter;
 
     bool m_shapeshift = false;
   };
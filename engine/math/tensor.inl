@@ -10,43 +10,222 @@
 
 #include "math/tensor.hpp"
 
+#include "utils/mntexcept.hpp"
+
 #include <sstream>
+#include <string>
 
 using namespace mnt;
 
+inline size_t mnt::LayoutBlock(Layout _layout) noexcept
+{
+  switch (_layout)
+  {
+  case Layout::NCHW8c:  return 8;
+  case Layout::NCHW16c: return 16;
+  default:              return 1;
+  }
+}
+
 template <typename T>
-Tensor<T>::Tensor(const std::vector<TSHAPE_TYPE>& _shape)
+Tensor<T>::Tensor(const TensorShape& _shape, Layout _layout)
 {
   m_shape = _shape;
+  m_layout = _layout;
 
-  m_memory = std::make_shared<LinearHeapMemory<T>>(10);
+  if (m_layout != Layout::Plain && m_shape.size() != 4)
+    MNT_THROW("Blocked layouts need a tensor of shape {N, C, H, W}");
+
+  // Channels are rounded up to full groups
+  const size_t block = LayoutBlock(m_layout);
+
+  size_t length = 1;
+  for (size_t i=0; i<m_shape.size(); i++)
+    length = CheckedMul(length, (i == 1 && block > 1) ? CheckedAdd(m_shape[i], block - 1) / block * block
+                                                      : m_shape[i]);
+
+  // The allocation is in bytes
+  CheckedMul(length, sizeof(T));
+
+  LinearHeapMemory<T>* memory = new LinearHeapMemory<T>(length);
+  m_memory = MemoryRef<T>(memory);
+  m_data = memory->Data();
+}
+
+template <typename T>
+Tensor<T>::Tensor(const TensorShape& _shape, MemoryRef<T> _memory)
+{
+  if (!_memory || _memory->Length() != ShapeLength(_shape))
+    MNT_THROW(("The memory doesn`t hold the " + std::to_string(ShapeLength(_shape)) +
+               " items of the shape").c_str());
+
+  m_shape = _shape;
+  m_memory = std::move(_memory);
+
+  if (m_memory->Kind() == MemoryKind::Linear)
+    m_data = static_cast<LinearMemory<T>*>(m_memory.Get())->Data();
 }
 
 template <typename T>
 T& Tensor<T>::operator [] (const size_t _index) noexcept
 {
-  return m_memory.get()[0][_index];
+  return m_data ? m_data[_index] : (*m_memory)[_index];
 }
 
 template <typename T>
 const T& Tensor<T>::operator [] (const size_t _index) const noexcept
 {
-  return m_memory.get()[0][_index];
+  return m_data ? m_data[_index] : (*m_memory)[_index];
 }
 
+template <typename T>
+T* Tensor<T>::Data() noexcept
+{
+  return m_data;
+}
 
 template <typename T>
-std::string Tensor<T>::ShapeStr()
+const T* Tensor<T>::Data() const noexcept
 {
-  std::stringstream string_stream;
+  return m_data;
+}
 
-  string_stream << "{";
-  if (m_shape.size() > 0)
+template <typename T>
+MemorySpan<T> Tensor<T>::Span() noexcept
+{
+  return {m_data, m_data ? Length() : 0};
+}
+
+template <typename T>
+typename Tensor<T>::SpanList Tensor<T>::Spans()
+{
+  SpanList spans;
+
+  if (m_data)
+  {
+    spans.push_back(Span());
+    return spans;
+  }
+
+  for (size_t i=0; i<m_memory->NoOfSpans(); i++)
+    spans.push_back(m_memory->Span(i));
+
+  return spans;
+}
+
+template <typename T>
+MemoryKind Tensor<T>::Storage() const noexcept
+{
+  return m_memory->Kind();
+}
+
+template <typename T>
+size_t Tensor<T>::Length() const noexcept
+{
+  return m_memory->Length();
+}
+
+template <typename T>
+Layout Tensor<T>::MemoryLayout() const noexcept
+{
+  return m_layout;
+}
+
+template <typename T>
+TensorStrides Tensor<T>::Strides() const
+{
+  if (m_layout != Layout::Plain)
+    MNT_THROW("Strides are only defined for the plain layout");
+
+  const size_t rank = m_shape.size();
+
+  // The shape the items are stored in
+  TensorStrides stored(rank);
+  for (size_t i=0; i<rank; i++)
+    stored[m_shapeshift ? m_shapeshifter[i] : i] = m_shape[i];
+
+  TensorStrides stored_strides(rank, 1);
+  for (size_t i=rank; i-- > 1;)
+    stored_strides[i - 1] = stored_strides[i] * stored[i];
+
+  TensorStrides strides(rank);
+  for (size_t i=0; i<rank; i++)
+    strides[i] = stored_strides[m_shapeshift ? m_shapeshifter[i] : i];
+
+  return strides;
+}
+
+template <typename T>
+bool Tensor<T>::IsContiguous() const noexcept
+{
+  return !m_shapeshift && m_data;
+}
+
+template <typename T>
+Tensor<T> Tensor<T>::Shapeshift(const TensorShape& _perm)
+{
+  const size_t rank = m_shape.size();
+
+  if (m_layout != Layout::Plain)
+    MNT_THROW("Shapeshift needs a tensor in the plain layout");
+
+  SmallVector<bool, MNT_TENSOR_INLINE_RANK> seen(rank, false);
+  bool valid = _perm.size() == rank;
+  for (size_t i=0; valid && i<rank; i++)
   {
-    for (auto i : m_shape)
-      string_stream << i << ", ";
-    string_stream.seekp(-2, std::ios_base::end);
+    valid = _perm[i] < rank && !seen[_perm[i]];
+    if (valid)
+      seen[_perm[i]] = true;
   }
+
+  if (!valid)
+    MNT_THROW(("Invalid permutation of the axes of a tensor of shape " + ShapeStr()).c_str());
+
+  Tensor<T> view;
+  view.m_memory = m_memory;
+  view.m_data = m_data;
+  view.m_layout = m_layout;
+
+  // Permutations of a view are composed, the view always refers to the stored axes
+  TensorShape stored(rank);
+  bool identity = true;
+  for (size_t i=0; i<rank; i++)
+  {
+    view.m_shape.push_back(m_shape[_perm[i]]);
+    stored[i] = m_shapeshift ? m_shapeshifter[_perm[i]] : _perm[i];
+    identity = identity && stored[i] == i;
+  }
+
+  if (!identity)
+  {
+    view.m_shapeshifter = std::move(stored);
+    view.m_shapeshift = true;
+  }
+
+  return view;
+}
+
+template <typename T>
+const TensorShape& Tensor<T>::Shape() const noexcept
+{
+  return m_shape;
+}
+
+template <typename T>
+size_t Tensor<T>::Rank() const noexcept
+{
+  return m_shape.size();
+}
+
+
+template <typename T>
+std::string Tensor<T>::ShapeStr() const
+{
+  std::stringstream string_stream;
+
+  string_stream << "{";
+  for (size_t i=0; i<m_shape.size(); i++)
+    string_stream << (i ? ", " : "") << m_shape[i];
   string_stream << "}";
 
   return string_stream.str();
@@ -0,0 +1,210 @@
+// File Name:     test_utils.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Helpers of the standalone test programs of the math ops
+
+// ---------------------
+// Detail Description:
+// The test programs ("*_test.cpp" next to the code they check) compare the ops of the backend
+// with naive loops. The kernels are bound once per process for "CPU::Active()", so
+// "RunOnEveryISA" starts the program again with MNT_ISA set to every instruction set the CPU
+// supports and the checks run in those children. A program started with MNT_ISA already set
+// only checks that instruction set.
+// ---------------------
+
+// =====
+// [Expect(_condition, _what)]: Counts a failure and prints _what if _condition is false
+// =====
+
+// =====
+// [Near(_value, _expected, _tolerance, _what)]: Expects |_value - _expected| to be at most
+// _tolerance * max(1, |_expected|)
+// =====
+
+// =====
+// [Items(_tensor, _expected, _tolerance, _what)]: Near on the item of _tensor furthest from
+// _expected, only one line is printed however many items are wrong
+// =====
+
+// =====
+// [Throws(_function, _what)]: Expects _function() to throw an MNTExcept
+// =====
+
+// =====
+// [Fill(_tensor, _seed, _low, _high)]: Uniform values in [_low, _high) of a fixed seed, integer
+// items get the integers of the range
+// =====
+
+// =====
+// [OnBlocks(_tensor, _no_of_blocks)]: A copy of the contiguous _tensor in a BlockHeapMemory,
+// its "Data" is nullptr and the ops reach the items through "Spans"
+// =====
+
+// =====
+// [RunOnEveryISA(_program, _checks)]: Returns the exit code of the program, 0 if _checks()
+// returned 0 on every instruction set
+// =====
+
+#ifndef ENGINE_MATH_TEST_UTILS_HPP
+#define ENGINE_MATH_TEST_UTILS_HPP
+
+#include "math/tensor.hpp"
+
+#include "memory/block/block_heap.hpp"
+
+#include "utils/configs.hpp"
+#include "utils/cpu.hpp"
+#include "utils/mntexcept.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mnt { namespace testing {
+
+  class Checks
+  {
+  public:
+    inline void Expect(bool _condition, const std::string& _what)
+    {
+      if (_condition)
+        return;
+
+      std::printf("  FAILED: %s\n", _what.c_str());
+      m_failures++;
+    };
+
+    inline void Near(double _value, double _expected, double _tolerance, const std::string& _what)
+    {
+      const double error = std::fabs(_value - _expected);
+      const bool near = error <= _tolerance * std::fmax(1.0, std::fabs(_expected));
+
+      Expect(near, _what + ": " + std::to_string(_value) + " instead of " + std::to_string(_expected));
+    };
+
+    template <typename T>
+    void Items(const Tensor<T>& _tensor, const std::vector<double>& _expected, double _tolerance,
+               const std::string& _what)
+    {
+      if (_tensor.Length() != _expected.size())
+      {
+        Expect(false, _what + " has " + std::to_string(_tensor.Length()) + " items instead of " +
+                      std::to_string(_expected.size()));
+        return;
+      }
+
+      size_t worst = 0;
+      double worst_error = 0.0;
+      for (size_t i=0; i<_expected.size(); i++)
+      {
+        double error = std::fabs((double)_tensor.Data()[i] - _expected[i]) / std::fmax(1.0, std::fabs(_expected[i]));
+        if (std::isnan(error))
+          error = INFINITY;
+
+        if (error > worst_error)
+        {
+          worst = i;
+          worst_error = error;
+        }
+      }
+
+      Near((double)_tensor.Data()[worst], _expected[worst], _tolerance, _what + " item " + std::to_string(worst));
+    }
+
+    template <typename F>
+    void Throws(const F& _function, const std::string& _what)
+    {
+      bool thrown = false;
+
+      try
+      {
+        _function();
+      }
+      catch (MNTExcept&)
+      {
+        thrown = true;
+      }
+
+      Expect(thrown, _what + " doesn`t throw");
+    }
+
+    inline int Failures() const noexcept {return m_failures;};
+
+  private:
+    int m_failures = 0;
+  };
+
+  template <typename T>
+  void Fill(Tensor<T>& _tensor, uint32_t _seed, double _low = -1.0, double _high = 1.0)
+  {
+    std::mt19937 generator(_seed);
+    std::uniform_real_distribution<double> uniform(_low, _high);
+
+    T* data = _tensor.Data();
+    for (size_t i=0; i<_tensor.Length(); i++)
+    {
+      if constexpr (std::is_integral<T>::value)
+        data[i] = (T)std::floor(uniform(generator));
+      else
+        data[i] = (T)uniform(generator);
+    }
+  }
+
+  template <typename T>
+  Tensor<T> OnBlocks(const Tensor<T>& _tensor, uint16_t _no_of_blocks = 3)
+  {
+    Tensor<T> blocks(_tensor.Shape(), MemoryRef<T>(new BlockHeapMemory<T>(_tensor.Length(), _no_of_blocks)));
+
+    const T* src = _tensor.Data();
+    for (const MemorySpan<T>& span : blocks.Spans())
+    {
+      std::copy(src, src + span.length, span.data);
+      src += span.length;
+    }
+
+    return blocks;
+  }
+
+  inline int RunOnEveryISA(const char* _program, const std::function<int()>& _checks)
+  {
+    const char* requested = getenv(MNT_ISA_ENV_VARIABLE);
+    if (requested && requested[0] != '\0')
+    {
+      std::printf("%s\n", CPU::ISAName(CPU::Active()));
+      const int failures = _checks();
+      std::printf("  %s\n", failures ? "FAILED" : "OK");
+      return failures ? 1 : 0;
+    }
+
+    const ISA isas[] = {ISA::Generic, ISA::SSE4, ISA::AVX2, ISA::AVX512, ISA::NEON};
+    int failures = 0;
+
+    for (const ISA isa : isas)
+    {
+      if (!CPU::Supports(isa))
+        continue;
+
+#if defined(_WIN32)
+      _putenv_s(MNT_ISA_ENV_VARIABLE, CPU::ISAName(isa));
+#else
+      setenv(MNT_ISA_ENV_VARIABLE, CPU::ISAName(isa), 1);
+#endif
+
+      std::fflush(stdout);
+      const std::string command = std::string("\"") + _program + "\"";
+      failures += std::system(command.c_str()) != 0;
+    }
+
+    std::printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+  };
+}}
+
+#endif
@@ -0,0 +1,113 @@
+// File Name:     winograd.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Winograd F(4x4, 3x3) convolution
+
+// ---------------------
+// Detail Description:
+// A 4x4 block of output of a 3x3 convolution is computed from a 6x6 block of input as
+//
+//   Y = AT [ (G g GT) * (BT d B) ] A
+//
+// where * is elementwise, 36 multiplications instead of 144. Summed over the input channels,
+// each of the 36 positions of the transformed domain becomes an independent GEMM:
+//
+//   M[pos] (OC x tiles) = U[pos] (OC x C) * V[pos] (C x tiles)
+//
+// Tiles are processed in blocks sized for L2: the input transform of a block, its 36 GEMMs
+// and its output transform run back to back on the same thread, so V and M never leave
+// the cache and are never allocated for the whole tensor.
+// ---------------------
+
+// ---------------------
+// Note:
+// The transforms trade multiplications for additions of numbers of different magnitudes,
+// the result has a relative error around MNT_WINOGRAD_RELATIVE_ERROR instead of the ~1e-6 of
+// a direct convolution, the backend only uses Winograd if "Conv2DParams::tolerance" allows it
+// ---------------------
+
+// ---------------------
+// Note:
+// With "Conv2DParams::constant_filter" the transformed filters are cached, keyed by the
+// address and the shape of the filter plus a fingerprint of a sample of its values.
+// A filter changed in place while cached isn`t detected, call "ClearCache" after that.
+// ---------------------
+
+#ifndef ENGINE_MATH_WINOGRAD_HPP
+#define ENGINE_MATH_WINOGRAD_HPP
+
+#include "configs.hpp"
+
+#include "math/conv.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mnt {
+
+  class Winograd
+  {
+  public:
+    // Output block, input block and filter sizes of F(4x4, 3x3)
+    static constexpr size_t output_tile = 4;
+    static constexpr size_t input_tile = 6;
+    static constexpr size_t positions = input_tile * input_tile;
+
+    // Largest number of tiles transformed and multiplied together
+    static constexpr size_t max_block = 128;
+
+    // 3x3 filters, stride 1, no dilation and no groups
+    static bool Supports(const Conv2DGeometry& _geometry) noexcept;
+
+    // _transformed has positions x out_channels x in_channels items
+    static void TransformFilter(const float* _filter, size_t _out_channels, size_t _in_channels,
+                                float* _transformed) noexcept;
+
+    // Transformed filter, cached if _geometry.params.constant_filter
+    static std::shared_ptr<const std::vector<float>> Filter(const float* _filter,
+                                                            const Conv2DGeometry& _geometry);
+
+    static void Run(const float* _input, const float* _transformed_filter, float* _output,
+                    const Conv2DGeometry& _geometry);
+
+    // Rough number of CPU cycles, comparable to "Gemm::Cost"
+    static size_t Cost(const Conv2DGeometry& _geometry) noexcept;
+
+    static void ClearCache() noexcept;
+
+  private:
+    struct CacheEntry
+    {
+      const float* filter;
+      size_t out_channels;
+      size_t in_channels;
+      uint64_t fingerprint;
+      std::shared_ptr<const std::vector<float>> transformed;
+    };
+
+    static uint64_t Fingerprint(const float* _filter, size_t _length) noexcept;
+
+    // Tiles [_tile_begin, _tile_begin + _tiles) of the whole batch, _scratch holds 36 x _tiles items
+    static void TransformInput(const float* _input, const Conv2DGeometry& _geometry,
+                               size_t _tile_begin, size_t _tiles, float* _scratch,
+                               float* _transformed) noexcept;
+    static void TransformOutput(const float* _transformed, const Conv2DGeometry& _geometry,
+                                size_t _tile_begin, size_t _tiles, float* _scratch,
+                                float* _output) noexcept;
+
+    // Most recently used first
+    static std::list<CacheEntry>& Cache() noexcept;
+    static std::mutex& CacheMutex() noexcept;
+
+    // Thread local buffer for V and M of a block of tiles
+    static float* Buffer(size_t _length);
+  };
+}
+
+#include "math/winograd.inl"
+
+#endif
@@ -0,0 +1,323 @@
+// File Name:     winograd.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Winograd F(4x4, 3x3) convolution
+
+#ifndef ENGINE_MATH_WINOGRAD_INL
+#define ENGINE_MATH_WINOGRAD_INL
+
+#include "math/winograd.hpp"
+#include "math/gemm.hpp"
+#include "math/kernels/registry.hpp"
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace mnt;
+
+inline bool Winograd::Supports(const Conv2DGeometry& _geometry) noexcept
+{
+  const Conv2DParams& p = _geometry.params;
+  return _geometry.kernel_h == 3 && _geometry.kernel_w == 3 &&
+         p.stride_h == 1 && p.stride_w == 1 &&
+         p.dilation_h == 1 && p.dilation_w == 1 && p.groups == 1;
+};
+
+// U = G g GT, with G = [ 1/4     0     0  ]
+//                      [-1/6  -1/6  -1/6  ]
+//                      [-1/6   1/6  -1/6  ]
+//                      [1/24  1/12   1/6  ]
+//                      [1/24 -1/12   1/6  ]
+//                      [  0     0     1   ]
+inline void Winograd::TransformFilter(const float* _filter, size_t _out_channels, size_t _in_channels,
+                                      float* _transformed) noexcept
+{
+  const size_t matrix_length = _out_channels * _in_channels;
+
+  for (size_t oc = 0; oc < _out_channels; oc++)
+    for (size_t c = 0; c < _in_channels; c++)
+    {
+      const float* g = _filter + (oc * _in_channels + c) * 9;
+
+      // G g, 6x3
+      float t[6][3];
+      for (size_t j = 0; j < 3; j++)
+      {
+        const float g0 = g[j], g1 = g[3 + j], g2 = g[6 + j];
+        t[0][j] = g0 / 4.0f;
+        t[1][j] = -(g0 + g1 + g2) / 6.0f;
+        t[2][j] = -(g0 - g1 + g2) / 6.0f;
+        t[3][j] = g0 / 24.0f + g1 / 12.0f + g2 / 6.0f;
+        t[4][j] = g0 / 24.0f - g1 / 12.0f + g2 / 6.0f;
+        t[5][j] = g2;
+      }
+
+      // (G g) GT, 6x6
+      float* u = _transformed + oc * _in_channels + c;
+      for (size_t i = 0; i < 6; i++)
+      {
+        const float t0 = t[i][0], t1 = t[i][1], t2 = t[i][2];
+        u[(i * 6 + 0) * matrix_length] = t0 / 4.0f;
+        u[(i * 6 + 1) * matrix_length] = -(t0 + t1 + t2) / 6.0f;
+        u[(i * 6 + 2) * matrix_length] = -(t0 - t1 + t2) / 6.0f;
+        u[(i * 6 + 3) * matrix_length] = t0 / 24.0f + t1 / 12.0f + t2 / 6.0f;
+        u[(i * 6 + 4) * matrix_length] = t0 / 24.0f - t1 / 12.0f + t2 / 6.0f;
+        u[(i * 6 + 5) * matrix_length] = t2;
+      }
+    }
+};
+
+inline std::shared_ptr<const std::vector<float>> Winograd::Filter(const float* _filter,
+                                                                  const Conv2DGeometry& _geometry)
+{
+  const size_t out_channels = _geometry.out_channels;
+  const size_t in_channels = _geometry.in_channels;
+
+  auto transform = [&]()
+  {
+    auto transformed = std::make_shared<std::vector<float>>(positions * out_channels * in_channels);
+    TransformFilter(_filter, out_channels, in_channels, transformed->data());
+    return transformed;
+  };
+
+  if (!_geometry.params.constant_filter)
+    return transform();
+
+  const uint64_t fingerprint = Fingerprint(_filter, out_channels * in_channels * 9);
+
+  {
+    std::lock_guard<std::mutex> lock(CacheMutex());
+    std::list<CacheEntry>& cache = Cache();
+
+    for (auto entry = cache.begin(); entry != cache.end(); entry++)
+      if (entry->filter == _filter && entry->out_channels == out_channels &&
+          entry->in_channels == in_channels && entry->fingerprint == fingerprint)
+      {
+        cache.splice(cache.begin(), cache, entry);
+        return cache.front().transformed;
+      }
+  }
+
+  // Transformed outside the lock, two threads may both do it for the same filter, it is harmless
+  std::shared_ptr<const std::vector<float>> transformed = transform();
+
+  std::lock_guard<std::mutex> lock(CacheMutex());
+  std::list<CacheEntry>& cache = Cache();
+
+  cache.push_front({_filter, out_channels, in_channels, fingerprint, transformed});
+  if (cache.size() > MNT_WINOGRAD_CACHE_ENTRIES)
+    cache.pop_back();
+
+  return transformed;
+};
+
+inline void Winograd::Run(const float* _input, const float* _transformed_filter, float* _output,
+                          const Conv2DGeometry& _geometry)
+{
+  const size_t in_channels = _geometry.in_channels;
+  const size_t out_channels = _geometry.out_channels;
+  const size_t tiles_h = (_geometry.out_height + output_tile - 1) / output_tile;
+  const size_t tiles_w = (_geometry.out_width + output_tile - 1) / output_tile;
+  const size_t total_tiles = _geometry.batch * tiles_h * tiles_w;
+
+  if (total_tiles == 0)
+    return;
+
+  // V and M of a block together take about as much as a packed block of B of the GEMM
+  size_t block = MNT_GEMM_KC * MNT_GEMM_NC / (positions * (in_channels + out_channels));
+  block = std::min(std::max(block, (size_t)16), max_block);
+
+  const size_t no_of_blocks = (total_tiles + block - 1) / block;
+  const KernelTable& table = KernelRegistry::Get();
+
+  ParallelFor(0, no_of_blocks, [&](size_t _begin, size_t _end)
+  {
+    for (size_t b = _begin; b < _end; b++)
+    {
+      const size_t tile_begin = b * block;
+      const size_t tiles = std::min(block, total_tiles - tile_begin);
+
+      float* v = Buffer(positions * (in_channels + out_channels + 1) * tiles);
+      float* m = v + positions * in_channels * tiles;
+      float* scratch = m + positions * out_channels * tiles;
+
+      TransformInput(_input, _geometry, tile_begin, tiles, scratch, v);
+
+      for (size_t pos = 0; pos < positions; pos++)
+      {
+        const float* v_pos = v + pos * in_channels * tiles;
+
+        Gemm::Block(0, out_channels, 0, tiles, in_channels,
+                    _transformed_filter + pos * out_channels * in_channels, in_channels, 1,
+                    [&](size_t _k_begin, size_t _depth, size_t _n_begin, size_t _cols, float* _packed)
+                    {
+                      table.gemm_pack_b(v_pos + _k_begin * tiles + _n_begin, tiles, 1, _depth, _cols, _packed);
+                    },
+                    m + pos * out_channels * tiles, tiles, false);
+      }
+
+      TransformOutput(m, _geometry, tile_begin, tiles, scratch, _output);
+    }
+  }, Gemm::Cost(out_channels, block, in_channels) * positions);
+};
+
+// The GEMMs in the transformed domain, plus repacking U for every extra block of tiles, plus
+// gathering and transforming the blocks at a few cycles per item
+inline size_t Winograd::Cost(const Conv2DGeometry& _geometry) noexcept
+{
+  const size_t in_channels = _geometry.in_channels;
+  const size_t out_channels = _geometry.out_channels;
+  const size_t tiles = _geometry.batch *
+                       ((_geometry.out_height + output_tile - 1) / output_tile) *
+                       ((_geometry.out_width + output_tile - 1) / output_tile);
+
+  size_t block = MNT_GEMM_KC * MNT_GEMM_NC / (positions * (in_channels + out_channels));
+  block = std::min(std::max(block, (size_t)16), max_block);
+
+  size_t gemm = positions * Gemm::Cost(out_channels, tiles, in_channels);
+  size_t repacking = positions * out_channels * in_channels * ((tiles + block - 1) / block - 1);
+  size_t transforms = 4 * positions * tiles * (in_channels + out_channels);
+
+  return gemm + repacking + transforms;
+};
+
+inline void Winograd::ClearCache() noexcept
+{
+  std::lock_guard<std::mutex> lock(CacheMutex());
+  Cache().clear();
+};
+
+// FNV-1a of up to 256 evenly spaced items and the length
+inline uint64_t Winograd::Fingerprint(const float* _filter, size_t _length) noexcept
+{
+  uint64_t hash = 14695981039346656037ull ^ _length;
+  const size_t step = std::max(_length / 256, (size_t)1);
+
+  for (size_t i = 0; i < _length; i += step)
+  {
+    uint32_t bits;
+    memcpy(&bits, _filter + i, sizeof(bits));
+    hash = (hash ^ bits) * 1099511628211ull;
+  }
+
+  return hash;
+};
+
+// Items of the 6x6 input blocks are gathered into rows, the transform itself runs
+// vectorized over the tiles of the block
+inline void Winograd::TransformInput(const float* _input, const Conv2DGeometry& _geometry,
+                                     size_t _tile_begin, size_t _tiles, float* _scratch,
+                                     float* _transformed) noexcept
+{
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t in_channels = _geometry.in_channels;
+  const ptrdiff_t height = (ptrdiff_t)_geometry.in_height;
+  const ptrdiff_t width = (ptrdiff_t)_geometry.in_width;
+  const size_t plane_length = _geometry.in_height * _geometry.in_width;
+  const size_t tiles_w = (_geometry.out_width + output_tile - 1) / output_tile;
+  const size_t tiles_per_image = ((_geometry.out_height + output_tile - 1) / output_tile) * tiles_w;
+
+  // Top left corner of the input block and the image of every tile
+  ptrdiff_t origin_h[max_block];
+  ptrdiff_t origin_w[max_block];
+  size_t image[max_block];
+
+  for (size_t i = 0; i < _tiles; i++)
+  {
+    const size_t tile = _tile_begin + i;
+    image[i] = tile / tiles_per_image;
+    origin_h[i] = (ptrdiff_t)(((tile % tiles_per_image) / tiles_w) * output_tile) - (ptrdiff_t)_geometry.params.padding_h;
+    origin_w[i] = (ptrdiff_t)((tile % tiles_w) * output_tile) - (ptrdiff_t)_geometry.params.padding_w;
+  }
+
+  for (size_t c = 0; c < in_channels; c++)
+  {
+    for (size_t i = 0; i < _tiles; i++)
+    {
+      const float* plane = _input + (image[i] * in_channels + c) * plane_length;
+      const ptrdiff_t h0 = origin_h[i];
+      const ptrdiff_t w0 = origin_w[i];
+
+      if (h0 >= 0 && w0 >= 0 && h0 + 6 <= height && w0 + 6 <= width)
+      {
+        for (ptrdiff_t y = 0; y < 6; y++)
+        {
+          const float* row = plane + (h0 + y) * width + w0;
+          for (ptrdiff_t x = 0; x < 6; x++)
+            _scratch[(y * 6 + x) * _tiles + i] = row[x];
+        }
+      }
+      else
+      {
+        for (ptrdiff_t y = 0; y < 6; y++)
+          for (ptrdiff_t x = 0; x < 6; x++)
+          {
+            const ptrdiff_t h = h0 + y;
+            const ptrdiff_t w = w0 + x;
+            _scratch[(y * 6 + x) * _tiles + i] =
+              (h >= 0 && h < height && w >= 0 && w < width) ? plane[h * width + w] : 0.0f;
+          }
+      }
+    }
+
+    table.winograd_input(_scratch, _tiles, _transformed + c * _tiles, in_channels * _tiles, _tiles);
+  }
+};
+
+inline void Winograd::TransformOutput(const float* _transformed, const Conv2DGeometry& _geometry,
+                                      size_t _tile_begin, size_t _tiles, float* _scratch,
+                                      float* _output) noexcept
+{
+  const KernelTable& table = KernelRegistry::Get();
+  const size_t out_channels = _geometry.out_channels;
+  const size_t out_height = _geometry.out_height;
+  const size_t out_width = _geometry.out_width;
+  const size_t tiles_w = (out_width + output_tile - 1) / output_tile;
+  const size_t tiles_per_image = ((out_height + output_tile - 1) / output_tile) * tiles_w;
+
+  for (size_t oc = 0; oc < out_channels; oc++)
+  {
+    table.winograd_output(_transformed + oc * _tiles, out_channels * _tiles, _scratch, _tiles, _tiles);
+
+    for (size_t i = 0; i < _tiles; i++)
+    {
+      const size_t tile = _tile_begin + i;
+      const size_t image = tile / tiles_per_image;
+      const size_t y0 = ((tile % tiles_per_image) / tiles_w) * output_tile;
+      const size_t x0 = (tile % tiles_w) * output_tile;
+      const size_t rows = std::min(output_tile, out_height - y0);
+      const size_t cols = std::min(output_tile, out_width - x0);
+
+      float* out = _output + (image * out_channels + oc) * out_height * out_width + y0 * out_width + x0;
+      for (size_t y = 0; y < rows; y++)
+        for (size_t x = 0; x < cols; x++)
+          out[y * out_width + x] = _scratch[(y * output_tile + x) * _tiles + i];
+    }
+  }
+};
+
+inline std::list<Winograd::CacheEntry>& Winograd::Cache() noexcept
+{
+  static std::list<CacheEntry> cache;
+  return cache;
+};
+
+inline std::mutex& Winograd::CacheMutex() noexcept
+{
+  static std::mutex mutex;
+  return mutex;
+};
+
+inline float* Winograd::Buffer(size_t _length)
+{
+  static thread_local std::vector<float> buffer;
+
+  if (buffer.size() < _length)
+    buffer.resize(_length);
+
+  return buffer.data();
+};
+
+#endif
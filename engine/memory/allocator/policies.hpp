@@ -0,0 +1,127 @@
+// File Name:     policies.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Allocation policies bound to memory classes at compile time
+
+// ---------------------
+// Detail Description:
+// "Allocator" is picked at runtime, every allocation through it is a branch on the pointer
+// and an indirect call, and the compiler can`t see through either. A policy is a type with
+// static "Allocate" and "Deallocate" functions given to a memory class as a template argument,
+// e.g. LinearHeapMemory<float, PoolAllocPolicy<4096>>, the calls are resolved at compile time
+// and inlined, so taking a chunk from a pool is a few loads and stores.
+// "RuntimeAllocPolicy" is the default, it keeps the behaviour of "Allocator" and "new".
+// ---------------------
+
+// ---------------------
+// Note:
+// "Deallocate" gets the size given to "Allocate", policies can use it to find where
+// the memory came from without a header in front of it
+// ---------------------
+
+// ---------------------
+// Note:
+// Pools and arenas keep their state per thread, memory allocated by one thread can be
+// deallocated by another one, a pool chunk then goes to the free list of the deallocating thread
+// ---------------------
+
+// =====
+// [RuntimeAllocPolicy]: Not a policy, tells the memory class to use its "Allocator" if it has one,
+// and "new" and "delete" otherwise
+// =====
+
+// =====
+// [HeapAllocPolicy<ALIGNMENT>]: "operator new" and "operator delete", the aligned overloads are
+// used only for alignments above the default one, they are several times slower in glibc
+// =====
+
+// =====
+// [PoolAllocPolicy<CHUNK_SIZE, TAG>]: Allocations of up to CHUNK_SIZE bytes take a chunk from
+// a free list and give it back on deallocation, bigger ones go to the heap, all of them aligned
+// to MNT_ALLOC_ALIGNMENT bytes.
+// Each TAG has its own free lists, chunks go back to the system only with "Trim()"
+// =====
+
+// =====
+// [ArenaAllocPolicy<TAG>]: Bumps a pointer in blocks of MNT_ARENA_BLOCK_SIZE bytes, in steps of
+// MNT_ALLOC_ALIGNMENT bytes, "Deallocate" does nothing. "Release()" frees everything the calling
+// thread allocated at once but keeps its first block for the next round, it is for
+// the temporaries of one pass that all die together
+// =====
+
+#ifndef ENGINE_MEMORY_POLICIES_HPP
+#define ENGINE_MEMORY_POLICIES_HPP
+
+#include "configs.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace mnt {
+
+  struct RuntimeAllocPolicy
+  {
+  };
+
+  template <size_t ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__>
+  struct HeapAllocPolicy
+  {
+    static void* Allocate(const size_t _size);
+    static void Deallocate(void* _memory, const size_t _size) noexcept;
+  };
+
+  template <size_t CHUNK_SIZE, typename TAG = void>
+  struct PoolAllocPolicy
+  {
+    static_assert(CHUNK_SIZE >= sizeof(void*), "A free chunk holds the pointer to the next one");
+
+    static void* Allocate(const size_t _size);
+    static void Deallocate(void* _memory, const size_t _size) noexcept;
+
+    // Frees the free chunks of the calling thread
+    static void Trim() noexcept;
+
+  private:
+    using Heap = HeapAllocPolicy<MNT_ALLOC_ALIGNMENT>;
+
+    struct FreeList
+    {
+      void* head = nullptr;
+
+      void Clear() noexcept;
+      ~FreeList() noexcept {Clear();};
+    };
+
+    static FreeList& Local() noexcept;
+  };
+
+  template <typename TAG = void>
+  struct ArenaAllocPolicy
+  {
+    static void* Allocate(const size_t _size);
+    static void Deallocate(void*, const size_t) noexcept {};
+
+    // Frees the allocations of the calling thread, nothing allocated by it may be used afterwards
+    static void Release() noexcept;
+
+  private:
+    using Heap = HeapAllocPolicy<MNT_ALLOC_ALIGNMENT>;
+
+    struct Arena
+    {
+      std::vector<void*> blocks;
+      std::vector<void*> large;
+      char* next = nullptr;
+      size_t left = 0;
+
+      void Clear() noexcept;
+      ~Arena() noexcept {Clear();};
+    };
+
+    static Arena& Local() noexcept;
+  };
+}
+
+#include "memory/allocator/policies.inl"
+
+#endif
@@ -0,0 +1,168 @@
+// File Name:     policies.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Allocation policies bound to memory classes at compile time
+
+#ifndef ENGINE_MEMORY_POLICIES_INL
+#define ENGINE_MEMORY_POLICIES_INL
+
+#include "memory/allocator/policies.hpp"
+
+#include "utils/mntexcept.hpp"
+
+#include <new>
+
+using namespace mnt;
+
+template <size_t ALIGNMENT>
+void* HeapAllocPolicy<ALIGNMENT>::Allocate(const size_t _size)
+{
+  // "operator new" throws std::bad_alloc, the memory classes report MNT exceptions
+  void* memory;
+  if constexpr (ALIGNMENT > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    memory = ::operator new(_size, std::align_val_t(ALIGNMENT), std::nothrow);
+  else
+    memory = ::operator new(_size, std::nothrow);
+
+  if (!memory)
+    MNT_THROW("new operation failed, this is a severe error!");
+
+  return memory;
+};
+
+template <size_t ALIGNMENT>
+void HeapAllocPolicy<ALIGNMENT>::Deallocate(void* _memory, const size_t) noexcept
+{
+  if constexpr (ALIGNMENT > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    ::operator delete(_memory, std::align_val_t(ALIGNMENT));
+  else
+    ::operator delete(_memory);
+};
+
+template <size_t CHUNK_SIZE, typename TAG>
+void* PoolAllocPolicy<CHUNK_SIZE, TAG>::Allocate(const size_t _size)
+{
+  if (_size > CHUNK_SIZE)
+    return Heap::Allocate(_size);
+
+  FreeList& list = Local();
+  if (!list.head)
+    return Heap::Allocate(CHUNK_SIZE);
+
+  void* chunk = list.head;
+  list.head = *(void**)chunk;
+  return chunk;
+};
+
+template <size_t CHUNK_SIZE, typename TAG>
+void PoolAllocPolicy<CHUNK_SIZE, TAG>::Deallocate(void* _memory, const size_t _size) noexcept
+{
+  if (_size > CHUNK_SIZE)
+  {
+    Heap::Deallocate(_memory, _size);
+    return;
+  }
+
+  FreeList& list = Local();
+  *(void**)_memory = list.head;
+  list.head = _memory;
+};
+
+template <size_t CHUNK_SIZE, typename TAG>
+void PoolAllocPolicy<CHUNK_SIZE, TAG>::Trim() noexcept
+{
+  Local().Clear();
+};
+
+template <size_t CHUNK_SIZE, typename TAG>
+void PoolAllocPolicy<CHUNK_SIZE, TAG>::FreeList::Clear() noexcept
+{
+  while (head)
+  {
+    void* chunk = head;
+    head = *(void**)chunk;
+    Heap::Deallocate(chunk, CHUNK_SIZE);
+  }
+};
+
+template <size_t CHUNK_SIZE, typename TAG>
+typename PoolAllocPolicy<CHUNK_SIZE, TAG>::FreeList& PoolAllocPolicy<CHUNK_SIZE, TAG>::Local() noexcept
+{
+  static thread_local FreeList list;
+  return list;
+};
+
+template <typename TAG>
+void* ArenaAllocPolicy<TAG>::Allocate(const size_t _size)
+{
+  // Every allocation keeps the alignment of the blocks
+  const size_t size = (_size + MNT_ALLOC_ALIGNMENT - 1) / MNT_ALLOC_ALIGNMENT * MNT_ALLOC_ALIGNMENT;
+
+  Arena& arena = Local();
+  if (size <= arena.left)
+  {
+    void* memory = arena.next;
+    arena.next += size;
+    arena.left -= size;
+    return memory;
+  }
+
+  // Allocations bigger than a block get one of their own, the current block stays in use
+  if (size > MNT_ARENA_BLOCK_SIZE)
+  {
+    arena.large.reserve(arena.large.size() + 1);
+    void* memory = Heap::Allocate(size);
+    arena.large.push_back(memory);
+    return memory;
+  }
+
+  arena.blocks.reserve(arena.blocks.size() + 1);
+  char* block = (char*)Heap::Allocate(MNT_ARENA_BLOCK_SIZE);
+  arena.blocks.push_back(block);
+
+  arena.next = block + size;
+  arena.left = MNT_ARENA_BLOCK_SIZE - size;
+  return block;
+};
+
+// The first block is kept and rewound, the pages of the next pass are already mapped
+template <typename TAG>
+void ArenaAllocPolicy<TAG>::Release() noexcept
+{
+  Arena& arena = Local();
+  if (arena.blocks.empty())
+    return;
+
+  void* first = arena.blocks[0];
+  arena.blocks[0] = nullptr;
+  arena.Clear();
+
+  arena.blocks.push_back(first);
+  arena.next = (char*)first;
+  arena.left = MNT_ARENA_BLOCK_SIZE;
+};
+
+template <typename TAG>
+void ArenaAllocPolicy<TAG>::Arena::Clear() noexcept
+{
+  for (void* block : blocks)
+    if (block)
+      Heap::Deallocate(block, MNT_ARENA_BLOCK_SIZE);
+
+  for (void* memory : large)
+    Heap::Deallocate(memory, 0);
+
+  blocks.clear();
+  large.clear();
+  next = nullptr;
+  left = 0;
+};
+
+template <typename TAG>
+typename ArenaAllocPolicy<TAG>::Arena& ArenaAllocPolicy<TAG>::Local() noexcept
+{
+  static thread_local Arena arena;
+  return arena;
+};
+
+#endif
@@ -76,6 +76,10 @@ namespace mnt {
 
     inline uint16_t NoOfBlocks() {return m_no_of_blocks;};
 
+    // One span per block, the last ones are shorter or empty
+    size_t NoOfSpans() const noexcept override;
+    MemorySpan<T> Span(const size_t _index) noexcept override;
+
     void SaveToFile(const char* _file_path);
     virtual void LoadFromFile(const char* _file_path) = 0;
     virtual void LoadFromFile(const char* _file_path, const uint16_t _no_of_blocks) = 0;
@@ -11,6 +11,7 @@
 #include "utils/general.hpp"
 #include "utils/mntexcept.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -19,7 +20,9 @@ using namespace mnt;
 
 template <typename T>
 BlockMemory<T>::BlockMemory(Allocator* _allocator): MNTMemory<T> (_allocator)
-{};
+{
+  this->m_kind = MemoryKind::Block;
+};
 
 // =====
 // Note:
@@ -57,6 +60,22 @@ const T& BlockMemory<T>::operator [] (const size_t _index) const noexcept
   return *((T*)block_address + block_offset);
 };
 
+template <typename T>
+size_t BlockMemory<T>::NoOfSpans() const noexcept
+{
+  return this->m_allocated ? m_no_of_blocks : 0;
+};
+
+// Blocks have room for m_block_length items, only the first m_length items of all of them are used
+template <typename T>
+MemorySpan<T> BlockMemory<T>::Span(const size_t _index) noexcept
+{
+  const size_t begin = _index * m_block_length;
+  const size_t length = begin < this->m_length ? std::min(m_block_length, this->m_length - begin) : 0;
+
+  return {(T*)*(m_block_array + _index), length};
+};
+
 template <typename T>
 void BlockMemory<T>::Write(const size_t _offset, const void* _buffer, const size_t _buffer_length)
 {
@@ -64,8 +83,8 @@ void BlockMemory<T>::Write(const size_t _offset, const void* _buffer, const size
     MNT_THROW("This memory object doesn`t have enought memory for this operation");
 
   // This is inefficient - Change the implementation if become necessary
-  for(size_t i=_offset; i < _buffer_length; i++)
-    this[0][i] = ((T*)_buffer)[0][i];
+  for(size_t i=0; i < _buffer_length; i++)
+    (*this)[_offset + i] = ((const T*)_buffer)[i];
 };
 
 // Provides strong exception safety
@@ -80,7 +80,7 @@ void BlockHeapMemory<T>::Allocate(const size_t _length, const uint16_t _no_of_bl
   {
     sprintf_mnt(exception_message,
                 MNT_EXCEPTION_MESSAGE_SIZE,
-                "Couldn`t allocate %d bytes of memory",
+                "Couldn`t allocate %zu bytes of memory",
                 this->m_no_of_blocks*sizeof(void*));
     MNT_THROW(exception_message);
   }
@@ -101,7 +101,7 @@ void BlockHeapMemory<T>::Allocate(const size_t _length, const uint16_t _no_of_bl
       {
         sprintf_mnt(exception_message,
                     MNT_EXCEPTION_MESSAGE_SIZE,
-                    "Couldn`t allocate %d bytes of memory",
+                    "Couldn`t allocate %zu bytes of memory",
                     this->m_block_size);
         MNT_THROW(exception_message);
       }
@@ -238,7 +238,7 @@ void BlockHeapMemory<T>::Resize(const size_t _length)
         {
           sprintf_mnt(exception_message,
                       MNT_EXCEPTION_MESSAGE_SIZE,
-                      "Couldn`t allocate %d bytes of memory",
+                      "Couldn`t allocate %zu bytes of memory",
                       this->m_no_of_blocks*sizeof(void*));
           MNT_THROW(exception_message);
         }
@@ -266,7 +266,7 @@ void BlockHeapMemory<T>::Resize(const size_t _length)
             {
               sprintf_mnt(exception_message,
                           MNT_EXCEPTION_MESSAGE_SIZE,
-                          "Couldn`t allocate %d bytes of memory",
+                          "Couldn`t allocate %zu bytes of memory",
                           this->m_block_size);
               MNT_THROW(exception_message);
             }
@@ -26,6 +26,11 @@
 // [operator []]: Returns the _index`th item of the array
 // =====
 
+// =====
+// [Data()]: Returns the pointer to the first item, items are contiguous, so kernels
+// can access the memory without the virtual call of "operator []" per item
+// =====
+
 // =====
 // [GetAsType(_index)]: Returns a reference to the content of memory
 // from _index to _index + sizeof(U) interpreted as type U
@@ -59,6 +64,13 @@ namespace mnt {
 
     void Write(const size_t _offset, const void* _buffer,const size_t _buffer_length) override;
 
+    inline T* Data() noexcept {return (T*)m_memory;};
+    inline const T* Data() const noexcept {return (const T*)m_memory;};
+
+    inline size_t NoOfSpans() const noexcept override {return 1;};
+    // Linear memory is a single span, any index is span 0
+    inline MemorySpan<T> Span(const size_t) noexcept override {return {Data(), this->m_length};};
+
     template<typename U>
     U& GetAsType(const size_t _index);
 
@@ -73,7 +85,7 @@ namespace mnt {
     virtual ~LinearMemory() noexcept = default;
 
   protected:
-    void* m_memory;
+    void* m_memory = nullptr;
   };
 }
 
@@ -20,7 +20,9 @@ using namespace mnt;
 
 template <typename T>
 LinearMemory<T>::LinearMemory(Allocator* _allocator): MNTMemory<T> (_allocator)
-{};
+{
+  this->m_kind = MemoryKind::Linear;
+};
 
 // =====
 // Note:
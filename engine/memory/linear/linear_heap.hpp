@@ -10,6 +10,14 @@
 // it needs a type as template argument in addition to it`s length and uses "new" and "delete"
 // ---------------------
 
+// ---------------------
+// Note:
+// The second template argument binds an allocation policy at compile time, see
+// "memory/allocator/policies.hpp", e.g. LinearHeapMemory<float, PoolAllocPolicy<4096>>.
+// The default, "RuntimeAllocPolicy", uses the "Allocator" given to the constructor, or "new"
+// and "delete" without one, the other policies inline their calls and ignore "Allocator"
+// ---------------------
+
 // =====
 // [LoadFromFile(_file_path)]: Load content of memory from a binary file
 // =====
@@ -24,18 +32,21 @@
 #define ENGINE_MEMORY_LINEAR_HEA_HPP
 
 #include "memory/linear/linear.hpp"
+#include "memory/allocator/policies.hpp"
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace mnt {
-  template <typename T>
+  template <typename T, typename ALLOC_POLICY = RuntimeAllocPolicy>
   class LinearHeapMemory : public LinearMemory<T>
   {
   public:
     LinearHeapMemory() = default;
     LinearHeapMemory(const char* _file_path);
     LinearHeapMemory(const size_t _length);
+    LinearHeapMemory(const size_t _length, Allocator* _allocator);
     ~LinearHeapMemory() noexcept;
 
     void LoadFromFile(const char* _file_path) override;
@@ -45,6 +56,12 @@ namespace mnt {
     void Allocate(const size_t _length);
     void Deallocate() noexcept;
 
+  private:
+    // Only these two know where the memory comes from
+    void* AllocateItems(const size_t _length);
+    void DeallocateItems(void* _memory, const size_t _length) noexcept;
+
+    static constexpr bool runtime_policy = std::is_same<ALLOC_POLICY, RuntimeAllocPolicy>::value;
   };
 }
 
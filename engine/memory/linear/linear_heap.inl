@@ -15,33 +15,39 @@
 
 using namespace mnt;
 
-template <typename T>
-LinearHeapMemory<T>::LinearHeapMemory(const char* _file_path)
+template <typename T, typename ALLOC_POLICY>
+LinearHeapMemory<T, ALLOC_POLICY>::LinearHeapMemory(const char* _file_path)
 {
   LoadFromFile(_file_path);
 };
 
-template <typename T>
-LinearHeapMemory<T>::LinearHeapMemory(const size_t _length)
+template <typename T, typename ALLOC_POLICY>
+LinearHeapMemory<T, ALLOC_POLICY>::LinearHeapMemory(const size_t _length)
 {
   if (_length > 0)
     Allocate(_length);
 };
 
-template <typename T>
-LinearHeapMemory<T>::~LinearHeapMemory() noexcept
+template <typename T, typename ALLOC_POLICY>
+LinearHeapMemory<T, ALLOC_POLICY>::LinearHeapMemory(const size_t _length, Allocator* _allocator) : LinearMemory<T>(_allocator)
+{
+  static_assert(runtime_policy, "Only RuntimeAllocPolicy uses an Allocator");
+
+  if (_length > 0)
+    Allocate(_length);
+};
+
+template <typename T, typename ALLOC_POLICY>
+LinearHeapMemory<T, ALLOC_POLICY>::~LinearHeapMemory() noexcept
 {
   Deallocate();
 };
 
 // Provides strong exception safety
-template <typename T>
-void LinearHeapMemory<T>::Allocate(const size_t _length)
+template <typename T, typename ALLOC_POLICY>
+void LinearHeapMemory<T, ALLOC_POLICY>::Allocate(const size_t _length)
 {
-
-  this->m_memory = this->m_allocator ?
-          (this->m_allocator->Allocate(_length * sizeof(T))) :
-          new T[_length];
+  this->m_memory = AllocateItems(_length);
 
   if (!this->m_memory)
     MNT_THROW("new operation failed, this is a severe error!");
@@ -51,22 +57,21 @@ void LinearHeapMemory<T>::Allocate(const size_t _length)
   this->m_allocated = true;
 };
 
-template <typename T>
-void LinearHeapMemory<T>::Deallocate() noexcept
+template <typename T, typename ALLOC_POLICY>
+void LinearHeapMemory<T, ALLOC_POLICY>::Deallocate() noexcept
 {
+  if (this->m_memory)
+    DeallocateItems(this->m_memory, this->m_length);
 
-  this->m_allocator ?
-            this->m_allocator->Deallocate(this->m_memory) :
-            delete[] (T*)this->m_memory;
-
+  this->m_memory = nullptr;
   this->m_length = 0;
   this->m_size = 0;
   this->m_allocated = false;
 };
 
 // Provides basic exception safety
-template <typename T>
-void LinearHeapMemory<T>::LoadFromFile(const char* _file_path)
+template <typename T, typename ALLOC_POLICY>
+void LinearHeapMemory<T, ALLOC_POLICY>::LoadFromFile(const char* _file_path)
 {
   auto input_file = std::fstream(_file_path, std::ios::in | std::ios::binary | std::ios::ate);
 
@@ -108,8 +113,8 @@ void LinearHeapMemory<T>::LoadFromFile(const char* _file_path)
 };
 
 // "Resize" function provides strong exception safety
-template <typename T>
-void LinearHeapMemory<T>::Resize(const size_t _length)
+template <typename T, typename ALLOC_POLICY>
+void LinearHeapMemory<T, ALLOC_POLICY>::Resize(const size_t _length)
 {
   if (_length == this->m_length) return;
   if (_length == 0) {Deallocate(); return;}
@@ -118,12 +123,12 @@ void LinearHeapMemory<T>::Resize(const size_t _length)
   {
     void* previous_pointer = this->m_memory;
 
-    this->m_memory = new T[_length];
+    this->m_memory = AllocateItems(_length);
 
     size_t copy_size_bytes = sizeof (T) * (_length > this->m_length ? this->m_length : _length);
     memcpy(this->m_memory, previous_pointer, copy_size_bytes);
 
-    delete[] (T*)previous_pointer;
+    DeallocateItems(previous_pointer, this->m_length);
 
     this->m_length = _length;
     this->m_size = _length * sizeof(T);
@@ -136,6 +141,32 @@ void LinearHeapMemory<T>::Resize(const size_t _length)
   }
 };
 
+// The policy is known at compile time, only the runtime one keeps the branch on the Allocator
+template <typename T, typename ALLOC_POLICY>
+void* LinearHeapMemory<T, ALLOC_POLICY>::AllocateItems(const size_t _length)
+{
+  if constexpr (runtime_policy)
+    return this->m_allocator ? this->m_allocator->Allocate(_length * sizeof(T)) : new T[_length];
+  else
+    return ALLOC_POLICY::Allocate(_length * sizeof(T));
+};
+
+template <typename T, typename ALLOC_POLICY>
+void LinearHeapMemory<T, ALLOC_POLICY>::DeallocateItems(void* _memory, const size_t _length) noexcept
+{
+  if constexpr (runtime_policy)
+  {
+    if (this->m_allocator)
+      this->m_allocator->Deallocate(_memory);
+    else
+      delete[] (T*)_memory;
+  }
+  else
+  {
+    ALLOC_POLICY::Deallocate(_memory, _length * sizeof(T));
+  }
+};
+
 #endif
 
 
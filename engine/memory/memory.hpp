@@ -46,6 +46,19 @@
 // The base class of memory subsystem, it is an abstract class that needs implementation
 // Memory classes can recieve custome "mnt::Allocator" class as their constructor parameter,
 // If no Allocator class provided, "new" and "delete" will be used.
+// Heap memories can also bind an allocation policy at compile time, see "memory/allocator/policies.hpp"
+// It also holds the reference count of "MemoryRef", so sharing a memory doesn`t
+// need a separate control block
+// =====
+
+// =====
+// [Kind()]: How the items are stored, it is not virtual, kernels check it once per operation
+// and then work on raw pointers instead of calling "operator []" for every item
+// =====
+
+// =====
+// [Span(_index)]: The _index`th contiguous run of items, in order, linear memories have one
+// run and block memories one per block, the runs together hold exactly "Length" items
 // =====
 
 
@@ -54,10 +67,29 @@
 
 #include "memory/allocator/blueprint.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 namespace mnt {
 
+  template<typename T>
+  class MemoryRef;
+
+  enum class MemoryKind : uint8_t
+  {
+    Linear = 0,  // One contiguous array
+    Block        // An array of contiguous blocks
+  };
+
+  // A contiguous run of items
+  template<typename T>
+  struct MemorySpan
+  {
+    T* data;
+    size_t length;
+  };
+
   template<typename T>
   class MNTMemory
   {
@@ -76,7 +108,11 @@ namespace mnt {
     virtual const T& operator [] (const size_t _index) const noexcept = 0;
 
     inline size_t Size() noexcept {return this->m_size;}
-    inline size_t Length() {return m_length;};
+    inline size_t Length() const noexcept {return m_length;};
+    inline MemoryKind Kind() const noexcept {return m_kind;};
+
+    virtual size_t NoOfSpans() const noexcept = 0;
+    virtual MemorySpan<T> Span(const size_t _index) noexcept = 0;
 
     // Attention: "Resize" gets the length as parameter, not the size
     virtual void Resize(const size_t _length) = 0;
@@ -93,6 +129,15 @@ namespace mnt {
 
     bool m_allocated = false;
     Allocator* m_allocator = nullptr;
+
+    // Set by the constructors of the subclasses
+    MemoryKind m_kind = MemoryKind::Linear;
+
+  private:
+    friend class MemoryRef<T>;
+
+    // Number of MemoryRef owning this memory
+    std::atomic<uint32_t> m_references{0};
   };
 }
 
@@ -0,0 +1,65 @@
+// File Name:     memory_ref.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Shared ownership of memory classes with an intrusive reference count
+
+// ---------------------
+// Detail Description:
+// Tensors and their views share one memory object, std::shared_ptr would allocate a control
+// block for it or, with std::make_shared, glue one to it, and every copy would update two
+// counters. MemoryRef keeps the count inside MNTMemory itself, so owning a memory costs a
+// pointer, sharing it an atomic increment, and moving a MemoryRef nothing at all.
+// The last MemoryRef that lets go deletes the memory.
+// ---------------------
+
+// ---------------------
+// Note:
+// The memory must be allocated with "new", and once a MemoryRef owns it, it must not be
+// deleted by anyone else. The count is thread safe, the memory itself is not
+// ---------------------
+
+// =====
+// [MemoryRef(_memory)]: Takes the ownership of _memory, shared with any other MemoryRef of it
+// =====
+
+#ifndef ENGINE_MEMORY_MEMORY_REF_HPP
+#define ENGINE_MEMORY_MEMORY_REF_HPP
+
+#include "memory/memory.hpp"
+
+#include <cstddef>
+
+namespace mnt {
+
+  template<typename T>
+  class MemoryRef
+  {
+  public:
+    MemoryRef() noexcept = default;
+    explicit MemoryRef(MNTMemory<T>* _memory) noexcept;
+    ~MemoryRef() noexcept;
+
+    MemoryRef(const MemoryRef& _other) noexcept;
+    MemoryRef(MemoryRef&& _other) noexcept;
+    MemoryRef& operator = (const MemoryRef& _other) noexcept;
+    MemoryRef& operator = (MemoryRef&& _other) noexcept;
+
+    inline MNTMemory<T>* Get() const noexcept {return m_memory;};
+    inline MNTMemory<T>* operator -> () const noexcept {return m_memory;};
+    inline MNTMemory<T>& operator * () const noexcept {return *m_memory;};
+    inline explicit operator bool () const noexcept {return m_memory != nullptr;};
+
+    // Number of MemoryRef sharing the memory, 0 if empty
+    size_t References() const noexcept;
+
+    // Lets go of the memory
+    void Reset() noexcept;
+
+  private:
+    MNTMemory<T>* m_memory = nullptr;
+  };
+}
+
+#include "memory/memory_ref.inl"
+
+#endif
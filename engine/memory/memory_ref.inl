@@ -0,0 +1,82 @@
+// File Name:     memory_ref.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Shared ownership of memory classes with an intrusive reference count
+
+#ifndef ENGINE_MEMORY_MEMORY_REF_INL
+#define ENGINE_MEMORY_MEMORY_REF_INL
+
+#include "memory/memory_ref.hpp"
+
+using namespace mnt;
+
+template<typename T>
+MemoryRef<T>::MemoryRef(MNTMemory<T>* _memory) noexcept
+{
+  m_memory = _memory;
+  if (m_memory)
+    m_memory->m_references.fetch_add(1, std::memory_order_relaxed);
+};
+
+template<typename T>
+MemoryRef<T>::~MemoryRef() noexcept
+{
+  Reset();
+};
+
+template<typename T>
+MemoryRef<T>::MemoryRef(const MemoryRef& _other) noexcept : MemoryRef(_other.m_memory)
+{
+};
+
+template<typename T>
+MemoryRef<T>::MemoryRef(MemoryRef&& _other) noexcept
+{
+  m_memory = _other.m_memory;
+  _other.m_memory = nullptr;
+};
+
+template<typename T>
+MemoryRef<T>& MemoryRef<T>::operator = (const MemoryRef& _other) noexcept
+{
+  // Taking the new reference first makes self assignment safe
+  if (_other.m_memory)
+    _other.m_memory->m_references.fetch_add(1, std::memory_order_relaxed);
+
+  Reset();
+  m_memory = _other.m_memory;
+
+  return *this;
+};
+
+template<typename T>
+MemoryRef<T>& MemoryRef<T>::operator = (MemoryRef&& _other) noexcept
+{
+  if (this != &_other)
+  {
+    Reset();
+    m_memory = _other.m_memory;
+    _other.m_memory = nullptr;
+  }
+
+  return *this;
+};
+
+template<typename T>
+size_t MemoryRef<T>::References() const noexcept
+{
+  return m_memory ? m_memory->m_references.load(std::memory_order_relaxed) : 0;
+};
+
+// The release pairs with the acquire of the owner that deletes the memory, so every
+// write through the other owners happens before the destructor
+template<typename T>
+void MemoryRef<T>::Reset() noexcept
+{
+  if (m_memory && m_memory->m_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    delete m_memory;
+
+  m_memory = nullptr;
+};
+
+#endif
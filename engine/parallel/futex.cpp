@@ -0,0 +1,62 @@
+// File Name:     futex.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Minimal wait/wake on the address of a 32-bit atomic
+
+#include "parallel/futex.hpp"
+
+#include "utils/general.hpp"
+
+#if defined(__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+  #include <climits>
+#elif defined(_WIN32)
+  #include <windows.h>
+  #pragma comment(lib, "synchronization.lib")
+#else
+  #include <thread>
+  #include <chrono>
+#endif
+
+using namespace mnt;
+
+// std::atomic<uint32_t> is lock-free and has the same layout as uint32_t on all supported
+// platforms, so its address can be handed to the OS
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "unexpected std::atomic layout");
+
+void Futex::Wait(std::atomic<uint32_t>* _address, uint32_t _expected) noexcept
+{
+#if defined(__linux__)
+  syscall(SYS_futex, (uint32_t*)_address, FUTEX_WAIT_PRIVATE, _expected, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+  WaitOnAddress((volatile VOID*)_address, &_expected, sizeof(uint32_t), INFINITE);
+#else
+  // No portable futex, sleeping shortly is the best we can do
+  if (_address->load(std::memory_order_acquire) == _expected)
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+};
+
+void Futex::WakeOne(std::atomic<uint32_t>* _address) noexcept
+{
+#if defined(__linux__)
+  syscall(SYS_futex, (uint32_t*)_address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+  WakeByAddressSingle((PVOID)_address);
+#else
+  MNTUSE(_address)
+#endif
+};
+
+void Futex::WakeAll(std::atomic<uint32_t>* _address) noexcept
+{
+#if defined(__linux__)
+  syscall(SYS_futex, (uint32_t*)_address, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+  WakeByAddressAll((PVOID)_address);
+#else
+  MNTUSE(_address)
+#endif
+};
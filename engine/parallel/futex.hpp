@@ -0,0 +1,58 @@
+// File Name:     futex.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Minimal wait/wake on the address of a 32-bit atomic
+
+// ---------------------
+// Detail Description:
+// Idle threads of the engine spin for a short while and then park with "Wait", the thread
+// that changes the value wakes them with "WakeOne" or "WakeAll". On Linux it is a private
+// futex, on Windows WaitOnAddress, elsewhere the waiting thread sleeps and polls.
+// ---------------------
+
+// ---------------------
+// Note:
+// "Wait" can return spuriously, callers should always re-check the value in a loop
+// ---------------------
+
+// =====
+// [Wait(_address, _expected)]: Blocks while *_address == _expected
+// =====
+
+// =====
+// [CpuRelax()]: Hint to the CPU that the thread is spinning (PAUSE on x86, YIELD on ARM)
+// =====
+
+#ifndef ENGINE_PARALLEL_FUTEX_HPP
+#define ENGINE_PARALLEL_FUTEX_HPP
+
+#include "utils/platform.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(MNT_ARCH_X86_64) || defined(MNT_ARCH_X86)
+  #include <immintrin.h>
+#endif
+
+namespace mnt {
+
+  class Futex
+  {
+  public:
+    static void Wait(std::atomic<uint32_t>* _address, uint32_t _expected) noexcept;
+    static void WakeOne(std::atomic<uint32_t>* _address) noexcept;
+    static void WakeAll(std::atomic<uint32_t>* _address) noexcept;
+  };
+
+  inline void CpuRelax() noexcept
+  {
+#if defined(MNT_ARCH_X86_64) || defined(MNT_ARCH_X86)
+    _mm_pause();
+#elif (defined(MNT_ARCH_ARM64) || defined(MNT_ARCH_ARM)) && !defined(_MSC_VER)
+    __asm__ __volatile__("yield");
+#endif
+  }
+}
+
+#endif
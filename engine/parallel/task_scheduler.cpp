@@ -0,0 +1,393 @@
+// File Name:     task_scheduler.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Work-stealing task scheduler and dependency graphs of tasks
+
+#include "parallel/task_scheduler.hpp"
+#include "parallel/futex.hpp"
+
+#include "utils/general.hpp"
+#include "utils/mntexcept.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+using namespace mnt;
+
+static const size_t g_no_worker = (size_t)-1;
+
+// The scheduler and the index of the worker that runs on the current thread
+static thread_local TaskScheduler* t_scheduler = nullptr;
+static thread_local size_t t_worker = g_no_worker;
+
+// xorshift64, to pick the victims of stealing
+static thread_local uint64_t t_random_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t NextRandom() noexcept
+{
+  t_random_state ^= t_random_state << 13;
+  t_random_state ^= t_random_state >> 7;
+  t_random_state ^= t_random_state << 17;
+  return t_random_state;
+}
+
+TaskScheduler::TaskScheduler(size_t _no_of_threads)
+{
+  if (_no_of_threads == 0)
+    _no_of_threads = std::thread::hardware_concurrency();
+  if (_no_of_threads == 0)
+    _no_of_threads = 1;
+
+  // The thread that waits on a counter is the last one
+  for (size_t i=0; i+1<_no_of_threads; i++)
+    m_workers.emplace_back(new Worker());
+
+  try
+  {
+    for (size_t i=0; i<m_workers.size(); i++)
+      m_workers[i]->thread = std::thread(&TaskScheduler::WorkerLoop, this, i);
+  }
+  catch (std::exception&)
+  {
+    m_stop.store(true);
+    m_epoch.fetch_add(1);
+    Futex::WakeAll(&m_epoch);
+
+    for (auto& worker : m_workers)
+      if (worker->thread.joinable())
+        worker->thread.join();
+
+    MNT_THROW("Failed to create the worker threads of the task scheduler");
+  }
+};
+
+TaskScheduler::~TaskScheduler() noexcept
+{
+  m_stop.store(true);
+  m_epoch.fetch_add(1);
+  Futex::WakeAll(&m_epoch);
+
+  for (auto& worker : m_workers)
+    worker->thread.join();
+};
+
+TaskScheduler& TaskScheduler::Global()
+{
+  // Local static variables are initialized once, in a thread safe manner
+  static TaskScheduler scheduler([]()
+  {
+    const char* threads = getenv(MNT_POOL_THREADS_ENV_VARIABLE);
+    return threads ? (size_t)strtoul(threads, nullptr, 10) : (size_t)0;
+  }());
+
+  return scheduler;
+};
+
+void TaskScheduler::Spawn(Task* _task)
+{
+  if (t_scheduler == this && t_worker != g_no_worker)
+  {
+    m_workers[t_worker]->deque.Push(_task);
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock(m_injection_mutex);
+    m_injection.push_back(_task);
+    m_injection_size.fetch_add(1);
+  }
+
+  Notify();
+};
+
+void TaskScheduler::Notify() noexcept
+{
+  // Same protocol as ThreadPool, a worker either sees the new epoch or is counted as sleeper
+  m_epoch.fetch_add(1);
+  if (m_sleepers.load() > 0)
+    Futex::WakeOne(&m_epoch);
+};
+
+bool TaskScheduler::FindTask(Task*& _task, size_t _self) noexcept
+{
+  if (_self != g_no_worker && m_workers[_self]->deque.Pop(_task))
+    return true;
+
+  if (m_injection_size.load(std::memory_order_relaxed) > 0)
+  {
+    std::lock_guard<std::mutex> lock(m_injection_mutex);
+    if (!m_injection.empty())
+    {
+      _task = m_injection.front();
+      m_injection.pop_front();
+      m_injection_size.fetch_sub(1);
+      return true;
+    }
+  }
+
+  size_t no_of_workers = m_workers.size();
+  if (no_of_workers == 0)
+    return false;
+
+  size_t first_victim = (size_t)(NextRandom() % no_of_workers);
+  for (size_t i=0; i<no_of_workers; i++)
+  {
+    size_t victim = (first_victim + i) % no_of_workers;
+    if (victim != _self && m_workers[victim]->deque.Steal(_task))
+      return true;
+  }
+
+  return false;
+};
+
+void TaskScheduler::Execute(Task* _task) noexcept
+{
+  while (_task)
+  {
+    TaskCounter* counter = _task->counter;
+
+    // After a failure the remaining tasks of the same counter are skipped
+    if (!counter || !counter->m_failed.load(std::memory_order_relaxed))
+    {
+      try
+      {
+        _task->function(_task->context, _task->index);
+      }
+      catch (...)
+      {
+        if (counter)
+        {
+          std::lock_guard<std::mutex> lock(counter->m_exception_mutex);
+          if (!counter->m_exception)
+            counter->m_exception = std::current_exception();
+          counter->m_failed.store(true);
+        }
+      }
+    }
+
+    // The first ready successor is the continuation, the others can be stolen
+    Task* next = nullptr;
+    for (Task* successor : _task->successors)
+      if (successor->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        if (!next)
+          next = successor;
+        else
+          Spawn(successor);
+      }
+
+    // Nothing of the task is touched after this point, the waiter may free it
+    // Waking only uses the address, it doesn`t read the memory
+    if (counter && counter->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      Futex::WakeAll(&counter->m_count);
+
+    _task = next;
+  }
+};
+
+void TaskScheduler::Wait(TaskCounter& _counter)
+{
+  size_t self = t_scheduler == this ? t_worker : g_no_worker;
+
+  // A thread from outside runs tasks here too, their loops go to the scheduler like the ones
+  // of the workers, the ThreadPool would add its own threads on top of the busy workers
+  struct DelegateGuard
+  {
+    ThreadPool::Delegate delegate = nullptr;
+    void* owner = nullptr;
+    bool installed = false;
+
+    DelegateGuard(TaskScheduler* _scheduler, bool _install) noexcept
+    {
+      if (!_install)
+        return;
+
+      ThreadPool::ThreadDelegate(delegate, owner);
+      ThreadPool::SetThreadDelegate(&TaskScheduler::Delegate, _scheduler);
+      installed = true;
+    };
+
+    ~DelegateGuard() noexcept
+    {
+      if (installed)
+        ThreadPool::SetThreadDelegate(delegate, owner);
+    };
+  } guard(this, self == g_no_worker);
+  const auto spin_duration = std::chrono::microseconds(MNT_POOL_SPIN_MICROSECONDS);
+  auto idle_start = std::chrono::steady_clock::now();
+  uint32_t spins = 0;
+
+  while (true)
+  {
+    uint32_t count = _counter.m_count.load(std::memory_order_acquire);
+    if (count == 0)
+      break;
+
+    Task* task;
+    if (FindTask(task, self))
+    {
+      Execute(task);
+      idle_start = std::chrono::steady_clock::now();
+      continue;
+    }
+
+    // Nothing to help with, the remaining tasks are running on other threads
+    CpuRelax();
+    if ((++spins & 63) == 0 && std::chrono::steady_clock::now() - idle_start > spin_duration)
+    {
+      Futex::Wait(&_counter.m_count, count);
+      idle_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  if (_counter.m_exception)
+    std::rethrow_exception(_counter.m_exception);
+};
+
+void TaskScheduler::RunChunks(size_t _no_of_chunks, ThreadPool::ChunkFunction _function, void* _context)
+{
+  if (_no_of_chunks == 0)
+    return;
+
+  std::vector<Task> tasks(_no_of_chunks);
+  TaskCounter counter((uint32_t)_no_of_chunks);
+
+  for (size_t i=0; i<_no_of_chunks; i++)
+  {
+    tasks[i].function = _function;
+    tasks[i].context = _context;
+    tasks[i].index = i;
+    tasks[i].counter = &counter;
+  }
+
+  for (size_t i=_no_of_chunks-1; i>0; i--)
+    Spawn(&tasks[i]);
+
+  Execute(&tasks[0]);
+  Wait(counter);
+};
+
+void TaskScheduler::Delegate(void* _owner, size_t _no_of_chunks,
+                             ThreadPool::ChunkFunction _function, void* _context)
+{
+  ((TaskScheduler*)_owner)->RunChunks(_no_of_chunks, _function, _context);
+};
+
+void TaskScheduler::WorkerLoop(size_t _index) noexcept
+{
+  t_scheduler = this;
+  t_worker = _index;
+  t_random_state ^= (uint64_t)(_index + 1) * 0xBF58476D1CE4E5B9ull;
+  ThreadPool::SetThreadDelegate(&TaskScheduler::Delegate, this);
+
+  const auto spin_duration = std::chrono::microseconds(MNT_POOL_SPIN_MICROSECONDS);
+
+  while (true)
+  {
+    // The epoch is read before looking for work and before the stop, a spawn or the stop after
+    // it changes the epoch, and the loops below don`t park on it
+    uint32_t seen_epoch = m_epoch.load();
+    if (m_stop.load())
+      break;
+
+    Task* task;
+    if (FindTask(task, _index))
+    {
+      Execute(task);
+      continue;
+    }
+
+    auto spin_start = std::chrono::steady_clock::now();
+    uint32_t spins = 0;
+    while (m_epoch.load(std::memory_order_acquire) == seen_epoch)
+    {
+      CpuRelax();
+
+      if ((++spins & 63) == 0 && std::chrono::steady_clock::now() - spin_start > spin_duration)
+      {
+        m_sleepers.fetch_add(1);
+        if (m_epoch.load() == seen_epoch && !m_stop.load())
+          Futex::Wait(&m_epoch, seen_epoch);
+        m_sleepers.fetch_sub(1);
+        break;
+      }
+    }
+  }
+
+  ThreadPool::SetThreadDelegate(nullptr, nullptr);
+};
+
+void TaskGraph::Depend(Node _node, Node _dependency)
+{
+  if (_node >= m_nodes.size() || _dependency >= m_nodes.size())
+    MNT_THROW("Task graph node doesn`t exist");
+
+  if (_node == _dependency)
+    MNT_THROW("A task can`t depend on itself");
+
+  m_nodes[_dependency].successors.push_back(_node);
+  m_nodes[_node].no_of_dependencies++;
+};
+
+// Kahn`s algorithm, all the nodes are visited only if there is no cycle
+void TaskGraph::CheckAcyclic() const
+{
+  std::vector<uint32_t> dependencies(m_nodes.size());
+  std::vector<Node> ready;
+
+  for (Node i=0; i<m_nodes.size(); i++)
+  {
+    dependencies[i] = m_nodes[i].no_of_dependencies;
+    if (dependencies[i] == 0)
+      ready.push_back(i);
+  }
+
+  size_t visited = 0;
+  while (!ready.empty())
+  {
+    Node node = ready.back();
+    ready.pop_back();
+    visited++;
+
+    for (Node successor : m_nodes[node].successors)
+      if (--dependencies[successor] == 0)
+        ready.push_back(successor);
+  }
+
+  if (visited != m_nodes.size())
+    MNT_THROW("Task graph has a cycle");
+};
+
+void TaskGraph::Run()
+{
+  Run(TaskScheduler::Global());
+};
+
+void TaskGraph::Run(TaskScheduler& _scheduler)
+{
+  if (m_nodes.empty())
+    return;
+
+  CheckAcyclic();
+
+  std::vector<Task> tasks(m_nodes.size());
+  TaskCounter counter((uint32_t)m_nodes.size());
+
+  for (Node i=0; i<m_nodes.size(); i++)
+  {
+    tasks[i].function = [](void* _context, size_t) {(*(std::function<void()>*)_context)();};
+    tasks[i].context = &m_nodes[i].function;
+    tasks[i].counter = &counter;
+    tasks[i].pending.store(m_nodes[i].no_of_dependencies, std::memory_order_relaxed);
+
+    tasks[i].successors.reserve(m_nodes[i].successors.size());
+    for (Node successor : m_nodes[i].successors)
+      tasks[i].successors.push_back(&tasks[successor]);
+  }
+
+  for (Node i=0; i<m_nodes.size(); i++)
+    if (m_nodes[i].no_of_dependencies == 0)
+      _scheduler.Spawn(&tasks[i]);
+
+  _scheduler.Wait(counter);
+};
@@ -0,0 +1,200 @@
+// File Name:     task_scheduler.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Work-stealing task scheduler and dependency graphs of tasks
+
+// ---------------------
+// Detail Description:
+// Every worker owns a Chase-Lev deque, spawned tasks go to the deque of the spawning
+// worker (or to a shared injection queue if spawned from outside), idle workers steal
+// from random victims. When a task finishes, its successors whose dependencies are all
+// done become ready, the first one runs right away on the same thread as a continuation,
+// the others are pushed to be stolen. This keeps all the cores busy with independent
+// branches of a network even when each op is too small to be split by itself.
+// ---------------------
+
+// ---------------------
+// Note:
+// Parallel loops (ParallelFor, etc.) called from inside a task don`t go to the ThreadPool,
+// their chunks become tasks of the scheduler, so a big op inside a graph still uses
+// the idle cores, and nothing is oversubscribed. It holds for the tasks that the thread
+// calling "Wait" runs as well, the scheduler takes over its loops until "Wait" returns
+// ---------------------
+
+// ---------------------
+// Note:
+// A task that waits (e.g. a nested loop) keeps executing other tasks while waiting,
+// so waiting never blocks a core as long as there is work to do
+// ---------------------
+
+// =====
+// [TaskCounter]: Counts unfinished tasks, "TaskScheduler::Wait" returns when it is zero,
+// it also keeps the first exception thrown by its tasks, which "Wait" rethrows
+// =====
+
+// =====
+// [TaskGraph]: A DAG of functions, e.g. two attention heads and their concatenation:
+//
+//   TaskGraph graph;
+//   auto head_1 = graph.Add([&]{ h1 = backend.Mul(q1, k1); });
+//   auto head_2 = graph.Add([&]{ h2 = backend.Mul(q2, k2); });
+//   graph.Add([&]{ out = backend.Add(h1, h2); }, {head_1, head_2});
+//   graph.Run();
+//
+// A graph can be run any number of times, "Run" throws if the graph has a cycle
+// =====
+
+#ifndef ENGINE_PARALLEL_TASK_SCHEDULER_HPP
+#define ENGINE_PARALLEL_TASK_SCHEDULER_HPP
+
+#include "configs.hpp"
+
+#include "parallel/work_stealing_deque.hpp"
+#include "parallel/thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mnt {
+
+  class TaskCounter
+  {
+  public:
+    explicit TaskCounter(uint32_t _count = 0) noexcept : m_count(_count) {};
+
+    inline void Add(uint32_t _count) noexcept {m_count.fetch_add(_count);};
+    inline uint32_t Count() const noexcept {return m_count.load(std::memory_order_acquire);};
+
+  private:
+    friend class TaskScheduler;
+
+    std::atomic<uint32_t> m_count;
+    std::atomic<bool> m_failed{false};
+    std::exception_ptr m_exception;
+    std::mutex m_exception_mutex;
+  };
+
+  struct Task
+  {
+    // The work of the task: function(context, index)
+    void (*function)(void*, size_t) = nullptr;
+    void* context = nullptr;
+    size_t index = 0;
+
+    // Unfinished dependencies, the task is spawned when it reaches zero
+    std::atomic<uint32_t> pending{0};
+    std::vector<Task*> successors;
+
+    // Decremented when the task is done, can be nullptr
+    TaskCounter* counter = nullptr;
+  };
+
+  class TaskScheduler
+  {
+  public:
+    explicit TaskScheduler(size_t _no_of_threads = 0);
+    ~TaskScheduler() noexcept;
+
+    // Removing copy, move constructors and assignment operator
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    void operator = (const TaskScheduler&) = delete;
+    void operator = (TaskScheduler&&) = delete;
+
+    // Created at the first call with the number of threads in MNT_NUM_THREADS
+    static TaskScheduler& Global();
+
+    // Number of workers, the thread that waits helps them as well
+    inline size_t NoOfWorkers() const noexcept {return m_workers.size();};
+
+    // The task must stay alive until its counter reaches zero
+    void Spawn(Task* _task);
+
+    // Executes tasks until the counter reaches zero, rethrows the first exception of its tasks
+    void Wait(TaskCounter& _counter);
+
+    // Runs _function(_context, i) for i in [0, _no_of_chunks) as stealable tasks
+    void RunChunks(size_t _no_of_chunks, ThreadPool::ChunkFunction _function, void* _context);
+
+  private:
+    struct Worker
+    {
+      WorkStealingDeque<Task*> deque;
+      std::thread thread;
+    };
+
+    void WorkerLoop(size_t _index) noexcept;
+
+    // Own deque first, then the injection queue, then stealing from a random victim
+    bool FindTask(Task*& _task, size_t _self) noexcept;
+
+    // Runs the task and its continuations
+    void Execute(Task* _task) noexcept;
+
+    void Notify() noexcept;
+
+    static void Delegate(void* _owner, size_t _no_of_chunks,
+                         ThreadPool::ChunkFunction _function, void* _context);
+
+  private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    // Tasks spawned from outside the workers
+    std::mutex m_injection_mutex;
+    std::deque<Task*> m_injection;
+    std::atomic<size_t> m_injection_size{0};
+
+    // Every spawn increments the epoch, parked workers wait on its address
+    alignas(64) std::atomic<uint32_t> m_epoch{0};
+    std::atomic<uint32_t> m_sleepers{0};
+
+    std::atomic<bool> m_stop{false};
+  };
+
+  class TaskGraph
+  {
+  public:
+    using Node = size_t;
+
+  public:
+    template <typename F>
+    Node Add(F&& _function);
+
+    template <typename F>
+    Node Add(F&& _function, std::initializer_list<Node> _dependencies);
+
+    // _node runs after _dependency is done
+    void Depend(Node _node, Node _dependency);
+
+    void Run();
+    void Run(TaskScheduler& _scheduler);
+
+    inline size_t Size() const noexcept {return m_nodes.size();};
+
+  private:
+    struct NodeData
+    {
+      std::function<void()> function;
+      std::vector<Node> successors;
+      uint32_t no_of_dependencies = 0;
+    };
+
+    void CheckAcyclic() const;
+
+  private:
+    std::vector<NodeData> m_nodes;
+  };
+}
+
+#include "parallel/task_scheduler.inl"
+
+#endif
@@ -0,0 +1,32 @@
+// File Name:     task_scheduler.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Work-stealing task scheduler and dependency graphs of tasks
+
+#ifndef ENGINE_PARALLEL_TASK_SCHEDULER_INL
+#define ENGINE_PARALLEL_TASK_SCHEDULER_INL
+
+#include "parallel/task_scheduler.hpp"
+
+#include <utility>
+
+using namespace mnt;
+
+template <typename F>
+TaskGraph::Node TaskGraph::Add(F&& _function)
+{
+  m_nodes.emplace_back();
+  m_nodes.back().function = std::forward<F>(_function);
+  return m_nodes.size() - 1;
+};
+
+template <typename F>
+TaskGraph::Node TaskGraph::Add(F&& _function, std::initializer_list<Node> _dependencies)
+{
+  Node node = Add(std::forward<F>(_function));
+  for (Node dependency : _dependencies)
+    Depend(node, dependency);
+  return node;
+};
+
+#endif
@@ -0,0 +1,233 @@
+// File Name:     task_scheduler_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the task scheduler, the task graphs and the work-stealing deque
+
+// ---------------------
+// Detail Description:
+// The deque is checked alone, by its owner and with thieves racing the owner, every item must
+// come out exactly once. The graphs record the order their nodes finish in, a node must finish
+// after all of its dependencies. The nodes of the nested graph run parallel loops, which go to
+// the scheduler instead of the ThreadPool. Schedulers are destroyed right after they are created,
+// before their workers had a chance to run, which used to leave a worker parked after the stop.
+// ---------------------
+
+#include "parallel/task_scheduler.hpp"
+#include "math/test_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  // Large enough per item that the nested loops are split into chunks
+  constexpr size_t cost = 10000;
+
+  void CheckDeque(Checks& _checks)
+  {
+    // A small capacity, so the pushes grow the array
+    WorkStealingDeque<size_t> deque(4);
+    size_t item = 0;
+
+    _checks.Expect(deque.Empty() && !deque.Pop(item) && !deque.Steal(item), "an empty deque has no items");
+
+    for (size_t i=0; i<1000; i++)
+      deque.Push(i);
+
+    // Thieves take the oldest items, the owner the newest
+    bool fifo = true;
+    for (size_t i=0; i<500; i++)
+      fifo &= deque.Steal(item) && item == i;
+    _checks.Expect(fifo, "Steal takes the items in the order they were pushed");
+
+    bool lifo = true;
+    for (size_t i=1000; i>500; i--)
+      lifo &= deque.Pop(item) && item == i - 1;
+    _checks.Expect(lifo, "Pop takes the items in the reverse order they were pushed");
+    _checks.Expect(deque.Empty() && !deque.Pop(item) && !deque.Steal(item), "a drained deque has no items");
+
+    // The owner pushes and pops while the thieves steal
+    const size_t no_of_items = 200000;
+    const size_t no_of_thieves = 3;
+    WorkStealingDeque<size_t> shared(4);
+    std::vector<std::atomic<uint32_t>> taken(no_of_items);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (size_t t=0; t<no_of_thieves; t++)
+      thieves.emplace_back([&]()
+      {
+        size_t stolen;
+        while (!done.load())
+          if (shared.Steal(stolen))
+            taken[stolen].fetch_add(1, std::memory_order_relaxed);
+      });
+
+    size_t popped;
+    for (size_t i=0; i<no_of_items; i++)
+    {
+      shared.Push(i);
+      if (i % 3 == 0 && shared.Pop(popped))
+        taken[popped].fetch_add(1, std::memory_order_relaxed);
+    }
+    while (shared.Pop(popped))
+      taken[popped].fetch_add(1, std::memory_order_relaxed);
+
+    done.store(true);
+    for (auto& thief : thieves)
+      thief.join();
+
+    size_t wrong = 0;
+    for (auto& count : taken)
+      wrong += count.load() != 1;
+    _checks.Expect(wrong == 0, "racing Pop and Steal take " + std::to_string(wrong) + " items other than once");
+  }
+
+  // Every node depends on a few of the nodes before it, so the graph is acyclic
+  void CheckGraph(Checks& _checks, TaskScheduler& _scheduler, const std::string& _what)
+  {
+    const size_t no_of_nodes = 300;
+    std::vector<std::vector<size_t>> dependencies(no_of_nodes);
+    std::vector<std::atomic<uint32_t>> runs(no_of_nodes);
+    std::vector<uint32_t> finished(no_of_nodes);
+    std::atomic<uint32_t> clock{0};
+
+    TaskGraph graph;
+    for (size_t i=0; i<no_of_nodes; i++)
+    {
+      TaskGraph::Node node = graph.Add([&, i]()
+      {
+        runs[i].fetch_add(1);
+        finished[i] = clock.fetch_add(1) + 1;
+      });
+
+      for (size_t d : {i / 2, i / 3, i - i % 7})
+        if (d < i)
+        {
+          graph.Depend(node, d);
+          dependencies[i].push_back(d);
+        }
+    }
+
+    for (uint32_t repeat=1; repeat<=3; repeat++)
+    {
+      graph.Run(_scheduler);
+
+      size_t wrong_runs = 0;
+      size_t wrong_order = 0;
+      for (size_t i=0; i<no_of_nodes; i++)
+      {
+        wrong_runs += runs[i].load() != repeat;
+        for (size_t d : dependencies[i])
+          wrong_order += finished[d] >= finished[i];
+      }
+
+      _checks.Expect(wrong_runs == 0, _what + " runs " + std::to_string(wrong_runs) + " nodes other than once");
+      _checks.Expect(wrong_order == 0, _what + " runs " + std::to_string(wrong_order) + " nodes before a dependency");
+    }
+  }
+
+  void CheckFailures(Checks& _checks, TaskScheduler& _scheduler)
+  {
+    TaskGraph cycle;
+    TaskGraph::Node a = cycle.Add([](){});
+    TaskGraph::Node b = cycle.Add([](){}, {a});
+    cycle.Depend(a, b);
+    _checks.Throws([&](){cycle.Run(_scheduler);}, "a graph with a cycle");
+    _checks.Throws([&](){cycle.Depend(a, a);}, "a node depending on itself");
+    _checks.Throws([&](){cycle.Depend(a, 7);}, "a dependency that doesn`t exist");
+
+    std::atomic<bool> after{false};
+    TaskGraph failing;
+    TaskGraph::Node first = failing.Add([](){MNT_THROW("First node");});
+    failing.Add([&](){after.store(true);}, {first});
+    _checks.Throws([&](){failing.Run(_scheduler);}, "a graph with a throwing node");
+    _checks.Expect(!after.load(), "the successors of a throwing node are skipped");
+  }
+
+  // The loops inside the nodes become tasks of the scheduler
+  void CheckNested(Checks& _checks, TaskScheduler& _scheduler)
+  {
+    const size_t no_of_nodes = 8;
+    const size_t length = 4099;
+    std::vector<std::vector<std::atomic<uint32_t>>> visits(no_of_nodes);
+    std::vector<uint64_t> sums(no_of_nodes);
+
+    TaskGraph graph;
+    std::vector<TaskGraph::Node> nodes;
+    for (size_t n=0; n<no_of_nodes; n++)
+    {
+      visits[n] = std::vector<std::atomic<uint32_t>>(length);
+      auto body = [&, n]()
+      {
+        ParallelFor(0, length, [&](size_t _begin, size_t _end)
+        {
+          for (size_t i=_begin; i<_end; i++)
+            visits[n][i].fetch_add(1, std::memory_order_relaxed);
+        }, cost);
+
+        sums[n] = ParallelReduce(0, length, (uint64_t)0, [&](size_t _begin, size_t _end)
+        {
+          uint64_t sum = 0;
+          for (size_t i=_begin; i<_end; i++)
+            sum += i * (n + 1);
+          return sum;
+        }, [](uint64_t _a, uint64_t _b) {return _a + _b;}, cost, 64);
+      };
+
+      // Two independent chains
+      nodes.push_back(n < 2 ? graph.Add(body) : graph.Add(body, {nodes[n - 2]}));
+    }
+
+    graph.Run(_scheduler);
+
+    size_t wrong = 0;
+    for (size_t n=0; n<no_of_nodes; n++)
+    {
+      for (auto& count : visits[n])
+        wrong += count.load() != 1;
+      _checks.Expect(sums[n] == (uint64_t)(n + 1) * length * (length - 1) / 2,
+                     "ParallelReduce inside node " + std::to_string(n));
+    }
+    _checks.Expect(wrong == 0, "ParallelFor inside the nodes visits " + std::to_string(wrong) + " items other than once");
+  }
+
+  void CheckSchedulers(Checks& _checks)
+  {
+    // Destroyed before the workers start
+    for (size_t i=0; i<2000; i++)
+      TaskScheduler scheduler(4);
+
+    for (size_t i=0; i<50; i++)
+    {
+      const size_t threads = 1 + i % 6;
+      TaskScheduler scheduler(threads);
+
+      _checks.Expect(scheduler.NoOfWorkers() == threads - 1, "a scheduler of " + std::to_string(threads) +
+                                                             " threads has " + std::to_string(scheduler.NoOfWorkers()) +
+                                                             " workers");
+      CheckGraph(_checks, scheduler, "graph on scheduler " + std::to_string(i));
+    }
+
+    TaskScheduler scheduler(4);
+    CheckFailures(_checks, scheduler);
+    CheckNested(_checks, scheduler);
+    CheckGraph(_checks, scheduler, "graph after the failures");
+  }
+}
+
+int main()
+{
+  Checks checks;
+  CheckDeque(checks);
+  CheckSchedulers(checks);
+
+  std::printf("%s\n", checks.Failures() ? "FAILED" : "OK");
+  return checks.Failures() ? 1 : 0;
+}
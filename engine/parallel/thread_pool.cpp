@@ -0,0 +1,297 @@
+// File Name:     thread_pool.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Persistent pool of worker threads for data parallel loops
+
+#include "parallel/thread_pool.hpp"
+#include "parallel/futex.hpp"
+
+#include "utils/general.hpp"
+#include "utils/mntexcept.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#elif defined(_WIN32)
+  #include <windows.h>
+#endif
+
+using namespace mnt;
+
+// Set for the lifetime of worker threads, loops called from a worker run serially
+static thread_local bool t_in_worker = false;
+
+// Set by other runtimes for their own threads, see "SetThreadDelegate"
+static thread_local ThreadPool::Delegate t_delegate = nullptr;
+static thread_local void* t_delegate_owner = nullptr;
+
+static std::unique_ptr<ThreadPool>& GlobalPool()
+{
+  static std::unique_ptr<ThreadPool> pool;
+  return pool;
+}
+
+// The pool is published once it is created, the loops read it without taking the mutex
+static std::atomic<ThreadPool*>& GlobalPoolPointer()
+{
+  static std::atomic<ThreadPool*> pointer(nullptr);
+  return pointer;
+}
+
+static std::mutex& GlobalPoolMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+ThreadPool::ThreadPool(size_t _no_of_threads, bool _pin_threads)
+{
+  m_pin_threads = _pin_threads;
+
+  if (_no_of_threads == 0)
+    _no_of_threads = std::thread::hardware_concurrency();
+  if (_no_of_threads == 0)
+    _no_of_threads = 1;
+
+  // Read before any worker starts, a worker that reads it itself could see the epoch of the
+  // destructor and park after it was woken
+  const uint32_t epoch = m_epoch.load();
+
+  try
+  {
+    for (size_t i=1; i<_no_of_threads; i++)
+      m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i, epoch);
+  }
+  catch (std::exception&)
+  {
+    m_stop.store(true);
+    m_epoch.fetch_add(1);
+    Futex::WakeAll(&m_epoch);
+
+    for (auto& worker : m_workers)
+      worker.join();
+
+    MNT_THROW("Failed to create the worker threads of the pool");
+  }
+};
+
+ThreadPool::~ThreadPool() noexcept
+{
+  m_stop.store(true);
+  m_epoch.fetch_add(1);
+  Futex::WakeAll(&m_epoch);
+
+  for (auto& worker : m_workers)
+    worker.join();
+};
+
+ThreadPool& ThreadPool::Global()
+{
+  ThreadPool* published = GlobalPoolPointer().load(std::memory_order_acquire);
+  if (published)
+    return *published;
+
+  std::lock_guard<std::mutex> lock(GlobalPoolMutex());
+
+  std::unique_ptr<ThreadPool>& pool = GlobalPool();
+  if (!pool)
+  {
+    size_t no_of_threads = 0;
+    const char* threads = getenv(MNT_POOL_THREADS_ENV_VARIABLE);
+    if (threads)
+      no_of_threads = strtoul(threads, nullptr, 10);
+
+    const char* pin = getenv(MNT_POOL_PIN_ENV_VARIABLE);
+    bool pin_threads = pin && strcmp(pin, "1") == 0;
+
+    pool.reset(new ThreadPool(no_of_threads, pin_threads));
+    GlobalPoolPointer().store(pool.get(), std::memory_order_release);
+  }
+
+  return *pool;
+};
+
+void ThreadPool::Init(size_t _no_of_threads, bool _pin_threads)
+{
+  std::lock_guard<std::mutex> lock(GlobalPoolMutex());
+
+  std::unique_ptr<ThreadPool>& pool = GlobalPool();
+  GlobalPoolPointer().store(nullptr, std::memory_order_release);
+  pool.reset();
+  pool.reset(new ThreadPool(_no_of_threads, _pin_threads));
+  GlobalPoolPointer().store(pool.get(), std::memory_order_release);
+};
+
+bool ThreadPool::InWorker() noexcept
+{
+  return t_in_worker;
+};
+
+void ThreadPool::SetThreadDelegate(Delegate _delegate, void* _owner) noexcept
+{
+  t_delegate = _delegate;
+  t_delegate_owner = _owner;
+};
+
+void ThreadPool::ThreadDelegate(Delegate& _delegate, void*& _owner) noexcept
+{
+  _delegate = t_delegate;
+  _owner = t_delegate_owner;
+};
+
+size_t ThreadPool::Grain(size_t _length, size_t _cost) const noexcept
+{
+  if (_cost == 0)
+    _cost = 1;
+
+  if ((NoOfThreads() == 1 && !t_delegate) || _length * _cost < MNT_POOL_MIN_PARALLEL_COST || InWorker())
+    return _length ? _length : 1;
+
+  // Big enough chunks to amortize claiming them, small enough to balance the load
+  size_t min_grain = (MNT_POOL_MIN_CHUNK_COST + _cost - 1) / _cost;
+  size_t balance_grain = (_length + NoOfThreads() * MNT_POOL_CHUNKS_PER_THREAD - 1) /
+                         (NoOfThreads() * MNT_POOL_CHUNKS_PER_THREAD);
+
+  return std::max<size_t>(1, std::max(min_grain, balance_grain));
+};
+
+void ThreadPool::Run(size_t _no_of_chunks, ChunkFunction _function, void* _context)
+{
+  if (_no_of_chunks == 0)
+    return;
+
+  if (t_delegate && _no_of_chunks > 1)
+  {
+    t_delegate(t_delegate_owner, _no_of_chunks, _function, _context);
+    return;
+  }
+
+  // Single chunk, nested call or the pool is busy with another caller
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (_no_of_chunks == 1 || m_workers.empty() || InWorker() || !lock.try_lock())
+  {
+    for (size_t i=0; i<_no_of_chunks; i++)
+      _function(_context, i);
+    return;
+  }
+
+  Job job;
+  job.function = _function;
+  job.context = _context;
+  job.no_of_chunks = _no_of_chunks;
+
+  // Publish the job, then wake the workers only if some of them are parked
+  // The sequentially consistent order of m_epoch and m_sleepers guarantees that a worker
+  // either sees the new epoch before parking, or is counted in m_sleepers here
+  m_job.store(&job);
+  m_epoch.fetch_add(1);
+  if (m_sleepers.load() > 0)
+    Futex::WakeAll(&m_epoch);
+
+  Work(job);
+
+  // Workers that enter after this point see no job, wait for the ones that already entered
+  m_job.store(nullptr);
+  for (uint32_t spins = 1; m_entered.load() != 0; spins++)
+    if (spins & 1023)
+      CpuRelax();
+    else
+      std::this_thread::yield();
+
+  if (job.exception)
+    std::rethrow_exception(job.exception);
+};
+
+void ThreadPool::Work(Job& _job) noexcept
+{
+  while (!_job.failed.load(std::memory_order_relaxed))
+  {
+    size_t chunk = _job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= _job.no_of_chunks)
+      break;
+
+    try
+    {
+      _job.function(_job.context, chunk);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(_job.exception_mutex);
+      if (!_job.exception)
+        _job.exception = std::current_exception();
+      _job.failed.store(true);
+    }
+  }
+};
+
+void ThreadPool::WorkerLoop(size_t _index, uint32_t _epoch) noexcept
+{
+  t_in_worker = true;
+
+  if (m_pin_threads)
+    PinCurrentThread(_index);
+
+  uint32_t seen_epoch = _epoch;
+  const auto spin_duration = std::chrono::microseconds(MNT_POOL_SPIN_MICROSECONDS);
+
+  while (true)
+  {
+    // Spin for a while, checking the clock every few iterations, then park
+    auto spin_start = std::chrono::steady_clock::now();
+    uint32_t spins = 0;
+    while (m_epoch.load(std::memory_order_acquire) == seen_epoch)
+    {
+      CpuRelax();
+
+      if ((++spins & 63) == 0 && std::chrono::steady_clock::now() - spin_start > spin_duration)
+      {
+        m_sleepers.fetch_add(1);
+        if (m_epoch.load() == seen_epoch && !m_stop.load())
+          Futex::Wait(&m_epoch, seen_epoch);
+        m_sleepers.fetch_sub(1);
+
+        spin_start = std::chrono::steady_clock::now();
+      }
+    }
+
+    seen_epoch = m_epoch.load();
+
+    if (m_stop.load())
+      return;
+
+    // Announce first, then look at the job, see "Run"
+    m_entered.fetch_add(1);
+    Job* job = m_job.load();
+    if (job)
+      Work(*job);
+    m_entered.fetch_sub(1);
+  }
+};
+
+// The calling thread is not pinned, workers are pinned to the cores 1, 2, ...
+void ThreadPool::PinCurrentThread(size_t _core) noexcept
+{
+  size_t no_of_cores = std::thread::hardware_concurrency();
+  if (no_of_cores == 0)
+    return;
+
+  _core = _core % no_of_cores;
+
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(_core, &cpu_set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0)
+    MNT_WARN("Failed to pin thread to core " + std::to_string(_core));
+#elif defined(_WIN32)
+  if (!SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << _core))
+    MNT_WARN("Failed to pin thread to core " + std::to_string(_core));
+#else
+  MNTUSE(_core)
+#endif
+};
@@ -0,0 +1,195 @@
+// File Name:     thread_pool.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Persistent pool of worker threads for data parallel loops
+
+// ---------------------
+// Detail Description:
+// The workers are created once and live as long as the pool, a parallel loop publishes
+// a job, wakes the workers, and the calling thread works on the job as well. The job is
+// split into chunks that threads claim with an atomic counter, so faster threads take more.
+// Idle workers spin for MNT_POOL_SPIN_MICROSECONDS before parking on a futex, so ops issued
+// back to back don`t pay the wake-up latency, and parked workers don`t waste the CPU.
+// ---------------------
+
+// ---------------------
+// Note:
+// The "_cost" parameter of the loops is the estimated number of CPU cycles per item,
+// (e.g. 1 for an addition, a few hundreds for a row of a small matrix product), it is used
+// to run cheap loops on the calling thread and to size the chunks, see MNT_POOL_* in configs.hpp
+// ---------------------
+
+// ---------------------
+// Note:
+// A loop that is called from inside a worker, or while the pool is busy with another
+// caller thread, runs on the calling thread, so nested parallelism never deadlocks.
+// If the loop body throws, the remaining chunks are skipped and the first exception is
+// rethrown on the calling thread.
+// ---------------------
+
+// ---------------------
+// Note:
+// Threads of other runtimes can take over the loops they call with "SetThreadDelegate",
+// e.g. the workers of TaskScheduler turn the chunks into tasks that idle workers steal,
+// instead of competing with the pool for the same cores
+// ---------------------
+
+// =====
+// [Global()]: The pool used by the engine, created at the first call with the number of
+// threads in MNT_NUM_THREADS (all the cores if not set), pinned if MNT_PIN_THREADS=1. Only
+// the creation takes a lock, the loops of every op read the published pool with one atomic load
+// =====
+
+// =====
+// [Init(_no_of_threads, _pin_threads)]: Recreates the global pool, _no_of_threads includes the
+// calling thread, 0 means all the cores, should not be called while the pool is used
+// =====
+
+// =====
+// [ParallelFor(_begin, _end, _function, _cost)]: Calls _function(begin, end) on disjoint
+// chunks that cover [_begin, _end)
+// =====
+
+// =====
+// [ParallelFor2D(_rows, _cols, _function, _cost)]: Calls _function(row_begin, row_end,
+// col_begin, col_end) on disjoint tiles that cover the _rows x _cols range
+// =====
+
+// =====
+// [ParallelForND(_extents, _function, _cost)]: Calls _function(index, length) where index is
+// the multi-index of the first item and length is the number of items along the last
+// dimension, from index[rank-1] on, it never crosses a row of the last dimension,
+// _extents is any container with "size()" and "operator []", e.g. std::vector or TensorStrides
+// =====
+
+// =====
+// [ParallelReduce(_begin, _end, _identity, _map, _reduce, _cost, _grain)]: _map(begin, end)
+// returns the partial result of a chunk, and partial results are combined with _reduce
+// in the order of chunks. If _grain is given, chunks don`t depend on the number of threads,
+// so the result is bitwise reproducible on any machine
+// =====
+
+#ifndef ENGINE_PARALLEL_THREAD_POOL_HPP
+#define ENGINE_PARALLEL_THREAD_POOL_HPP
+
+#include "configs.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mnt {
+
+  class ThreadPool
+  {
+  public:
+    // Type erased chunk function: _context, chunk index
+    using ChunkFunction = void (*)(void*, size_t);
+
+    // Runs all the chunks of a loop instead of the pool: _owner, no of chunks, function, context
+    using Delegate = void (*)(void*, size_t, ChunkFunction, void*);
+
+  public:
+    explicit ThreadPool(size_t _no_of_threads = 0, bool _pin_threads = false);
+    ~ThreadPool() noexcept;
+
+    // Removing copy, move constructors and assignment operator
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    void operator = (const ThreadPool&) = delete;
+    void operator = (ThreadPool&&) = delete;
+
+    static ThreadPool& Global();
+    static void Init(size_t _no_of_threads, bool _pin_threads);
+
+    // Number of threads that work on a job, including the calling thread
+    inline size_t NoOfThreads() const noexcept {return m_workers.size() + 1;};
+
+    // True if the current thread is a worker of any pool
+    static bool InWorker() noexcept;
+
+    // Sets the delegate of the current thread, nullptr to remove it
+    static void SetThreadDelegate(Delegate _delegate, void* _owner) noexcept;
+    // The delegate of the current thread, nullptr if it has none
+    static void ThreadDelegate(Delegate& _delegate, void*& _owner) noexcept;
+
+    template <typename F>
+    void ParallelFor(size_t _begin, size_t _end, const F& _function, size_t _cost = 1);
+
+    template <typename F>
+    void ParallelFor2D(size_t _rows, size_t _cols, const F& _function, size_t _cost = 1);
+
+    template <typename E = std::vector<size_t>, typename F>
+    void ParallelForND(const E& _extents, const F& _function, size_t _cost = 1);
+
+    template <typename R, typename M, typename C>
+    R ParallelReduce(size_t _begin, size_t _end, const R& _identity,
+                     const M& _map, const C& _reduce, size_t _cost = 1, size_t _grain = 0);
+
+    // Runs _function(_context, i) for every i in [0, _no_of_chunks), the primitive
+    // used by the loops above, returns when all the chunks are done
+    void Run(size_t _no_of_chunks, ChunkFunction _function, void* _context);
+
+    // Number of items per chunk for a loop of _length items, each costing _cost cycles
+    // Returns _length if the loop should run on the calling thread
+    size_t Grain(size_t _length, size_t _cost) const noexcept;
+
+  private:
+    struct Job
+    {
+      ChunkFunction function;
+      void* context;
+      size_t no_of_chunks;
+
+      std::atomic<size_t> next_chunk{0};
+      std::atomic<bool> failed{false};
+      std::exception_ptr exception;
+      std::mutex exception_mutex;
+    };
+
+    // _epoch is the epoch before the worker was created, jobs and the stop come after it
+    void WorkerLoop(size_t _index, uint32_t _epoch) noexcept;
+    void Work(Job& _job) noexcept;
+    void PinCurrentThread(size_t _core) noexcept;
+
+  private:
+    std::vector<std::thread> m_workers;
+
+    // Serializes the callers, if busy, the loop runs on the calling thread
+    std::mutex m_mutex;
+
+    // Each published job increments the epoch, parked workers wait on its address
+    alignas(64) std::atomic<uint32_t> m_epoch{0};
+    alignas(64) std::atomic<Job*> m_job{nullptr};
+
+    // Workers that may still access the current job
+    alignas(64) std::atomic<uint32_t> m_entered{0};
+    std::atomic<uint32_t> m_sleepers{0};
+
+    std::atomic<bool> m_stop{false};
+    bool m_pin_threads = false;
+  };
+
+  // Shortcuts to the loops of the global pool
+  template <typename F>
+  void ParallelFor(size_t _begin, size_t _end, const F& _function, size_t _cost = 1);
+
+  template <typename F>
+  void ParallelFor2D(size_t _rows, size_t _cols, const F& _function, size_t _cost = 1);
+
+  template <typename E = std::vector<size_t>, typename F>
+  void ParallelForND(const E& _extents, const F& _function, size_t _cost = 1);
+
+  template <typename R, typename M, typename C>
+  R ParallelReduce(size_t _begin, size_t _end, const R& _identity,
+                   const M& _map, const C& _reduce, size_t _cost = 1, size_t _grain = 0);
+}
+
+#include "parallel/thread_pool.inl"
+
+#endif
@@ -0,0 +1,204 @@
+// File Name:     thread_pool.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Persistent pool of worker threads for data parallel loops
+
+#ifndef ENGINE_PARALLEL_THREAD_POOL_INL
+#define ENGINE_PARALLEL_THREAD_POOL_INL
+
+#include "parallel/thread_pool.hpp"
+
+#include <algorithm>
+
+using namespace mnt;
+
+template <typename F>
+void ThreadPool::ParallelFor(size_t _begin, size_t _end, const F& _function, size_t _cost)
+{
+  if (_end <= _begin)
+    return;
+
+  size_t length = _end - _begin;
+  size_t grain = Grain(length, _cost);
+  size_t no_of_chunks = (length + grain - 1) / grain;
+
+  if (no_of_chunks <= 1)
+  {
+    _function(_begin, _end);
+    return;
+  }
+
+  struct Context
+  {
+    const F* function;
+    size_t begin;
+    size_t end;
+    size_t grain;
+  } context = {&_function, _begin, _end, grain};
+
+  Run(no_of_chunks, [](void* _context, size_t _chunk)
+  {
+    const Context* ctx = (const Context*)_context;
+    size_t begin = ctx->begin + _chunk * ctx->grain;
+    size_t end = std::min(begin + ctx->grain, ctx->end);
+    (*ctx->function)(begin, end);
+  }, &context);
+};
+
+// Tiles cover full rows when possible, so the inner dimension stays contiguous
+template <typename F>
+void ThreadPool::ParallelFor2D(size_t _rows, size_t _cols, const F& _function, size_t _cost)
+{
+  if (_rows == 0 || _cols == 0)
+    return;
+
+  size_t grain = Grain(_rows * _cols, _cost);
+
+  if (grain >= _rows * _cols)
+  {
+    _function(0, _rows, 0, _cols);
+    return;
+  }
+
+  size_t tile_rows = grain >= _cols ? grain / _cols : 1;
+  size_t tile_cols = grain >= _cols ? _cols : grain;
+
+  struct Context
+  {
+    const F* function;
+    size_t rows;
+    size_t cols;
+    size_t tile_rows;
+    size_t tile_cols;
+    size_t tiles_per_row;
+  } context = {&_function, _rows, _cols, tile_rows, tile_cols, (_cols + tile_cols - 1) / tile_cols};
+
+  size_t no_of_tiles = ((_rows + tile_rows - 1) / tile_rows) * context.tiles_per_row;
+
+  Run(no_of_tiles, [](void* _context, size_t _tile)
+  {
+    const Context* ctx = (const Context*)_context;
+    size_t row_begin = (_tile / ctx->tiles_per_row) * ctx->tile_rows;
+    size_t col_begin = (_tile % ctx->tiles_per_row) * ctx->tile_cols;
+    (*ctx->function)(row_begin, std::min(row_begin + ctx->tile_rows, ctx->rows),
+                     col_begin, std::min(col_begin + ctx->tile_cols, ctx->cols));
+  }, &context);
+};
+
+template <typename E, typename F>
+void ThreadPool::ParallelForND(const E& _extents, const F& _function, size_t _cost)
+{
+  const size_t rank = _extents.size();
+  if (rank == 0)
+    return;
+
+  size_t total = 1;
+  for (size_t extent : _extents)
+    total *= extent;
+  if (total == 0)
+    return;
+
+  ParallelFor(0, total, [&](size_t _begin, size_t _end)
+  {
+    // Multi-index of _begin, ranks up to 8 don`t need any heap allocation
+    size_t index_buffer[8];
+    std::vector<size_t> index_vector;
+    size_t* index = index_buffer;
+    if (rank > 8)
+    {
+      index_vector.resize(rank);
+      index = index_vector.data();
+    }
+
+    size_t remainder = _begin;
+    for (size_t d = rank; d-- > 0;)
+    {
+      index[d] = remainder % _extents[d];
+      remainder /= _extents[d];
+    }
+
+    size_t position = _begin;
+    while (position < _end)
+    {
+      size_t length = std::min(_extents[rank - 1] - index[rank - 1], _end - position);
+      _function((const size_t*)index, length);
+      position += length;
+
+      // Advance the multi-index by length items
+      index[rank - 1] += length;
+      for (size_t d = rank - 1; d > 0 && index[d] == _extents[d]; d--)
+      {
+        index[d] = 0;
+        index[d - 1]++;
+      }
+    }
+  }, _cost);
+};
+
+template <typename R, typename M, typename C>
+R ThreadPool::ParallelReduce(size_t _begin, size_t _end, const R& _identity,
+                             const M& _map, const C& _reduce, size_t _cost, size_t _grain)
+{
+  if (_end <= _begin)
+    return _identity;
+
+  size_t length = _end - _begin;
+  size_t grain = _grain ? _grain : Grain(length, _cost);
+  size_t no_of_chunks = (length + grain - 1) / grain;
+
+  if (no_of_chunks == 1)
+    return _reduce(_identity, _map(_begin, _end));
+
+  std::vector<R> partials(no_of_chunks, _identity);
+
+  struct Context
+  {
+    const M* map;
+    R* partials;
+    size_t begin;
+    size_t end;
+    size_t grain;
+  } context = {&_map, partials.data(), _begin, _end, grain};
+
+  Run(no_of_chunks, [](void* _context, size_t _chunk)
+  {
+    const Context* ctx = (const Context*)_context;
+    size_t begin = ctx->begin + _chunk * ctx->grain;
+    size_t end = std::min(begin + ctx->grain, ctx->end);
+    ctx->partials[_chunk] = (*ctx->map)(begin, end);
+  }, &context);
+
+  // Combined in the order of chunks, independent of which thread computed what
+  R result = _identity;
+  for (const R& partial : partials)
+    result = _reduce(result, partial);
+
+  return result;
+};
+
+template <typename F>
+void mnt::ParallelFor(size_t _begin, size_t _end, const F& _function, size_t _cost)
+{
+  ThreadPool::Global().ParallelFor(_begin, _end, _function, _cost);
+};
+
+template <typename F>
+void mnt::ParallelFor2D(size_t _rows, size_t _cols, const F& _function, size_t _cost)
+{
+  ThreadPool::Global().ParallelFor2D(_rows, _cols, _function, _cost);
+};
+
+template <typename E, typename F>
+void mnt::ParallelForND(const E& _extents, const F& _function, size_t _cost)
+{
+  ThreadPool::Global().ParallelForND(_extents, _function, _cost);
+};
+
+template <typename R, typename M, typename C>
+R mnt::ParallelReduce(size_t _begin, size_t _end, const R& _identity,
+                      const M& _map, const C& _reduce, size_t _cost, size_t _grain)
+{
+  return ThreadPool::Global().ParallelReduce(_begin, _end, _identity, _map, _reduce, _cost, _grain);
+};
+
+#endif
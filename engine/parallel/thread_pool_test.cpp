@@ -0,0 +1,131 @@
+// File Name:     thread_pool_test.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Checks of the loops of ThreadPool and of creating and destroying pools
+
+// ---------------------
+// Detail Description:
+// Pools are destroyed right after they are created, before their workers had a chance to run,
+// and between loops, which used to leave a worker parked after the stop of its pool. The loops
+// count the visits of every item, so a chunk that runs twice or never shows up, and the
+// reductions add integers, which are exact in any order.
+// ---------------------
+
+#include "parallel/thread_pool.hpp"
+#include "math/test_utils.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace mnt;
+using namespace mnt::testing;
+
+namespace {
+
+  // Large enough per item that the loops run on every thread
+  constexpr size_t cost = 10000;
+
+  void CheckLoops(Checks& _checks, ThreadPool& _pool, const std::string& _what)
+  {
+    const size_t length = 10007;
+    std::vector<std::atomic<uint32_t>> visits(length);
+
+    _pool.ParallelFor(0, length, [&](size_t _begin, size_t _end)
+    {
+      for (size_t i=_begin; i<_end; i++)
+        visits[i].fetch_add(1, std::memory_order_relaxed);
+    }, cost);
+
+    size_t wrong = 0;
+    for (size_t i=0; i<length; i++)
+      wrong += visits[i].load() != 1;
+    _checks.Expect(wrong == 0, _what + " ParallelFor visits " + std::to_string(wrong) + " items other than once");
+
+    std::vector<std::atomic<uint32_t>> cells(37 * 53);
+    _pool.ParallelFor2D(37, 53, [&](size_t _row_begin, size_t _row_end, size_t _col_begin, size_t _col_end)
+    {
+      for (size_t r=_row_begin; r<_row_end; r++)
+        for (size_t c=_col_begin; c<_col_end; c++)
+          cells[r * 53 + c].fetch_add(1, std::memory_order_relaxed);
+    }, cost);
+
+    wrong = 0;
+    for (auto& cell : cells)
+      wrong += cell.load() != 1;
+    _checks.Expect(wrong == 0, _what + " ParallelFor2D visits " + std::to_string(wrong) + " items other than once");
+
+    const auto map = [](size_t _begin, size_t _end)
+    {
+      uint64_t sum = 0;
+      for (size_t i=_begin; i<_end; i++)
+        sum += i * i;
+      return sum;
+    };
+    const auto reduce = [](uint64_t _a, uint64_t _b) {return _a + _b;};
+
+    uint64_t expected = 0;
+    for (size_t i=0; i<length; i++)
+      expected += i * i;
+
+    _checks.Expect(_pool.ParallelReduce(0, length, (uint64_t)0, map, reduce, cost) == expected,
+                   _what + " ParallelReduce");
+    _checks.Expect(_pool.ParallelReduce(0, length, (uint64_t)0, map, reduce, cost, 100) == expected,
+                   _what + " ParallelReduce of a fixed grain");
+    _checks.Expect(_pool.ParallelReduce(5, 5, (uint64_t)7, map, reduce, cost) == 7,
+                   _what + " ParallelReduce of an empty range");
+  }
+
+  void CheckException(Checks& _checks, ThreadPool& _pool, const std::string& _what)
+  {
+    _checks.Throws([&]()
+    {
+      _pool.ParallelFor(0, 1000, [&](size_t _begin, size_t _end)
+      {
+        if (_begin <= 500 && 500 < _end)
+          MNT_THROW("Chunk of item 500");
+      }, cost);
+    }, _what + " ParallelFor of a throwing body");
+
+    // The pool is still usable after the exception
+    CheckLoops(_checks, _pool, _what + " after an exception");
+  }
+
+  void CheckPools(Checks& _checks)
+  {
+    // Destroyed before the workers start
+    for (size_t i=0; i<2000; i++)
+      ThreadPool pool(4, false);
+
+    for (size_t i=0; i<200; i++)
+    {
+      const size_t threads = 1 + i % 8;
+      ThreadPool pool(threads, false);
+
+      _checks.Expect(pool.NoOfThreads() == threads, "a pool of " + std::to_string(threads) + " threads has " +
+                                                    std::to_string(pool.NoOfThreads()));
+      CheckLoops(_checks, pool, "pool " + std::to_string(i) + " of " + std::to_string(threads) + " threads");
+    }
+
+    ThreadPool pool(4, false);
+    CheckException(_checks, pool, "pool of 4 threads");
+
+    // The global pool recreated between loops
+    for (size_t i=0; i<200; i++)
+    {
+      ThreadPool::Init(1 + i % 4, false);
+      CheckLoops(_checks, ThreadPool::Global(), "global pool " + std::to_string(i));
+    }
+  }
+}
+
+int main()
+{
+  Checks checks;
+  CheckPools(checks);
+
+  std::printf("%s\n", checks.Failures() ? "FAILED" : "OK");
+  return checks.Failures() ? 1 : 0;
+}
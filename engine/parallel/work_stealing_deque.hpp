@@ -0,0 +1,96 @@
+// File Name:     work_stealing_deque.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Lock-free Chase-Lev work-stealing deque
+
+// ---------------------
+// Detail Description:
+// The owner thread pushes and pops at the bottom (LIFO, good for cache locality), other
+// threads steal from the top (FIFO, they take the oldest and usually biggest work).
+// The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+// ---------------------
+
+// ---------------------
+// Note:
+// "Push" and "Pop" must only be called by the owner thread, "Steal" by any thread.
+// The circular array grows when full, the old arrays are kept until the deque is destroyed
+// because a thief may still read from them, they are small compared to the final one.
+// T must be trivially copyable, it is meant for pointers.
+// ---------------------
+
+// =====
+// [Pop(_item)]: Returns false if the deque is empty, or the last item was stolen concurrently
+// =====
+
+// =====
+// [Steal(_item)]: Returns false if the deque is empty or another thread won the race
+// =====
+
+#ifndef ENGINE_PARALLEL_WORK_STEALING_DEQUE_HPP
+#define ENGINE_PARALLEL_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace mnt {
+
+  template <typename T>
+  class WorkStealingDeque
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque needs a trivially copyable type");
+
+  public:
+    explicit WorkStealingDeque(size_t _capacity = 256);
+    ~WorkStealingDeque() noexcept = default;
+
+    // Removing copy, move constructors and assignment operator
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque(WorkStealingDeque&&) = delete;
+    void operator = (const WorkStealingDeque&) = delete;
+    void operator = (WorkStealingDeque&&) = delete;
+
+    void Push(T _item);
+    bool Pop(T& _item) noexcept;
+    bool Steal(T& _item) noexcept;
+
+    // Approximate when called concurrently
+    bool Empty() const noexcept;
+
+  private:
+    struct Array
+    {
+      explicit Array(size_t _capacity)
+        : capacity(_capacity), mask(_capacity - 1), items(new std::atomic<T>[_capacity])
+      {};
+
+      T Get(int64_t _index) const noexcept
+      {return items[(size_t)_index & mask].load(std::memory_order_relaxed);};
+
+      void Put(int64_t _index, T _item) noexcept
+      {items[(size_t)_index & mask].store(_item, std::memory_order_relaxed);};
+
+      size_t capacity;
+      size_t mask;
+      std::unique_ptr<std::atomic<T>[]> items;
+    };
+
+    Array* Grow(Array* _array, int64_t _bottom, int64_t _top);
+
+  private:
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+    alignas(64) std::atomic<Array*> m_array{nullptr};
+
+    // All the arrays ever allocated, only touched by the owner
+    std::vector<std::unique_ptr<Array>> m_arrays;
+  };
+}
+
+#include "parallel/work_stealing_deque.inl"
+
+#endif
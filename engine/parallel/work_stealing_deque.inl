@@ -0,0 +1,105 @@
+// File Name:     work_stealing_deque.inl
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Lock-free Chase-Lev work-stealing deque
+
+#ifndef ENGINE_PARALLEL_WORK_STEALING_DEQUE_INL
+#define ENGINE_PARALLEL_WORK_STEALING_DEQUE_INL
+
+#include "parallel/work_stealing_deque.hpp"
+
+using namespace mnt;
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t _capacity)
+{
+  // The capacity has to be a power of two, indexes are masked instead of divided
+  size_t capacity = 2;
+  while (capacity < _capacity)
+    capacity *= 2;
+
+  m_arrays.emplace_back(new Array(capacity));
+  m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+};
+
+template <typename T>
+void WorkStealingDeque<T>::Push(T _item)
+{
+  int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+  int64_t top = m_top.load(std::memory_order_acquire);
+  Array* array = m_array.load(std::memory_order_relaxed);
+
+  if (bottom - top > (int64_t)array->capacity - 1)
+    array = Grow(array, bottom, top);
+
+  // Release store instead of the paper`s fence, same code on x86 and visible to TSan
+  array->Put(bottom, _item);
+  m_bottom.store(bottom + 1, std::memory_order_release);
+};
+
+template <typename T>
+bool WorkStealingDeque<T>::Pop(T& _item) noexcept
+{
+  int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+  Array* array = m_array.load(std::memory_order_relaxed);
+  m_bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = m_top.load(std::memory_order_relaxed);
+
+  if (top > bottom)
+  {
+    // Empty, restore the bottom
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  _item = array->Get(bottom);
+  if (top < bottom)
+    return true;
+
+  // Last item, race against the thieves for it
+  bool won = m_top.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed);
+  m_bottom.store(bottom + 1, std::memory_order_relaxed);
+  return won;
+};
+
+template <typename T>
+bool WorkStealingDeque<T>::Steal(T& _item) noexcept
+{
+  int64_t top = m_top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom)
+    return false;
+
+  Array* array = m_array.load(std::memory_order_acquire);
+  _item = array->Get(top);
+
+  return m_top.compare_exchange_strong(top, top + 1,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed);
+};
+
+template <typename T>
+bool WorkStealingDeque<T>::Empty() const noexcept
+{
+  return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+};
+
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::Grow(Array* _array, int64_t _bottom, int64_t _top)
+{
+  m_arrays.emplace_back(new Array(_array->capacity * 2));
+  Array* array = m_arrays.back().get();
+
+  for (int64_t i = _top; i < _bottom; i++)
+    array->Put(i, _array->Get(i));
+
+  m_array.store(array, std::memory_order_release);
+  return array;
+};
+
+#endif
@@ -34,4 +34,8 @@
 
 #define MNT_EXCEPTION_FILENAME_SIZE 64
 
+// The environment variable that can force a lower instruction set than the detected one
+// Valid values: "generic", "sse4", "avx2", "avx512", "neon"
+#define MNT_ISA_ENV_VARIABLE "MNT_ISA"
+
 #endif
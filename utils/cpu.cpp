@@ -0,0 +1,229 @@
+// File Name:     cpu.cpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime detection of CPU features
+
+#include "cpu.hpp"
+#include "general.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(MNT_ARCH_X86_64) || defined(MNT_ARCH_X86)
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+    #include <immintrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+using namespace mnt;
+
+#if defined(MNT_ARCH_X86_64) || defined(MNT_ARCH_X86)
+
+// Wrappers to have the same CPUID and XGETBV interface on all compilers
+static void CPUID(uint32_t _leaf, uint32_t _subleaf, uint32_t _registers[4]) noexcept
+{
+#if defined(_MSC_VER)
+  int registers[4];
+  __cpuidex(registers, (int)_leaf, (int)_subleaf);
+  for (int i=0; i<4; i++)
+    _registers[i] = (uint32_t)registers[i];
+#else
+  __cpuid_count(_leaf, _subleaf, _registers[0], _registers[1], _registers[2], _registers[3]);
+#endif
+}
+
+// "_xgetbv" needs -mxsave on GCC, inline assembly doesn`t
+static uint64_t XGETBV(uint32_t _index) noexcept
+{
+#if defined(_MSC_VER)
+  return _xgetbv(_index);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(_index));
+  return ((uint64_t)edx << 32) | eax;
+#endif
+}
+
+#endif
+
+CPUFeatures CPU::Detect() noexcept
+{
+  CPUFeatures features;
+
+#if defined(MNT_ARCH_X86_64) || defined(MNT_ARCH_X86)
+
+  uint32_t registers[4];
+
+  // Leaf 0: highest supported leaf and vendor string (EBX, EDX, ECX)
+  CPUID(0, 0, registers);
+  uint32_t max_leaf = registers[0];
+  memcpy(features.vendor + 0, &registers[1], 4);
+  memcpy(features.vendor + 4, &registers[3], 4);
+  memcpy(features.vendor + 8, &registers[2], 4);
+  features.vendor[12] = '\0';
+
+  if (max_leaf < 1)
+    return features;
+
+  CPUID(1, 0, registers);
+  uint32_t ecx = registers[2];
+  uint32_t edx = registers[3];
+
+  features.sse2   = edx & (1u << 26);
+  features.ssse3  = ecx & (1u << 9);
+  features.sse41  = ecx & (1u << 19);
+  features.sse42  = ecx & (1u << 20);
+  features.popcnt = ecx & (1u << 23);
+
+  bool fma = ecx & (1u << 12);
+  bool f16c = ecx & (1u << 29);
+  bool osxsave = ecx & (1u << 27);
+  bool avx = ecx & (1u << 28);
+
+  // The CPU supporting AVX is not enough, the OS should save YMM/ZMM registers
+  // XCR0 bit 1: SSE state, bit 2: AVX state, bits 5,6,7: opmask and ZMM states
+  uint64_t xcr0 = osxsave ? XGETBV(0) : 0;
+  bool os_avx = (xcr0 & 0x6) == 0x6;
+  bool os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+  features.avx  = avx && os_avx;
+  features.fma  = fma && os_avx;
+  features.f16c = f16c && os_avx;
+
+  if (max_leaf >= 7)
+  {
+    CPUID(7, 0, registers);
+    uint32_t ebx = registers[1];
+    ecx = registers[2];
+
+    features.avx2       = os_avx && (ebx & (1u << 5));
+    features.bmi2       = ebx & (1u << 8);
+    features.avx512f    = os_avx512 && (ebx & (1u << 16));
+    features.avx512dq   = os_avx512 && (ebx & (1u << 17));
+    features.avx512bw   = os_avx512 && (ebx & (1u << 30));
+    features.avx512vl   = os_avx512 && (ebx & (1u << 31));
+    features.avx512vnni = os_avx512 && (ecx & (1u << 11));
+
+    CPUID(7, 1, registers);
+    features.avxvnni    = os_avx && (registers[0] & (1u << 4));
+    features.avx512bf16 = os_avx512 && (registers[0] & (1u << 5));
+  }
+
+#elif defined(MNT_ARCH_ARM64)
+
+  // Advanced SIMD is mandatory on ARMv8-A
+  features.neon = true;
+
+#elif defined(MNT_ARCH_ARM) && defined(__ARM_NEON)
+
+  features.neon = true;
+
+#endif
+
+  return features;
+};
+
+const CPUFeatures& CPU::Features() noexcept
+{
+  // Local static variables are initialized once, in a thread safe manner
+  static const CPUFeatures features = Detect();
+  return features;
+};
+
+ISA CPU::Detected() noexcept
+{
+  const CPUFeatures& features = Features();
+
+  if (features.neon)
+    return ISA::NEON;
+
+  // F16C shipped with every AVX2 CPU, the AVX2 kernels count on it
+  if (features.avx512f && features.avx512bw && features.avx512dq && features.avx512vl &&
+      features.avx2 && features.fma && features.f16c)
+    return ISA::AVX512;
+
+  if (features.avx2 && features.fma && features.f16c)
+    return ISA::AVX2;
+
+  if (features.sse41 && features.ssse3)
+    return ISA::SSE4;
+
+  return ISA::Generic;
+};
+
+bool CPU::Supports(ISA _isa) noexcept
+{
+  ISA detected = Detected();
+
+  if (_isa == ISA::Generic)
+    return true;
+
+  // NEON and x86 levels are not comparable
+  if (_isa == ISA::NEON || detected == ISA::NEON)
+    return _isa == detected;
+
+  return (uint8_t)_isa <= (uint8_t)detected;
+};
+
+ISA CPU::SelectActive() noexcept
+{
+  ISA detected = Detected();
+
+  const char* requested = getenv(MNT_ISA_ENV_VARIABLE);
+  if (!requested || requested[0] == '\0')
+    return detected;
+
+  ISA isa;
+  if (!ISAFromName(requested, isa))
+  {
+    MNT_WARN(std::string(MNT_ISA_ENV_VARIABLE) + "=" + requested +
+             " is not a valid ISA name, using " + ISAName(detected));
+    return detected;
+  }
+
+  if (!Supports(isa))
+  {
+    MNT_WARN(std::string(MNT_ISA_ENV_VARIABLE) + "=" + requested +
+             " is not supported by this CPU, using " + ISAName(detected));
+    return detected;
+  }
+
+  return isa;
+};
+
+ISA CPU::Active() noexcept
+{
+  static const ISA active = SelectActive();
+  return active;
+};
+
+const char* CPU::ISAName(ISA _isa) noexcept
+{
+  switch (_isa)
+  {
+  case ISA::Generic: return "generic";
+  case ISA::SSE4:    return "sse4";
+  case ISA::AVX2:    return "avx2";
+  case ISA::AVX512:  return "avx512";
+  case ISA::NEON:    return "neon";
+  }
+  return "unknown";
+};
+
+bool CPU::ISAFromName(const char* _name, ISA& _isa) noexcept
+{
+  const ISA all[] = {ISA::Generic, ISA::SSE4, ISA::AVX2, ISA::AVX512, ISA::NEON};
+
+  for (ISA isa : all)
+    if (strcmp(_name, ISAName(isa)) == 0)
+    {
+      _isa = isa;
+      return true;
+    }
+
+  return false;
+};
@@ -0,0 +1,104 @@
+// File Name:     cpu.hpp
+// Author:        Arash Fatehi
+// Date:          19th Oct 2026
+// Description:   Runtime detection of CPU features
+
+// ---------------------
+// Detail Description:
+// On x86 the features are read with CPUID, and XGETBV is used to make sure the OS
+// actually saves the AVX and AVX-512 registers on context switch, on ARM the features
+// are known at compile time. The engine uses the result to bind the best available
+// kernels once at startup, so a single binary runs on any machine of the fleet.
+// ---------------------
+
+// ---------------------
+// Note:
+// The ISA used by the engine can be lowered, never raised, by setting the environment
+// variable defined by MNT_ISA_ENV_VARIABLE in configs.hpp ("MNT_ISA") to one of
+// "generic", "sse4", "avx2", "avx512" or "neon", it is useful to test the kernels
+// of older machines on a new one. Invalid or unsupported values are ignored with a warning.
+// ---------------------
+
+// =====
+// [Features()]: Returns the detected features, the detection runs once at the first call
+// =====
+
+// =====
+// [Detected()]: The best ISA level that the running CPU and OS support
+// =====
+
+// =====
+// [Active()]: The ISA level that should be used by the engine, it is "Detected()"
+// unless it is lowered with the environment variable
+// =====
+
+#ifndef UTILS_CPU_HPP
+#define UTILS_CPU_HPP
+
+#include "configs.hpp"
+#include "platform.hpp"
+
+#include <cinttypes>
+
+namespace mnt {
+
+  // Levels are ordered, a level implies all the lower ones of the same architecture
+  enum class ISA : uint8_t
+  {
+    Generic = 0,
+    SSE4,     // SSE4.1, SSSE3
+    AVX2,     // AVX2, FMA, F16C
+    AVX512,   // AVX-512 F, BW, DQ, VL
+    NEON,     // ARMv8 Advanced SIMD
+  };
+
+  struct CPUFeatures
+  {
+    // x86
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool popcnt = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool bmi2 = false;
+    bool avx512f = false;
+    bool avx512dq = false;
+    bool avx512bw = false;
+    bool avx512vl = false;
+    bool avx512vnni = false;
+    bool avx512bf16 = false;
+    bool avxvnni = false;
+
+    // ARM
+    bool neon = false;
+
+    // "GenuineIntel", "AuthenticAMD", etc. empty if not available
+    char vendor[13] = {0};
+  };
+
+  class CPU
+  {
+  public:
+    static const CPUFeatures& Features() noexcept;
+
+    static ISA Detected() noexcept;
+    static ISA Active() noexcept;
+
+    static bool Supports(ISA _isa) noexcept;
+
+    static const char* ISAName(ISA _isa) noexcept;
+
+    // Returns false if _name is not a valid ISA name
+    static bool ISAFromName(const char* _name, ISA& _isa) noexcept;
+
+  private:
+    static CPUFeatures Detect() noexcept;
+    static ISA SelectActive() noexcept;
+  };
+}
+
+#endif
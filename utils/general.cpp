@@ -362,3 +362,6 @@ int mnt::sprintf_mnt(char* _dest, size_t _dest_length, const char* const _format
   return needed_length;
 }
 
+// The memory classes are templates in headers, they can only call the instances made here
+template int mnt::sprintf_mnt<size_t>(char*, size_t, const char* const, size_t) noexcept;
+
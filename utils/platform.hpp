@@ -6,12 +6,14 @@
 // ---------------------
 // Detail Description:
 // Consists of macros and classes that be added as per MNT needs in future
-// Currently it only detect the Compiler and OS
+// Currently it detects the Compiler, OS and the CPU architecture, runtime detection
+// of CPU features (SSE, AVX, NEON, etc.) lives in "cpu.hpp"
 // --------------------
 
 // ---------------------
 // OS: Windows, Unix
 // Compiler: GCC, Clang, MSVC, MinGW
+// Architecture: x86, x86_64, ARM, ARM64
 // --------------------
 
 #ifndef UTILS_PLATFORM_HPP
@@ -33,6 +35,16 @@
   #endif
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+  #define MNT_ARCH_X86_64
+#elif defined(__i386__) || defined(_M_IX86)
+  #define MNT_ARCH_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  #define MNT_ARCH_ARM64
+#elif defined(__arm__) || defined(_M_ARM)
+  #define MNT_ARCH_ARM
+#endif
+
 #endif
 
 